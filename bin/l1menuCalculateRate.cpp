@@ -1,11 +1,17 @@
 #include <stdexcept>
 #include <iostream>
 #include <fstream>
+#include <limits>
+#include <tuple>
+#include <cmath>
 
 #include <TFile.h>
 #include "l1menu/ISample.h"
 #include "l1menu/IMenuRate.h"
 #include "l1menu/TriggerMenu.h"
+#include "l1menu/SampleRange.h"
+#include "l1menu/MenuRateSums.h"
+#include "l1menu/TriggerExpression.h"
 #include "l1menu/tools/CommandLineParser.h"
 #include "l1menu/tools/stringManipulation.h"
 #include "l1menu/tools/fileIO.h"
@@ -14,6 +20,18 @@ void printUsage( const std::string& executableName, std::ostream& output=std::co
 {
 	output << "Usage:" << "\n"
 			<< "\t" << executableName << " --totalrate <total rate in kHz> [--output <output filename>] [--format <CSV | OLD | XML>] <sample filename> <menu filename>" << "\n"
+			<< "\t" << "\t" << "[--first-event <event number>] [--num-events <number of events>] [--shard <i>/<N>] [--raw]" << "\n"
+			<< "\t" << "\t" << "Only events in the given range, or the i'th of N equal parts (counting from zero), are" << "\n"
+			<< "\t" << "\t" << "used. The \"raw\" option saves the unnormalised sums of weights to the \"output\" file" << "\n"
+			<< "\t" << "\t" << "instead of the rates, so that the results from several jobs can be combined with" << "\n"
+			<< "\t" << "\t" << "l1menuMergeShards." << "\n"
+			<< "\t" << "\t" << "[--overlaps <overlaps filename>] also saves the rate of events passing each pair of" << "\n"
+			<< "\t" << "\t" << "triggers as a CSV table, and adds them to the output if the format is XML." << "\n"
+			<< "\t" << "\t" << "[--query [<name>=]<expression>] prints the rate of events passing a boolean expression of" << "\n"
+			<< "\t" << "\t" << "the menu triggers, e.g. --query \"muons=L1_*Mu*\" or --query \"(L1_SingleMu OR L1_DoubleMu) AND NOT L1_HTT\"." << "\n"
+			<< "\t" << "\t" << "Can be given many times, and all are calculated in the same pass as the menu rates." << "\n"
+			<< "\t" << "\t" << "[--trigger-definitions <XML filename>] registers the triggers declared in the file before the" << "\n"
+			<< "\t" << "\t" << "sample and menu are loaded, so that they can use them. Can be given many times." << "\n"
 			<< "\n"
 			<< "\t" << executableName << " --help" << "\n"
 			<< "\t" << "\t" << "prints this help message" << "\n"
@@ -27,6 +45,13 @@ int main( int argc, char* argv[] )
 	std::string outputFilename;
 	l1menu::IL1MenuFile::FileFormat fileFormat=l1menu::IL1MenuFile::FileFormat::XML;
 	float totalTriggerRatekHz; // The rate if every single event passed
+	size_t firstEvent=0;
+	size_t numberOfEvents=std::numeric_limits<size_t>::max();
+	std::string shardSpecification;
+	bool outputRawSums=false;
+	std::string overlapsFilename;
+	std::vector<std::string> queries;
+	std::vector<std::string> triggerDefinitionsFilenames;
 
 	l1menu::tools::CommandLineParser commandLineParser;
 	try
@@ -34,6 +59,13 @@ int main( int argc, char* argv[] )
 		commandLineParser.addOption( "output", l1menu::tools::CommandLineParser::RequiredArgument );
 		commandLineParser.addOption( "totalrate", l1menu::tools::CommandLineParser::RequiredArgument );
 		commandLineParser.addOption( "format", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "first-event", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "num-events", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "shard", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "raw", l1menu::tools::CommandLineParser::NoArgument );
+		commandLineParser.addOption( "overlaps", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "query", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "trigger-definitions", l1menu::tools::CommandLineParser::RequiredArgument );
 		commandLineParser.addOption( "help", l1menu::tools::CommandLineParser::NoArgument );
 		commandLineParser.parse( argc, argv );
 
@@ -53,6 +85,26 @@ int main( int argc, char* argv[] )
 			else if( formatString=="CSV" ) fileFormat=l1menu::IL1MenuFile::FileFormat::CSV;
 			else throw std::runtime_error( "format must be one of 'XML', 'OLD', or 'CSV'" );
 		}
+		if( commandLineParser.optionHasBeenSet( "shard" ) )
+		{
+			if( commandLineParser.optionHasBeenSet( "first-event" ) || commandLineParser.optionHasBeenSet( "num-events" ) ) throw std::runtime_error( "The 'shard' option cannot be used with 'first-event' or 'num-events'" );
+			shardSpecification=commandLineParser.optionArguments("shard").back();
+			l1menu::SampleRange::parseShardSpecification( shardSpecification ); // Just to check the format now rather than after loading the sample
+		}
+		if( commandLineParser.optionHasBeenSet( "first-event" ) ) firstEvent=l1menu::tools::convertStringToSize( commandLineParser.optionArguments("first-event").back() );
+		if( commandLineParser.optionHasBeenSet( "num-events" ) ) numberOfEvents=l1menu::tools::convertStringToSize( commandLineParser.optionArguments("num-events").back() );
+		if( commandLineParser.optionHasBeenSet( "raw" ) )
+		{
+			if( !commandLineParser.optionHasBeenSet( "output" ) ) throw std::runtime_error( "The 'raw' option requires an output filename to be set with 'output'" );
+			outputRawSums=true;
+		}
+		if( commandLineParser.optionHasBeenSet( "overlaps" ) )
+		{
+			if( outputRawSums ) throw std::runtime_error( "The 'overlaps' option cannot be used with 'raw', the raw sums already include the overlaps" );
+			overlapsFilename=commandLineParser.optionArguments("overlaps").back();
+		}
+		if( commandLineParser.optionHasBeenSet( "query" ) ) queries=commandLineParser.optionArguments("query");
+		if( commandLineParser.optionHasBeenSet( "trigger-definitions" ) ) triggerDefinitionsFilenames=commandLineParser.optionArguments("trigger-definitions");
 
 		//
 		// Code to work out what to scale to
@@ -89,6 +141,11 @@ int main( int argc, char* argv[] )
 
 	try
 	{
+		for( const auto& definitionsFilename : triggerDefinitionsFilenames )
+		{
+			std::cout << "Loading trigger definitions from the file " << definitionsFilename << std::endl;
+			l1menu::tools::loadTriggerDefinitions( definitionsFilename );
+		}
 		std::cout << "Loading sample from the file " << sampleFilename << std::endl;
 		std::unique_ptr<l1menu::ISample> pSample=l1menu::tools::loadSample( sampleFilename );
 		pSample->setEventRate( totalTriggerRatekHz );
@@ -96,9 +153,27 @@ int main( int argc, char* argv[] )
 		std::cout << "Loading menu from file " << menuFilename << std::endl;
 		std::unique_ptr<l1menu::TriggerMenu> pMenu=l1menu::tools::loadMenu( menuFilename );
 
+		if( !shardSpecification.empty() )
+		{
+			std::pair<size_t,size_t> shard=l1menu::SampleRange::parseShardSpecification( shardSpecification );
+			std::tie( firstEvent, numberOfEvents )=l1menu::SampleRange::shardRange( shard.first, shard.second, pSample->numberOfEvents() );
+		}
+		l1menu::SampleRange sampleRange( *pSample, firstEvent, numberOfEvents );
+		if( sampleRange.numberOfEvents()!=pSample->numberOfEvents() ) std::cout << "Using " << sampleRange.numberOfEvents() << " events starting from event " << sampleRange.firstEvent() << std::endl;
+
 		std::cout << "Calculating rates..." << std::endl;
 
-		std::shared_ptr<const l1menu::IMenuRate> pRates=pSample->rate(*pMenu);
+		if( outputRawSums )
+		{
+			l1menu::MenuRateSums rateSums( *pMenu, sampleRange, queries );
+			rateSums.saveToFile( outputFilename );
+			std::cout << "Raw sums of weights saved to " << outputFilename << std::endl;
+			return 0;
+		}
+
+		// The sums are always calculated, because the queries have to be done in the same pass
+		l1menu::MenuRateSums rateSums( *pMenu, sampleRange, queries );
+		std::shared_ptr<const l1menu::IMenuRate> pRates=rateSums.rate();
 
 		if( !outputFilename.empty() )
 		{
@@ -106,7 +181,7 @@ int main( int argc, char* argv[] )
 			if( !outputFile.is_open() ) std::cerr << "ERROR unable to open " << outputFilename << " to store the output" << std::endl;
 			else
 			{
-				l1menu::tools::dumpTriggerRates( outputFile, *pRates, fileFormat );
+				l1menu::tools::dumpTriggerRates( outputFile, *pRates, fileFormat, !overlapsFilename.empty() );
 				std::cout << "Output saved to " << outputFilename << std::endl;
 			}
 		}
@@ -114,7 +189,31 @@ int main( int argc, char* argv[] )
 		else
 		{
 			std::cout << "\"output\" option not specified so dumping results to standard output" << "\n";
-			l1menu::tools::dumpTriggerRates( std::cout, *pRates, fileFormat );
+			l1menu::tools::dumpTriggerRates( std::cout, *pRates, fileFormat, !overlapsFilename.empty() );
+		}
+
+		if( rateSums.numberOfQueries()>0 )
+		{
+			std::cout << "Rates for the queries:" << "\n";
+			for( size_t queryNumber=0; queryNumber<rateSums.numberOfQueries(); ++queryNumber )
+			{
+				double fraction=rateSums.weightOfEventsPassingQuery(queryNumber)/rateSums.sumOfWeights();
+				double fractionError=std::sqrt(rateSums.weightSquaredOfEventsPassingQuery(queryNumber))/rateSums.sumOfWeights();
+				std::cout << "\t" << rateSums.query(queryNumber).name() << " = " << fraction*rateSums.eventRate()
+						<< " +/- " << fractionError*rateSums.eventRate() << " kHz" << "\n";
+			}
+			std::cout << std::flush;
+		}
+
+		if( !overlapsFilename.empty() )
+		{
+			std::ofstream overlapsFile( overlapsFilename );
+			if( !overlapsFile.is_open() ) std::cerr << "ERROR unable to open " << overlapsFilename << " to store the trigger overlaps" << std::endl;
+			else
+			{
+				l1menu::tools::dumpTriggerOverlaps( overlapsFile, *pRates );
+				std::cout << "Trigger overlaps saved to " << overlapsFilename << std::endl;
+			}
 		}
 
 	}
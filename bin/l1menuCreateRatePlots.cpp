@@ -1,14 +1,19 @@
 #include <stdexcept>
 #include <iostream>
+#include <limits>
+#include <tuple>
 
 #include <TFile.h>
+#include <TParameter.h>
 #include "l1menu/ISample.h"
 #include "l1menu/MenuRatePlots.h"
 #include "l1menu/IMenuRate.h"
 #include "l1menu/TriggerMenu.h"
+#include "l1menu/SampleRange.h"
 #include "l1menu/tools/miscellaneous.h"
 #include "l1menu/tools/fileIO.h"
 #include "l1menu/tools/CommandLineParser.h"
+#include "l1menu/tools/stringManipulation.h"
 
 void printUsage( const std::string& executableName, std::ostream& output=std::cout )
 {
@@ -18,6 +23,12 @@ void printUsage( const std::string& executableName, std::ostream& output=std::co
 			<< "\t" << "\t" << "you to specify the filename for the output (default is \"rateHistograms.root\"). The" << "\n"
 			<< "\t" << "\t" << "\"original-binning\" option will use the binning that was used in the L1Menu2015.C macro." << "\n"
 			<< "\n"
+			<< "\t" << "\t" << "Additional options [--first-event <event number>] [--num-events <number of events>] [--shard <i>/<N>]" << "\n"
+			<< "\t" << "\t" << "restrict the events used to the given range, or the i'th of N equal parts (counting from zero)." << "\n"
+			<< "\t" << "\t" << "The sum of weights is saved with the plots so that several files can be combined with l1menuMergeShards." << "\n"
+			<< "\t" << "\t" << "[--trigger-definitions <XML filename>] registers the triggers declared in the file before the" << "\n"
+			<< "\t" << "\t" << "sample and menu are loaded, so that they can use them. Can be given many times." << "\n"
+			<< "\n"
 			<< "\t" << executableName << " --help" << "\n"
 			<< "\t" << "\t" << "prints this help message"
 			<< "\n"
@@ -30,6 +41,10 @@ int main( int argc, char* argv[] )
 	std::string sampleFilename;
 	std::string menuFilename;
 	std::string outputFilename="rateHistograms.root"; // default value if not specified on the command line
+	size_t firstEvent=0;
+	size_t numberOfEvents=std::numeric_limits<size_t>::max();
+	std::string shardSpecification;
+	std::vector<std::string> triggerDefinitionsFilenames;
 
 	l1menu::tools::CommandLineParser commandLineParser;
 	try
@@ -37,6 +52,10 @@ int main( int argc, char* argv[] )
 		commandLineParser.addOption( "help", l1menu::tools::CommandLineParser::NoArgument );
 		commandLineParser.addOption( "output", l1menu::tools::CommandLineParser::RequiredArgument );
 		commandLineParser.addOption( "original-binning", l1menu::tools::CommandLineParser::NoArgument );
+		commandLineParser.addOption( "first-event", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "num-events", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "shard", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "trigger-definitions", l1menu::tools::CommandLineParser::RequiredArgument );
 		commandLineParser.parse( argc, argv );
 
 		if( commandLineParser.optionHasBeenSet( "help" ) )
@@ -47,6 +66,15 @@ int main( int argc, char* argv[] )
 
 		if( commandLineParser.optionHasBeenSet( "output" ) ) outputFilename=commandLineParser.optionArguments("output").back();
 		if( commandLineParser.optionHasBeenSet( "original-binning" ) ) l1menu::tools::setBinningToL1Menu2015Values();
+		if( commandLineParser.optionHasBeenSet( "trigger-definitions" ) ) triggerDefinitionsFilenames=commandLineParser.optionArguments("trigger-definitions");
+		if( commandLineParser.optionHasBeenSet( "shard" ) )
+		{
+			if( commandLineParser.optionHasBeenSet( "first-event" ) || commandLineParser.optionHasBeenSet( "num-events" ) ) throw std::runtime_error( "The 'shard' option cannot be used with 'first-event' or 'num-events'" );
+			shardSpecification=commandLineParser.optionArguments("shard").back();
+			l1menu::SampleRange::parseShardSpecification( shardSpecification ); // Just to check the format now rather than after loading the sample
+		}
+		if( commandLineParser.optionHasBeenSet( "first-event" ) ) firstEvent=l1menu::tools::convertStringToSize( commandLineParser.optionArguments("first-event").back() );
+		if( commandLineParser.optionHasBeenSet( "num-events" ) ) numberOfEvents=l1menu::tools::convertStringToSize( commandLineParser.optionArguments("num-events").back() );
 		if( commandLineParser.nonOptionArguments().size()<2 ) throw std::runtime_error( "Not enough command line arguments" );
 
 		const std::vector<std::string>& arguments=commandLineParser.nonOptionArguments();
@@ -72,10 +100,23 @@ int main( int argc, char* argv[] )
 		else throw std::logic_error( "The number of bunches has not been programmed for the bunch spacing selected" );
 
 
+		for( const auto& definitionsFilename : triggerDefinitionsFilenames )
+		{
+			std::cout << "Loading trigger definitions from the file " << definitionsFilename << std::endl;
+			l1menu::tools::loadTriggerDefinitions( definitionsFilename );
+		}
 		std::cout << "Loading sample from the file " << sampleFilename << std::endl;
 		std::unique_ptr<l1menu::ISample> pSample=l1menu::tools::loadSample( sampleFilename );
 		pSample->setEventRate( orbitsPerSecond*numberOfBunches*scaleToKiloHz );
 
+		if( !shardSpecification.empty() )
+		{
+			std::pair<size_t,size_t> shard=l1menu::SampleRange::parseShardSpecification( shardSpecification );
+			std::tie( firstEvent, numberOfEvents )=l1menu::SampleRange::shardRange( shard.first, shard.second, pSample->numberOfEvents() );
+		}
+		l1menu::SampleRange sampleRange( *pSample, firstEvent, numberOfEvents );
+		if( sampleRange.numberOfEvents()!=pSample->numberOfEvents() ) std::cout << "Using " << sampleRange.numberOfEvents() << " events starting from event " << sampleRange.firstEvent() << std::endl;
+
 		std::cout << "Loading menu from file " << menuFilename << std::endl;
 		std::unique_ptr<l1menu::TriggerMenu> pMenu=l1menu::tools::loadMenu( menuFilename );
 
@@ -93,7 +134,17 @@ int main( int argc, char* argv[] )
 		rateVersusThresholdPlots.relinquishOwnershipOfPlots();
 
 		std::cout << "Calculating rate plots..." << std::endl;
-		rateVersusThresholdPlots.addSample( *pSample );
+		rateVersusThresholdPlots.addSample( sampleRange );
+
+		// The plots are normalised to the sum of weights of the events used. Save that
+		// sum so that the normalisation can be undone when combining the plots from
+		// several jobs. These aren't histograms so MenuRatePlots will ignore them when
+		// loading the file.
+		pMyRootFile->cd();
+		TParameter<double> sumOfWeightsParameter( "sumOfWeights", sampleRange.sumOfWeights() );
+		sumOfWeightsParameter.Write();
+		TParameter<double> eventRateParameter( "eventRate", sampleRange.eventRate() );
+		eventRateParameter.Write();
 	}
 	catch( std::exception& error )
 	{
@@ -1,31 +1,74 @@
 #include "l1menu/FullSample.h"
 #include "l1menu/TriggerMenu.h"
 #include "l1menu/ReducedSample.h"
+#include "l1menu/SampleRange.h"
+#include "l1menu/tools/fileIO.h"
+#include "l1menu/tools/CommandLineParser.h"
+#include "l1menu/tools/stringManipulation.h"
 #include <iostream>
 #include <iomanip>
 #include <string>
 #include <stdexcept>
+#include <limits>
+#include <tuple>
 
+void printUsage( const std::string& executableName, std::ostream& output=std::cout )
+{
+	output << "   Usage: " << executableName << " [--output <output filename>] [--first-event <event number>] [--num-events <number of events>] [--shard <i>/<N>] <menu file> <input ntuple 1> [input ntuple 2 [...] ]" << "\n"
+			<< " Creates an l1menu::ReducedSample in protobuf format from the input files specified on the "
+			<< "command line. The output file is called \"reducedSample.proto\" unless specified with \"output\"." << "\n"
+			<< " Event numbers count through all of the input ntuples in the order given. The \"shard\" option uses the"
+			<< " i'th of N equal parts (counting from zero). Reduced samples made in separate jobs can be combined with"
+			<< " l1menuMergeShards." << "\n"
+			<< std::endl;
+}
 
 int main( int argc, char* argv[] )
 {
 	std::string outputFilename="reducedSample.proto";
+	std::string menuFilename;
+	std::vector<std::string> inputFilenames;
+	size_t firstEvent=0;
+	size_t numberOfEvents=std::numeric_limits<size_t>::max();
+	std::string shardSpecification;
 
-	if( argc<3 )
+	l1menu::tools::CommandLineParser commandLineParser;
+	try
 	{
-		std::string executableName=argv[0];
-		size_t lastSlashPosition=executableName.find_last_of('/');
-		if( lastSlashPosition!=std::string::npos ) executableName=executableName.substr( lastSlashPosition+1, std::string::npos );
-		std::cerr << "   Usage: " << executableName << " <menu file> <input ntuple 1> [input ntuple 2 [...] ]" << "\n"
-				<< " Creates an l1menu::ReducedSample in protobuf format from the input files specified on the "
-				<< "command line. The output file is called \"" << outputFilename << "\"." << std::endl;
-		return -1;
-	}
+		commandLineParser.addOption( "help", l1menu::tools::CommandLineParser::NoArgument );
+		commandLineParser.addOption( "output", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "first-event", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "num-events", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "shard", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.parse( argc, argv );
 
-	std::string menuFilename=argv[1];
+		if( commandLineParser.optionHasBeenSet( "help" ) )
+		{
+			printUsage( commandLineParser.executableName() );
+			return 0;
+		}
 
-	std::vector<std::string> inputFilenames;
-	for( int index=2; index<argc; ++index ) inputFilenames.push_back( argv[index] );
+		if( commandLineParser.optionHasBeenSet( "output" ) ) outputFilename=commandLineParser.optionArguments("output").back();
+		if( commandLineParser.optionHasBeenSet( "shard" ) )
+		{
+			if( commandLineParser.optionHasBeenSet( "first-event" ) || commandLineParser.optionHasBeenSet( "num-events" ) ) throw std::runtime_error( "The 'shard' option cannot be used with 'first-event' or 'num-events'" );
+			shardSpecification=commandLineParser.optionArguments("shard").back();
+			l1menu::SampleRange::parseShardSpecification( shardSpecification ); // Just to check the format now rather than after loading the samples
+		}
+		if( commandLineParser.optionHasBeenSet( "first-event" ) ) firstEvent=l1menu::tools::convertStringToSize( commandLineParser.optionArguments("first-event").back() );
+		if( commandLineParser.optionHasBeenSet( "num-events" ) ) numberOfEvents=l1menu::tools::convertStringToSize( commandLineParser.optionArguments("num-events").back() );
+		if( commandLineParser.nonOptionArguments().size()<2 ) throw std::runtime_error( "Not enough command line arguments" );
+
+		const std::vector<std::string>& arguments=commandLineParser.nonOptionArguments();
+		menuFilename=arguments[0];
+		inputFilenames.insert( inputFilenames.end(), arguments.begin()+1, arguments.end() );
+	} // end of try block
+	catch( std::exception& error )
+	{
+		std::cerr << "Error parsing the command line: " << error.what() << std::endl;
+		printUsage( commandLineParser.executableName(), std::cerr );
+		return -1;
+	}
 
 
 	try
@@ -35,11 +78,46 @@ int main( int argc, char* argv[] )
 
 		l1menu::ReducedSample outputReducedSample( *pMyMenu );
 
+		// To split into shards I need to know how many events there are in total
+		// before I start.
+		if( !shardSpecification.empty() )
+		{
+			size_t totalEvents=0;
+			for( const auto& filename : inputFilenames )
+			{
+				l1menu::FullSample inputSample;
+				inputSample.loadFile(filename);
+				totalEvents+=inputSample.numberOfEvents();
+			}
+			std::pair<size_t,size_t> shard=l1menu::SampleRange::parseShardSpecification( shardSpecification );
+			std::tie( firstEvent, numberOfEvents )=l1menu::SampleRange::shardRange( shard.first, shard.second, totalEvents );
+			std::cout << "Using " << numberOfEvents << " events starting from event " << firstEvent << std::endl;
+		}
+
+		// The event range is over all of the input files in order, so keep track of
+		// how many events have been skipped or used so far.
+		size_t eventsToSkip=firstEvent;
+		size_t eventsRemaining=numberOfEvents;
 		for( const auto& filename : inputFilenames )
 		{
+			if( eventsRemaining==0 ) break;
+
 			l1menu::FullSample inputSample;
 			inputSample.loadFile(filename);
-			outputReducedSample.addSample( inputSample );
+
+			if( eventsToSkip>=inputSample.numberOfEvents() )
+			{
+				eventsToSkip-=inputSample.numberOfEvents();
+				continue;
+			}
+
+			size_t eventsFromThisFile=inputSample.numberOfEvents()-eventsToSkip;
+			if( eventsFromThisFile>eventsRemaining ) eventsFromThisFile=eventsRemaining;
+
+			outputReducedSample.addSample( inputSample, eventsToSkip, eventsFromThisFile );
+
+			eventsRemaining-=eventsFromThisFile;
+			eventsToSkip=0;
 		}
 
 		outputReducedSample.saveToFile( outputFilename );
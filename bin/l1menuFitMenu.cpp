@@ -30,6 +30,8 @@ void printUsage( const std::string& executableName, std::ostream& output=std::co
 			<< "\t" << "\t" << "standard output." << "\n"
 			<< "\t" << "\t" << "The 'format' option allows you specify what format the output will be in. XML (the default)" << "\n"
 			<< "\t" << "\t" << "is required to do the scaling with l1menuScaleMenuRates." << "\n"
+			<< "\t" << "\t" << "[--trigger-definitions <XML filename>] registers the triggers declared in the file before the" << "\n"
+			<< "\t" << "\t" << "sample and menu are loaded, so that they can use them. Can be given many times." << "\n"
 			<< "\n"
 			<< "\t" << executableName << " --help" << "\n"
 			<< "\t" << "\t" << "prints this help message"
@@ -46,6 +48,7 @@ int main( int argc, char* argv[] )
 	l1menu::IL1MenuFile::FileFormat fileFormat=l1menu::IL1MenuFile::FileFormat::XML;
 	float totalTriggerRatekHz; // The rate if every single event passed
 	std::vector<float> totalRates;
+	std::vector<std::string> triggerDefinitionsFilenames;
 
 	l1menu::tools::CommandLineParser commandLineParser;
 	try
@@ -55,6 +58,7 @@ int main( int argc, char* argv[] )
 		commandLineParser.addOption( "rateplots", l1menu::tools::CommandLineParser::RequiredArgument );
 		commandLineParser.addOption( "output", l1menu::tools::CommandLineParser::RequiredArgument );
 		commandLineParser.addOption( "format", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "trigger-definitions", l1menu::tools::CommandLineParser::RequiredArgument );
 		commandLineParser.parse( argc, argv );
 
 		if( commandLineParser.optionHasBeenSet( "help" ) )
@@ -65,6 +69,7 @@ int main( int argc, char* argv[] )
 
 		if( commandLineParser.nonOptionArguments().size()<3 ) throw std::runtime_error( "Not enough command line arguments" );
 		if( commandLineParser.optionHasBeenSet( "rateplots" ) ) ratePlotsFilename=commandLineParser.optionArguments("rateplots").back();
+		if( commandLineParser.optionHasBeenSet( "trigger-definitions" ) ) triggerDefinitionsFilenames=commandLineParser.optionArguments("trigger-definitions");
 		if( commandLineParser.optionHasBeenSet( "format" ) )
 		{
 			std::string formatString=commandLineParser.optionArguments("format").back();
@@ -133,6 +138,11 @@ int main( int argc, char* argv[] )
 
 	try
 	{
+		for( const auto& definitionsFilename : triggerDefinitionsFilenames )
+		{
+			std::cout << "Loading trigger definitions from the file " << definitionsFilename << std::endl;
+			l1menu::tools::loadTriggerDefinitions( definitionsFilename );
+		}
 		std::cout << "Loading sample from the file " << sampleFilename << std::endl;
 		std::unique_ptr<l1menu::ISample> pSample=l1menu::tools::loadSample( sampleFilename );
 		std::cout << "Loading menu from file " << menuFilename << std::endl;
@@ -0,0 +1,232 @@
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <functional>
+
+#include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TList.h>
+#include <TParameter.h>
+#include "l1menu/IMenuRate.h"
+#include "l1menu/MenuRateSums.h"
+#include "l1menu/ReducedSample.h"
+#include "l1menu/tools/CommandLineParser.h"
+#include "l1menu/tools/fileIO.h"
+
+void printUsage( const std::string& executableName, std::ostream& output=std::cout )
+{
+	output << "Usage:" << "\n"
+			<< "\t" << executableName << " --output <output filename> [--raw] [--format <CSV | OLD | XML>] <input 1> <input 2> [input 3 [...] ]" << "\n"
+			<< "\t" << "\t" << "Combines the outputs of several jobs that were each run over part of a sample (e.g. with the" << "\n"
+			<< "\t" << "\t" << "\"shard\" option). The inputs must all be the same type, which can be any of:" << "\n"
+			<< "\t" << "\t" << "  - raw sums from l1menuCalculateRate --raw. The combined rates are written in the format given" << "\n"
+			<< "\t" << "\t" << "    by \"format\" (default XML), or if \"raw\" is set the combined raw sums are written so that" << "\n"
+			<< "\t" << "\t" << "    they can be merged again later." << "\n"
+			<< "\t" << "\t" << "  - rate plots from l1menuCreateRatePlots." << "\n"
+			<< "\t" << "\t" << "  - reduced samples from l1menuCreateReducedSample." << "\n"
+			<< "\t" << "\t" << "The result is the same as if a single job had been run over all of the events." << "\n"
+			<< "\n"
+			<< "\t" << executableName << " --help" << "\n"
+			<< "\t" << "\t" << "prints this help message" << "\n"
+			<< std::endl;
+}
+
+/** @brief Returns the first few characters of the file so that the file type can be determined. */
+std::string fileStart( const std::string& filename )
+{
+	std::ifstream inputFile( filename, std::ios_base::binary );
+	if( !inputFile.is_open() ) throw std::runtime_error( "The file "+filename+" does not exist or could not be opened" );
+
+	const size_t bufferSize=20;
+	char buffer[bufferSize];
+	inputFile.get( buffer, bufferSize );
+	return std::string(buffer);
+}
+
+/** @brief Reads a TParameter<double> from the file, or throws a std::runtime_error if it is not there. */
+double getParameter( TFile& file, const std::string& parameterName )
+{
+	TParameter<double>* pParameter=dynamic_cast<TParameter<double>*>( file.Get( parameterName.c_str() ) );
+	if( pParameter==nullptr ) throw std::runtime_error( std::string("The file ")+file.GetName()+" has no \""+parameterName+"\" record. It was probably made with an old version of l1menuCreateRatePlots." );
+	return pParameter->GetVal();
+}
+
+/** @brief Combines the rate plots in several files, weighting each by the sum of weights of the events used to create it.
+ *
+ * Each plot is normalised with the sum of weights of the events in that file, so multiplying by
+ * that sum gives back the raw sums. These are added and then normalised with the total sum of
+ * weights, so every histogram has to be in every file or a std::runtime_error is thrown.
+ */
+void mergeRatePlots( const std::vector<std::string>& inputFilenames, const std::string& outputFilename )
+{
+	// Use a smart pointer with a custom deleter that will close the file properly.
+	std::unique_ptr<TFile,std::function<void(TFile*)>> pOutputFile( new TFile( outputFilename.c_str(), "RECREATE" ),
+			[](TFile*p){ p->Write();p->Close();delete p; } );
+
+	std::map<std::string,TH1*> mergedHistograms; // Owned by pOutputFile
+	std::map<std::string,size_t> numberOfFilesWithHistogram; // Each is normalised by every file's weights, so must be in every file
+	double totalSumOfWeights=0;
+	double eventRate=-1;
+
+	for( const auto& filename : inputFilenames )
+	{
+		std::unique_ptr<TFile> pInputFile( TFile::Open( filename.c_str() ) );
+		if( pInputFile==nullptr || pInputFile->IsZombie() ) throw std::runtime_error( "Unable to open the file "+filename );
+
+		double sumOfWeights=getParameter( *pInputFile, "sumOfWeights" );
+		double fileEventRate=getParameter( *pInputFile, "eventRate" );
+		if( eventRate==-1 ) eventRate=fileEventRate;
+		else if( eventRate!=fileEventRate ) throw std::runtime_error( "The file "+filename+" was made with a different event rate to the previous files" );
+		totalSumOfWeights+=sumOfWeights;
+
+		TList* pListOfKeys=pInputFile->GetListOfKeys();
+		std::string oldKeyName;
+		for( int index=0; index<pListOfKeys->GetEntries(); ++index )
+		{
+			TKey* pKey=dynamic_cast<TKey*>( pListOfKeys->At(index) );
+			// Only use the highest cycle number for each key
+			if( oldKeyName==pKey->GetName() ) continue;
+			oldKeyName=pKey->GetName();
+
+			std::unique_ptr<TH1> pHistogram( dynamic_cast<TH1*>( pKey->ReadObj() ) );
+			if( pHistogram==nullptr ) continue;
+			pHistogram->SetDirectory( nullptr );
+
+			auto iFindResult=mergedHistograms.find( pHistogram->GetName() );
+			if( iFindResult==mergedHistograms.end() )
+			{
+				if( filename!=inputFilenames.front() ) throw std::runtime_error( std::string("The histogram ")+pHistogram->GetName()+" in "+filename+" is not in the first file" );
+				TH1* pMergedHistogram=static_cast<TH1*>( pHistogram->Clone() );
+				pMergedHistogram->SetDirectory( pOutputFile.get() );
+				pMergedHistogram->Scale( sumOfWeights );
+				mergedHistograms[pHistogram->GetName()]=pMergedHistogram;
+			}
+			else
+			{
+				// The title records the trigger and all of its parameters, so check they match
+				if( std::string(iFindResult->second->GetTitle())!=pHistogram->GetTitle() ) throw std::runtime_error( std::string("The histogram ")+pHistogram->GetName()+" in "+filename+" was made with a different trigger to the previous files" );
+				iFindResult->second->Add( pHistogram.get(), sumOfWeights );
+			}
+			++numberOfFilesWithHistogram[pHistogram->GetName()];
+		} // end of loop over keys
+	} // end of loop over input files
+
+	for( const auto& nameNumberPair : numberOfFilesWithHistogram )
+	{
+		if( nameNumberPair.second!=inputFilenames.size() ) throw std::runtime_error( "The histogram "+nameNumberPair.first+" is only in "+std::to_string(nameNumberPair.second)+" of the "+std::to_string(inputFilenames.size())+" input files" );
+	}
+	for( auto& nameHistogramPair : mergedHistograms ) nameHistogramPair.second->Scale( 1.0/totalSumOfWeights );
+
+	// Record the total so that the output can be merged again if required
+	pOutputFile->cd();
+	TParameter<double> sumOfWeightsParameter( "sumOfWeights", totalSumOfWeights );
+	sumOfWeightsParameter.Write();
+	TParameter<double> eventRateParameter( "eventRate", eventRate );
+	eventRateParameter.Write();
+
+	std::cout << "Merged rate plots written to file \"" << outputFilename << "\"" << std::endl;
+}
+
+int main( int argc, char* argv[] )
+{
+	std::string outputFilename;
+	std::vector<std::string> inputFilenames;
+	bool outputRawSums=false;
+	l1menu::IL1MenuFile::FileFormat fileFormat=l1menu::IL1MenuFile::FileFormat::XML;
+
+	l1menu::tools::CommandLineParser commandLineParser;
+	try
+	{
+		commandLineParser.addOption( "output", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "raw", l1menu::tools::CommandLineParser::NoArgument );
+		commandLineParser.addOption( "format", l1menu::tools::CommandLineParser::RequiredArgument );
+		commandLineParser.addOption( "help", l1menu::tools::CommandLineParser::NoArgument );
+		commandLineParser.parse( argc, argv );
+
+		if( commandLineParser.optionHasBeenSet( "help" ) )
+		{
+			printUsage( commandLineParser.executableName() );
+			return 0;
+		}
+
+		if( !commandLineParser.optionHasBeenSet( "output" ) ) throw std::runtime_error( "The output filename must be set with 'output'" );
+		outputFilename=commandLineParser.optionArguments("output").back();
+		if( commandLineParser.optionHasBeenSet( "raw" ) ) outputRawSums=true;
+		if( commandLineParser.optionHasBeenSet( "format" ) )
+		{
+			std::string formatString=commandLineParser.optionArguments("format").back();
+			if( formatString=="XML" ) fileFormat=l1menu::IL1MenuFile::FileFormat::XML;
+			else if( formatString=="OLD" ) fileFormat=l1menu::IL1MenuFile::FileFormat::OLD;
+			else if( formatString=="CSV" ) fileFormat=l1menu::IL1MenuFile::FileFormat::CSV;
+			else throw std::runtime_error( "format must be one of 'XML', 'OLD', or 'CSV'" );
+		}
+
+		inputFilenames=commandLineParser.nonOptionArguments();
+		if( inputFilenames.empty() ) throw std::runtime_error( "No input files were given" );
+	} // end of try block
+	catch( std::exception& error )
+	{
+		std::cerr << "Error parsing the command line: " << error.what() << std::endl;
+		printUsage( commandLineParser.executableName(), std::cerr );
+		return -1;
+	}
+
+
+	try
+	{
+		// Work out what type of file I'm merging from the first file, and check the rest
+		// are the same.
+		std::string fileType=fileStart( inputFilenames.front() );
+		if( fileType.substr(0,4)=="root" ) fileType="root";
+		else if( fileType!="l1menuReducedSample" ) fileType="xml";
+
+		for( const auto& filename : inputFilenames )
+		{
+			std::string thisFileType=fileStart( filename );
+			if( thisFileType.substr(0,4)=="root" ) thisFileType="root";
+			else if( thisFileType!="l1menuReducedSample" ) thisFileType="xml";
+			if( thisFileType!=fileType ) throw std::runtime_error( "The file "+filename+" is not the same type as "+inputFilenames.front() );
+		}
+
+		if( fileType=="root" ) mergeRatePlots( inputFilenames, outputFilename );
+		else if( fileType=="l1menuReducedSample" )
+		{
+			l1menu::ReducedSample mergedSample( inputFilenames.front() );
+			for( size_t index=1; index<inputFilenames.size(); ++index )
+			{
+				std::cout << "Adding " << inputFilenames[index] << std::endl;
+				mergedSample.addSample( l1menu::ReducedSample( inputFilenames[index] ) );
+			}
+			mergedSample.saveToFile( outputFilename );
+			std::cout << "Merged reduced sample saved to " << outputFilename << std::endl;
+		}
+		else
+		{
+			l1menu::MenuRateSums mergedSums( inputFilenames.front() );
+			for( size_t index=1; index<inputFilenames.size(); ++index ) mergedSums.add( l1menu::MenuRateSums( inputFilenames[index] ) );
+
+			if( outputRawSums )
+			{
+				mergedSums.saveToFile( outputFilename );
+				std::cout << "Merged raw sums of weights saved to " << outputFilename << std::endl;
+			}
+			else
+			{
+				std::ofstream outputFile( outputFilename );
+				if( !outputFile.is_open() ) throw std::runtime_error( "Unable to open "+outputFilename+" to store the output" );
+				l1menu::tools::dumpTriggerRates( outputFile, *mergedSums.rate(), fileFormat );
+				std::cout << "Merged rates from " << mergedSums.numberOfEvents() << " events saved to " << outputFilename << std::endl;
+			}
+		}
+	}
+	catch( std::exception& error )
+	{
+		std::cerr << "Exception caught: " << error.what() << std::endl;
+		return -1;
+	}
+
+	return 0;
+}
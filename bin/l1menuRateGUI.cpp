@@ -9,6 +9,7 @@
 #include "l1menu/IMenuRate.h"
 #include "l1menu/ITriggerRate.h"
 #include "l1menu/ReducedSample.h"
+#include "l1menu/TotalRateCalculator.h"
 #include "l1menu/IL1MenuFile.h"
 #include "l1menu/tools/miscellaneous.h"
 
@@ -69,6 +70,7 @@ namespace menuwidgets
 		void saveMenu();
 	private:
 		l1menu::ReducedSample& sample_;
+		l1menu::TotalRateCalculator totalRateCalculator_; ///< Kept between calculations so that it remembers the best trigger order
 		l1menu::TriggerMenu menu_;
 		std::vector<TriggerWidget*> triggerWidgets_;
 		std::unique_ptr<QDoubleSpinBox> pCollisionRate_;
@@ -216,7 +218,7 @@ void menuwidgets::TriggerWidget::thresholdChanged( double value )
 
 }
 
-menuwidgets::MainWidget::MainWidget( l1menu::ReducedSample& sample ) : sample_(sample), menu_(sample.getTriggerMenu())
+menuwidgets::MainWidget::MainWidget( l1menu::ReducedSample& sample ) : sample_(sample), totalRateCalculator_(sample), menu_(sample.getTriggerMenu())
 {
 	std::unique_ptr<QVBoxLayout> pTriggerListLayout( new QVBoxLayout );
 
@@ -284,20 +286,36 @@ void menuwidgets::MainWidget::calculateRates()
 	}
 
 	sample_.setEventRate( pCollisionRate_->value() );
-	std::shared_ptr<const l1menu::IMenuRate> pMenuRate=sample_.rate(menuForCalculation);
-	pTotalRateLabel_->setText( ("Total rate= "+std::to_string(pMenuRate->totalRate())+" +/- "+std::to_string(pMenuRate->totalRateError())+" kHz").c_str() );
+	// The total only needs each event to pass one trigger, so it can be shown before the per trigger
+	// rates are known.
+	pTotalRateLabel_->setText( ("Total rate= "+std::to_string(totalRateCalculator_.totalRate(menuForCalculation))+" kHz (calculating the trigger rates)").c_str() );
+	QApplication::processEvents( QEventLoop::ExcludeUserInputEvents );
 
 	// The trigger rates should be in the same order as the active trigger widgets
-	std::vector<const l1menu::ITriggerRate*>::const_iterator iTriggerRate=pMenuRate->triggerRates().begin();
-	for( const auto& pTriggerWidget : triggerWidgets_ )
+	auto setTriggerRates=[this]( const l1menu::IMenuRate& menuRate )
 	{
-		if( pTriggerWidget->isEnabled() )
+		std::vector<const l1menu::ITriggerRate*>::const_iterator iTriggerRate=menuRate.triggerRates().begin();
+		for( const auto& pTriggerWidget : triggerWidgets_ )
 		{
-			pTriggerWidget->setRate( *iTriggerRate );
-			++iTriggerRate;
-			if( iTriggerRate==pMenuRate->triggerRates().begin() ) break;
+			if( pTriggerWidget->isEnabled() )
+			{
+				if( iTriggerRate==menuRate.triggerRates().end() ) break;
+				pTriggerWidget->setRate( *iTriggerRate );
+				++iTriggerRate;
+			}
 		}
-	}
+	};
+
+	// Go through the sample a block at a time so that estimates of the trigger rates can be shown while
+	// the rest is calculated. Once every block is done the result is the same as sample_.rate().
+	std::shared_ptr<const l1menu::IMenuRate> pMenuRate=sample_.progressiveRate( menuForCalculation, [&]( const l1menu::IMenuRate& rateSoFar )
+		{
+			setTriggerRates( rateSoFar );
+			QApplication::processEvents( QEventLoop::ExcludeUserInputEvents );
+			return true;
+		} );
+	pTotalRateLabel_->setText( ("Total rate= "+std::to_string(pMenuRate->totalRate())+" +/- "+std::to_string(pMenuRate->totalRateError())+" kHz").c_str() );
+	setTriggerRates( *pMenuRate );
 
 	// Re-enable the button
 	pCalculateRateButton_->setDisabled(false);
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 #include "l1menu/ISample.h"
 
 // Forward declarations
@@ -37,6 +38,12 @@ namespace l1menu
 		void loadFile( const std::string& filename );
 		void loadFilesFromList( const std::string& filenameOfList );
 		const l1menu::L1TriggerDPGEvent& getFullEvent( size_t eventNumber ) const;
+		/** @brief Loads several consecutive events at once, e.g. for ITrigger::applyBatch.
+		 *
+		 * The returned events are only valid until the next call of getFullEvents. This isn't any slower
+		 * than calling getFullEvent for each one, because each event is swapped into the batch rather
+		 * than copied. */
+		const std::vector<const l1menu::L1TriggerDPGEvent*>& getFullEvents( size_t firstEventNumber, size_t numberOfEvents ) const;
 
 		virtual size_t numberOfEvents() const;
 		virtual const l1menu::IEvent& getEvent( size_t eventNumber ) const;
@@ -46,6 +53,8 @@ namespace l1menu
 		virtual float sumOfWeights() const;
 		virtual std::shared_ptr<const l1menu::IMenuRate> rate( const l1menu::TriggerMenu& menu ) const;
 		virtual std::shared_ptr<const l1menu::IMenuRate> rate( const l1menu::TriggerMenu& menu, const l1menu::MenuRatePlots& ratePlots ) const;
+		virtual std::vector< std::shared_ptr<const l1menu::IMenuRate> > rates( const std::vector<l1menu::TriggerMenu>& menus ) const;
+		virtual std::shared_ptr<const l1menu::IMenuRate> progressiveRate( const l1menu::TriggerMenu& menu, const std::function<bool(const l1menu::IMenuRate& rateSoFar)>& progressCallback, float relativeErrorTolerance=0 ) const;
 	private:
 		class FullSamplePrivateMembers* pImple_;
 	}; // end of class FullSample
@@ -23,6 +23,8 @@ namespace l1menu
 		virtual ~IEvent() {}
 		virtual bool passesTrigger( const l1menu::ITrigger& trigger ) const = 0;
 		virtual float weight() const = 0; ///< @brief The weighting this event has been given
+		virtual unsigned int run() const = 0; ///< @brief The run the event was recorded in, or zero if not known
+		virtual unsigned int lumiSection() const = 0; ///< @brief The luminosity section in the run, or zero if not known
 		virtual const l1menu::ISample& sample() const = 0; ///< @brief The sample that this event came from.
 	};
 
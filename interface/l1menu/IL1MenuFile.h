@@ -26,8 +26,14 @@ namespace l1menu
 		enum class FileFormat : char { XML, OLD, CSV };
 
 	public:
-		static std::unique_ptr<l1menu::IL1MenuFile> getOutputFile( FileFormat fileFormat, std::ostream& outputStream );
-		static std::unique_ptr<l1menu::IL1MenuFile> getOutputFile( FileFormat fileFormat, const std::string& filename );
+		/** @brief Get an instance that writes to the stream or file.
+		 *
+		 * @param[in] includeOverlaps  Whether to also write the overlaps between pairs of triggers for rates that
+		 *                             have them (see IMenuRate::overlaps()). Only the XML format supports this,
+		 *                             and it's off by default so that the files are the same as they always were.
+		 */
+		static std::unique_ptr<l1menu::IL1MenuFile> getOutputFile( FileFormat fileFormat, std::ostream& outputStream, bool includeOverlaps=false );
+		static std::unique_ptr<l1menu::IL1MenuFile> getOutputFile( FileFormat fileFormat, const std::string& filename, bool includeOverlaps=false );
 
 		/** @brief Get an instance populated with some previously saved information.
 		 *
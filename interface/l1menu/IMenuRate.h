@@ -10,6 +10,7 @@
 namespace l1menu
 {
 	class ITriggerRate;
+	struct IMenuRateOverlaps;
 	namespace tools
 	{
 		class XMLElement;
@@ -36,6 +37,12 @@ namespace l1menu
 
 		virtual const std::vector<const l1menu::ITriggerRate*>& triggerRates() const = 0;
 
+		/** @brief The overlaps between each pair of triggers, or nullptr if they weren't calculated.
+		 *
+		 * Not every implementation can provide these (e.g. after scaling), so this has a default
+		 * implementation rather than being pure virtual. The pointer is valid as long as this object. */
+		virtual const l1menu::IMenuRateOverlaps* overlaps() const { return nullptr; }
+
 //		virtual void save( std::ostream& outputStream ) const = 0;
 //		virtual void convertToXML( l1menu::tools::XMLElement& parentElement ) const = 0;
 //		static std::unique_ptr<l1menu::IMenuRate> load( const std::string& filename );
@@ -0,0 +1,31 @@
+#ifndef l1menu_IMenuRateOverlaps_h
+#define l1menu_IMenuRateOverlaps_h
+
+#include <cstddef>
+
+namespace l1menu
+{
+	/** @brief Interface to the pairwise overlaps between the triggers in an IMenuRate.
+	 *
+	 * Get one from IMenuRate::overlaps(). Triggers are identified by their index in IMenuRate::triggerRates().
+	 * The matrix is symmetric, and the diagonal is the trigger's own fraction or rate. Useful for deciding
+	 * which triggers can be removed from a menu, since the overlap with everything else is known without
+	 * having to recalculate the menu with each trigger removed.
+	 */
+	struct IMenuRateOverlaps
+	{
+	public:
+		virtual ~IMenuRateOverlaps() {}
+
+		/** @brief The fraction of events that passed both triggers, before applying any scaling. */
+		virtual float overlapFraction( size_t firstTriggerNumber, size_t secondTriggerNumber ) const = 0;
+		virtual float overlapFractionError( size_t firstTriggerNumber, size_t secondTriggerNumber ) const = 0;
+
+		/** @brief The rate of events that passed both triggers, so overlapFraction multiplied by the scaling. */
+		virtual float overlapRate( size_t firstTriggerNumber, size_t secondTriggerNumber ) const = 0;
+		virtual float overlapRateError( size_t firstTriggerNumber, size_t secondTriggerNumber ) const = 0;
+	};
+
+} // end of namespace l1menu
+
+#endif
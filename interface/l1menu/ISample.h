@@ -2,6 +2,8 @@
 #define l1menu_ISample_h
 
 #include <memory>
+#include <functional>
+#include <vector>
 
 //
 // Forward declarations
@@ -42,6 +44,13 @@ namespace l1menu
 		virtual std::shared_ptr<const l1menu::IMenuRate> rate( const l1menu::TriggerMenu& menu ) const = 0;
 		/** @brief Overload that will use the MenuRatePlots supplied to calculate errors on the thresholds. */
 		virtual std::shared_ptr<const l1menu::IMenuRate> rate( const l1menu::TriggerMenu& menu, const l1menu::MenuRatePlots& ratePlots ) const = 0;
+		/** @brief The rates for each of the menus, from one pass over the events. Triggers that are the same in more
+		 * than one menu are only applied once. See MenuRateSums::forEachMenu. */
+		virtual std::vector< std::shared_ptr<const l1menu::IMenuRate> > rates( const std::vector<l1menu::TriggerMenu>& menus ) const = 0;
+		/** @brief Calculates the rates from blocks of events taken in a random order, calling progressCallback with
+		 * the estimate so far after each block. Stops when the callback returns false, or when the relative error on
+		 * the total rate drops below relativeErrorTolerance if that is more than zero. See MenuRateSums::progressive. */
+		virtual std::shared_ptr<const l1menu::IMenuRate> progressiveRate( const l1menu::TriggerMenu& menu, const std::function<bool(const l1menu::IMenuRate& rateSoFar)>& progressCallback, float relativeErrorTolerance=0 ) const = 0;
 	};
 
 } // end of namespace l1menu
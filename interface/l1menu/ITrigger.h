@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 #include "l1menu/ITriggerDescription.h"
 
 // Forward declarations
@@ -27,6 +28,10 @@ namespace l1menu
 	 * this depends on the implementation of this interface to follow the convention.
 	 * There are some tools in l1menu::tools to get a std::vector of the threshold names.
 	 *
+	 * Parameters can also be accessed with the ParameterHandle from parameterIndex(), which
+	 * avoids the string comparisons. Anything looping over events should get the handles
+	 * first and use those.
+	 *
 	 * Other parameters can be set and queried in the same way, depending on the
 	 * implementation. Current examples are "muonQuality", "etaCut" and "regionCut". Muon
 	 * triggers tend to specify eta cuts in absolute eta ("etaCut"), whereas jets and
@@ -41,6 +46,13 @@ namespace l1menu
 	 * and pass the trigger to IEvent::passesTrigger(). That delegates to however the
 	 * ISample/IEvent implementation wants to do it.
 	 *
+	 * When the same trigger is applied many times, applyBatch() can be used instead of apply().
+	 * There are default implementations that just call apply(), but some trigger families
+	 * override them with something quicker.
+	 *
+	 * Copies should be made with clone(). Implementations normally get it by deriving from
+	 * l1menu::triggers::CloneableTrigger, which uses their copy constructor.
+	 *
 	 * For details on implementing new triggers by subclassing this interface, see
 	 * @ref L1Trigger_MenuGeneration_implementingTriggers.
 	 *
@@ -52,9 +64,28 @@ namespace l1menu
 	public:
 		virtual ~ITrigger() {}
 		virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const = 0;
+		/** @brief Applies the trigger to each of the events, with passed[i] set to the result for events[i].
+		 *
+		 * "passed" is resized to the number of events. The default implementation calls apply() for each
+		 * event, overriding implementations must give the same results. */
+		virtual void applyBatch( const std::vector<const l1menu::L1TriggerDPGEvent*>& events, std::vector<bool>& passed ) const;
+		/** @brief Applies the trigger to one event for each of the values of a threshold parameter.
+		 *
+		 * passed[i] is set to the result of apply() with the parameter set to values[i]. The values must be
+		 * in ascending order, and the parameter has to behave like a threshold, i.e. if the event passes
+		 * for one value then it passes for every lower value. When the call returns the parameter is left
+		 * with the value it had before.
+		 *
+		 * The default implementation uses bisection so only calls apply() a few times. Implementations where
+		 * the result for every value can be read off from one calculation should override this. */
+		virtual void applyBatch( const l1menu::L1TriggerDPGEvent& event, ParameterHandle thresholdHandle, const std::vector<float>& values, std::vector<bool>& passed );
 		virtual bool thresholdsAreCorrelated() const = 0;
+		/** @brief Returns a copy of this trigger, including the current parameter values. */
+		virtual std::unique_ptr<l1menu::ITrigger> clone() const = 0;
 		/** @brief A version of the method from ITriggerEvent that allows the parameter to be changed. */
 		virtual float& parameter( const std::string& parameterName ) = 0;
+		/** @brief Non const version of parameter(ParameterHandle), in the same way as for names. */
+		virtual float& parameter( ParameterHandle handle ) = 0;
 
 		//
 		// These are the methods from ITriggerDescription that any subclass
@@ -64,6 +95,7 @@ namespace l1menu
 		virtual unsigned int version() const = 0;
 		virtual const std::vector<std::string> parameterNames() const = 0;
 		virtual const float& parameter( const std::string& parameterName ) const = 0;
+		virtual const float& parameter( ParameterHandle handle ) const = 0;
 	};
 
 } // end of namespace l1menu
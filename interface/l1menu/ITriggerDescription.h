@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <cstddef>
 
 // Forward declarations
 namespace l1menu
@@ -19,17 +20,38 @@ namespace l1menu
 	/** @brief Abstract interface for a description. This interface should give enough information to
 	 * uniquely describe a specific trigger.
 	 *
+	 * Parameters can be looked up either by name or by a ParameterHandle. Looking up by name
+	 * requires string comparisons, so if a parameter is accessed repeatedly (e.g. in an event
+	 * loop) get the handle once with parameterIndex() and use that instead. A handle is just
+	 * the position of the parameter in the list returned by parameterNames(), so it is only
+	 * valid for descriptions of the same implementation with the same name and version.
+	 *
 	 * @author Mark Grimes (mark.grimes@bristol.ac.uk)
 	 * @date 14/Oct/2013
 	 */
 	class ITriggerDescription
 	{
 	public:
+		/** @brief Identifies a parameter without needing a string lookup, see parameterIndex(). */
+		typedef size_t ParameterHandle;
+
 		virtual ~ITriggerDescription() {}
 		virtual const std::string name() const = 0;
 		virtual unsigned int version() const = 0;
 		virtual const std::vector<std::string> parameterNames() const = 0;
 		virtual const float& parameter( const std::string& parameterName ) const = 0;
+
+		/** @brief Returns the handle for the named parameter. Throws a std::logic_error if there
+		 * is no parameter with that name.
+		 *
+		 * The default implementation searches parameterNames(), so this is not any quicker than
+		 * a single string lookup. The saving comes from using the handle many times. */
+		virtual ParameterHandle parameterIndex( const std::string& parameterName ) const;
+		/** @brief Version of parameter(const std::string&) using a handle from parameterIndex().
+		 *
+		 * The default implementation just converts back to the name, implementations should
+		 * override this with something quicker. */
+		virtual const float& parameter( ParameterHandle handle ) const;
 	};
 
 } // end of namespace l1menu
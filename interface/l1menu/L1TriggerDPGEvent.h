@@ -2,6 +2,7 @@
 #define l1menu_L1TriggerDPGEvent_h
 
 #include <memory>
+#include <vector>
 #include "l1menu/IEvent.h"
 
 // Forward declarations
@@ -22,12 +23,93 @@ namespace l1menu
 	 * Later on I might wrap the L1AnalysisDataFormat more fully so that everything can be done without
 	 * knowledge of L1AnalysisDataFormat, just using this lightweight interface.
 	 *
+	 * Almost every trigger does the same filtering of the raw objects before its own logic (zero bias
+	 * bit set, objects in the triggered bunch crossing, not a forward jet etcetera). Rather than every
+	 * trigger doing this on every call of apply, the results are cached in the PrefilteredObjects
+	 * returned by prefilteredObjects(). This is built the first time it's requested after any change
+	 * to the event, so triggers should use it in preference to rawEvent() where they can.
+	 *
 	 * @author Mark Grimes (mark.grimes@bristol.ac.uk)
 	 * @date 21/May/2013
 	 */
 	class L1TriggerDPGEvent : public l1menu::IEvent
 	{
 	public:
+		/** @brief The information triggers use for a single object (jet, muon etcetera).
+		 *
+		 * Values are kept as double so that comparisons give exactly the same results as the same
+		 * comparisons on the raw data. */
+		struct L1Object
+		{
+			double et;              ///< Et, or Pt for muons
+			double eta;             ///< Calorimeter eta region (0 to 21) for everything except muons, which have real eta
+			double phi;             ///< Calorimeter phi region for everything except muons, which have real phi
+			/** @brief Number of regions from the nearest end of the calorimeter, i.e. the minimum of eta and 21-eta.
+			 * The "eta<regionCut || eta>21-regionCut" test is then just "symmetricRegion<regionCut". Zero for muons. */
+			double symmetricRegion;
+			double zVtx;            ///< Vertex z position for track objects, zero for everything else
+			double trackIsolation;  ///< Track isolation for track objects that have it, zero for everything else
+			int quality;            ///< Muon quality, zero for everything else
+			bool isolated;          ///< The isolation flag for the collection, false if it doesn't have one
+			/** @brief Position in the 22x18 grid of calorimeter regions, "eta*numberOfPhiRegions+phi".
+			 * Minus one if eta and phi aren't whole numbers in range, e.g. for muons. */
+			int tower;
+
+			/** @brief Whether the two objects have exactly the same eta and phi.
+			 *
+			 * Gives the same result as "eta==other.eta && phi==other.phi", but for objects in the region
+			 * grid it only has to compare one integer. */
+			bool inSameTower( const L1Object& other ) const
+			{
+				if( tower>=0 || other.tower>=0 ) return tower==other.tower;
+				else return eta==other.eta && phi==other.phi;
+			}
+		};
+		static const int numberOfEtaRegions=22; ///< Size of the calorimeter region grid used for L1Object::tower
+		static const int numberOfPhiRegions=18; ///< Size of the calorimeter region grid used for L1Object::tower
+
+		/** @brief Float copies of the values the single object triggers cut on, one array per value.
+		 *
+		 * Laid out this way so that the vectorised kernels in l1menu/tools/vectorisedKernels.h can scan
+		 * them. The triggers compare float copies of the values anyway, so the results are the same.
+		 * Entries are in the same order as the corresponding L1Object vector. */
+		struct ObjectColumns
+		{
+			std::vector<float> et;
+			std::vector<float> symmetricRegion;
+			std::vector<float> absoluteEta;    ///< |eta|, only really useful for muons which have real eta
+			std::vector<float> quality;
+			std::vector<float> isolated;       ///< 1 if the isolation flag is set, 0 if not
+			std::vector<float> trackIsolation;
+		};
+
+		/** @brief The objects from the bunch crossing of interest (bx==0), split by collection. */
+		struct PrefilteredObjects
+		{
+			bool zeroBias;                         ///< Physics bit zero. Every trigger requires this.
+			std::vector<L1Object> centralJets;     ///< Jets that are neither forward nor tau jets
+			std::vector<L1Object> tauJets;         ///< Jets flagged as tau jets, "isolated" is the tau isolation flag
+			std::vector<L1Object> egamma;
+			std::vector<L1Object> muons;
+			std::vector<L1Object> trackElectrons;
+			std::vector<L1Object> trackElectrons2; ///< The second, lower Pt, collection of track electrons
+			std::vector<L1Object> trackEM;
+			std::vector<L1Object> trackJets;
+			std::vector<L1Object> trackTaus;
+			std::vector<L1Object> trackMuons;
+
+			ObjectColumns centralJetColumns;
+			ObjectColumns tauJetColumns;
+			ObjectColumns egammaColumns;
+			ObjectColumns muonColumns;
+			ObjectColumns trackElectronColumns;
+			ObjectColumns trackElectron2Columns;
+			ObjectColumns trackEMColumns;
+			ObjectColumns trackJetColumns;
+			ObjectColumns trackTauColumns;
+			ObjectColumns trackMuonColumns;
+		};
+
 		L1TriggerDPGEvent( const l1menu::ISample& parentSample );
 		L1TriggerDPGEvent( const L1TriggerDPGEvent& otherEvent );
 		L1TriggerDPGEvent( L1TriggerDPGEvent&& otherEvent ) noexcept;
@@ -39,6 +121,35 @@ namespace l1menu
 		virtual const L1Analysis::L1AnalysisDataFormat& rawEvent() const;
 		virtual bool* physicsBits(); ///< @brief A 128 element array of the physics bits
 		virtual const bool* physicsBits() const; ///< @brief Const access to the 128 element array of the physics bits.
+		/** @brief The objects that triggers use with the common filtering already done.
+		 *
+		 * Calculated from rawEvent() and physicsBits() the first time it's called after either of
+		 * those has been accessed non-const. So don't keep hold of the non-const references from
+		 * those methods and modify the event later, or this will be out of date. */
+		virtual const PrefilteredObjects& prefilteredObjects() const;
+		/** @brief Et of the objects in the collection that pass the region cut, highest first.
+		 *
+		 * "collection" must be one of the vectors in the structure returned by prefilteredObjects().
+		 * Objects pass if "symmetricRegion<regionCut" is false. Objects with a NaN Et are left out, since
+		 * they can't pass any threshold. The values are float copies, which is what
+		 * the triggers compare to their thresholds, so "are there at least k objects above t" becomes
+		 * "sortedEt(...)[k-1]>=t". Each list is sorted the first time it's asked for and kept until the
+		 * event changes, so triggers that are called repeatedly for the same event (e.g. when finding the
+		 * tightest thresholds) don't redo the work. */
+		virtual const std::vector<float>& sortedEt( const std::vector<L1Object>& collection, float regionCut ) const;
+		/** @brief The same objects that sortedEt gives the Et for, in the same order.
+		 *
+		 * Useful for cross triggers that remove overlaps, where the question "is there a leg 2 object
+		 * above threshold that isn't in the same tower as this leg 1 object" can usually be answered by
+		 * looking at the leading leg 2 object only. */
+		virtual const std::vector<const L1Object*>& sortedObjects( const std::vector<L1Object>& collection, float regionCut ) const;
+		/** @brief Indices into the collection, ordered so that the zVtx values are increasing.
+		 *
+		 * "collection" must be one of the vectors in the structure returned by prefilteredObjects().
+		 * Used by the track triggers that look for pairs of objects from the same vertex, so that they
+		 * only have to look at the objects nearby in z rather than every pair. Objects with a NaN zVtx
+		 * are at the end. Cached per event in the same way as sortedEt. */
+		virtual const std::vector<size_t>& zVertexOrder( const std::vector<L1Object>& collection ) const;
 
 		virtual void setWeight( float weight );
 
@@ -47,6 +158,8 @@ namespace l1menu
 		//
 		virtual bool passesTrigger( const l1menu::ITrigger& trigger ) const;
 		virtual float weight() const;
+		virtual unsigned int run() const;
+		virtual unsigned int lumiSection() const;
 		virtual const l1menu::ISample& sample() const;
 	protected:
 		/** @brief Hide implementation details in a pimple.
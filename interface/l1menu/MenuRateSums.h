@@ -0,0 +1,210 @@
+#ifndef l1menu_MenuRateSums_h
+#define l1menu_MenuRateSums_h
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <map>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+//
+// Forward declarations
+//
+namespace l1menu
+{
+	class TriggerMenu;
+	class ISample;
+	class ReducedSample;
+	class IMenuRate;
+	class TriggerExpression;
+}
+
+
+namespace l1menu
+{
+	/** @brief The raw, unnormalised sums of weights needed to calculate the rates of a menu.
+	 *
+	 * IMenuRate only holds the normalised fractions and rates, which can't be combined if the
+	 * sample has been split into several parts and processed separately (e.g. on a batch farm).
+	 * This class holds the sums of event weights (and weights squared for the errors) instead, so
+	 * that the results from each part can be added together with add(). Once everything has been
+	 * added, rate() gives exactly the same result as if the whole sample had been processed in
+	 * one go.
+	 *
+	 * All sums are held as doubles so that adding many parts doesn't lose precision.
+	 *
+	 * ReducedSamples and FullSamples are processed on several threads, as are SampleRanges of them. The
+	 * events are split into fixed size chunks that are summed separately and then added together in order,
+	 * so the result is exactly the same for any number of threads. FullSample can only read one event at a
+	 * time, so its threads take turns reading and apply the triggers in parallel. Whether each event passes
+	 * each trigger is recorded as bits, so the total, pure and pairwise overlap sums all come from the same
+	 * single pass over the events.
+	 */
+	class MenuRateSums
+	{
+	public:
+		/** @brief Loops over all events in the sample and accumulates the sums for each trigger in the menu.
+		 *
+		 * @param[in] numberOfThreads  The most threads to use, where the sample supports it. Zero means
+		 *                             one per core. The result doesn't depend on this.
+		 */
+		MenuRateSums( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample, size_t numberOfThreads=0 );
+		/** @brief As the other constructor, but also sums the weights of events passing each of the queries.
+		 *
+		 * The queries are boolean expressions of the triggers in the menu, see l1menu::TriggerExpression
+		 * for the syntax. They are all evaluated in the same pass over the events, on whether each trigger
+		 * passed, so they cost very little extra. A std::runtime_error is thrown if any are invalid.
+		 */
+		MenuRateSums( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample, const std::vector<std::string>& queries, size_t numberOfThreads=0 );
+		/** @brief The sums for the default weights, followed by the sums for each of the sample's named weights in
+		 * the order of ReducedSample::weightNames().
+		 *
+		 * Which triggers each event passes is only worked out once, and the sums for each set of weights are made
+		 * from the same bits. So each extra set of weights costs a few additions per event rather than another
+		 * pass of the menu over the sample. Each result is exactly what the constructor would give if the sample
+		 * had that set of weights as its default.
+		 */
+		static std::vector<l1menu::MenuRateSums> forEachWeight( const l1menu::TriggerMenu& menu, const l1menu::ReducedSample& sample, const std::vector<std::string>& queries=std::vector<std::string>(), size_t numberOfThreads=0 );
+		/** @brief The sums for each lumi section in the sample separately, keyed by run and lumi section.
+		 *
+		 * Everything is done in one pass over the events. Samples that don't record where the events came
+		 * from have all of their events under run and lumi section zero. To bin the rates by instantaneous
+		 * luminosity instead, which isn't stored in the samples, pass the result to inLuminosityBins().
+		 * There can be a lot of lumi sections, so the overlaps between pairs of triggers aren't kept and
+		 * hasOverlaps() is false. Adding all of the results together gives the same totals, pass and pure
+		 * sums as the constructor.
+		 */
+		static std::map< std::pair<unsigned int,unsigned int>, l1menu::MenuRateSums > forEachLumiSection( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample );
+		/** @brief Adds together the sums from forEachLumiSection for the lumi sections in each luminosity bin.
+		 *
+		 * @param[in] lumiSectionSums  The result of forEachLumiSection, or anything else keyed by run and lumi section.
+		 * @param[in] luminosities     The instantaneous luminosity of each lumi section, keyed the same way, e.g.
+		 *                             from the luminosity database. Lumi sections missing from this throw a
+		 *                             std::runtime_error.
+		 * @param[in] binEdges         The edges of the bins in increasing order. Each bin includes its lower edge,
+		 *                             and lumi sections outside all of the bins are left out.
+		 * @return The sums for each bin in order, one fewer than the number of edges. Bins with no lumi sections
+		 *         have zero events.
+		 */
+		static std::vector<l1menu::MenuRateSums> inLuminosityBins( const std::map< std::pair<unsigned int,unsigned int>, l1menu::MenuRateSums >& lumiSectionSums,
+				const std::map< std::pair<unsigned int,unsigned int>, float >& luminosities, const std::vector<float>& binEdges );
+		/** @brief The sums for each of the menus, in the same order, from one pass over the events.
+		 *
+		 * Triggers that appear in more than one menu with the same version and parameter values are only
+		 * applied once per event. The bits saying which events passed each trigger are then shared out to
+		 * each menu's total, pure and overlap sums. So comparing lots of variations of a menu costs about
+		 * the same as one pass with all of the different triggers, plus a few operations per word of bits
+		 * for each menu. Each result is the same as the constructor would give for that menu.
+		 */
+		static std::vector<l1menu::MenuRateSums> forEachMenu( const std::vector<l1menu::TriggerMenu>& menus, const l1menu::ISample& sample, size_t numberOfThreads=0 );
+		/** @brief As the first constructor, but also accumulates the totals, pass and pure sums for a number of
+		 * Poisson bootstrap replicas of the sample, in the same pass over the events.
+		 *
+		 * In each replica every event's weight is multiplied by a number drawn from a Poisson distribution with a
+		 * mean of one. The draw comes from a counter based generator keyed on the seed, the event number and the
+		 * replica number, so the result is the same however many threads are used. The spread of the replicas
+		 * gives errors that include the correlations between triggers and the effect of the weights, see
+		 * bootstrapFractionError(). rate() uses these errors when there are replicas. Each replica costs another
+		 * pass over the trigger bits of each chunk of events, but the triggers are only applied once.
+		 *
+		 * Sums with replicas can be added to others with the same number of replicas. For a SampleRange the
+		 * event numbers are those of the underlying sample, so the ranges of a sample (e.g. shards on a batch
+		 * farm) should all use the same seed, and added together give the same replicas as the whole sample.
+		 * Otherwise the event numbers start from zero in each sample, so different samples need different seeds.
+		 * The replicas aren't saved by saveToFile().
+		 */
+		static l1menu::MenuRateSums withBootstrap( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample, size_t numberOfReplicas, uint64_t seed=0, size_t numberOfThreads=0 );
+		/// The number of consecutive events processed at a time by progressive(). The same as ReducedSample::eventsPerZone,
+		/// so that each block is one zone of the parameter columns.
+		static const size_t eventsPerProgressiveBlock=4096;
+		/// The fewest blocks progressive() does before the spread of the blocks is used to decide whether to stop
+		static const size_t minimumProgressiveBlocks=10;
+		/** @brief Accumulates the sums a block of events at a time, with the blocks in a random order, so that
+		 * there's a usable estimate long before the whole sample has been processed.
+		 *
+		 * After each block progressCallback (if set) is called with the sums so far, and processing stops if it
+		 * returns false. It also stops if relativeErrorTolerance is more than zero and the relative error on the
+		 * fraction of weight passing any trigger drops below it. Events next to each other in a sample usually
+		 * come from the same file or lumi section, so the error is worked out from the variance between the
+		 * fractions passing in each block rather than from the sum of weights squared, and only after at least
+		 * minimumProgressiveBlocks blocks. Since the blocks are in a random order, the sums so far divided by
+		 * their sumOfWeights() are an unbiased estimate of the fractions for the whole sample, and rate() gives
+		 * the rates with errors for the events processed. numberOfEvents() says how many events that was. The
+		 * order is the same every time, and if it doesn't stop early the result is the same as the constructor's
+		 * apart from rounding. Blocks are smaller than the chunks shared out to threads, so numberOfThreads
+		 * makes little difference.
+		 */
+		static l1menu::MenuRateSums progressive( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample, const std::function<bool(const l1menu::MenuRateSums& sumsSoFar)>& progressCallback,
+				float relativeErrorTolerance=0, size_t numberOfThreads=0 );
+		/** @brief Loads sums previously written with saveToFile(). */
+		explicit MenuRateSums( const std::string& filename );
+		MenuRateSums( const l1menu::MenuRateSums& otherMenuRateSums );
+		MenuRateSums( l1menu::MenuRateSums&& otherMenuRateSums ) noexcept;
+		MenuRateSums& operator=( const l1menu::MenuRateSums& otherMenuRateSums );
+		MenuRateSums& operator=( l1menu::MenuRateSums&& otherMenuRateSums ) noexcept;
+		virtual ~MenuRateSums();
+
+		/** @brief Adds the sums from another, independent, set of events.
+		 *
+		 * The menus must be identical (same triggers in the same order with the same parameters)
+		 * and the event rates and queries must be the same, otherwise a std::runtime_error is thrown.
+		 */
+		void add( const l1menu::MenuRateSums& otherMenuRateSums );
+
+		/** @brief Saves the sums to an XML file that can be loaded with the filename constructor.
+		 *
+		 * The file contains the menu as well, so it can also be used anywhere a menu file is expected. */
+		void saveToFile( const std::string& filename ) const;
+
+		/** @brief Calculates the normalised fractions and rates from the sums. */
+		std::shared_ptr<const l1menu::IMenuRate> rate() const;
+
+		const l1menu::TriggerMenu& menu() const;
+		float eventRate() const;
+		size_t numberOfEvents() const;
+		double sumOfWeights() const;
+		double sumOfWeightsSquared() const;
+		double weightOfEventsPassingAnyTrigger() const;
+		double weightSquaredOfEventsPassingAnyTrigger() const;
+		double weightOfEventsPassed( size_t triggerNumber ) const;
+		double weightSquaredOfEventsPassed( size_t triggerNumber ) const;
+		/** @brief The sum of weights of events that pass this trigger and no other. */
+		double weightOfEventsPure( size_t triggerNumber ) const;
+		double weightSquaredOfEventsPure( size_t triggerNumber ) const;
+
+		/** @brief Whether the overlaps between pairs of triggers are available. False if the sums were loaded
+		 * from a file written before the overlaps were saved, came from forEachLumiSection, or were added to
+		 * sums that were. */
+		bool hasOverlaps() const;
+		/** @brief The sum of weights of events that pass both triggers, in either order. If the trigger numbers
+		 * are the same this is weightOfEventsPassed. Throws a std::runtime_error if hasOverlaps() is false. */
+		double weightOfEventsPassedBoth( size_t firstTriggerNumber, size_t secondTriggerNumber ) const;
+		double weightSquaredOfEventsPassedBoth( size_t firstTriggerNumber, size_t secondTriggerNumber ) const;
+
+		size_t numberOfQueries() const;
+		const l1menu::TriggerExpression& query( size_t queryNumber ) const;
+		/** @brief The sum of weights of events that pass the query. Divide by sumOfWeights() for the fraction. */
+		double weightOfEventsPassingQuery( size_t queryNumber ) const;
+		double weightSquaredOfEventsPassingQuery( size_t queryNumber ) const;
+
+		/** @brief Zero unless the sums were made by withBootstrap(). */
+		size_t numberOfBootstrapReplicas() const;
+		/** @brief Half the width of the central 68.3% of the bootstrap replicas' fractions of weight passing any
+		 * trigger, i.e. the one sigma error on the total fraction. Throws a std::runtime_error if there are no
+		 * replicas. Multiply by eventRate() for the error on the rate. */
+		double bootstrapTotalFractionError() const;
+		/** @brief As bootstrapTotalFractionError, but for the fraction passing the trigger. */
+		double bootstrapFractionError( size_t triggerNumber ) const;
+		/** @brief As bootstrapTotalFractionError, but for the fraction passing only this trigger. */
+		double bootstrapPureFractionError( size_t triggerNumber ) const;
+	private:
+		explicit MenuRateSums( std::unique_ptr<class MenuRateSumsPrivateMembers> pImple );
+		std::unique_ptr<class MenuRateSumsPrivateMembers> pImple_;
+	}; // end of class MenuRateSums
+
+} // end of namespace l1menu
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef l1menu_RateSession_h
+#define l1menu_RateSession_h
+
+#include <memory>
+#include <string>
+#include <cstddef>
+
+//
+// Forward declarations
+//
+namespace l1menu
+{
+	class TriggerMenu;
+	class ISample;
+	class IMenuRate;
+	class ITriggerDescription;
+	class MenuRatePlots;
+}
+
+
+namespace l1menu
+{
+	/** @brief Keeps the state needed to update the menu rates quickly when one trigger is changed.
+	 *
+	 * Calculating the rates with ISample::rate applies every trigger to every event. When only one trigger
+	 * changes (e.g. a threshold edited in the GUI, or MenuFitter changing a few triggers per iteration)
+	 * that's wasteful. This class applies every trigger once when it's created and remembers whether each
+	 * event passed each trigger (as bits), how many triggers it passed and which one if it's only one.
+	 * Changing a trigger then only applies that trigger to each event, and for the events where the result
+	 * changes the total and pure sums are adjusted. So an update is O(events) rather than O(events x
+	 * triggers), and the bookkeeping is only done for the events that changed.
+	 *
+	 * The sums are adjusted by adding and subtracting weights, so after many updates they can differ from
+	 * a fresh calculation in the last few significant figures. The trigger overlaps aren't available from
+	 * rates calculated here.
+	 *
+	 * The sample must outlive this instance. Bits are kept for every event and trigger, so memory use is
+	 * about numberOfEvents x (numberOfTriggers/8 + 12) bytes.
+	 */
+	class RateSession
+	{
+	public:
+		/** @brief Applies every trigger in the menu to every event in the sample, and keeps a copy of the menu. */
+		RateSession( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample );
+		virtual ~RateSession();
+
+		/** @brief The menu with any changes that have been made. */
+		const l1menu::TriggerMenu& menu() const;
+
+		/** @brief Changes one parameter of one trigger, and updates the rates. */
+		void setParameter( size_t triggerNumber, const std::string& parameterName, float value );
+
+		/** @brief Copies all of the parameters from the given trigger into the trigger at triggerNumber, and
+		 * updates the rates. If none of the parameters are different nothing is done. The name and version
+		 * must match, otherwise a std::runtime_error is thrown. */
+		void setTrigger( size_t triggerNumber, const l1menu::ITriggerDescription& trigger );
+
+		/** @brief The number of events that changed from passing to failing or the other way round with the
+		 * most recent update. Mainly for diagnostics. */
+		size_t numberOfEventsChangedByLastUpdate() const;
+
+		/** @brief The rates for the menu as it currently is. */
+		std::shared_ptr<const l1menu::IMenuRate> rate() const;
+		/** @brief Overload that will use the MenuRatePlots supplied to calculate errors on the thresholds. */
+		std::shared_ptr<const l1menu::IMenuRate> rate( const l1menu::MenuRatePlots& ratePlots ) const;
+	private:
+		std::unique_ptr<class RateSessionPrivateMembers> pImple_;
+	}; // end of class RateSession
+
+} // end of namespace l1menu
+
+#endif
@@ -40,6 +40,8 @@ namespace l1menu
 		//
 		virtual bool passesTrigger( const l1menu::ITrigger& trigger ) const;
 		virtual float weight() const;
+		virtual unsigned int run() const;
+		virtual unsigned int lumiSection() const;
 		virtual const l1menu::ISample& sample() const;
 	private:
 		l1menuprotobuf::Event* pProtobufEvent_;
@@ -4,6 +4,8 @@
 #include <string>
 #include <memory>
 #include <map>
+#include <vector>
+#include <functional>
 
 #include "l1menu/ReducedEvent.h"
 #include "l1menu/ISample.h"
@@ -27,6 +29,9 @@ namespace l1menu
 	class ReducedSample : public l1menu::ISample
 	{
 	public:
+		/// The number of consecutive events summarised by parameterZoneMinima and parameterZoneMaxima.
+		static const size_t eventsPerZone=4096;
+
 		/** @brief Load from a file in protobuf format. */
 		explicit ReducedSample( const std::string& filename );
 		explicit ReducedSample( const l1menu::FullSample& originalSample, const l1menu::TriggerMenu& triggerMenu );
@@ -34,6 +39,28 @@ namespace l1menu
 		virtual ~ReducedSample();
 
 		void addSample( const l1menu::FullSample& originalSample );
+		/** @brief Only adds the events in the range [firstEvent, firstEvent+numberOfEvents) of the original sample.
+		 *
+		 * Used to split creation of a ReducedSample over several jobs. If the range goes past the end of the
+		 * original sample it is truncated. */
+		void addSample( const l1menu::FullSample& originalSample, size_t firstEvent, size_t numberOfEvents );
+		/** @brief Appends all of the events from another ReducedSample, e.g. when merging samples made in separate jobs.
+		 *
+		 * The other sample must have been made with exactly the same menu, otherwise a std::runtime_error is thrown. */
+		void addSample( const l1menu::ReducedSample& otherSample );
+
+		/** @brief Adds another set of weights for the events, e.g. for a different pileup or luminosity scenario.
+		 *
+		 * The default weight (IEvent::weight) is still used everywhere else. The named weights are only used by
+		 * code that asks for them, e.g. MenuRateSums::forEachWeight and TriggerRatePlot::addSampleForEachWeight,
+		 * which give results for every set of weights from a single pass over the events. They are saved with
+		 * the sample. There must be one weight for each event, and the name must not be empty or already used,
+		 * otherwise a std::runtime_error is thrown. Events can't be added from a FullSample once there are named
+		 * weights, since there would be nothing to set them to.
+		 */
+		void addWeightColumn( const std::string& weightName, const std::vector<float>& weights );
+		/** @brief The names of the weights added with addWeightColumn, in the order they were added. */
+		std::vector<std::string> weightNames() const;
 
 		/** @brief Save to a file in protobuf format (protobuf in src/protobuf/l1menu.proto). */
 		void saveToFile( const std::string& filename ) const;
@@ -42,6 +69,70 @@ namespace l1menu
 		bool containsTrigger( const l1menu::ITrigger& trigger, bool allowOlderVersion=false ) const;
 		const std::map<std::string,ReducedEvent::ParameterID> getTriggerParameterIdentifiers( const l1menu::ITrigger& trigger, bool allowOlderVersion=false ) const;
 
+		/** @brief Calls "function" for each event in the range [firstEvent, firstEvent+numberOfEvents), in order.
+		 *
+		 * getEvent() points the sample's own event at the requested event, so can't be used from more than
+		 * one thread at once. This uses its own event, so different threads can loop over different ranges
+		 * at the same time. It's also quicker than calling getEvent() for each event, since the position in
+		 * the sample only has to be looked up once. The range is truncated if it goes past the end.
+		 */
+		void forEachEvent( size_t firstEvent, size_t numberOfEvents, const std::function<void(const l1menu::IEvent&)>& function ) const;
+
+		/** @brief The sum of the weights of the events where the parameter is at or above the threshold, i.e.
+		 * the events that would pass if the parameter were set to the threshold.
+		 *
+		 * The first time a parameter is used, its values for every event are sorted and cumulative sums of
+		 * the weights are made. After that this is a binary search, instead of a loop over all of the events.
+		 * For a trigger with only one threshold that gives the rate at any threshold directly, with
+		 * parameterID from getTriggerParameterIdentifiers. Multiply by eventRate()/sumOfWeights() to get the
+		 * rate. Adding events invalidates the index, so it's made again when next needed. Events where the
+		 * value is NaN pass every threshold, the same as with the cached triggers.
+		 *
+		 * Throws a std::runtime_error if parameterID isn't valid for this sample.
+		 */
+		double sumOfWeightsPassing( ReducedEvent::ParameterID parameterID, float threshold ) const;
+		/** @brief The same as sumOfWeightsPassing, but the sum of the weights squared, for the error. */
+		double sumOfWeightsSquaredPassing( ReducedEvent::ParameterID parameterID, float threshold ) const;
+		/** @brief The inverse of sumOfWeightsPassing. Gives the lowest threshold where the sum of the weights of
+		 * the passing events is no more than targetSumOfWeights.
+		 *
+		 * The result is always one of the values in the sample (or just above the highest if even that lets
+		 * too much through), since the sum of weights only changes at those values.
+		 */
+		float thresholdForSumOfWeights( ReducedEvent::ParameterID parameterID, double targetSumOfWeights ) const;
+
+		/** @brief The value of the parameter for every event, contiguous in memory and in event order.
+		 *
+		 * The events are stored as one protobuf message each, so the first call for each parameter copies its
+		 * value from every event into a column. Only the parameters asked for are copied, so a scan of one menu
+		 * doesn't hold a second copy of the whole sample. This is for code that scans whole blocks of events at
+		 * once, e.g. with SIMD compares, rather than one event and parameter at a time. The pointer stays valid
+		 * until events or weight columns are added. Throws a std::runtime_error if parameterID isn't valid for this sample.
+		 */
+		const float* parameterColumn( ReducedEvent::ParameterID parameterID ) const;
+		/** @brief The weight of every event, in the same format as parameterColumn. */
+		const float* weightColumn() const;
+		/** @brief The named weight of every event, in the same format as parameterColumn. Throws a
+		 * std::runtime_error if there is no weight with that name. */
+		const float* weightColumn( const std::string& weightName ) const;
+		/** @brief The run number of every event, in the same format as parameterColumn. Zero for events from
+		 * samples made before the run was recorded. */
+		const unsigned int* runColumn() const;
+		/** @brief The lumi section of every event, in the same format as runColumn. */
+		const unsigned int* lumiSectionColumn() const;
+		/** @brief The sum of the named weight over all events, i.e. what sumOfWeights() is for the default weight. */
+		float sumOfWeights( const std::string& weightName ) const;
+		/** @brief The lowest value of the parameter in each zone of eventsPerZone consecutive events.
+		 *
+		 * Together with parameterZoneMaxima this lets a scan skip a whole zone if no event in it can pass a
+		 * threshold, or if every event passes. Made at the same time as the parameter's column, and valid for
+		 * as long as it is. The last zone can be shorter than eventsPerZone. NaN values, which pass any threshold,
+		 * count as +infinity.
+		 */
+		const float* parameterZoneMinima( ReducedEvent::ParameterID parameterID ) const;
+		/** @brief The highest value of the parameter in each zone, see parameterZoneMinima. */
+		const float* parameterZoneMaxima( ReducedEvent::ParameterID parameterID ) const;
+
 		//
 		// Implementations required for the ISample interface
 		//
@@ -53,6 +144,11 @@ namespace l1menu
 		virtual float sumOfWeights() const;
 		virtual std::shared_ptr<const l1menu::IMenuRate> rate( const l1menu::TriggerMenu& menu ) const;
 		virtual std::shared_ptr<const l1menu::IMenuRate> rate( const l1menu::TriggerMenu& menu, const l1menu::MenuRatePlots& ratePlots ) const;
+		virtual std::vector< std::shared_ptr<const l1menu::IMenuRate> > rates( const std::vector<l1menu::TriggerMenu>& menus ) const;
+		virtual std::shared_ptr<const l1menu::IMenuRate> progressiveRate( const l1menu::TriggerMenu& menu, const std::function<bool(const l1menu::IMenuRate& rateSoFar)>& progressCallback, float relativeErrorTolerance=0 ) const;
+		/** @brief The rates using the default weight first, then each of the named weights in the order of weightNames().
+		 * The triggers are only applied once for all of them, see MenuRateSums::forEachWeight. */
+		std::vector< std::shared_ptr<const l1menu::IMenuRate> > rateForEachWeight( const l1menu::TriggerMenu& menu ) const;
 
 	private:
 		std::unique_ptr<class ReducedSamplePrivateMembers> pImple_;
@@ -0,0 +1,81 @@
+#ifndef l1menu_SampleRange_h
+#define l1menu_SampleRange_h
+
+#include <memory>
+#include <string>
+#include <utility>
+#include "l1menu/ISample.h"
+
+
+namespace l1menu
+{
+	/** @brief An ISample that only exposes a contiguous range of the events in another ISample.
+	 *
+	 * Used to split the processing of a sample into several independent jobs ("shards") on a batch
+	 * farm. Events are delegated to the underlying sample, so the underlying sample must outlive
+	 * this instance. Event numbers are relative to the start of the range, i.e. getEvent(0) returns
+	 * event firstEvent of the underlying sample.
+	 *
+	 * The event rate is initially copied from the underlying sample but can be changed independently.
+	 * The sum of weights is only for events in the range, so rates calculated on a SampleRange are
+	 * correctly normalised for that range. To combine several ranges use the raw sums, e.g.
+	 * l1menu::MenuRateSums.
+	 */
+	class SampleRange : public l1menu::ISample
+	{
+	public:
+		/** @brief Constructor specifying the range explicitly.
+		 *
+		 * @param[in] sample           The sample to take events from. A reference is kept.
+		 * @param[in] firstEvent       The first event in the underlying sample to use.
+		 * @param[in] numberOfEvents   The maximum number of events to use. If the range goes beyond the
+		 *                             end of the underlying sample it is truncated.
+		 */
+		SampleRange( const l1menu::ISample& sample, size_t firstEvent, size_t numberOfEvents );
+		virtual ~SampleRange();
+
+		/** @brief The index of the first event in the underlying sample. */
+		size_t firstEvent() const;
+
+		/** @brief The sample the events are taken from. Lets code that has a quicker way of processing
+		 * particular sample types (e.g. MenuRateSums) use it for just the range. */
+		const l1menu::ISample& underlyingSample() const;
+
+		/** @brief Works out the event range for one shard when splitting a number of events into equal parts.
+		 *
+		 * The events are split as evenly as possible, and every event is in one and only one shard.
+		 *
+		 * @param[in] shardNumber      The shard required, counting from zero.
+		 * @param[in] numberOfShards   The total number of shards.
+		 * @param[in] totalEvents      The total number of events being split.
+		 * @return                     A pair where 'first' is the first event and 'second' the number of events.
+		 */
+		static std::pair<size_t,size_t> shardRange( size_t shardNumber, size_t numberOfShards, size_t totalEvents );
+
+		/** @brief Converts a shard specification of the form "i/N" into the shard number and number of shards.
+		 *
+		 * A std::runtime_error is thrown if the string is not of the correct form or i is not less than N.
+		 * @return   A pair where 'first' is the shard number and 'second' the number of shards.
+		 */
+		static std::pair<size_t,size_t> parseShardSpecification( const std::string& shardSpecification );
+
+		//
+		// Implementations required for the ISample interface
+		//
+		virtual size_t numberOfEvents() const;
+		virtual const l1menu::IEvent& getEvent( size_t eventNumber ) const;
+		virtual std::unique_ptr<l1menu::ICachedTrigger> createCachedTrigger( const l1menu::ITrigger& trigger ) const;
+		virtual float eventRate() const;
+		virtual void setEventRate( float rate );
+		virtual float sumOfWeights() const;
+		virtual std::shared_ptr<const l1menu::IMenuRate> rate( const l1menu::TriggerMenu& menu ) const;
+		virtual std::shared_ptr<const l1menu::IMenuRate> rate( const l1menu::TriggerMenu& menu, const l1menu::MenuRatePlots& ratePlots ) const;
+		virtual std::vector< std::shared_ptr<const l1menu::IMenuRate> > rates( const std::vector<l1menu::TriggerMenu>& menus ) const;
+		virtual std::shared_ptr<const l1menu::IMenuRate> progressiveRate( const l1menu::TriggerMenu& menu, const std::function<bool(const l1menu::IMenuRate& rateSoFar)>& progressCallback, float relativeErrorTolerance=0 ) const;
+	private:
+		std::unique_ptr<class SampleRangePrivateMembers> pImple_;
+	}; // end of class SampleRange
+
+} // end of namespace l1menu
+
+#endif
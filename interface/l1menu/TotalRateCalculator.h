@@ -0,0 +1,55 @@
+#ifndef l1menu_TotalRateCalculator_h
+#define l1menu_TotalRateCalculator_h
+
+#include <memory>
+#include <cstddef>
+
+//
+// Forward declarations
+//
+namespace l1menu
+{
+	class TriggerMenu;
+	class ISample;
+}
+
+
+namespace l1menu
+{
+	/** @brief Calculates only the total rate of a menu, as quickly as possible.
+	 *
+	 * ISample::rate applies every trigger to every event so that it can also give the rate and pure
+	 * rate of each trigger. When only the total is needed (e.g. previewing a menu where lots of
+	 * thresholds have changed at once) an event can stop being processed as soon as one trigger
+	 * passes it. The order the triggers are tried in then matters: it's best to try first those
+	 * that are likely to pass and are cheap to apply. Neither is known beforehand, so while the
+	 * events are looped over this records how often each trigger passes the events it's tried on,
+	 * and times a sample of the calls to it. Every so often the triggers are sorted by pass
+	 * probability divided by cost. For a FullSample this usually means the expensive cross
+	 * triggers are only tried on the few events that none of the simpler triggers pass.
+	 *
+	 * The statistics are kept between calls, so later calls start with a good order. The order
+	 * doesn't change the result. If only a few triggers change at a time RateSession is quicker.
+	 *
+	 * The sample must outlive this instance.
+	 */
+	class TotalRateCalculator
+	{
+	public:
+		TotalRateCalculator( const l1menu::ISample& sample );
+		virtual ~TotalRateCalculator();
+
+		/** @brief The fraction of the sample's weight in events that pass at least one trigger in the menu.
+		 *
+		 * Menus with a different number of triggers than the last call start the statistics from scratch,
+		 * otherwise the triggers are assumed to be in the same order as last time. */
+		float totalFraction( const l1menu::TriggerMenu& menu );
+		/** @brief totalFraction scaled by the sample's event rate, i.e. the same as IMenuRate::totalRate. */
+		float totalRate( const l1menu::TriggerMenu& menu );
+	private:
+		std::unique_ptr<class TotalRateCalculatorPrivateMembers> pImple_;
+	}; // end of class TotalRateCalculator
+
+} // end of namespace l1menu
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef l1menu_TriggerExpression_h
+#define l1menu_TriggerExpression_h
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+//
+// Forward declarations
+//
+namespace l1menu
+{
+	class TriggerMenu;
+}
+
+namespace l1menu
+{
+	/** @brief A boolean expression of the triggers in a menu, e.g. to get the rate of "(A OR B) AND NOT C".
+	 *
+	 * The expression is parsed when constructed, and refers to the triggers by their position in the
+	 * menu. So it doesn't need re-parsing for every event, and is evaluated on whether each trigger
+	 * passed rather than applying the triggers again. The syntax is
+	 * @code
+	 * [<name>=] <expression>
+	 * @endcode
+	 * where the expression can use trigger names, parentheses and the operators "AND", "OR" and "NOT"
+	 * (or "&&", "||" and "!"; "&" and "|" also work). NOT binds tightest, then AND, then OR. A trigger
+	 * name can contain "*" as a wildcard, which means the OR of all of the matching triggers in the menu.
+	 * So "muons=L1_*Mu*" is the total rate of the muon triggers. If no name is given the expression is
+	 * used as the name.
+	 *
+	 * A std::runtime_error is thrown if the expression is invalid or uses a trigger that isn't in the menu.
+	 */
+	class TriggerExpression
+	{
+	public:
+		TriggerExpression( const std::string& expression, const l1menu::TriggerMenu& menu );
+
+		/** @brief The name given before "=" or, if there wasn't one, the expression. */
+		const std::string& name() const;
+		/** @brief The string the expression was created from, so it can be re-created for another menu. */
+		const std::string& expression() const;
+
+		/** @brief Whether an event passes, given whether it passed each trigger in the menu. */
+		bool evaluate( const std::vector<bool>& triggerResults ) const;
+
+		/** @brief Evaluates 64 events at once, where each bit is a different event.
+		 *
+		 * @param[in] triggerBits   Whether the events passed each trigger, where the bits for trigger "n"
+		 *                          are in triggerBits[n*stride+wordIndex].
+		 * @param[in] stride        The distance between the words of consecutive triggers.
+		 * @param[in] wordIndex     Which word to use for each trigger.
+		 * @return                  The bits for the events that pass the expression. Note that NOT sets
+		 *                          bits for unused positions, so mask off any bits that aren't events.
+		 */
+		uint64_t evaluate( const uint64_t* triggerBits, size_t stride, size_t wordIndex ) const;
+	protected:
+		/** @brief The expression is held in reverse Polish notation, with the triggers as their index in the menu. */
+		enum class Operation : char { PUSH_TRIGGER, AND, OR, NOT };
+		struct Step
+		{
+			Operation operation;
+			size_t triggerNumber; ///< Only used for PUSH_TRIGGER
+		};
+		static const size_t maximumStackDepth=64;
+
+		std::string name_;
+		std::string expression_;
+		std::vector<Step> steps_;
+	};
+
+} // end of namespace l1menu
+
+#endif
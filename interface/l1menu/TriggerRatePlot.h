@@ -16,6 +16,7 @@ namespace l1menu
 	class ITriggerDescription;
 	class ICachedTrigger;
 	class ISample;
+	class ReducedSample;
 }
 
 
@@ -138,6 +139,16 @@ namespace l1menu
 		 * slower than reading the event once and passing it to each TriggerRatePlot.
 		 */
 		static void addSample( const l1menu::ISample& sample, std::vector<TriggerRatePlot>& ratePlots );
+
+		/** @brief Fills the same rate plot for each set of weights in the sample, from one loop over the events.
+		 *
+		 * ratePlots[0] is filled using the default event weights, and ratePlots[n] with the named weight
+		 * sample.weightNames()[n-1]. There can't be more plots than sets of weights, but there can be fewer. Every
+		 * plot must be for the same trigger, versus parameter and binning, otherwise a std::runtime_error is thrown.
+		 * The bins each event passes are found once, then each plot is filled with that event's weight for it.
+		 * Each plot is normalised with its own sum of weights.
+		 */
+		static void addSampleForEachWeight( const l1menu::ReducedSample& sample, std::vector<TriggerRatePlot>& ratePlots );
 	protected:
 		void initiate( const l1menu::ITriggerDescription& trigger, const std::vector<std::string>& scaledParameters );
 		std::unique_ptr<l1menu::ITrigger> pTrigger_;
@@ -146,6 +157,12 @@ namespace l1menu
 		std::string versusParameter_;
 		/// Pointer to the versusParameter_ reference in pTrigger_ to avoid expensive string comparison look ups
 		float* pParameter_;
+		/// The ParameterHandle for versusParameter_, for ITrigger::applyBatch
+		size_t versusParameterHandle_;
+		/// The low edges of every bin, i.e. the values of versusParameter_ to test
+		std::vector<float> binLowEdges_;
+		/// Storage for the results from ITrigger::applyBatch, kept to save reallocating for every event
+		std::vector<bool> binPassed_;
 		/// The names of the other parameters that are scaled along with the main threshold.
 		std::vector<std::string> otherScaledParameters_;
 		/// A vector of pointers of any other parameters that should be scaled, and what the scaling should be.
@@ -154,6 +171,16 @@ namespace l1menu
 		bool histogramOwnedByMe_;
 		/// The implementation that the public methods delegate to
 		void addEvent( const l1menu::IEvent& event, const std::unique_ptr<l1menu::ICachedTrigger>& pCachedTrigger, float weightPerEvent );
+		/** @brief Uses bisection to find the highest bin where the event passes the trigger, or zero if it doesn't
+		 * pass even the lowest. The trigger is assumed to pass every bin below one it passes. */
+		size_t highestPassingBin( const l1menu::IEvent& event, const std::unique_ptr<l1menu::ICachedTrigger>& pCachedTrigger );
+		/** @brief Fills every bin from the ReducedSample sorted index if possible. Returns false without changing
+		 * anything if the sample isn't a ReducedSample or the plot isn't for a single threshold trigger. */
+		bool addSampleUsingIndex( const l1menu::ISample& sample, float weightPerEvent );
+		/** @brief For a ReducedSample, the parameter IDs of the trigger thresholds paired with their values at the
+		 * lowest bin. Events below any of these can't fill any bin, so zones where that's true for every event
+		 * can be skipped. Empty for other samples. */
+		std::vector< std::pair<size_t,float> > lowestBinCuts( const l1menu::ISample& sample );
 	};
 }
 #endif
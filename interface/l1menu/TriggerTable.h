@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <functional>
 
 // Forward declarations
 namespace l1menu
@@ -26,7 +27,9 @@ namespace l1menu
 	 * aid in plotting.
 	 *
 	 * Uses the Meyer's singleton pattern, the instance can be retrieved with the instance() static
-	 * method.
+	 * method. All methods can be called concurrently from different threads. Triggers are indexed by
+	 * name and version, so lookups don't depend on how many triggers are registered. Getting and
+	 * listing triggers doesn't take a lock, only changing the table or reading the suggested binning does.
 	 *
 	 * @author Mark Grimes (mark.grimes@bristol.ac.uk)
 	 * @date 21/May/2013
@@ -52,7 +55,10 @@ namespace l1menu
 		std::unique_ptr<l1menu::ITrigger> getTrigger( const std::string& name, unsigned int version ) const;
 		std::unique_ptr<l1menu::ITrigger> getTrigger( const TriggerDetails& details ) const;
 
-		/** @brief Provides a copy of the supplied trigger, with the correct version and also copyies the parameters. */
+		/** @brief Provides a copy of the supplied trigger, with the correct version and also copyies the parameters.
+		 *
+		 * If triggerToCopy is actually an ITrigger this is the same as calling its clone() method.
+		 */
 		std::unique_ptr<l1menu::ITrigger> copyTrigger( const l1menu::ITriggerDescription& triggerToCopy ) const;
 
 		/** @brief List the triggers available.
@@ -69,6 +75,20 @@ namespace l1menu
 		 * @param[in] creationFunctionPointer  A function pointer to a function with no parameters that returns an unique_ptr of the new trigger.
 		 */
 		void registerTrigger( const std::string& name, unsigned int version, std::unique_ptr<l1menu::ITrigger> (*creationFunctionPointer)() );
+		/** @brief Register a trigger that is created by something that isn't a plain function.
+		 *
+		 * Used for triggers that aren't compiled in, e.g. the ones declared in XML files and loaded with
+		 * l1menu::tools::loadTriggerDefinitions. Otherwise the same as the function pointer version.
+		 */
+		void registerTrigger( const std::string& name, unsigned int version, std::function<std::unique_ptr<l1menu::ITrigger>()> creationFunction );
+		/** @brief Removes a trigger from the table, so that it can't be created any more.
+		 *
+		 * Triggers that have already been created are unaffected. Intended for triggers that were registered
+		 * at runtime, e.g. with l1menu::tools::loadTriggerDefinitions, and that are only wanted temporarily.
+		 * If it was the last version with that name the suggested binning for the name is removed too.
+		 * @return  Whether a trigger with that name and version was registered.
+		 */
+		bool unregisterTrigger( const std::string& name, unsigned int version );
 		void registerSuggestedBinning( const std::string& triggerName, const std::string& parameterName, unsigned int numberOfBins, float lowerEdge, float upperEdge );
 
 		unsigned int getSuggestedNumberOfBins( const std::string& triggerName, const std::string& parameterName ) const;
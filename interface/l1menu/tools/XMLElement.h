@@ -44,9 +44,12 @@ namespace l1menu
 			std::string getValue() const;
 			int getIntValue() const;
 			float getFloatValue() const;
+			double getDoubleValue() const;
 			void setValue( const std::string& value );
 			void setValue( int value );
 			void setValue( float value );
+			/** @brief Sets the value with enough precision that getDoubleValue() returns exactly the same number. */
+			void setValue( double value );
 		private:
 			XMLElement( xercesc::DOMElement* pRawElement, xercesc::DOMDocument* pDocument );
 			xercesc::DOMElement* pRawElement_;
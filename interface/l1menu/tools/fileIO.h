@@ -14,6 +14,8 @@
 
 // Need this for the definition of l1menu::IL1MenuFile::FileFormat
 #include "l1menu/IL1MenuFile.h"
+// Need this for the definition of l1menu::TriggerTable::TriggerDetails
+#include "l1menu/TriggerTable.h"
 //
 // Forward declarations
 //
@@ -34,11 +36,25 @@ namespace l1menu
 		 * @param[out] output       The stream to dump the information to.
 		 * @param[in]  menuRates    The object containing the information to be dumped.
 		 * @param[in]  format       The file format to dump in.
+		 * @param[in]  includeOverlaps  Whether to also dump the overlaps between pairs of triggers, if menuRates
+		 *                              has them. Only the XML format supports this.
 		 *
 		 * @author Mark Grimes (mark.grimes@bristol.ac.uk)
 		 * @date 05/Jul/2013
 		 */
-		void dumpTriggerRates( std::ostream& output, const l1menu::IMenuRate& menuRates, l1menu::IL1MenuFile::FileFormat format=l1menu::IL1MenuFile::FileFormat::OLD );
+		void dumpTriggerRates( std::ostream& output, const l1menu::IMenuRate& menuRates, l1menu::IL1MenuFile::FileFormat format=l1menu::IL1MenuFile::FileFormat::OLD, bool includeOverlaps=false );
+
+		/** @brief Prints out the pairwise overlap rates between all of the triggers as a delimited table.
+		 *
+		 * There is a line for each pair of triggers (including each trigger with itself), with the columns
+		 * "firstTrigger", "secondTrigger", "fraction", "fractionError", "rate" and "rateError". The first
+		 * line is the column names. Throws a std::runtime_error if menuRates doesn't have the overlaps.
+		 *
+		 * @param[out] output       The stream to dump the information to.
+		 * @param[in]  menuRates    The object containing the information to be dumped.
+		 * @param[in]  delimeter    The character to put between columns.
+		 */
+		void dumpTriggerOverlaps( std::ostream& output, const l1menu::IMenuRate& menuRates, char delimeter=',' );
 
 		/** @brief Prints out the trigger menu in the same format as the old L1Menu2015 to the given ostream
 		 *
@@ -73,6 +89,22 @@ namespace l1menu
 		 */
 		std::unique_ptr<l1menu::TriggerMenu> loadMenu( const std::string& filename );
 
+		/** @brief Reads trigger definitions from an XML file and registers them in the TriggerTable.
+		 *
+		 * Lets new triggers be added without writing or compiling any C++. The root element should have
+		 * a "TriggerDefinition" child for each trigger, see l1menu::triggers::DeclarativeTriggerPlan in
+		 * src/triggers/DeclarativeTrigger.h for the format. Once loaded the triggers can be used in menus
+		 * like any other. Any suggested binning in the file is registered as well.
+		 *
+		 * Throws a std::runtime_error if a definition is invalid, and std::logic_error if a trigger with
+		 * the same name and version is already registered. Definitions before the failing one will
+		 * already have been registered.
+		 *
+		 * @param[in]  filename     The XML file to read.
+		 * @return                  The names and versions of the triggers that were registered.
+		 */
+		std::vector<l1menu::TriggerTable::TriggerDetails> loadTriggerDefinitions( const std::string& filename );
+
 	} // end of the tools namespace
 } // end of the l1menu namespace
 #endif
@@ -10,6 +10,7 @@
 #include <memory>
 #include <utility>
 #include <iosfwd>
+#include "l1menu/ITriggerDescription.h"
 
 //
 // Forward declarations
@@ -17,7 +18,6 @@
 namespace l1menu
 {
 	class ITrigger;
-	class ITriggerDescription;
 	class L1TriggerDPGEvent;
 }
 
@@ -41,6 +41,16 @@ namespace l1menu
 		 */
 		std::vector<std::string> getThresholdNames( const l1menu::ITriggerDescription& trigger );
 
+		/** @brief The same as getThresholdNames but gives the handles instead of the names.
+		 *
+		 * Use these in event loops rather than the names to save on string comparisons.
+		 *
+		 * @param[in] trigger    The trigger to check.
+		 * @return               The handles of the thresholds, in the same order as getThresholdNames
+		 *                       returns the names. Only valid for triggers with the same name and version.
+		 */
+		std::vector<l1menu::ITriggerDescription::ParameterHandle> getThresholdHandles( const l1menu::ITriggerDescription& trigger );
+
 		/** @brief Finds all of the parameter names that don't refer to thresholds.
 		 *
 		 * Does the opposite of getThresholdNames, so returns all parameter names that getThresholdNames
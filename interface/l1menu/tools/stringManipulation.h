@@ -7,6 +7,7 @@
 
 #include <vector>
 #include <string>
+#include <cstddef>
 
 namespace l1menu
 {
@@ -24,6 +25,15 @@ namespace l1menu
 		 */
 		float convertStringToFloat( const std::string& string );
 
+		/** @brief Converts the entire string to a double or throws an exception.
+		 *
+		 * @param[in] string    The string to convert.
+		 * @return              The double that the string represents, if every character could
+		 *                      be converted. If there are any problems a std::runtime_error is
+		 *                      thrown.
+		 */
+		double convertStringToDouble( const std::string& string );
+
 		/** @brief Converts the entire string to an int or throws an exception.
 		 *
 		 * @param[in] string    The string to convert.
@@ -36,6 +46,15 @@ namespace l1menu
 		 */
 		int convertStringToInt( const std::string& string );
 
+		/** @brief Converts the entire string to a size_t or throws an exception.
+		 *
+		 * @param[in] string    The string to convert.
+		 * @return              The size_t that the string represents. A std::runtime_error is thrown if
+		 *                      any character can't be converted, or if the number is negative rather
+		 *                      than being allowed to wrap around.
+		 */
+		size_t convertStringToSize( const std::string& string );
+
 		/** Splits a string into individual parts delimited by whitespace.
 		 *
 		 * Whitespace is defined as any of "\x20\x09\x0D\x0A", i.e. space, tab, carriage return
@@ -0,0 +1,82 @@
+#ifndef l1menu_tools_vectorisedKernels_h
+#define l1menu_tools_vectorisedKernels_h
+
+/** @file
+ * Small loops over contiguous arrays of object values that are written with vector instructions
+ * where the CPU supports them. The instruction set is chosen at runtime, with a plain C++ version
+ * for machines (or compilers) that don't support any of the vectorised versions.
+ */
+
+#include <vector>
+#include <cstddef>
+#include <initializer_list>
+
+namespace l1menu
+{
+	namespace tools
+	{
+		/** @brief The instruction sets that the kernels have been written for. */
+		enum class InstructionSet { Scalar, SSE4, AVX2 };
+
+		/** @brief The best instruction set that both the compiler and this CPU support.
+		 *
+		 * Worked out the first time it's called and remembered after that.
+		 */
+		InstructionSet bestInstructionSet();
+
+		/** @brief Whether the kernels can be run with the given instruction set on this machine. */
+		bool instructionSetIsAvailable( InstructionSet instructionSet );
+
+		/** @brief A requirement that values[i] is not below minimum or above maximum, for use with highestPassingValue.
+		 *
+		 * Use +/- std::numeric_limits<float>::infinity() for a range that is only limited on one side. A NaN
+		 * value passes, the same as in the trigger loops which skip objects with "value<minimum" or
+		 * "value>maximum". Only the values being compared to the threshold have to be numbers.
+		 */
+		struct ColumnCut
+		{
+			const float* values;
+			float minimum;
+			float maximum;
+		};
+
+		/** @brief Returns the highest of the values for which every cut is satisfied.
+		 *
+		 * Used by the single object triggers, where the event passes if any object passes the cuts and
+		 * has Et above threshold. That's the same as the highest Et of the objects passing the cuts being
+		 * above threshold, which is a lot easier to vectorise.
+		 *
+		 * @param[in] values        The values to take the maximum of (e.g. object Et).
+		 * @param[in] size          The number of entries in values, and in each of the cut arrays.
+		 * @param[in] cuts          Pointer to the first of the cuts that entries must pass.
+		 * @param[in] numberOfCuts  The number of cuts.
+		 * @return                  The highest value that passes, or minus infinity if none do. NaN values
+		 *                          are never the highest, as with a plain "value>highest" loop.
+		 */
+		float highestPassingValue( const float* values, size_t size, const ColumnCut* cuts, size_t numberOfCuts );
+
+		/** @brief Same as the other highestPassingValue but forces the instruction set used.
+		 *
+		 * Intended for testing and benchmarking. Throws a std::runtime_error if the instruction set is
+		 * not available on this machine.
+		 */
+		float highestPassingValue( const float* values, size_t size, const ColumnCut* cuts, size_t numberOfCuts, InstructionSet instructionSet );
+
+		/** @brief Convenience version of highestPassingValue for std::vectors. All cut arrays must be at least as long as values. */
+		float highestPassingValue( const std::vector<float>& values, std::initializer_list<ColumnCut> cuts );
+
+		/** @brief Whether any of the values for which every cut is satisfied is at or above threshold.
+		 *
+		 * Gives the same answer as highestPassingValue(...)>=threshold, but stops at the first entry that
+		 * passes. This is what the triggers' apply methods need, highestPassingValue is for when the value
+		 * itself is wanted (e.g. filling rate plots).
+		 */
+		bool anyValuePassing( const float* values, size_t size, float threshold, const ColumnCut* cuts, size_t numberOfCuts );
+
+		/** @brief Same as the other anyValuePassing but forces the instruction set used. */
+		bool anyValuePassing( const float* values, size_t size, float threshold, const ColumnCut* cuts, size_t numberOfCuts, InstructionSet instructionSet );
+
+	} // end of namespace tools
+} // end of namespace l1menu
+
+#endif
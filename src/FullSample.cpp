@@ -2,6 +2,7 @@
 
 #include <stdexcept>
 #include <cmath>
+#include <utility>
 
 #include <TSystem.h>
 #include "FWCore/FWLite/interface/AutoLibraryLoader.h"
@@ -9,6 +10,7 @@
 #include "l1menu/L1TriggerDPGEvent.h"
 #include "l1menu/ICachedTrigger.h"
 #include "l1menu/IMenuRate.h"
+#include "l1menu/MenuRateSums.h"
 #include "./implementation/MenuRateImplementation.h"
 #include "L1UpgradeNtuple.h"
 #include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
@@ -61,6 +63,8 @@ namespace l1menu
 		void fillL1Bits();
 		L1UpgradeNtuple inputNtuple;
 		l1menu::L1TriggerDPGEvent currentEvent;
+		std::vector<l1menu::L1TriggerDPGEvent> eventBatch; ///< Storage for the events returned by FullSample::getFullEvents
+		std::vector<const l1menu::L1TriggerDPGEvent*> eventBatchPointers;
 		float sumOfWeights;
 		float eventRate;
 	};
@@ -797,6 +801,25 @@ const l1menu::L1TriggerDPGEvent& l1menu::FullSample::getFullEvent( size_t eventN
 	return pImple_->currentEvent;
 }
 
+const std::vector<const l1menu::L1TriggerDPGEvent*>& l1menu::FullSample::getFullEvents( size_t firstEventNumber, size_t numberOfEvents ) const
+{
+	if( firstEventNumber+numberOfEvents>this->numberOfEvents() ) throw std::runtime_error( "Requested event range is out of range" );
+
+	while( pImple_->eventBatch.size()<numberOfEvents ) pImple_->eventBatch.push_back( l1menu::L1TriggerDPGEvent(*this) );
+	pImple_->eventBatchPointers.resize( numberOfEvents );
+
+	for( size_t index=0; index<numberOfEvents; ++index )
+	{
+		getFullEvent( firstEventNumber+index );
+		// Swap rather than copy. The previous contents of this batch entry become currentEvent, which
+		// gets reset and refilled for the next event, so the memory is reused.
+		std::swap( pImple_->currentEvent, pImple_->eventBatch[index] );
+		pImple_->eventBatchPointers[index]=&pImple_->eventBatch[index];
+	}
+
+	return pImple_->eventBatchPointers;
+}
+
 size_t l1menu::FullSample::numberOfEvents() const
 {
 	return static_cast<size_t>( pImple_->inputNtuple.GetEntries() );
@@ -848,3 +871,16 @@ std::shared_ptr<const l1menu::IMenuRate> l1menu::FullSample::rate( const l1menu:
 {
 	return std::shared_ptr<const l1menu::IMenuRate>( new l1menu::implementation::MenuRateImplementation( menu, *this, ratePlots ) );
 }
+
+std::vector< std::shared_ptr<const l1menu::IMenuRate> > l1menu::FullSample::rates( const std::vector<l1menu::TriggerMenu>& menus ) const
+{
+	std::vector< std::shared_ptr<const l1menu::IMenuRate> > menuRates;
+	for( const auto& menuRateSums : l1menu::MenuRateSums::forEachMenu( menus, *this ) ) menuRates.push_back( menuRateSums.rate() );
+	return menuRates;
+}
+
+std::shared_ptr<const l1menu::IMenuRate> l1menu::FullSample::progressiveRate( const l1menu::TriggerMenu& menu, const std::function<bool(const l1menu::IMenuRate&)>& progressCallback, float relativeErrorTolerance ) const
+{
+	auto sumsCallback=[&]( const l1menu::MenuRateSums& sumsSoFar ){ return !progressCallback || progressCallback( *sumsSoFar.rate() ); };
+	return l1menu::MenuRateSums::progressive( menu, *this, sumsCallback, relativeErrorTolerance ).rate();
+}
@@ -10,17 +10,17 @@
  * concrete instances. These are defined here.
  */
 
-std::unique_ptr<l1menu::IL1MenuFile> l1menu::IL1MenuFile::getOutputFile( l1menu::IL1MenuFile::FileFormat fileFormat, std::ostream& outputStream )
+std::unique_ptr<l1menu::IL1MenuFile> l1menu::IL1MenuFile::getOutputFile( l1menu::IL1MenuFile::FileFormat fileFormat, std::ostream& outputStream, bool includeOverlaps )
 {
-	if( fileFormat==l1menu::IL1MenuFile::FileFormat::XML ) return std::unique_ptr<l1menu::IL1MenuFile>( new l1menu::implementation::XMLL1MenuFile(outputStream) );
+	if( fileFormat==l1menu::IL1MenuFile::FileFormat::XML ) return std::unique_ptr<l1menu::IL1MenuFile>( new l1menu::implementation::XMLL1MenuFile(outputStream,includeOverlaps) );
 	if( fileFormat==l1menu::IL1MenuFile::FileFormat::CSV ) return std::unique_ptr<l1menu::IL1MenuFile>( new l1menu::implementation::OldL1MenuFile(outputStream,',') );
 	if( fileFormat==l1menu::IL1MenuFile::FileFormat::OLD ) return std::unique_ptr<l1menu::IL1MenuFile>( new l1menu::implementation::OldL1MenuFile(outputStream,' ') );
 	else throw std::logic_error( "Unimplemented value for l1menu::IL1MenuFile::FileFormat" );
 }
 
-std::unique_ptr<l1menu::IL1MenuFile> l1menu::IL1MenuFile::getOutputFile( FileFormat fileFormat, const std::string& filename )
+std::unique_ptr<l1menu::IL1MenuFile> l1menu::IL1MenuFile::getOutputFile( FileFormat fileFormat, const std::string& filename, bool includeOverlaps )
 {
-	if( fileFormat==l1menu::IL1MenuFile::FileFormat::XML ) return std::unique_ptr<l1menu::IL1MenuFile>( new l1menu::implementation::XMLL1MenuFile(filename,true) );
+	if( fileFormat==l1menu::IL1MenuFile::FileFormat::XML ) return std::unique_ptr<l1menu::IL1MenuFile>( new l1menu::implementation::XMLL1MenuFile(filename,true,includeOverlaps) );
 	if( fileFormat==l1menu::IL1MenuFile::FileFormat::CSV ) return std::unique_ptr<l1menu::IL1MenuFile>( new l1menu::implementation::OldL1MenuFile(filename,',',true) );
 	if( fileFormat==l1menu::IL1MenuFile::FileFormat::OLD ) return std::unique_ptr<l1menu::IL1MenuFile>( new l1menu::implementation::OldL1MenuFile(filename,' ',true) );
 	else throw std::logic_error( "Unimplemented value for l1menu::IL1MenuFile::FileFormat" );
@@ -0,0 +1,51 @@
+#include "l1menu/ITrigger.h"
+
+#include <algorithm>
+
+/** @file
+ *
+ * Default implementations of the ITrigger batch methods, so that triggers only need to
+ * override them if they can do better than calling apply() repeatedly.
+ */
+
+void l1menu::ITrigger::applyBatch( const std::vector<const l1menu::L1TriggerDPGEvent*>& events, std::vector<bool>& passed ) const
+{
+	passed.resize( events.size() );
+	for( size_t index=0; index<events.size(); ++index ) passed[index]=apply( *events[index] );
+}
+
+void l1menu::ITrigger::applyBatch( const l1menu::L1TriggerDPGEvent& event, ParameterHandle thresholdHandle, const std::vector<float>& values, std::vector<bool>& passed )
+{
+	passed.assign( values.size(), false );
+	if( values.empty() ) return;
+
+	float& threshold=parameter( thresholdHandle );
+	const float originalValue=threshold;
+
+	// Find how many of the values pass. Since the parameter is a threshold these will be the
+	// first numberPassing values.
+	size_t numberPassing=0;
+	threshold=values.front();
+	if( apply(event) )
+	{
+		threshold=values.back();
+		if( apply(event) ) numberPassing=values.size();
+		else
+		{
+			// values[lowIndex] passes and values[highIndex] fails
+			size_t lowIndex=0;
+			size_t highIndex=values.size()-1;
+			while( highIndex-lowIndex>1 )
+			{
+				size_t middleIndex=(highIndex+lowIndex)/2;
+				threshold=values[middleIndex];
+				if( apply(event) ) lowIndex=middleIndex;
+				else highIndex=middleIndex;
+			}
+			numberPassing=lowIndex+1;
+		}
+	}
+
+	threshold=originalValue;
+	std::fill( passed.begin(), passed.begin()+numberPassing, true );
+}
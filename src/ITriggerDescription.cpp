@@ -0,0 +1,26 @@
+#include "l1menu/ITriggerDescription.h"
+
+#include <stdexcept>
+#include <algorithm>
+
+/** @file
+ *
+ * Although ITriggerDescription is an abstract interface there are default implementations
+ * of the ParameterHandle methods so that implementations only need to provide them if
+ * they want to make them quicker. These are defined here.
+ */
+
+l1menu::ITriggerDescription::ParameterHandle l1menu::ITriggerDescription::parameterIndex( const std::string& parameterName ) const
+{
+	const std::vector<std::string> names=parameterNames();
+	const auto iFindResult=std::find( names.begin(), names.end(), parameterName );
+	if( iFindResult==names.end() ) throw std::logic_error( "Not a valid parameter name (\""+parameterName+"\")" );
+	return iFindResult-names.begin();
+}
+
+const float& l1menu::ITriggerDescription::parameter( ParameterHandle handle ) const
+{
+	const std::vector<std::string> names=parameterNames();
+	if( handle>=names.size() ) throw std::logic_error( "Not a valid parameter handle" );
+	return parameter( names[handle] );
+}
@@ -1,5 +1,11 @@
 #include "l1menu/L1TriggerDPGEvent.h"
 
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <iterator>
+#include <stdexcept>
+#include <string>
 #include "l1menu/ITrigger.h"
 #include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
 
@@ -8,14 +14,264 @@ namespace l1menu
 	class L1TriggerDPGEventPrivateMembers
 	{
 	public:
-		L1TriggerDPGEventPrivateMembers( const l1menu::ISample* pParentSample ) : pParentSample_(pParentSample) {}
+		L1TriggerDPGEventPrivateMembers( const l1menu::ISample* pParentSample ) : prefilteredObjectsAreValid(false), numberOfSortedEt(0), numberOfZVertexOrders(0), pParentSample_(pParentSample) {}
+		void fillPrefilteredObjects();
 		L1Analysis::L1AnalysisDataFormat rawEvent;
 		bool physicsBits[128];
 		float weight;
+		l1menu::L1TriggerDPGEvent::PrefilteredObjects prefilteredObjects;
+		bool prefilteredObjectsAreValid; ///< Set to false whenever the raw event might have been changed
+		/** @brief A collection sorted by Et for a particular region cut, as returned by L1TriggerDPGEvent::sortedEt. */
+		struct SortedEt
+		{
+			const std::vector<l1menu::L1TriggerDPGEvent::L1Object>* pCollection;
+			float regionCut;
+			std::vector<float> et;
+			std::vector<const l1menu::L1TriggerDPGEvent::L1Object*> objects; ///< The objects that "et" was taken from, in the same order
+		};
+		/** @brief Finds or creates the entry in sortedEtCache for the collection and region cut. */
+		const SortedEt& sortedEtEntry( const std::vector<l1menu::L1TriggerDPGEvent::L1Object>& collection, float regionCut );
+		std::deque<SortedEt> sortedEtCache; ///< Not cleared between events so that the memory can be reused. Deque so that references stay valid as it grows.
+		size_t numberOfSortedEt; ///< The number of entries in sortedEtCache that are for the current event
+		/** @brief The order of a collection by z vertex, as returned by L1TriggerDPGEvent::zVertexOrder. */
+		struct ZVertexOrder
+		{
+			const std::vector<l1menu::L1TriggerDPGEvent::L1Object>* pCollection;
+			std::vector<size_t> indices;
+		};
+		std::deque<ZVertexOrder> zVertexOrderCache; ///< Reused between events in the same way as sortedEtCache
+		size_t numberOfZVertexOrders; ///< The number of entries in zVertexOrderCache that are for the current event
+		/** @brief Throws a std::logic_error if the collection isn't one of the ones in prefilteredObjects. */
+		void checkIsPrefilteredCollection( const std::vector<l1menu::L1TriggerDPGEvent::L1Object>& collection, const char* methodName ) const;
 		const l1menu::ISample* pParentSample_;
 	};
 }
 
+namespace // Use the unnamed namespace for things only used in this file
+{
+	/** @brief Returns the value at the index, or zero if the vector is too short. Not all input
+	 * formats fill all of the extra information (isolation flags etcetera). */
+	template<class T> double valueOrZero( const std::vector<T>& values, size_t index )
+	{
+		if( index<values.size() ) return values[index];
+		else return 0;
+	}
+
+	l1menu::L1TriggerDPGEvent::L1Object createObject( double et, double eta, double phi, bool etaIsCalorimeterRegion )
+	{
+		l1menu::L1TriggerDPGEvent::L1Object object;
+		object.et=et;
+		object.eta=eta;
+		object.phi=phi;
+		object.symmetricRegion=( etaIsCalorimeterRegion ? std::min( eta, 21.-eta ) : 0 );
+		object.zVtx=0;
+		object.trackIsolation=0;
+		object.quality=0;
+		object.isolated=false;
+
+		// Only objects with whole number region coordinates get a place in the grid, so that objects
+		// with the same tower definitely have the same eta and phi.
+		object.tower=-1;
+		if( etaIsCalorimeterRegion && eta>=0 && eta<l1menu::L1TriggerDPGEvent::numberOfEtaRegions && eta==std::floor(eta)
+				&& phi>=0 && phi<l1menu::L1TriggerDPGEvent::numberOfPhiRegions && phi==std::floor(phi) )
+		{
+			object.tower=static_cast<int>(eta)*l1menu::L1TriggerDPGEvent::numberOfPhiRegions+static_cast<int>(phi);
+		}
+		return object;
+	}
+
+	/** @brief Copies the values from the objects into the columns, converting to float the same way the triggers do. */
+	void fillColumns( const std::vector<l1menu::L1TriggerDPGEvent::L1Object>& objects, l1menu::L1TriggerDPGEvent::ObjectColumns& columns )
+	{
+		columns.et.resize( objects.size() );
+		columns.symmetricRegion.resize( objects.size() );
+		columns.absoluteEta.resize( objects.size() );
+		columns.quality.resize( objects.size() );
+		columns.isolated.resize( objects.size() );
+		columns.trackIsolation.resize( objects.size() );
+
+		for( size_t index=0; index<objects.size(); ++index )
+		{
+			const l1menu::L1TriggerDPGEvent::L1Object& object=objects[index];
+			columns.et[index]=object.et;
+			columns.symmetricRegion[index]=object.symmetricRegion;
+			float eta=object.eta;
+			columns.absoluteEta[index]=std::fabs(eta);
+			columns.quality[index]=object.quality;
+			columns.isolated[index]=( object.isolated ? 1 : 0 );
+			columns.trackIsolation[index]=object.trackIsolation;
+		}
+	}
+}
+
+void l1menu::L1TriggerDPGEventPrivateMembers::checkIsPrefilteredCollection( const std::vector<l1menu::L1TriggerDPGEvent::L1Object>& collection, const char* methodName ) const
+{
+	const std::vector<l1menu::L1TriggerDPGEvent::L1Object>* collections[]={ &prefilteredObjects.centralJets, &prefilteredObjects.tauJets, &prefilteredObjects.egamma,
+			&prefilteredObjects.muons, &prefilteredObjects.trackElectrons, &prefilteredObjects.trackElectrons2, &prefilteredObjects.trackEM,
+			&prefilteredObjects.trackJets, &prefilteredObjects.trackTaus, &prefilteredObjects.trackMuons };
+	if( std::find( std::begin(collections), std::end(collections), &collection )==std::end(collections) )
+	{
+		throw std::logic_error( std::string("L1TriggerDPGEvent::")+methodName+" - the collection is not one from prefilteredObjects()" );
+	}
+}
+
+const l1menu::L1TriggerDPGEventPrivateMembers::SortedEt& l1menu::L1TriggerDPGEventPrivateMembers::sortedEtEntry( const std::vector<l1menu::L1TriggerDPGEvent::L1Object>& collection, float regionCut )
+{
+	// There are only ever a few of these per event, so a linear search is fine
+	for( size_t index=0; index<numberOfSortedEt; ++index )
+	{
+		const SortedEt& entry=sortedEtCache[index];
+		if( entry.pCollection==&collection && entry.regionCut==regionCut ) return entry;
+	}
+
+	checkIsPrefilteredCollection( collection, "sortedEt" );
+
+	if( numberOfSortedEt==sortedEtCache.size() ) sortedEtCache.push_back( SortedEt() );
+	SortedEt& entry=sortedEtCache[numberOfSortedEt];
+	++numberOfSortedEt;
+
+	entry.pCollection=&collection;
+	entry.regionCut=regionCut;
+	entry.objects.clear();
+	for( const auto& object : collection )
+	{
+		if( object.symmetricRegion<regionCut ) continue;
+		// A NaN Et never passes a threshold, so the old counting loops never counted these. Leaving
+		// them out also keeps the comparison below a strict weak ordering, which std::sort needs.
+		if( std::isnan( static_cast<float>(object.et) ) ) continue;
+		entry.objects.push_back( &object );
+	}
+	// Sort on the float value, since that's what the triggers compare
+	std::sort( entry.objects.begin(), entry.objects.end(), []( const l1menu::L1TriggerDPGEvent::L1Object* pFirst, const l1menu::L1TriggerDPGEvent::L1Object* pSecond )
+		{ return static_cast<float>(pFirst->et)>static_cast<float>(pSecond->et); } );
+
+	entry.et.resize( entry.objects.size() );
+	for( size_t index=0; index<entry.objects.size(); ++index ) entry.et[index]=entry.objects[index]->et;
+
+	return entry;
+}
+
+void l1menu::L1TriggerDPGEventPrivateMembers::fillPrefilteredObjects()
+{
+	l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=prefilteredObjects;
+
+	// Clear rather than create new so that the memory can be reused
+	objects.centralJets.clear();
+	objects.tauJets.clear();
+	objects.egamma.clear();
+	objects.muons.clear();
+	objects.trackElectrons.clear();
+	objects.trackElectrons2.clear();
+	objects.trackEM.clear();
+	objects.trackJets.clear();
+	objects.trackTaus.clear();
+	objects.trackMuons.clear();
+
+	objects.zeroBias=physicsBits[0];
+
+	for( int index=0; index<rawEvent.Njet; ++index )
+	{
+		if( rawEvent.Bxjet[index]!=0 ) continue;
+		l1menu::L1TriggerDPGEvent::L1Object jet=createObject( rawEvent.Etjet[index], rawEvent.Etajet[index], rawEvent.Phijet[index], true );
+		// Tau jets are used whether they're forward or not, but central jets exclude both
+		if( valueOrZero( rawEvent.Taujet, index ) )
+		{
+			jet.isolated=valueOrZero( rawEvent.isoTaujet, index );
+			objects.tauJets.push_back( jet );
+		}
+		else if( !valueOrZero( rawEvent.Fwdjet, index ) ) objects.centralJets.push_back( jet );
+	}
+
+	for( int index=0; index<rawEvent.Nele; ++index )
+	{
+		if( rawEvent.Bxel[index]!=0 ) continue;
+		l1menu::L1TriggerDPGEvent::L1Object egamma=createObject( rawEvent.Etel[index], rawEvent.Etael[index], rawEvent.Phiel[index], true );
+		egamma.isolated=valueOrZero( rawEvent.Isoel, index );
+		objects.egamma.push_back( egamma );
+	}
+
+	for( int index=0; index<rawEvent.Nmu; ++index )
+	{
+		if( rawEvent.Bxmu[index]!=0 ) continue;
+		l1menu::L1TriggerDPGEvent::L1Object muon=createObject( rawEvent.Ptmu[index], rawEvent.Etamu[index], valueOrZero( rawEvent.Phimu, index ), false );
+		muon.quality=valueOrZero( rawEvent.Qualmu, index );
+		muon.isolated=valueOrZero( rawEvent.Isomu, index );
+		objects.muons.push_back( muon );
+	}
+
+	for( int index=0; index<rawEvent.NTkele; ++index )
+	{
+		if( rawEvent.BxTkel[index]!=0 ) continue;
+		l1menu::L1TriggerDPGEvent::L1Object electron=createObject( rawEvent.EtTkel[index], rawEvent.EtaTkel[index], valueOrZero( rawEvent.PhiTkel, index ), true );
+		electron.zVtx=valueOrZero( rawEvent.zVtxTkel, index );
+		electron.trackIsolation=valueOrZero( rawEvent.tIsoTkel, index );
+		electron.isolated=valueOrZero( rawEvent.IsoTkel, index );
+		objects.trackElectrons.push_back( electron );
+	}
+
+	for( int index=0; index<rawEvent.NTkele2; ++index )
+	{
+		if( rawEvent.BxTkel2[index]!=0 ) continue;
+		l1menu::L1TriggerDPGEvent::L1Object electron=createObject( rawEvent.EtTkel2[index], rawEvent.EtaTkel2[index], valueOrZero( rawEvent.PhiTkel2, index ), true );
+		electron.zVtx=valueOrZero( rawEvent.zVtxTkel2, index );
+		electron.trackIsolation=valueOrZero( rawEvent.tIsoTkel2, index );
+		electron.isolated=valueOrZero( rawEvent.IsoTkel2, index );
+		objects.trackElectrons2.push_back( electron );
+	}
+
+	for( int index=0; index<rawEvent.NTkem; ++index )
+	{
+		if( rawEvent.BxTkem[index]!=0 ) continue;
+		objects.trackEM.push_back( createObject( rawEvent.EtTkem[index], rawEvent.EtaTkem[index], valueOrZero( rawEvent.PhiTkem, index ), true ) );
+	}
+
+	for( int index=0; index<rawEvent.NTkjet; ++index )
+	{
+		if( rawEvent.BxTkjet[index]!=0 ) continue;
+		l1menu::L1TriggerDPGEvent::L1Object jet=createObject( rawEvent.EtTkjet[index], rawEvent.EtaTkjet[index], valueOrZero( rawEvent.PhiTkjet, index ), true );
+		jet.zVtx=valueOrZero( rawEvent.zVtxTkjet, index );
+		objects.trackJets.push_back( jet );
+	}
+
+	for( int index=0; index<rawEvent.NTktau; ++index )
+	{
+		if( rawEvent.BxTktau[index]!=0 ) continue;
+		l1menu::L1TriggerDPGEvent::L1Object tau=createObject( rawEvent.EtTktau[index], rawEvent.EtaTktau[index], valueOrZero( rawEvent.PhiTktau, index ), true );
+		tau.zVtx=valueOrZero( rawEvent.zVtxTktau, index );
+		tau.trackIsolation=valueOrZero( rawEvent.tIsoTktau, index );
+		tau.isolated=valueOrZero( rawEvent.IsoTktau, index );
+		objects.trackTaus.push_back( tau );
+	}
+
+	for( int index=0; index<rawEvent.NTkmu; ++index )
+	{
+		if( rawEvent.BxTkmu[index]!=0 ) continue;
+		l1menu::L1TriggerDPGEvent::L1Object muon=createObject( rawEvent.PtTkmu[index], rawEvent.EtaTkmu[index], valueOrZero( rawEvent.PhiTkmu, index ), false );
+		muon.zVtx=valueOrZero( rawEvent.zVtxTkmu, index );
+		muon.trackIsolation=valueOrZero( rawEvent.tIsoTkmu, index );
+		muon.quality=valueOrZero( rawEvent.QualTkmu, index );
+		muon.isolated=valueOrZero( rawEvent.IsoTkmu, index );
+		objects.trackMuons.push_back( muon );
+	}
+
+	fillColumns( objects.centralJets, objects.centralJetColumns );
+	fillColumns( objects.tauJets, objects.tauJetColumns );
+	fillColumns( objects.egamma, objects.egammaColumns );
+	fillColumns( objects.muons, objects.muonColumns );
+	fillColumns( objects.trackElectrons, objects.trackElectronColumns );
+	fillColumns( objects.trackElectrons2, objects.trackElectron2Columns );
+	fillColumns( objects.trackEM, objects.trackEMColumns );
+	fillColumns( objects.trackJets, objects.trackJetColumns );
+	fillColumns( objects.trackTaus, objects.trackTauColumns );
+	fillColumns( objects.trackMuons, objects.trackMuonColumns );
+
+	// Anything sorted for the previous contents is now out of date
+	numberOfSortedEt=0;
+	numberOfZVertexOrders=0;
+
+	prefilteredObjectsAreValid=true;
+}
+
 
 l1menu::L1TriggerDPGEvent::L1TriggerDPGEvent( const l1menu::ISample& parentSample ) : pImple_( new L1TriggerDPGEventPrivateMembers(&parentSample) )
 {
@@ -24,7 +280,9 @@ l1menu::L1TriggerDPGEvent::L1TriggerDPGEvent( const l1menu::ISample& parentSampl
 
 l1menu::L1TriggerDPGEvent::L1TriggerDPGEvent( const L1TriggerDPGEvent& otherEvent ) : pImple_( new L1TriggerDPGEventPrivateMembers(*otherEvent.pImple_) )
 {
-	// No operation besides the initialiser list
+	// The sorted caches refer to the other event's collections, so they can't be used
+	pImple_->numberOfSortedEt=0;
+	pImple_->numberOfZVertexOrders=0;
 }
 
 l1menu::L1TriggerDPGEvent::L1TriggerDPGEvent( L1TriggerDPGEvent&& otherEvent ) noexcept : pImple_( std::move(otherEvent.pImple_) )
@@ -35,6 +293,9 @@ l1menu::L1TriggerDPGEvent::L1TriggerDPGEvent( L1TriggerDPGEvent&& otherEvent ) n
 l1menu::L1TriggerDPGEvent& l1menu::L1TriggerDPGEvent::operator=( const L1TriggerDPGEvent& otherEvent )
 {
 	*pImple_=*otherEvent.pImple_;
+	// The sorted caches refer to the other event's collections so can't be used
+	pImple_->numberOfSortedEt=0;
+	pImple_->numberOfZVertexOrders=0;
 	return *this;
 }
 
@@ -51,6 +312,8 @@ l1menu::L1TriggerDPGEvent::~L1TriggerDPGEvent()
 
 L1Analysis::L1AnalysisDataFormat& l1menu::L1TriggerDPGEvent::rawEvent()
 {
+	// The caller could change anything, so the cached objects have to be recalculated
+	pImple_->prefilteredObjectsAreValid=false;
 	return pImple_->rawEvent;
 }
 
@@ -61,6 +324,7 @@ const L1Analysis::L1AnalysisDataFormat& l1menu::L1TriggerDPGEvent::rawEvent() co
 
 bool* l1menu::L1TriggerDPGEvent::physicsBits()
 {
+	pImple_->prefilteredObjectsAreValid=false;
 	return pImple_->physicsBits;
 }
 
@@ -69,6 +333,55 @@ const bool* l1menu::L1TriggerDPGEvent::physicsBits() const
 	return pImple_->physicsBits;
 }
 
+const l1menu::L1TriggerDPGEvent::PrefilteredObjects& l1menu::L1TriggerDPGEvent::prefilteredObjects() const
+{
+	if( !pImple_->prefilteredObjectsAreValid ) pImple_->fillPrefilteredObjects();
+	return pImple_->prefilteredObjects;
+}
+
+const std::vector<float>& l1menu::L1TriggerDPGEvent::sortedEt( const std::vector<L1Object>& collection, float regionCut ) const
+{
+	prefilteredObjects(); // Makes sure the cache is up to date
+	return pImple_->sortedEtEntry( collection, regionCut ).et;
+}
+
+const std::vector<const l1menu::L1TriggerDPGEvent::L1Object*>& l1menu::L1TriggerDPGEvent::sortedObjects( const std::vector<L1Object>& collection, float regionCut ) const
+{
+	prefilteredObjects(); // Makes sure the cache is up to date
+	return pImple_->sortedEtEntry( collection, regionCut ).objects;
+}
+
+const std::vector<size_t>& l1menu::L1TriggerDPGEvent::zVertexOrder( const std::vector<L1Object>& collection ) const
+{
+	prefilteredObjects(); // Makes sure the cache is up to date
+
+	for( size_t index=0; index<pImple_->numberOfZVertexOrders; ++index )
+	{
+		const L1TriggerDPGEventPrivateMembers::ZVertexOrder& entry=pImple_->zVertexOrderCache[index];
+		if( entry.pCollection==&collection ) return entry.indices;
+	}
+
+	pImple_->checkIsPrefilteredCollection( collection, "zVertexOrder" );
+
+	if( pImple_->numberOfZVertexOrders==pImple_->zVertexOrderCache.size() ) pImple_->zVertexOrderCache.push_back( L1TriggerDPGEventPrivateMembers::ZVertexOrder() );
+	L1TriggerDPGEventPrivateMembers::ZVertexOrder& entry=pImple_->zVertexOrderCache[pImple_->numberOfZVertexOrders];
+	++pImple_->numberOfZVertexOrders;
+
+	entry.pCollection=&collection;
+	entry.indices.resize( collection.size() );
+	for( size_t index=0; index<collection.size(); ++index ) entry.indices[index]=index;
+	// NaNs go at the end, all equivalent to each other. A plain "<" isn't a strict weak ordering if
+	// there are NaNs, which std::sort needs.
+	std::sort( entry.indices.begin(), entry.indices.end(), [&collection]( size_t first, size_t second )
+		{
+			const double firstZvtx=collection[first].zVtx;
+			const double secondZvtx=collection[second].zVtx;
+			return firstZvtx<secondZvtx || ( std::isnan(secondZvtx) && !std::isnan(firstZvtx) );
+		} );
+
+	return entry.indices;
+}
+
 void l1menu::L1TriggerDPGEvent::setWeight( float weight )
 {
 	pImple_->weight=weight;
@@ -87,6 +400,16 @@ float l1menu::L1TriggerDPGEvent::weight() const
 	return pImple_->weight;
 }
 
+unsigned int l1menu::L1TriggerDPGEvent::run() const
+{
+	return pImple_->rawEvent.Run;
+}
+
+unsigned int l1menu::L1TriggerDPGEvent::lumiSection() const
+{
+	return pImple_->rawEvent.LS;
+}
+
 const l1menu::ISample& l1menu::L1TriggerDPGEvent::sample() const
 {
 	return *pImple_->pParentSample_;
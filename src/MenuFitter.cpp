@@ -8,6 +8,7 @@
 #include <cmath>
 #include "l1menu/ICachedTrigger.h"
 #include "l1menu/ISample.h"
+#include "l1menu/ReducedSample.h"
 #include "l1menu/IEvent.h"
 #include "l1menu/IMenuRate.h"
 #include "l1menu/ITriggerRate.h"
@@ -16,6 +17,7 @@
 #include "l1menu/TriggerRatePlot.h"
 #include "l1menu/TriggerConstraint.h"
 #include "l1menu/MenuRatePlots.h"
+#include "l1menu/RateSession.h"
 #include "l1menu/tools/miscellaneous.h"
 #include "l1menu/tools/fileIO.h"
 #include "l1menu/tools/stringManipulation.h"
@@ -81,6 +83,10 @@ namespace l1menu
 		std::vector< ::TriggerScalingDetails > scalableTriggers;
 		std::vector<std::pair<size_t,float> > bandwidthFractions;
 		void addBandwidthConstraint( size_t triggerNumber, float fractionOfTotalBandwidth );
+		/** @brief The threshold that gives currentBandwidth for the trigger. Uses the sorted index in the
+		 * sample if it's a ReducedSample and the trigger has a single threshold, since that's exact,
+		 * otherwise interpolates the rate plot. */
+		float findThreshold( const ::TriggerScalingDetails& triggerScalingDetails ) const;
 		std::stringstream debugLog;
 	};
 
@@ -147,7 +153,7 @@ std::shared_ptr<const l1menu::IMenuRate> l1menu::MenuFitter::fit( float totalRat
 		// Figure out what threshold should give the target rate for this particular trigger.
 		// Note this is a reference so this command changes the trigger.
 		triggerScalingDetails.currentBandwidth=totalRate*triggerScalingDetails.bandwidthFraction;
-		mainThreshold=triggerScalingDetails.ratePlot.findThreshold( triggerScalingDetails.currentBandwidth );
+		mainThreshold=pImple_->findThreshold( triggerScalingDetails );
 		// Then scale all of the others off this
 		for( const auto& nameScalePair : triggerScalingDetails.thresholdScalings )
 		{
@@ -157,9 +163,11 @@ std::shared_ptr<const l1menu::IMenuRate> l1menu::MenuFitter::fit( float totalRat
 		pImple_->debugLog << "Initially setting threshold for " << std::setw(20) << trigger.name() << " to " << std::setw(10) << mainThreshold << " to try and get a rate of " << totalRate*triggerScalingDetails.bandwidthFraction << std::endl;
 	}
 
-	// Then work out what the total rate is
+	// Then work out what the total rate is. Only the scalable triggers change from now on, so
+	// use a RateSession so that only those are applied again on each iteration.
+	l1menu::RateSession rateSession( pImple_->menu, pImple_->sample );
 	std::shared_ptr<const l1menu::IMenuRate> pMenuRate;
-	pMenuRate=pImple_->sample.rate( pImple_->menu, menuRatePlots() );
+	pMenuRate=rateSession.rate( menuRatePlots() );
 
 	l1menu::tools::dumpTriggerRates( pImple_->debugLog, *pMenuRate );
 
@@ -181,7 +189,7 @@ std::shared_ptr<const l1menu::IMenuRate> l1menu::MenuFitter::fit( float totalRat
 			float& mainThreshold=trigger.parameter( triggerScalingDetails.mainThreshold );
 			// Figure out what threshold should give the target rate for this particular trigger.
 			triggerScalingDetails.currentBandwidth*=scaleAllBandwidthsBy;
-			mainThreshold=triggerScalingDetails.ratePlot.findThreshold( triggerScalingDetails.currentBandwidth );
+			mainThreshold=pImple_->findThreshold( triggerScalingDetails );
 
 			// Then scale all of the others off this
 			for( const auto& nameScalePair : triggerScalingDetails.thresholdScalings )
@@ -189,10 +197,11 @@ std::shared_ptr<const l1menu::IMenuRate> l1menu::MenuFitter::fit( float totalRat
 				trigger.parameter( nameScalePair.first )=mainThreshold*nameScalePair.second;
 			}
 			pImple_->debugLog << "Changing threshold for " << std::setw(20) << trigger.name() << " to " << std::setw(10) << mainThreshold << " to try and change the rate from " << std::setw(10) << pTriggerRate->rate() << " to " << pTriggerRate->rate()*scaleAllBandwidthsBy << std::endl;
+			rateSession.setTrigger( triggerNumber, trigger );
 
 		} // end of loop over triggers I'm allowed to change thresholds for
 
-		pMenuRate=pImple_->sample.rate( pImple_->menu, menuRatePlots() );
+		pMenuRate=rateSession.rate( menuRatePlots() );
 		l1menu::tools::dumpTriggerRates( pImple_->debugLog, *pMenuRate );
 	}
 
@@ -215,6 +224,26 @@ void l1menu::MenuFitter::addTrigger( const l1menu::ITrigger& trigger, const Trig
 	}
 }
 
+float l1menu::MenuFitterPrivateMembers::findThreshold( const ::TriggerScalingDetails& triggerScalingDetails ) const
+{
+	const l1menu::ReducedSample* pReducedSample=dynamic_cast<const l1menu::ReducedSample*>( &sample );
+	if( pReducedSample!=nullptr && triggerScalingDetails.thresholdScalings.empty() )
+	{
+		const l1menu::ITrigger& trigger=menu.getTrigger( triggerScalingDetails.triggerNumber );
+		if( pReducedSample->containsTrigger( trigger ) )
+		{
+			const auto parameterIdentifiers=pReducedSample->getTriggerParameterIdentifiers( trigger );
+			if( parameterIdentifiers.size()==1 && parameterIdentifiers.begin()->first==triggerScalingDetails.mainThreshold )
+			{
+				double targetSumOfWeights=triggerScalingDetails.currentBandwidth*pReducedSample->sumOfWeights()/pReducedSample->eventRate();
+				return pReducedSample->thresholdForSumOfWeights( parameterIdentifiers.begin()->second, targetSumOfWeights );
+			}
+		}
+	}
+
+	return triggerScalingDetails.ratePlot.findThreshold( triggerScalingDetails.currentBandwidth );
+}
+
 void l1menu::MenuFitterPrivateMembers::addBandwidthConstraint( size_t triggerNumber, float fractionOfTotalBandwidth )
 {
 	const l1menu::ITrigger& newTrigger=menu.getTrigger( triggerNumber );
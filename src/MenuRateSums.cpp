@@ -0,0 +1,1482 @@
+#include "l1menu/MenuRateSums.h"
+
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <functional>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <random>
+#include <numeric>
+#include <cmath>
+#include "l1menu/TriggerMenu.h"
+#include "l1menu/ITrigger.h"
+#include "l1menu/ICachedTrigger.h"
+#include "l1menu/ISample.h"
+#include "l1menu/FullSample.h"
+#include "l1menu/ReducedSample.h"
+#include "l1menu/SampleRange.h"
+#include "l1menu/L1TriggerDPGEvent.h"
+#include "l1menu/IEvent.h"
+#include "l1menu/IMenuRate.h"
+#include "l1menu/TriggerExpression.h"
+#include "l1menu/tools/XMLFile.h"
+#include "l1menu/tools/XMLElement.h"
+#include "./implementation/MenuRateImplementation.h"
+#include "./implementation/CompiledMenu.h"
+#include "./implementation/ColumnScanMenu.h"
+#include "./implementation/TriggerDescriptionWithErrorsFromXML.h"
+
+namespace // unnamed namespace
+{
+	/** @brief Returns the value of the one and only child element with the given name, or throws a std::runtime_error. */
+	double getUniqueChildDoubleValue( const l1menu::tools::XMLElement& element, const std::string& childName )
+	{
+		std::vector<l1menu::tools::XMLElement> childElements=element.getChildren(childName);
+		if( childElements.size()!=1 ) throw std::runtime_error( "Failed to load MenuRateSums from XML because the element '"+element.name()+"' did not have one and only one '"+childName+"' child." );
+		return childElements.front().getDoubleValue();
+	}
+
+	/** @brief Where each of the sums is in the flat arrays used while accumulating.
+	 *
+	 * The totals come first, then four sums for each trigger: weight passed, weight squared passed, weight
+	 * pure and weight squared pure. So trigger "n" starts at numberOfTotals+n*numberOfSumsPerTrigger. After
+	 * those are the weight and weight squared of events passing both triggers, for each pair of triggers in
+	 * the order given by pairIndex(). Then the weight and weight squared of events passing each query. */
+	enum SumIndex { sumOfWeightsIndex, sumOfWeightsSquaredIndex, passingAnyIndex, passingAnySquaredIndex, numberOfTotals };
+	enum TriggerSumIndex { passedIndex, passedSquaredIndex, pureIndex, pureSquaredIndex, numberOfSumsPerTrigger };
+	enum PairSumIndex { passedBothIndex, passedBothSquaredIndex, numberOfSumsPerPair };
+	enum QuerySumIndex { passedQueryIndex, passedQuerySquaredIndex, numberOfSumsPerQuery };
+
+	/** @brief The position of the pair of triggers in the packed upper triangle of the overlap matrix.
+	 * The diagonal isn't stored, so firstTriggerNumber must be less than secondTriggerNumber. */
+	size_t pairIndex( size_t firstTriggerNumber, size_t secondTriggerNumber, size_t numberOfTriggers )
+	{
+		return firstTriggerNumber*(2*numberOfTriggers-firstTriggerNumber-1)/2+(secondTriggerNumber-firstTriggerNumber-1);
+	}
+
+	size_t numberOfPairs( size_t numberOfTriggers )
+	{
+		return numberOfTriggers*(numberOfTriggers-1)/2;
+	}
+
+	/** @brief The splitmix64 finaliser, which turns a counter into bits that look random. */
+	uint64_t mixBits( uint64_t value )
+	{
+		value+=0x9e3779b97f4a7c15ULL;
+		value=(value^(value>>30))*0xbf58476d1ce4e5b9ULL;
+		value=(value^(value>>27))*0x94d049bb133111ebULL;
+		return value^(value>>31);
+	}
+
+	/** @brief Turns random bits into a number drawn from a Poisson distribution with a mean of one. */
+	unsigned int poissonOfMeanOne( uint64_t randomBits )
+	{
+		// Top 53 bits to a uniform number in [0,1), then invert the cumulative distribution
+		const double uniform=(randomBits>>11)*(1.0/9007199254740992.0);
+		unsigned int number=0;
+		double probability=std::exp(-1.0);
+		double cumulative=probability;
+		while( uniform>=cumulative && number<20 )
+		{
+			++number;
+			probability/=number;
+			cumulative+=probability;
+		}
+		return number;
+	}
+
+	/** @brief Half the distance between the 15.9% and 84.1% quantiles, i.e. the equivalent of one sigma
+	 * for a Gaussian. Linearly interpolates between the values. */
+	double centralIntervalHalfWidth( std::vector<double> values )
+	{
+		if( values.size()<2 ) return 0;
+		std::sort( values.begin(), values.end() );
+		auto quantile=[&]( double probability )
+		{
+			const double position=probability*(values.size()-1);
+			const size_t below=static_cast<size_t>( position );
+			if( below+1>=values.size() ) return values.back();
+			return values[below]+(position-below)*(values[below+1]-values[below]);
+		};
+		return ( quantile(0.841345)-quantile(0.158655) )/2;
+	}
+
+	/** @brief Records which triggers each event in a chunk passed, one bit per event, and then works out all
+	 * of the sums from the bits.
+	 *
+	 * Each trigger has its own row of bits with 64 consecutive events packed into each word. Once all of the
+	 * events are added the total, pure and pairwise overlap sums are just ANDs and ORs of whole words. Most
+	 * samples have the same weight for every event, so for words where all 64 events have the same weight
+	 * the sum is a popcount times the weight. Otherwise the set bits are looped over. Queries are evaluated
+	 * on the same words, so they don't need the triggers applying again.
+	 */
+	class PassBitsets
+	{
+	public:
+		PassBitsets( size_t numberOfTriggers, size_t maximumNumberOfEvents, const std::vector<l1menu::TriggerExpression>& queries )
+			: numberOfTriggers_(numberOfTriggers), wordsPerTrigger_((maximumNumberOfEvents+63)/64), numberOfEvents_(0),
+			  bits_(numberOfTriggers*wordsPerTrigger_,0), queries_(queries)
+		{
+			weights_.reserve( maximumNumberOfEvents );
+		}
+
+		/** @brief Records the next event, given whether it passed each trigger. */
+		void addEvent( double weight, const std::vector<bool>& triggerResults )
+		{
+			const size_t wordIndex=numberOfEvents_/64;
+			const uint64_t bit=static_cast<uint64_t>(1)<<(numberOfEvents_%64);
+			for( size_t triggerNumber=0; triggerNumber<numberOfTriggers_; ++triggerNumber )
+			{
+				if( triggerResults[triggerNumber] ) bits_[triggerNumber*wordsPerTrigger_+wordIndex]|=bit;
+			}
+			weights_.push_back( weight );
+			++numberOfEvents_;
+		}
+
+		/** @brief Records the next block of up to 64 events, where bit "n" of triggerBits[triggerNumber] is whether
+		 * event "n" in the block passed that trigger. Bits past the end of the block must be zero.
+		 *
+		 * The block doesn't have to start on a word boundary, e.g. when the events are a range of a sample that
+		 * doesn't start on a block boundary, in which case it is split over two words. */
+		void addBlock( const float* weights, size_t numberOfEventsInBlock, const uint64_t* triggerBits )
+		{
+			const size_t wordIndex=numberOfEvents_/64;
+			const size_t shift=numberOfEvents_%64;
+			for( size_t triggerNumber=0; triggerNumber<numberOfTriggers_; ++triggerNumber )
+			{
+				uint64_t* row=&bits_[triggerNumber*wordsPerTrigger_];
+				row[wordIndex]|=triggerBits[triggerNumber]<<shift;
+				if( shift+numberOfEventsInBlock>64 ) row[wordIndex+1]|=triggerBits[triggerNumber]>>(64-shift);
+			}
+			weights_.insert( weights_.end(), weights, weights+numberOfEventsInBlock );
+			numberOfEvents_+=numberOfEventsInBlock;
+		}
+
+		/** @brief Replaces the weights of every event recorded so far, so that the sums can be made for another
+		 * set of weights without the triggers being applied again. */
+		void setWeights( const float* weights )
+		{
+			weights_.assign( weights, weights+numberOfEvents_ );
+		}
+		void setWeights( const std::vector<double>& weights )
+		{
+			weights_=weights;
+		}
+		const std::vector<double>& weights() const { return weights_; }
+
+		/** @brief Adds everything recorded to a flat array of sums laid out as described in SumIndex. If
+		 * includePairsAndQueries is false the array stops after the trigger sums. */
+		void addToSums( double* sums, bool includePairsAndQueries=true ) const
+		{
+			std::vector<size_t> allTriggers( numberOfTriggers_ );
+			std::iota( allTriggers.begin(), allTriggers.end(), 0 );
+			addToSums( sums, allTriggers, uniformWeights(), includePairsAndQueries );
+		}
+
+		/** @brief As addToSums, but one after the other for each of the selections of triggers, as though each
+		 * selection (in its own order) were all of the triggers. The rows are read where they are rather than
+		 * copied, and the weights are only looked at once. Queries aren't evaluated, since they refer to the
+		 * trigger numbers of all of the triggers, so there must be none.
+		 *
+		 * @param[in]  selections         The trigger numbers in each selection.
+		 * @param[in]  sumsPerSelection   The size of each selection's flat array of sums.
+		 * @param[out] sums               Where the arrays are added, one after the other.
+		 */
+		void addToSumsForEachSelection( const std::vector< std::vector<size_t> >& selections, const std::vector<size_t>& sumsPerSelection, double* sums ) const
+		{
+			if( !queries_.empty() ) throw std::logic_error( "PassBitsets::addToSumsForEachSelection - queries can't be evaluated for a selection of triggers" );
+			const std::vector<char> uniformWeight=uniformWeights();
+			for( size_t selectionNumber=0; selectionNumber<selections.size(); ++selectionNumber )
+			{
+				addToSums( sums, selections[selectionNumber], uniformWeight, true );
+				sums+=sumsPerSelection[selectionNumber];
+			}
+		}
+	private:
+		/** @brief For each word of events, whether all of the events in it have the same weight. */
+		std::vector<char> uniformWeights() const
+		{
+			const size_t numberOfWords=(numberOfEvents_+63)/64;
+			std::vector<char> uniformWeight( numberOfWords );
+			for( size_t wordIndex=0; wordIndex<numberOfWords; ++wordIndex )
+			{
+				const size_t endOfWord=std::min( numberOfEvents_, wordIndex*64+64 );
+				uniformWeight[wordIndex]=std::all_of( weights_.begin()+wordIndex*64, weights_.begin()+endOfWord, [&](double weight){ return weight==weights_[wordIndex*64]; } );
+			}
+			return uniformWeight;
+		}
+
+		/** @brief Does the work for the public addToSums methods, for the rows of the given triggers in that order. */
+		void addToSums( double* sums, const std::vector<size_t>& triggerNumbers, const std::vector<char>& uniformWeight, bool includePairsAndQueries ) const
+		{
+			const size_t numberOfWords=(numberOfEvents_+63)/64;
+			const size_t numberOfTriggers=triggerNumbers.size();
+
+			for( const auto weight : weights_ )
+			{
+				sums[sumOfWeightsIndex]+=weight;
+				sums[sumOfWeightsSquaredIndex]+=weight*weight;
+			}
+
+			// For each word find the events that passed any trigger and those that passed exactly one
+			std::vector<uint64_t> passedExactlyOne( numberOfWords );
+			for( size_t wordIndex=0; wordIndex<numberOfWords; ++wordIndex )
+			{
+				uint64_t passedAtLeastOne=0;
+				uint64_t passedMoreThanOne=0;
+				for( const auto triggerNumber : triggerNumbers )
+				{
+					const uint64_t word=bits_[triggerNumber*wordsPerTrigger_+wordIndex];
+					passedMoreThanOne|=passedAtLeastOne & word;
+					passedAtLeastOne|=word;
+				}
+				passedExactlyOne[wordIndex]=passedAtLeastOne & ~passedMoreThanOne;
+				addWeightOfBits( passedAtLeastOne, wordIndex, uniformWeight, sums[passingAnyIndex], sums[passingAnySquaredIndex] );
+			}
+
+			for( size_t index=0; index<numberOfTriggers; ++index )
+			{
+				const uint64_t* triggerBits=&bits_[triggerNumbers[index]*wordsPerTrigger_];
+				double* triggerSums=sums+numberOfTotals+index*numberOfSumsPerTrigger;
+				for( size_t wordIndex=0; wordIndex<numberOfWords; ++wordIndex )
+				{
+					addWeightOfBits( triggerBits[wordIndex], wordIndex, uniformWeight, triggerSums[passedIndex], triggerSums[passedSquaredIndex] );
+					addWeightOfBits( triggerBits[wordIndex] & passedExactlyOne[wordIndex], wordIndex, uniformWeight, triggerSums[pureIndex], triggerSums[pureSquaredIndex] );
+				}
+			}
+			if( !includePairsAndQueries ) return;
+
+			double* pairSums=sums+numberOfTotals+numberOfTriggers*numberOfSumsPerTrigger;
+			for( size_t firstIndex=0; firstIndex<numberOfTriggers; ++firstIndex )
+			{
+				const uint64_t* firstBits=&bits_[triggerNumbers[firstIndex]*wordsPerTrigger_];
+				for( size_t secondIndex=firstIndex+1; secondIndex<numberOfTriggers; ++secondIndex )
+				{
+					const uint64_t* secondBits=&bits_[triggerNumbers[secondIndex]*wordsPerTrigger_];
+					double* thisPairSums=pairSums+::pairIndex(firstIndex,secondIndex,numberOfTriggers)*numberOfSumsPerPair;
+					for( size_t wordIndex=0; wordIndex<numberOfWords; ++wordIndex )
+					{
+						addWeightOfBits( firstBits[wordIndex] & secondBits[wordIndex], wordIndex, uniformWeight, thisPairSums[passedBothIndex], thisPairSums[passedBothSquaredIndex] );
+					}
+				}
+			}
+
+			double* querySums=pairSums+::numberOfPairs(numberOfTriggers)*numberOfSumsPerPair;
+			for( size_t queryNumber=0; queryNumber<queries_.size(); ++queryNumber )
+			{
+				double* thisQuerySums=querySums+queryNumber*numberOfSumsPerQuery;
+				for( size_t wordIndex=0; wordIndex<numberOfWords; ++wordIndex )
+				{
+					// NOT sets the bits past the last event, so those need to be masked off
+					uint64_t validBits=~static_cast<uint64_t>(0);
+					if( wordIndex==numberOfWords-1 && numberOfEvents_%64!=0 ) validBits=(static_cast<uint64_t>(1)<<(numberOfEvents_%64))-1;
+					uint64_t passed=queries_[queryNumber].evaluate( bits_.data(), wordsPerTrigger_, wordIndex ) & validBits;
+					addWeightOfBits( passed, wordIndex, uniformWeight, thisQuerySums[passedQueryIndex], thisQuerySums[passedQuerySquaredIndex] );
+				}
+			}
+		}
+
+		/** @brief Adds the weight and weight squared of the events with bits set in the word. */
+		void addWeightOfBits( uint64_t word, size_t wordIndex, const std::vector<char>& uniformWeight, double& sum, double& sumSquared ) const
+		{
+			if( word==0 ) return;
+			if( uniformWeight[wordIndex] )
+			{
+				const double weight=weights_[wordIndex*64];
+				const double numberOfBits=__builtin_popcountll( word );
+				sum+=numberOfBits*weight;
+				sumSquared+=numberOfBits*weight*weight;
+			}
+			else
+			{
+				for( ; word!=0; word&=word-1 )
+				{
+					const double weight=weights_[wordIndex*64+__builtin_ctzll(word)];
+					sum+=weight;
+					sumSquared+=weight*weight;
+				}
+			}
+		}
+
+		size_t numberOfTriggers_;
+		size_t wordsPerTrigger_;
+		size_t numberOfEvents_;
+		std::vector<uint64_t> bits_; ///< Row for each trigger, wordsPerTrigger_ long
+		std::vector<double> weights_;
+		const std::vector<l1menu::TriggerExpression>& queries_;
+	};
+
+	/// The number of events in each of the chunks that accumulateInChunks splits the events into
+	const size_t eventsPerChunk=65536;
+
+	/** @brief How many threads accumulateInChunks will actually use, where zero means one per core. There's
+	 * no point having more threads than chunks. */
+	size_t numberOfThreadsToUse( size_t numberOfThreads, size_t numberOfEvents )
+	{
+		if( numberOfThreads==0 ) numberOfThreads=std::max( 1u, std::thread::hardware_concurrency() );
+		return std::min( numberOfThreads, (numberOfEvents+eventsPerChunk-1)/eventsPerChunk );
+	}
+
+	/** @brief Splits the events into fixed size chunks, sums each chunk separately on a pool of threads,
+	 * then adds the chunk sums together in order.
+	 *
+	 * The chunks don't depend on the number of threads, and neither does the order they're added together,
+	 * so the result is exactly the same however many threads are used. Each chunk's sums are padded out to
+	 * a whole number of cache lines so that threads don't share cache lines while they work. Chunks are
+	 * added to the totals as soon as all of the chunks before them are finished, so only the chunks still
+	 * in progress or waiting on an earlier one are held in memory.
+	 *
+	 * @param[in]  firstEvent       The first event to process. Chunks start from here.
+	 * @param[in]  numberOfEvents   The number of events to process.
+	 * @param[in]  numberOfSums     The size of the flat array of sums for one chunk.
+	 * @param[in]  numberOfThreads  How many threads to use. Zero means one per core.
+	 * @param[in]  processChunk     Called as processChunk(firstEvent,numberOfEvents,sums) to add the events
+	 *                              in the chunk to "sums", which starts at zero. Must be thread safe if
+	 *                              numberOfThreads isn't one.
+	 * @param[out] totals           The sums over all the chunks, resized to numberOfSums.
+	 */
+	void accumulateInChunks( size_t firstEvent, size_t numberOfEvents, size_t numberOfSums, size_t numberOfThreads, const std::function<void(size_t,size_t,double*)>& processChunk, std::vector<double>& totals )
+	{
+		const size_t doublesPerCacheLine=64/sizeof(double);
+
+		const size_t numberOfChunks=(numberOfEvents+eventsPerChunk-1)/eventsPerChunk;
+		const size_t paddedNumberOfSums=(numberOfSums+doublesPerCacheLine-1)/doublesPerCacheLine*doublesPerCacheLine;
+
+		numberOfThreads=::numberOfThreadsToUse( numberOfThreads, numberOfEvents );
+
+		totals.assign( numberOfSums, 0 );
+		std::vector< std::vector<double> > finishedChunks( numberOfChunks ); ///< Buffers for chunks that can't be added yet
+		std::vector<size_t> finishedChunkOffsets( numberOfChunks );
+		size_t nextChunkToAdd=0;
+		std::mutex totalsMutex;
+
+		std::atomic<size_t> nextChunk( 0 );
+		std::exception_ptr pFirstException;
+		auto worker=[&]()
+		{
+			try
+			{
+				for( size_t chunk=nextChunk++; chunk<numberOfChunks; chunk=nextChunk++ )
+				{
+					// std::vector doesn't guarantee any alignment beyond that of double, so allocate an extra
+					// cache line and start at the first aligned position.
+					std::vector<double> buffer( paddedNumberOfSums+doublesPerCacheLine, 0 );
+					size_t offset=0;
+					while( reinterpret_cast<uintptr_t>(buffer.data()+offset)%64!=0 ) ++offset;
+
+					const size_t eventsBeforeChunk=chunk*eventsPerChunk;
+					processChunk( firstEvent+eventsBeforeChunk, std::min( eventsPerChunk, numberOfEvents-eventsBeforeChunk ), buffer.data()+offset );
+
+					// Always add the chunks in the same order so that the rounding is always the same
+					std::lock_guard<std::mutex> lock( totalsMutex );
+					finishedChunks[chunk].swap( buffer );
+					finishedChunkOffsets[chunk]=offset;
+					for( ; nextChunkToAdd<numberOfChunks && !finishedChunks[nextChunkToAdd].empty(); ++nextChunkToAdd )
+					{
+						const double* chunkSums=finishedChunks[nextChunkToAdd].data()+finishedChunkOffsets[nextChunkToAdd];
+						for( size_t index=0; index<numberOfSums; ++index ) totals[index]+=chunkSums[index];
+						std::vector<double>().swap( finishedChunks[nextChunkToAdd] );
+					}
+				}
+			}
+			catch( ... )
+			{
+				// Stop the other threads picking up any more work, and keep the exception to rethrow
+				nextChunk=numberOfChunks;
+				std::lock_guard<std::mutex> lock( totalsMutex );
+				if( !pFirstException ) pFirstException=std::current_exception();
+			}
+		};
+
+		if( numberOfThreads<=1 ) worker();
+		else
+		{
+			std::vector<std::thread> threads;
+			for( size_t index=0; index<numberOfThreads; ++index ) threads.push_back( std::thread(worker) );
+			for( auto& thread : threads ) thread.join();
+		}
+		if( pFirstException ) std::rethrow_exception( pFirstException );
+	}
+
+	/** @brief Sums the totals and the per trigger sums separately for each lumi section.
+	 *
+	 * Each lumi section gets a flat array laid out as in SumIndex, but stopping after the triggers
+	 * because there are no pairs or queries. Events from the same lumi section are nearly always
+	 * next to each other, so the array for the last lumi section is kept to hand rather than
+	 * looking it up in the map for every event.
+	 */
+	class LumiSectionSums
+	{
+	public:
+		typedef std::pair<unsigned int,unsigned int> LumiSection; ///< Run and lumi section
+		/// The number of events and the flat array of sums
+		typedef std::map< LumiSection, std::pair< size_t,std::vector<double> > > SumsMap;
+
+		explicit LumiSectionSums( size_t numberOfTriggers ) : numberOfTriggers_(numberOfTriggers), pCurrentSums_(nullptr) {}
+
+		/** @brief Adds an event, where bit "bitIndex" of triggerBits[triggerNumber] is whether it passed that trigger. */
+		void addEvent( const LumiSection& lumiSection, double weight, const uint64_t* triggerBits, size_t bitIndex )
+		{
+			double* sums=sumsFor( lumiSection, weight );
+			const uint64_t bit=static_cast<uint64_t>(1)<<bitIndex;
+			size_t numberPassed=0;
+			size_t lastPassed=0;
+			for( size_t triggerNumber=0; triggerNumber<numberOfTriggers_; ++triggerNumber )
+			{
+				if( (triggerBits[triggerNumber] & bit)==0 ) continue;
+				double* triggerSums=sums+numberOfTotals+triggerNumber*numberOfSumsPerTrigger;
+				triggerSums[passedIndex]+=weight;
+				triggerSums[passedSquaredIndex]+=weight*weight;
+				++numberPassed;
+				lastPassed=triggerNumber;
+			}
+			if( numberPassed==0 ) return;
+			sums[passingAnyIndex]+=weight;
+			sums[passingAnySquaredIndex]+=weight*weight;
+			if( numberPassed==1 )
+			{
+				double* triggerSums=sums+numberOfTotals+lastPassed*numberOfSumsPerTrigger;
+				triggerSums[pureIndex]+=weight;
+				triggerSums[pureSquaredIndex]+=weight*weight;
+			}
+		}
+
+		/** @brief Adds an event that is already known not to pass any trigger. */
+		void addFailedEvent( const LumiSection& lumiSection, double weight )
+		{
+			sumsFor( lumiSection, weight );
+		}
+
+		const SumsMap& sums() const { return sums_; }
+	private:
+		/** @brief Counts the event and adds its weight to the totals, and returns the array for the lumi section. */
+		double* sumsFor( const LumiSection& lumiSection, double weight )
+		{
+			if( pCurrentSums_==nullptr || lumiSection!=currentLumiSection_ )
+			{
+				std::pair< size_t,std::vector<double> >& numberAndSums=sums_[lumiSection];
+				if( numberAndSums.second.empty() ) numberAndSums.second.resize( numberOfTotals+numberOfTriggers_*numberOfSumsPerTrigger, 0 );
+				currentLumiSection_=lumiSection;
+				pCurrentNumberOfEvents_=&numberAndSums.first;
+				pCurrentSums_=numberAndSums.second.data();
+			}
+			++*pCurrentNumberOfEvents_;
+			pCurrentSums_[sumOfWeightsIndex]+=weight;
+			pCurrentSums_[sumOfWeightsSquaredIndex]+=weight*weight;
+			return pCurrentSums_;
+		}
+
+		size_t numberOfTriggers_;
+		SumsMap sums_;
+		LumiSection currentLumiSection_;
+		size_t* pCurrentNumberOfEvents_;
+		double* pCurrentSums_; ///< Into sums_, which is safe because std::map never moves its values
+	};
+
+	/** @brief Something that is the same for two triggers if, and only if, they have the same name, version
+	 * and parameter values, so that identical triggers can be found with a hash map rather than comparing
+	 * each trigger with every other. As for CompiledMenu, the bytes of the floats are used, so e.g. 0 and -0
+	 * count as different, which just means those two aren't shared. */
+	std::string triggerKey( const l1menu::ITrigger& trigger )
+	{
+		std::string key=trigger.name()+"\n"+std::to_string( trigger.version() )+"\n";
+		const size_t numberOfParameters=trigger.parameterNames().size();
+		for( size_t handle=0; handle<numberOfParameters; ++handle )
+		{
+			const float value=trigger.parameter( handle );
+			key.append( reinterpret_cast<const char*>(&value), sizeof(value) );
+		}
+		return key;
+	}
+
+	/** @brief Checks that two triggers have the same name, version and parameter values. */
+	bool triggersAreIdentical( const l1menu::ITrigger& trigger, const l1menu::ITrigger& otherTrigger )
+	{
+		if( trigger.name()!=otherTrigger.name() ) return false;
+		if( trigger.version()!=otherTrigger.version() ) return false;
+
+		for( const auto& parameterName : trigger.parameterNames() )
+		{
+			if( trigger.parameter(parameterName)!=otherTrigger.parameter(parameterName) ) return false;
+		}
+		return true;
+	}
+}
+
+namespace l1menu
+{
+	/** @brief Private members for the MenuRateSums class
+	 */
+	class MenuRateSumsPrivateMembers
+	{
+	public:
+		MenuRateSumsPrivateMembers() : eventRate(1), numberOfEvents(0), sumOfWeights(0), sumOfWeightsSquared(0),
+			weightOfEventsPassingAnyTrigger(0), weightSquaredOfEventsPassingAnyTrigger(0), hasOverlaps(true),
+			numberOfBootstrapReplicas(0), bootstrapSeed(0) {}
+		void resizeForMenu();
+		/** @brief Adds the events from firstEvent to firstEvent+numberOfEvents to the sums. A SampleRange is
+		 * passed on to the sample it is a range of, so that it gets the same quicker version. */
+		void accumulate( const l1menu::ISample& sample, size_t firstEvent, size_t numberOfEvents, size_t numberOfThreads );
+		/** @brief Quicker version of accumulate for FullSamples, that gets the triggers to process a batch of events at a time.
+		 * FullSample can only read one event at a time, so with more than one thread the threads take turns to read
+		 * and then apply the triggers to their own copies of the events. */
+		void accumulate( const l1menu::FullSample& sample, size_t firstEvent, size_t numberOfEvents, size_t numberOfThreads );
+		/** @brief Version of accumulate for ReducedSamples that scans the parameter columns with ColumnScanMenu,
+		 * and spreads the events over several threads. */
+		void accumulate( const l1menu::ReducedSample& sample, size_t firstEvent, size_t numberOfEvents, size_t numberOfThreads );
+		/** @brief Does the work for accumulate( ReducedSample ), giving the flat array of sums for each of the weight
+		 * columns. The triggers are only applied once for all of the columns. */
+		std::vector< std::vector<double> > sumsForEachWeight( const l1menu::ReducedSample& sample, size_t firstEvent, size_t numberOfEvents, size_t numberOfThreads, const std::vector<const float*>& weightColumns ) const;
+		/** @brief Adds the chunk to the flat array of sums, followed by the sums for each bootstrap replica if there are any. */
+		void addChunkToSums( ::PassBitsets& passBitsets, size_t firstEventInChunk, double* chunkSums ) const;
+		/** @brief The size of the totals and trigger sums for one bootstrap replica. */
+		size_t numberOfSumsPerReplica() const;
+		/** @brief The bootstrap error from the sum at this index in each replica's flat array, normalised by each
+		 * replica's own sum of weights. */
+		double bootstrapFractionError( size_t sumIndex, const std::string& caller ) const;
+		/** @brief Adds the sums from accumulateInChunks to the members. */
+		void addSums( size_t numberOfEventsAdded, const std::vector<double>& sums );
+		/** @brief Sets all of the sums and the number of events to zero, keeping the menu, queries and replicas. */
+		void clearSums();
+		/** @brief The size of the flat array of sums used while accumulating, see SumIndex in MenuRateSums.cpp */
+		size_t numberOfSums() const;
+
+		l1menu::TriggerMenu menu;
+		float eventRate;
+		size_t numberOfEvents;
+		double sumOfWeights;
+		double sumOfWeightsSquared;
+		double weightOfEventsPassingAnyTrigger;
+		double weightSquaredOfEventsPassingAnyTrigger;
+		std::vector<double> weightOfEventsPassed;
+		std::vector<double> weightSquaredOfEventsPassed;
+		std::vector<double> weightOfEventsPure;
+		std::vector<double> weightSquaredOfEventsPure;
+		/// False if loaded from a file written before the overlaps were saved
+		bool hasOverlaps;
+		std::vector<double> weightOfEventsPassedBoth; ///< Packed upper triangle, see pairIndex() in MenuRateSums.cpp
+		std::vector<double> weightSquaredOfEventsPassedBoth;
+		std::vector<l1menu::TriggerExpression> queries;
+		std::vector<double> weightOfEventsPassingQuery;
+		std::vector<double> weightSquaredOfEventsPassingQuery;
+		size_t numberOfBootstrapReplicas;
+		uint64_t bootstrapSeed;
+		/// The totals and trigger sums for each replica one after the other, laid out as in SumIndex
+		std::vector<double> bootstrapSums;
+		/// Only used by forEachMenu, where "menu" is all of the different triggers in the menus. For each menu,
+		/// the number in "menu" of each of its triggers. The flat array of sums is then the sums for each of
+		/// the menus one after the other, and addSums just adds them to subMenuSums.
+		std::vector< std::vector<size_t> > subMenuTriggers;
+		std::vector<size_t> subMenuNumberOfSums;
+		std::vector<double> subMenuSums;
+	};
+}
+
+void l1menu::MenuRateSumsPrivateMembers::resizeForMenu()
+{
+	weightOfEventsPassed.resize( menu.numberOfTriggers(), 0 );
+	weightSquaredOfEventsPassed.resize( menu.numberOfTriggers(), 0 );
+	weightOfEventsPure.resize( menu.numberOfTriggers(), 0 );
+	weightSquaredOfEventsPure.resize( menu.numberOfTriggers(), 0 );
+	weightOfEventsPassedBoth.resize( ::numberOfPairs(menu.numberOfTriggers()), 0 );
+	weightSquaredOfEventsPassedBoth.resize( ::numberOfPairs(menu.numberOfTriggers()), 0 );
+	weightOfEventsPassingQuery.resize( queries.size(), 0 );
+	weightSquaredOfEventsPassingQuery.resize( queries.size(), 0 );
+	bootstrapSums.resize( numberOfBootstrapReplicas*numberOfSumsPerReplica(), 0 );
+}
+
+void l1menu::MenuRateSumsPrivateMembers::clearSums()
+{
+	numberOfEvents=0;
+	sumOfWeights=0;
+	sumOfWeightsSquared=0;
+	weightOfEventsPassingAnyTrigger=0;
+	weightSquaredOfEventsPassingAnyTrigger=0;
+	for( auto pSums : { &weightOfEventsPassed, &weightSquaredOfEventsPassed, &weightOfEventsPure, &weightSquaredOfEventsPure,
+			&weightOfEventsPassedBoth, &weightSquaredOfEventsPassedBoth, &weightOfEventsPassingQuery, &weightSquaredOfEventsPassingQuery,
+			&bootstrapSums, &subMenuSums } )
+	{
+		std::fill( pSums->begin(), pSums->end(), 0 );
+	}
+}
+
+size_t l1menu::MenuRateSumsPrivateMembers::numberOfSums() const
+{
+	if( !subMenuTriggers.empty() ) return std::accumulate( subMenuNumberOfSums.begin(), subMenuNumberOfSums.end(), static_cast<size_t>(0) );
+	return numberOfTotals+menu.numberOfTriggers()*numberOfSumsPerTrigger+::numberOfPairs(menu.numberOfTriggers())*numberOfSumsPerPair+queries.size()*numberOfSumsPerQuery
+			+numberOfBootstrapReplicas*numberOfSumsPerReplica();
+}
+
+size_t l1menu::MenuRateSumsPrivateMembers::numberOfSumsPerReplica() const
+{
+	return numberOfTotals+menu.numberOfTriggers()*numberOfSumsPerTrigger;
+}
+
+void l1menu::MenuRateSumsPrivateMembers::addChunkToSums( ::PassBitsets& passBitsets, size_t firstEventInChunk, double* chunkSums ) const
+{
+	if( !subMenuTriggers.empty() )
+	{
+		passBitsets.addToSumsForEachSelection( subMenuTriggers, subMenuNumberOfSums, chunkSums );
+		return;
+	}
+
+	passBitsets.addToSums( chunkSums );
+	if( numberOfBootstrapReplicas==0 ) return;
+
+	// Each event's Poisson weight for each replica only depends on the seed, the event number and the replica
+	// number, so it's the same however the events are split into chunks or threads.
+	const std::vector<double> weights=passBitsets.weights();
+	std::vector<uint64_t> eventSeeds;
+	for( size_t index=0; index<weights.size(); ++index ) eventSeeds.push_back( ::mixBits( bootstrapSeed^::mixBits( firstEventInChunk+index ) ) );
+
+	double* replicaSums=chunkSums+numberOfSums()-numberOfBootstrapReplicas*numberOfSumsPerReplica();
+	std::vector<double> replicaWeights( weights.size() );
+	for( size_t replicaNumber=0; replicaNumber<numberOfBootstrapReplicas; ++replicaNumber )
+	{
+		for( size_t index=0; index<weights.size(); ++index )
+		{
+			replicaWeights[index]=weights[index]*::poissonOfMeanOne( ::mixBits( eventSeeds[index]+replicaNumber ) );
+		}
+		passBitsets.setWeights( replicaWeights );
+		passBitsets.addToSums( replicaSums+replicaNumber*numberOfSumsPerReplica(), false );
+	}
+	passBitsets.setWeights( weights );
+}
+
+double l1menu::MenuRateSumsPrivateMembers::bootstrapFractionError( size_t sumIndex, const std::string& caller ) const
+{
+	if( numberOfBootstrapReplicas==0 ) throw std::runtime_error( "MenuRateSums::"+caller+" - there are no bootstrap replicas" );
+	std::vector<double> fractions;
+	for( size_t replicaNumber=0; replicaNumber<numberOfBootstrapReplicas; ++replicaNumber )
+	{
+		const double* replicaSums=&bootstrapSums[replicaNumber*numberOfSumsPerReplica()];
+		fractions.push_back( replicaSums[sumOfWeightsIndex]>0 ? replicaSums[sumIndex]/replicaSums[sumOfWeightsIndex] : 0 );
+	}
+	return ::centralIntervalHalfWidth( fractions );
+}
+
+void l1menu::MenuRateSumsPrivateMembers::addSums( size_t numberOfEventsAdded, const std::vector<double>& sums )
+{
+	if( !subMenuTriggers.empty() )
+	{
+		numberOfEvents+=numberOfEventsAdded;
+		subMenuSums.resize( sums.size(), 0 );
+		for( size_t index=0; index<sums.size(); ++index ) subMenuSums[index]+=sums[index];
+		return;
+	}
+
+	numberOfEvents+=numberOfEventsAdded;
+	sumOfWeights+=sums[sumOfWeightsIndex];
+	sumOfWeightsSquared+=sums[sumOfWeightsSquaredIndex];
+	weightOfEventsPassingAnyTrigger+=sums[passingAnyIndex];
+	weightSquaredOfEventsPassingAnyTrigger+=sums[passingAnySquaredIndex];
+	for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+	{
+		const double* triggerSums=&sums[numberOfTotals+triggerNumber*numberOfSumsPerTrigger];
+		weightOfEventsPassed[triggerNumber]+=triggerSums[passedIndex];
+		weightSquaredOfEventsPassed[triggerNumber]+=triggerSums[passedSquaredIndex];
+		weightOfEventsPure[triggerNumber]+=triggerSums[pureIndex];
+		weightSquaredOfEventsPure[triggerNumber]+=triggerSums[pureSquaredIndex];
+	}
+	const double* pairSums=&sums[numberOfTotals+menu.numberOfTriggers()*numberOfSumsPerTrigger];
+	for( size_t pair=0; pair<weightOfEventsPassedBoth.size(); ++pair )
+	{
+		weightOfEventsPassedBoth[pair]+=pairSums[pair*numberOfSumsPerPair+passedBothIndex];
+		weightSquaredOfEventsPassedBoth[pair]+=pairSums[pair*numberOfSumsPerPair+passedBothSquaredIndex];
+	}
+	const double* querySums=pairSums+weightOfEventsPassedBoth.size()*numberOfSumsPerPair;
+	for( size_t queryNumber=0; queryNumber<queries.size(); ++queryNumber )
+	{
+		weightOfEventsPassingQuery[queryNumber]+=querySums[queryNumber*numberOfSumsPerQuery+passedQueryIndex];
+		weightSquaredOfEventsPassingQuery[queryNumber]+=querySums[queryNumber*numberOfSumsPerQuery+passedQuerySquaredIndex];
+	}
+	const double* replicaSums=querySums+queries.size()*numberOfSumsPerQuery;
+	for( size_t index=0; index<bootstrapSums.size(); ++index ) bootstrapSums[index]+=replicaSums[index];
+}
+
+void l1menu::MenuRateSumsPrivateMembers::accumulate( const l1menu::ISample& sample, size_t firstEvent, size_t numberOfEvents, size_t numberOfThreads )
+{
+	// A range of another sample can use whatever is quickest for that sample. The event numbers are then
+	// those of the underlying sample, which is also what the bootstrap replicas are keyed on.
+	const l1menu::SampleRange* pSampleRange=dynamic_cast<const l1menu::SampleRange*>( &sample );
+	if( pSampleRange!=nullptr ) return accumulate( pSampleRange->underlyingSample(), pSampleRange->firstEvent()+firstEvent, numberOfEvents, numberOfThreads );
+
+	// FullSample can be done in batches
+	const l1menu::FullSample* pFullSample=dynamic_cast<const l1menu::FullSample*>( &sample );
+	if( pFullSample!=nullptr ) return accumulate( *pFullSample, firstEvent, numberOfEvents, numberOfThreads );
+
+	// ReducedSample can be spread over several threads
+	const l1menu::ReducedSample* pReducedSample=dynamic_cast<const l1menu::ReducedSample*>( &sample );
+	if( pReducedSample!=nullptr ) return accumulate( *pReducedSample, firstEvent, numberOfEvents, numberOfThreads );
+
+	// Using cached triggers significantly increases speed for ReducedSample
+	// because it cuts out expensive string comparisons when querying the trigger
+	// parameters.
+	std::vector< std::unique_ptr<l1menu::ICachedTrigger> > cachedTriggers;
+	for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+	{
+		cachedTriggers.push_back( sample.createCachedTrigger( menu.getTrigger( triggerNumber ) ) );
+	}
+
+	std::vector<bool> triggerResults( cachedTriggers.size() );
+
+	// Nothing is known about whether other samples can be read from several threads, so only use one. Still
+	// go through accumulateInChunks so that the sums are added up in the same way as for the other samples.
+	std::vector<double> sums;
+	accumulateInChunks( firstEvent, numberOfEvents, numberOfSums(), 1, [&]( size_t firstEventNumber, size_t numberOfEventsInChunk, double* chunkSums )
+		{
+			::PassBitsets passBitsets( cachedTriggers.size(), numberOfEventsInChunk, queries );
+			for( size_t eventNumber=firstEventNumber; eventNumber<firstEventNumber+numberOfEventsInChunk; ++eventNumber )
+			{
+				const l1menu::IEvent& event=sample.getEvent(eventNumber);
+
+				for( size_t triggerNumber=0; triggerNumber<cachedTriggers.size(); ++triggerNumber )
+				{
+					triggerResults[triggerNumber]=cachedTriggers[triggerNumber]->apply(event);
+				}
+
+				passBitsets.addEvent( event.weight(), triggerResults );
+			}
+			addChunkToSums( passBitsets, firstEventNumber, chunkSums );
+		}, sums );
+	addSums( numberOfEvents, sums );
+}
+
+void l1menu::MenuRateSumsPrivateMembers::accumulate( const l1menu::ReducedSample& sample, size_t firstEvent, size_t numberOfEvents, size_t numberOfThreads )
+{
+	addSums( numberOfEvents, sumsForEachWeight( sample, firstEvent, numberOfEvents, numberOfThreads, { sample.weightColumn() } ).front() );
+}
+
+std::vector< std::vector<double> > l1menu::MenuRateSumsPrivateMembers::sumsForEachWeight( const l1menu::ReducedSample& sample, size_t firstEvent, size_t numberOfEvents, size_t numberOfThreads, const std::vector<const float*>& weightColumns ) const
+{
+	// The thresholds are compared to whole columns of events at a time. This only reads from
+	// the sample, so can be shared by all of the threads.
+	const l1menu::implementation::ColumnScanMenu columnScanMenu( menu, sample );
+	const size_t blockSize=l1menu::implementation::ColumnScanMenu::eventsPerBlock;
+	const size_t sumsPerWeight=numberOfSums();
+
+	// The sums for each set of weights are one after the other in the same flat array
+	std::vector<double> sums;
+	accumulateInChunks( firstEvent, numberOfEvents, sumsPerWeight*weightColumns.size(), numberOfThreads, [&]( size_t firstEventInChunk, size_t numberOfEventsInChunk, double* chunkSums )
+		{
+			// Everything written to here is local to the chunk so that threads don't share anything
+			std::vector<uint64_t> triggerBits( columnScanMenu.numberOfTriggers() );
+			::PassBitsets passBitsets( columnScanMenu.numberOfTriggers(), numberOfEventsInChunk, queries );
+
+			// Blocks can't cross a block boundary in the sample, so that they stay within one zone. If the
+			// range doesn't start on a boundary the first block is shorter.
+			const size_t endOfChunk=firstEventInChunk+numberOfEventsInChunk;
+			for( size_t firstEventNumber=firstEventInChunk; firstEventNumber<endOfChunk; )
+			{
+				const size_t numberOfEventsInBlock=std::min( blockSize-firstEventNumber%blockSize, endOfChunk-firstEventNumber );
+				columnScanMenu.applyBlock( firstEventNumber, numberOfEventsInBlock, triggerBits.data() );
+				passBitsets.addBlock( weightColumns.front()+firstEventNumber, numberOfEventsInBlock, triggerBits.data() );
+				firstEventNumber+=numberOfEventsInBlock;
+			}
+			addChunkToSums( passBitsets, firstEventInChunk, chunkSums );
+
+			for( size_t weightNumber=1; weightNumber<weightColumns.size(); ++weightNumber )
+			{
+				passBitsets.setWeights( weightColumns[weightNumber]+firstEventInChunk );
+				addChunkToSums( passBitsets, firstEventInChunk, chunkSums+weightNumber*sumsPerWeight );
+			}
+		}, sums );
+
+	std::vector< std::vector<double> > returnValue;
+	for( size_t weightNumber=0; weightNumber<weightColumns.size(); ++weightNumber )
+	{
+		returnValue.push_back( std::vector<double>( sums.begin()+weightNumber*sumsPerWeight, sums.begin()+(weightNumber+1)*sumsPerWeight ) );
+	}
+	return returnValue;
+}
+
+void l1menu::MenuRateSumsPrivateMembers::accumulate( const l1menu::FullSample& sample, size_t firstEvent, size_t numberOfEvents, size_t numberOfThreads )
+{
+	// Each trigger is run over this many events at a time, so the dispatch to the trigger
+	// implementation is only done once per batch.
+	const size_t batchSize=64;
+	// With several threads each one reads this many events before applying the triggers. Reading a lot
+	// at once keeps each thread's reads mostly sequential, so the ntuple doesn't keep changing baskets.
+	const size_t eventsPerRead=1024;
+
+	// The events from getFullEvents are only valid until it's called again, so they can only be used directly
+	// if there's one thread. Otherwise the threads copy them while they hold the lock.
+	const bool copyEvents=( ::numberOfThreadsToUse( numberOfThreads, numberOfEvents )>1 );
+	std::mutex sampleMutex;
+
+	std::vector<double> sums;
+	accumulateInChunks( firstEvent, numberOfEvents, numberOfSums(), numberOfThreads, [&]( size_t firstEventInChunk, size_t numberOfEventsInChunk, double* chunkSums )
+		{
+			// Selections shared by more than one trigger (or cross trigger leg) are only evaluated once.
+			// CompiledMenu keeps its working space in the instance, so every chunk needs its own.
+			const l1menu::implementation::CompiledMenu compiledMenu( menu );
+			std::vector< std::vector<bool> > batchResults( menu.numberOfTriggers() );
+			std::vector<bool> triggerResults( menu.numberOfTriggers() );
+			std::vector<l1menu::L1TriggerDPGEvent> eventCopies;
+			std::vector<const l1menu::L1TriggerDPGEvent*> events;
+
+			::PassBitsets passBitsets( menu.numberOfTriggers(), numberOfEventsInChunk, queries );
+			const size_t endOfChunk=firstEventInChunk+numberOfEventsInChunk;
+			const size_t eventsPerStep=( copyEvents ? eventsPerRead : batchSize );
+			for( size_t firstEventInStep=firstEventInChunk; firstEventInStep<endOfChunk; firstEventInStep+=eventsPerStep )
+			{
+				const size_t numberOfEventsInStep=std::min( eventsPerStep, endOfChunk-firstEventInStep );
+				if( !copyEvents ) events=sample.getFullEvents( firstEventInStep, numberOfEventsInStep );
+				else
+				{
+					std::lock_guard<std::mutex> lock( sampleMutex );
+					const std::vector<const l1menu::L1TriggerDPGEvent*>& sampleEvents=sample.getFullEvents( firstEventInStep, numberOfEventsInStep );
+					while( eventCopies.size()<sampleEvents.size() ) eventCopies.push_back( l1menu::L1TriggerDPGEvent(sample) );
+					events.resize( sampleEvents.size() );
+					for( size_t index=0; index<sampleEvents.size(); ++index )
+					{
+						eventCopies[index]=*sampleEvents[index];
+						events[index]=&eventCopies[index];
+					}
+				}
+
+				for( size_t firstIndexInBatch=0; firstIndexInBatch<events.size(); firstIndexInBatch+=batchSize )
+				{
+					const std::vector<const l1menu::L1TriggerDPGEvent*> batch( events.begin()+firstIndexInBatch, events.begin()+std::min( events.size(), firstIndexInBatch+batchSize ) );
+					compiledMenu.applyBatch( batch, batchResults );
+
+					for( size_t index=0; index<batch.size(); ++index )
+					{
+						for( size_t triggerNumber=0; triggerNumber<batchResults.size(); ++triggerNumber ) triggerResults[triggerNumber]=batchResults[triggerNumber][index];
+						passBitsets.addEvent( batch[index]->weight(), triggerResults );
+					}
+				}
+			}
+			addChunkToSums( passBitsets, firstEventInChunk, chunkSums );
+		}, sums );
+	addSums( numberOfEvents, sums );
+}
+
+l1menu::MenuRateSums::MenuRateSums( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample, size_t numberOfThreads )
+	: pImple_( new l1menu::MenuRateSumsPrivateMembers )
+{
+	pImple_->menu=menu;
+	pImple_->eventRate=sample.eventRate();
+	pImple_->resizeForMenu();
+	pImple_->accumulate( sample, 0, sample.numberOfEvents(), numberOfThreads );
+}
+
+l1menu::MenuRateSums::MenuRateSums( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample, const std::vector<std::string>& queries, size_t numberOfThreads )
+	: pImple_( new l1menu::MenuRateSumsPrivateMembers )
+{
+	pImple_->menu=menu;
+	pImple_->eventRate=sample.eventRate();
+	// Parse the queries before doing any work, so that mistakes are found quickly
+	for( const auto& query : queries ) pImple_->queries.push_back( l1menu::TriggerExpression( query, menu ) );
+	pImple_->resizeForMenu();
+	pImple_->accumulate( sample, 0, sample.numberOfEvents(), numberOfThreads );
+}
+
+std::vector<l1menu::MenuRateSums> l1menu::MenuRateSums::forEachWeight( const l1menu::TriggerMenu& menu, const l1menu::ReducedSample& sample, const std::vector<std::string>& queries, size_t numberOfThreads )
+{
+	l1menu::MenuRateSumsPrivateMembers emptySums;
+	emptySums.menu=menu;
+	emptySums.eventRate=sample.eventRate();
+	for( const auto& query : queries ) emptySums.queries.push_back( l1menu::TriggerExpression( query, menu ) );
+	emptySums.resizeForMenu();
+
+	std::vector<const float*> weightColumns( 1, sample.weightColumn() );
+	for( const auto& weightName : sample.weightNames() ) weightColumns.push_back( sample.weightColumn(weightName) );
+
+	std::vector<l1menu::MenuRateSums> returnValue;
+	for( const auto& sums : emptySums.sumsForEachWeight( sample, 0, sample.numberOfEvents(), numberOfThreads, weightColumns ) )
+	{
+		std::unique_ptr<l1menu::MenuRateSumsPrivateMembers> pNewImple( new l1menu::MenuRateSumsPrivateMembers( emptySums ) );
+		pNewImple->addSums( sample.numberOfEvents(), sums );
+		returnValue.push_back( l1menu::MenuRateSums( std::move(pNewImple) ) );
+	}
+	return returnValue;
+}
+
+std::map< std::pair<unsigned int,unsigned int>, l1menu::MenuRateSums > l1menu::MenuRateSums::forEachLumiSection( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample )
+{
+	::LumiSectionSums lumiSectionSums( menu.numberOfTriggers() );
+
+	const l1menu::ReducedSample* pReducedSample=dynamic_cast<const l1menu::ReducedSample*>( &sample );
+	if( pReducedSample!=nullptr )
+	{
+		// Scan the columns a block at a time like accumulate does. Most zero bias events don't pass
+		// anything, so only look at the individual trigger bits for events that passed at least one.
+		const l1menu::implementation::ColumnScanMenu columnScanMenu( menu, *pReducedSample );
+		const size_t blockSize=l1menu::implementation::ColumnScanMenu::eventsPerBlock;
+		const float* weights=pReducedSample->weightColumn();
+		const unsigned int* runs=pReducedSample->runColumn();
+		const unsigned int* lumiSections=pReducedSample->lumiSectionColumn();
+		std::vector<uint64_t> triggerBits( columnScanMenu.numberOfTriggers() );
+
+		for( size_t firstEventNumber=0; firstEventNumber<sample.numberOfEvents(); firstEventNumber+=blockSize )
+		{
+			const size_t numberOfEventsInBlock=std::min( blockSize, sample.numberOfEvents()-firstEventNumber );
+			columnScanMenu.applyBlock( firstEventNumber, numberOfEventsInBlock, triggerBits.data() );
+			uint64_t passedAny=0;
+			for( const auto word : triggerBits ) passedAny|=word;
+
+			for( size_t index=0; index<numberOfEventsInBlock; ++index )
+			{
+				const size_t eventNumber=firstEventNumber+index;
+				const ::LumiSectionSums::LumiSection lumiSection( runs[eventNumber], lumiSections[eventNumber] );
+				if( passedAny & (static_cast<uint64_t>(1)<<index) ) lumiSectionSums.addEvent( lumiSection, weights[eventNumber], triggerBits.data(), index );
+				else lumiSectionSums.addFailedEvent( lumiSection, weights[eventNumber] );
+			}
+		}
+	}
+	else
+	{
+		std::vector< std::unique_ptr<l1menu::ICachedTrigger> > cachedTriggers;
+		for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+		{
+			cachedTriggers.push_back( sample.createCachedTrigger( menu.getTrigger( triggerNumber ) ) );
+		}
+
+		std::vector<uint64_t> triggerBits( cachedTriggers.size() );
+		for( size_t eventNumber=0; eventNumber<sample.numberOfEvents(); ++eventNumber )
+		{
+			const l1menu::IEvent& event=sample.getEvent(eventNumber);
+			for( size_t triggerNumber=0; triggerNumber<cachedTriggers.size(); ++triggerNumber )
+			{
+				triggerBits[triggerNumber]=( cachedTriggers[triggerNumber]->apply(event) ? 1 : 0 );
+			}
+			lumiSectionSums.addEvent( ::LumiSectionSums::LumiSection( event.run(), event.lumiSection() ), event.weight(), triggerBits.data(), 0 );
+		}
+	}
+
+	l1menu::MenuRateSumsPrivateMembers emptySums;
+	emptySums.menu=menu;
+	emptySums.eventRate=sample.eventRate();
+	emptySums.resizeForMenu();
+	emptySums.hasOverlaps=false;
+	emptySums.weightOfEventsPassedBoth.clear();
+	emptySums.weightSquaredOfEventsPassedBoth.clear();
+
+	std::map< std::pair<unsigned int,unsigned int>, l1menu::MenuRateSums > returnValue;
+	for( const auto& lumiSectionAndSums : lumiSectionSums.sums() )
+	{
+		std::unique_ptr<l1menu::MenuRateSumsPrivateMembers> pNewImple( new l1menu::MenuRateSumsPrivateMembers( emptySums ) );
+		pNewImple->addSums( lumiSectionAndSums.second.first, lumiSectionAndSums.second.second );
+		returnValue.insert( std::make_pair( lumiSectionAndSums.first, l1menu::MenuRateSums( std::move(pNewImple) ) ) );
+	}
+	return returnValue;
+}
+
+std::vector<l1menu::MenuRateSums> l1menu::MenuRateSums::inLuminosityBins( const std::map< std::pair<unsigned int,unsigned int>, l1menu::MenuRateSums >& lumiSectionSums,
+		const std::map< std::pair<unsigned int,unsigned int>, float >& luminosities, const std::vector<float>& binEdges )
+{
+	if( lumiSectionSums.empty() ) throw std::runtime_error( "MenuRateSums::inLuminosityBins - there are no lumi sections to bin" );
+	if( binEdges.size()<2 ) throw std::runtime_error( "MenuRateSums::inLuminosityBins - at least two bin edges are needed" );
+	if( std::adjacent_find( binEdges.begin(), binEdges.end(), std::greater_equal<float>() )!=binEdges.end() )
+	{
+		throw std::runtime_error( "MenuRateSums::inLuminosityBins - the bin edges must be in increasing order" );
+	}
+
+	// Start every bin with an empty copy of the first lumi section's sums, so that they all have the same
+	// menu, event rate and queries and empty bins still give something that can be added to.
+	std::unique_ptr<l1menu::MenuRateSumsPrivateMembers> pEmptySums( new l1menu::MenuRateSumsPrivateMembers( *lumiSectionSums.begin()->second.pImple_ ) );
+	pEmptySums->clearSums();
+	std::vector<l1menu::MenuRateSums> returnValue( binEdges.size()-1, l1menu::MenuRateSums( std::move(pEmptySums) ) );
+
+	for( const auto& lumiSectionAndSums : lumiSectionSums )
+	{
+		const auto iLuminosity=luminosities.find( lumiSectionAndSums.first );
+		if( iLuminosity==luminosities.end() )
+		{
+			throw std::runtime_error( "MenuRateSums::inLuminosityBins - there is no luminosity for run "+std::to_string(lumiSectionAndSums.first.first)
+					+" lumi section "+std::to_string(lumiSectionAndSums.first.second) );
+		}
+
+		// Bins include their lower edge, anything outside all of the bins is left out
+		const auto iUpperEdge=std::upper_bound( binEdges.begin(), binEdges.end(), iLuminosity->second );
+		if( iUpperEdge==binEdges.begin() || iUpperEdge==binEdges.end() ) continue;
+		returnValue[iUpperEdge-binEdges.begin()-1].add( lumiSectionAndSums.second );
+	}
+	return returnValue;
+}
+
+std::vector<l1menu::MenuRateSums> l1menu::MenuRateSums::forEachMenu( const std::vector<l1menu::TriggerMenu>& menus, const l1menu::ISample& sample, size_t numberOfThreads )
+{
+	// Make a menu of all the different triggers, and record where each menu's triggers are in it
+	l1menu::MenuRateSumsPrivateMembers allTriggers;
+	allTriggers.eventRate=sample.eventRate();
+	std::vector<l1menu::MenuRateSumsPrivateMembers> emptySums( menus.size() );
+	std::unordered_map<std::string,size_t> uniqueTriggerNumbers;
+	for( size_t menuNumber=0; menuNumber<menus.size(); ++menuNumber )
+	{
+		const l1menu::TriggerMenu& menu=menus[menuNumber];
+		std::vector<size_t> triggerNumbers;
+		for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+		{
+			const l1menu::ITrigger& trigger=menu.getTrigger(triggerNumber);
+			const auto insertResult=uniqueTriggerNumbers.insert( std::make_pair( ::triggerKey(trigger), allTriggers.menu.numberOfTriggers() ) );
+			if( insertResult.second ) allTriggers.menu.addTrigger( trigger );
+			triggerNumbers.push_back( insertResult.first->second );
+		}
+		allTriggers.subMenuTriggers.push_back( triggerNumbers );
+
+		emptySums[menuNumber].menu=menu;
+		emptySums[menuNumber].eventRate=sample.eventRate();
+		emptySums[menuNumber].resizeForMenu();
+		allTriggers.subMenuNumberOfSums.push_back( emptySums[menuNumber].numberOfSums() );
+	}
+	if( menus.empty() ) return std::vector<l1menu::MenuRateSums>();
+
+	// Each different trigger is only applied once, then the sums for each menu come from its rows of the bits
+	allTriggers.accumulate( sample, 0, sample.numberOfEvents(), numberOfThreads );
+
+	std::vector<l1menu::MenuRateSums> returnValue;
+	std::vector<double>::const_iterator iMenuSums=allTriggers.subMenuSums.begin();
+	for( size_t menuNumber=0; menuNumber<menus.size(); ++menuNumber )
+	{
+		std::unique_ptr<l1menu::MenuRateSumsPrivateMembers> pNewImple( new l1menu::MenuRateSumsPrivateMembers( std::move(emptySums[menuNumber]) ) );
+		const std::vector<double> menuSums( iMenuSums, iMenuSums+allTriggers.subMenuNumberOfSums[menuNumber] );
+		pNewImple->addSums( allTriggers.numberOfEvents, menuSums );
+		iMenuSums+=allTriggers.subMenuNumberOfSums[menuNumber];
+		returnValue.push_back( l1menu::MenuRateSums( std::move(pNewImple) ) );
+	}
+	return returnValue;
+}
+
+l1menu::MenuRateSums l1menu::MenuRateSums::withBootstrap( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample, size_t numberOfReplicas, uint64_t seed, size_t numberOfThreads )
+{
+	std::unique_ptr<l1menu::MenuRateSumsPrivateMembers> pNewImple( new l1menu::MenuRateSumsPrivateMembers );
+	pNewImple->menu=menu;
+	pNewImple->eventRate=sample.eventRate();
+	pNewImple->numberOfBootstrapReplicas=numberOfReplicas;
+	pNewImple->bootstrapSeed=seed;
+	pNewImple->resizeForMenu();
+	pNewImple->accumulate( sample, 0, sample.numberOfEvents(), numberOfThreads );
+	return l1menu::MenuRateSums( std::move(pNewImple) );
+}
+
+const size_t l1menu::MenuRateSums::eventsPerProgressiveBlock;
+const size_t l1menu::MenuRateSums::minimumProgressiveBlocks;
+static_assert( l1menu::MenuRateSums::eventsPerProgressiveBlock==l1menu::ReducedSample::eventsPerZone, "Progressive blocks should be ReducedSample zones" );
+
+l1menu::MenuRateSums l1menu::MenuRateSums::progressive( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample, const std::function<bool(const l1menu::MenuRateSums&)>& progressCallback, float relativeErrorTolerance, size_t numberOfThreads )
+{
+	std::unique_ptr<l1menu::MenuRateSumsPrivateMembers> pNewImple( new l1menu::MenuRateSumsPrivateMembers );
+	pNewImple->menu=menu;
+	pNewImple->eventRate=sample.eventRate();
+	pNewImple->resizeForMenu();
+	l1menu::MenuRateSums sumsSoFar( std::move(pNewImple) );
+
+	// Samples are usually made by adding files one after the other, so neighbouring events are more alike
+	// than random ones. Shuffle the blocks so that the estimate isn't biased towards the first files. A
+	// fixed seed means the estimates are the same every time.
+	const size_t numberOfBlocks=(sample.numberOfEvents()+eventsPerProgressiveBlock-1)/eventsPerProgressiveBlock;
+	std::vector<size_t> blockOrder( numberOfBlocks );
+	std::iota( blockOrder.begin(), blockOrder.end(), 0 );
+	std::mt19937 randomGenerator( 12345 );
+	std::shuffle( blockOrder.begin(), blockOrder.end(), randomGenerator );
+
+	// Sums over the blocks so far of the squares and product of each block's weight and weight passing
+	// any trigger, for the variance between the blocks
+	size_t numberOfBlocksDone=0;
+	double sumOfBlockWeightsSquared=0;
+	double sumOfBlockPassingSquared=0;
+	double sumOfBlockWeightTimesPassing=0;
+	for( const auto blockNumber : blockOrder )
+	{
+		const size_t firstEvent=blockNumber*eventsPerProgressiveBlock;
+		l1menu::MenuRateSumsPrivateMembers& sums=*sumsSoFar.pImple_;
+		const double sumOfWeightsBefore=sums.sumOfWeights;
+		const double weightPassingAnyBefore=sums.weightOfEventsPassingAnyTrigger;
+		sums.accumulate( sample, firstEvent, std::min( eventsPerProgressiveBlock, sample.numberOfEvents()-firstEvent ), numberOfThreads );
+		const double blockWeight=sums.sumOfWeights-sumOfWeightsBefore;
+		const double blockPassing=sums.weightOfEventsPassingAnyTrigger-weightPassingAnyBefore;
+		++numberOfBlocksDone;
+		sumOfBlockWeightsSquared+=blockWeight*blockWeight;
+		sumOfBlockPassingSquared+=blockPassing*blockPassing;
+		sumOfBlockWeightTimesPassing+=blockWeight*blockPassing;
+
+		if( progressCallback && !progressCallback( sumsSoFar ) ) break;
+		if( relativeErrorTolerance>0 && numberOfBlocksDone>=minimumProgressiveBlocks && sums.weightOfEventsPassingAnyTrigger>0 )
+		{
+			// Neighbouring events tend to come from the same lumi section, so the error from the sum of weights
+			// squared is too small. The blocks are a random sample of all the blocks though, so use the spread
+			// of the blocks' fractions about the fraction so far, each weighted by the block's weight (the usual
+			// error for a ratio estimate). The sum of the squares of (passing-fraction*weight) is expanded so
+			// that it doesn't need every block. The last factor is because the blocks are sampled without
+			// replacement, so the error goes to zero once every block has been done.
+			const double fraction=sums.weightOfEventsPassingAnyTrigger/sums.sumOfWeights;
+			const double sumOfSquares=std::max( 0.0, sumOfBlockPassingSquared-2*fraction*sumOfBlockWeightTimesPassing+fraction*fraction*sumOfBlockWeightsSquared );
+			const double variance=numberOfBlocksDone/(numberOfBlocksDone-1.0)*sumOfSquares/(sums.sumOfWeights*sums.sumOfWeights)
+					*( 1-static_cast<double>(numberOfBlocksDone)/numberOfBlocks );
+			if( std::sqrt(variance)/fraction<relativeErrorTolerance ) break;
+		}
+	}
+	return sumsSoFar;
+}
+
+l1menu::MenuRateSums::MenuRateSums( std::unique_ptr<l1menu::MenuRateSumsPrivateMembers> pImple )
+	: pImple_( std::move(pImple) )
+{
+	// No operation besides the initialiser list
+}
+
+l1menu::MenuRateSums::MenuRateSums( const std::string& filename )
+	: pImple_( new l1menu::MenuRateSumsPrivateMembers )
+{
+	l1menu::tools::XMLFile inputFile( filename );
+	const l1menu::tools::XMLElement rootElement=inputFile.rootElement();
+
+	//
+	// First get the menu. This is written out in the same format as the XML menu files.
+	//
+	std::vector<l1menu::tools::XMLElement> menuElements=rootElement.getChildren("TriggerMenu");
+	if( menuElements.size()!=1 ) throw std::runtime_error( "Failed to load MenuRateSums from \""+filename+"\" because there was not one and only one 'TriggerMenu' element." );
+	for( const auto& triggerElement : menuElements.front().getChildren("Trigger") )
+	{
+		pImple_->menu.addTrigger( l1menu::implementation::TriggerDescriptionWithErrorsFromXML( triggerElement ) );
+	}
+	pImple_->resizeForMenu();
+
+	//
+	// Then the sums.
+	//
+	std::vector<l1menu::tools::XMLElement> sumsElements=rootElement.getChildren("MenuRateSums");
+	if( sumsElements.size()!=1 ) throw std::runtime_error( "Failed to load MenuRateSums from \""+filename+"\" because there was not one and only one 'MenuRateSums' element." );
+	const l1menu::tools::XMLElement& sumsElement=sumsElements.front();
+
+	pImple_->eventRate=getUniqueChildDoubleValue( sumsElement, "eventRate" );
+	pImple_->numberOfEvents=static_cast<size_t>( getUniqueChildDoubleValue( sumsElement, "numberOfEvents" ) );
+	pImple_->sumOfWeights=getUniqueChildDoubleValue( sumsElement, "sumOfWeights" );
+	pImple_->sumOfWeightsSquared=getUniqueChildDoubleValue( sumsElement, "sumOfWeightsSquared" );
+	pImple_->weightOfEventsPassingAnyTrigger=getUniqueChildDoubleValue( sumsElement, "weightOfEventsPassingAnyTrigger" );
+	pImple_->weightSquaredOfEventsPassingAnyTrigger=getUniqueChildDoubleValue( sumsElement, "weightSquaredOfEventsPassingAnyTrigger" );
+
+	// The trigger sums are stored in the same order as the triggers in the menu
+	std::vector<l1menu::tools::XMLElement> triggerSumsElements=sumsElement.getChildren("TriggerSums");
+	if( triggerSumsElements.size()!=pImple_->menu.numberOfTriggers() ) throw std::runtime_error( "Failed to load MenuRateSums from \""+filename+"\" because the number of 'TriggerSums' elements does not match the number of triggers in the menu." );
+	for( size_t triggerNumber=0; triggerNumber<triggerSumsElements.size(); ++triggerNumber )
+	{
+		const l1menu::tools::XMLElement& triggerSumsElement=triggerSumsElements[triggerNumber];
+		pImple_->weightOfEventsPassed[triggerNumber]=getUniqueChildDoubleValue( triggerSumsElement, "weightOfEventsPassed" );
+		pImple_->weightSquaredOfEventsPassed[triggerNumber]=getUniqueChildDoubleValue( triggerSumsElement, "weightSquaredOfEventsPassed" );
+		pImple_->weightOfEventsPure[triggerNumber]=getUniqueChildDoubleValue( triggerSumsElement, "weightOfEventsPure" );
+		pImple_->weightSquaredOfEventsPure[triggerNumber]=getUniqueChildDoubleValue( triggerSumsElement, "weightSquaredOfEventsPure" );
+	}
+
+	// Format version 0 didn't have the overlaps between pairs of triggers
+	pImple_->hasOverlaps=( sumsElement.hasAttribute("formatVersion") && sumsElement.getIntAttribute("formatVersion")>=1 );
+	if( pImple_->hasOverlaps )
+	{
+		std::vector<l1menu::tools::XMLElement> overlapSumsElements=sumsElement.getChildren("TriggerOverlapSums");
+		if( overlapSumsElements.size()!=pImple_->weightOfEventsPassedBoth.size() ) throw std::runtime_error( "Failed to load MenuRateSums from \""+filename+"\" because the number of 'TriggerOverlapSums' elements does not match the number of pairs of triggers in the menu." );
+		for( const auto& overlapSumsElement : overlapSumsElements )
+		{
+			int first=overlapSumsElement.getIntAttribute("first");
+			int second=overlapSumsElement.getIntAttribute("second");
+			if( first<0 || second<=first || static_cast<size_t>(second)>=pImple_->menu.numberOfTriggers() ) throw std::runtime_error( "Failed to load MenuRateSums from \""+filename+"\" because a 'TriggerOverlapSums' element has invalid trigger numbers." );
+			size_t pair=::pairIndex( first, second, pImple_->menu.numberOfTriggers() );
+			pImple_->weightOfEventsPassedBoth[pair]=getUniqueChildDoubleValue( overlapSumsElement, "weightOfEventsPassedBoth" );
+			pImple_->weightSquaredOfEventsPassedBoth[pair]=getUniqueChildDoubleValue( overlapSumsElement, "weightSquaredOfEventsPassedBoth" );
+		}
+	}
+
+	for( const auto& querySumsElement : sumsElement.getChildren("QuerySums") )
+	{
+		std::vector<l1menu::tools::XMLElement> expressionElements=querySumsElement.getChildren("expression");
+		if( expressionElements.size()!=1 ) throw std::runtime_error( "Failed to load MenuRateSums from \""+filename+"\" because a 'QuerySums' element did not have one and only one 'expression' child." );
+		pImple_->queries.push_back( l1menu::TriggerExpression( expressionElements.front().getValue(), pImple_->menu ) );
+		pImple_->weightOfEventsPassingQuery.push_back( getUniqueChildDoubleValue( querySumsElement, "weightOfEventsPassingQuery" ) );
+		pImple_->weightSquaredOfEventsPassingQuery.push_back( getUniqueChildDoubleValue( querySumsElement, "weightSquaredOfEventsPassingQuery" ) );
+	}
+}
+
+l1menu::MenuRateSums::MenuRateSums( const l1menu::MenuRateSums& otherMenuRateSums )
+	: pImple_( new l1menu::MenuRateSumsPrivateMembers( *otherMenuRateSums.pImple_ ) )
+{
+	// No operation besides the initialiser list
+}
+
+l1menu::MenuRateSums::MenuRateSums( l1menu::MenuRateSums&& otherMenuRateSums ) noexcept
+	: pImple_( std::move(otherMenuRateSums.pImple_) )
+{
+	// No operation besides the initialiser list
+}
+
+l1menu::MenuRateSums& l1menu::MenuRateSums::operator=( const l1menu::MenuRateSums& otherMenuRateSums )
+{
+	// A moved from instance has no pImple_, so needs a new one
+	if( pImple_==nullptr ) pImple_.reset( new l1menu::MenuRateSumsPrivateMembers( *otherMenuRateSums.pImple_ ) );
+	else *pImple_=*otherMenuRateSums.pImple_;
+	return *this;
+}
+
+l1menu::MenuRateSums& l1menu::MenuRateSums::operator=( l1menu::MenuRateSums&& otherMenuRateSums ) noexcept
+{
+	pImple_=std::move(otherMenuRateSums.pImple_);
+	return *this;
+}
+
+l1menu::MenuRateSums::~MenuRateSums()
+{
+	// No operation. Just need one defined otherwise the default one messes up
+	// the unique_ptr deletion because MenuRateSumsPrivateMembers isn't
+	// defined elsewhere.
+}
+
+void l1menu::MenuRateSums::add( const l1menu::MenuRateSums& otherMenuRateSums )
+{
+	const l1menu::MenuRateSumsPrivateMembers& other=*otherMenuRateSums.pImple_;
+
+	if( other.eventRate!=pImple_->eventRate ) throw std::runtime_error( "MenuRateSums::add - the event rates are different" );
+	if( other.menu.numberOfTriggers()!=pImple_->menu.numberOfTriggers() ) throw std::runtime_error( "MenuRateSums::add - the menus have a different number of triggers" );
+	for( size_t triggerNumber=0; triggerNumber<pImple_->menu.numberOfTriggers(); ++triggerNumber )
+	{
+		if( !::triggersAreIdentical( pImple_->menu.getTrigger(triggerNumber), other.menu.getTrigger(triggerNumber) ) )
+		{
+			throw std::runtime_error( "MenuRateSums::add - the menus are different for trigger "+pImple_->menu.getTrigger(triggerNumber).name() );
+		}
+	}
+
+	if( other.queries.size()!=pImple_->queries.size() ) throw std::runtime_error( "MenuRateSums::add - the number of queries is different" );
+	for( size_t queryNumber=0; queryNumber<pImple_->queries.size(); ++queryNumber )
+	{
+		if( other.queries[queryNumber].expression()!=pImple_->queries[queryNumber].expression() ) throw std::runtime_error( "MenuRateSums::add - the queries are different for "+pImple_->queries[queryNumber].name() );
+	}
+	if( other.numberOfBootstrapReplicas!=pImple_->numberOfBootstrapReplicas ) throw std::runtime_error( "MenuRateSums::add - the number of bootstrap replicas is different" );
+
+	pImple_->numberOfEvents+=other.numberOfEvents;
+	pImple_->sumOfWeights+=other.sumOfWeights;
+	pImple_->sumOfWeightsSquared+=other.sumOfWeightsSquared;
+	pImple_->weightOfEventsPassingAnyTrigger+=other.weightOfEventsPassingAnyTrigger;
+	pImple_->weightSquaredOfEventsPassingAnyTrigger+=other.weightSquaredOfEventsPassingAnyTrigger;
+	for( size_t triggerNumber=0; triggerNumber<pImple_->menu.numberOfTriggers(); ++triggerNumber )
+	{
+		pImple_->weightOfEventsPassed[triggerNumber]+=other.weightOfEventsPassed[triggerNumber];
+		pImple_->weightSquaredOfEventsPassed[triggerNumber]+=other.weightSquaredOfEventsPassed[triggerNumber];
+		pImple_->weightOfEventsPure[triggerNumber]+=other.weightOfEventsPure[triggerNumber];
+		pImple_->weightSquaredOfEventsPure[triggerNumber]+=other.weightSquaredOfEventsPure[triggerNumber];
+	}
+	// The overlaps can only be kept if both have them. Sums without them might not have space
+	// for them either (e.g. from forEachLumiSection), so don't read or keep them at all.
+	pImple_->hasOverlaps=pImple_->hasOverlaps && other.hasOverlaps;
+	if( pImple_->hasOverlaps )
+	{
+		for( size_t pair=0; pair<pImple_->weightOfEventsPassedBoth.size(); ++pair )
+		{
+			pImple_->weightOfEventsPassedBoth[pair]+=other.weightOfEventsPassedBoth[pair];
+			pImple_->weightSquaredOfEventsPassedBoth[pair]+=other.weightSquaredOfEventsPassedBoth[pair];
+		}
+	}
+	else
+	{
+		std::vector<double>().swap( pImple_->weightOfEventsPassedBoth );
+		std::vector<double>().swap( pImple_->weightSquaredOfEventsPassedBoth );
+	}
+	for( size_t queryNumber=0; queryNumber<pImple_->queries.size(); ++queryNumber )
+	{
+		pImple_->weightOfEventsPassingQuery[queryNumber]+=other.weightOfEventsPassingQuery[queryNumber];
+		pImple_->weightSquaredOfEventsPassingQuery[queryNumber]+=other.weightSquaredOfEventsPassingQuery[queryNumber];
+	}
+	for( size_t index=0; index<pImple_->bootstrapSums.size(); ++index ) pImple_->bootstrapSums[index]+=other.bootstrapSums[index];
+}
+
+void l1menu::MenuRateSums::saveToFile( const std::string& filename ) const
+{
+	l1menu::tools::XMLFile outputFile;
+	l1menu::tools::XMLElement rootElement=outputFile.rootElement();
+
+	// Write the menu in the same format as XMLL1MenuFile so that this file can
+	// also be loaded as a menu.
+	l1menu::tools::XMLElement menuElement=rootElement.createChild( "TriggerMenu" );
+	for( size_t triggerNumber=0; triggerNumber<pImple_->menu.numberOfTriggers(); ++triggerNumber )
+	{
+		const l1menu::ITrigger& trigger=pImple_->menu.getTrigger(triggerNumber);
+
+		l1menu::tools::XMLElement triggerElement=menuElement.createChild( "Trigger" );
+		triggerElement.setAttribute( "formatVersion", 0 );
+		triggerElement.createChild( "name" ).setValue( trigger.name() );
+		// Need a cast because the compiler doesn't like going from unsigned int to int
+		triggerElement.createChild( "version" ).setValue( static_cast<int>( trigger.version() ) );
+		for( const auto& parameterName : trigger.parameterNames() )
+		{
+			l1menu::tools::XMLElement parameterElement=triggerElement.createChild( "parameter" );
+			parameterElement.setAttribute( "name", parameterName );
+			parameterElement.setValue( trigger.parameter( parameterName ) );
+		}
+	}
+
+	// Use the double overload of setValue everywhere so that no precision is lost
+	l1menu::tools::XMLElement sumsElement=rootElement.createChild( "MenuRateSums" );
+	sumsElement.setAttribute( "formatVersion", pImple_->hasOverlaps ? 1 : 0 );
+	sumsElement.createChild( "eventRate" ).setValue( static_cast<double>(pImple_->eventRate) );
+	sumsElement.createChild( "numberOfEvents" ).setValue( static_cast<double>(pImple_->numberOfEvents) );
+	sumsElement.createChild( "sumOfWeights" ).setValue( pImple_->sumOfWeights );
+	sumsElement.createChild( "sumOfWeightsSquared" ).setValue( pImple_->sumOfWeightsSquared );
+	sumsElement.createChild( "weightOfEventsPassingAnyTrigger" ).setValue( pImple_->weightOfEventsPassingAnyTrigger );
+	sumsElement.createChild( "weightSquaredOfEventsPassingAnyTrigger" ).setValue( pImple_->weightSquaredOfEventsPassingAnyTrigger );
+	for( size_t triggerNumber=0; triggerNumber<pImple_->menu.numberOfTriggers(); ++triggerNumber )
+	{
+		l1menu::tools::XMLElement triggerSumsElement=sumsElement.createChild( "TriggerSums" );
+		triggerSumsElement.setAttribute( "name", pImple_->menu.getTrigger(triggerNumber).name() );
+		triggerSumsElement.createChild( "weightOfEventsPassed" ).setValue( pImple_->weightOfEventsPassed[triggerNumber] );
+		triggerSumsElement.createChild( "weightSquaredOfEventsPassed" ).setValue( pImple_->weightSquaredOfEventsPassed[triggerNumber] );
+		triggerSumsElement.createChild( "weightOfEventsPure" ).setValue( pImple_->weightOfEventsPure[triggerNumber] );
+		triggerSumsElement.createChild( "weightSquaredOfEventsPure" ).setValue( pImple_->weightSquaredOfEventsPure[triggerNumber] );
+	}
+	if( pImple_->hasOverlaps )
+	{
+		for( size_t firstTriggerNumber=0; firstTriggerNumber<pImple_->menu.numberOfTriggers(); ++firstTriggerNumber )
+		{
+			for( size_t secondTriggerNumber=firstTriggerNumber+1; secondTriggerNumber<pImple_->menu.numberOfTriggers(); ++secondTriggerNumber )
+			{
+				size_t pair=::pairIndex( firstTriggerNumber, secondTriggerNumber, pImple_->menu.numberOfTriggers() );
+				l1menu::tools::XMLElement overlapSumsElement=sumsElement.createChild( "TriggerOverlapSums" );
+				overlapSumsElement.setAttribute( "first", static_cast<int>(firstTriggerNumber) );
+				overlapSumsElement.setAttribute( "second", static_cast<int>(secondTriggerNumber) );
+				overlapSumsElement.createChild( "weightOfEventsPassedBoth" ).setValue( pImple_->weightOfEventsPassedBoth[pair] );
+				overlapSumsElement.createChild( "weightSquaredOfEventsPassedBoth" ).setValue( pImple_->weightSquaredOfEventsPassedBoth[pair] );
+			}
+		}
+	}
+	for( size_t queryNumber=0; queryNumber<pImple_->queries.size(); ++queryNumber )
+	{
+		l1menu::tools::XMLElement querySumsElement=sumsElement.createChild( "QuerySums" );
+		querySumsElement.createChild( "expression" ).setValue( pImple_->queries[queryNumber].expression() );
+		querySumsElement.createChild( "weightOfEventsPassingQuery" ).setValue( pImple_->weightOfEventsPassingQuery[queryNumber] );
+		querySumsElement.createChild( "weightSquaredOfEventsPassingQuery" ).setValue( pImple_->weightSquaredOfEventsPassingQuery[queryNumber] );
+	}
+
+	std::ofstream outputStream( filename );
+	if( !outputStream.is_open() ) throw std::runtime_error( "MenuRateSums::saveToFile - unable to open the file \""+filename+"\"" );
+	outputFile.outputToStream( outputStream );
+}
+
+std::shared_ptr<const l1menu::IMenuRate> l1menu::MenuRateSums::rate() const
+{
+	return std::shared_ptr<const l1menu::IMenuRate>( new l1menu::implementation::MenuRateImplementation( *this ) );
+}
+
+const l1menu::TriggerMenu& l1menu::MenuRateSums::menu() const
+{
+	return pImple_->menu;
+}
+
+float l1menu::MenuRateSums::eventRate() const
+{
+	return pImple_->eventRate;
+}
+
+size_t l1menu::MenuRateSums::numberOfEvents() const
+{
+	return pImple_->numberOfEvents;
+}
+
+double l1menu::MenuRateSums::sumOfWeights() const
+{
+	return pImple_->sumOfWeights;
+}
+
+double l1menu::MenuRateSums::sumOfWeightsSquared() const
+{
+	return pImple_->sumOfWeightsSquared;
+}
+
+double l1menu::MenuRateSums::weightOfEventsPassingAnyTrigger() const
+{
+	return pImple_->weightOfEventsPassingAnyTrigger;
+}
+
+double l1menu::MenuRateSums::weightSquaredOfEventsPassingAnyTrigger() const
+{
+	return pImple_->weightSquaredOfEventsPassingAnyTrigger;
+}
+
+double l1menu::MenuRateSums::weightOfEventsPassed( size_t triggerNumber ) const
+{
+	return pImple_->weightOfEventsPassed.at(triggerNumber);
+}
+
+double l1menu::MenuRateSums::weightSquaredOfEventsPassed( size_t triggerNumber ) const
+{
+	return pImple_->weightSquaredOfEventsPassed.at(triggerNumber);
+}
+
+double l1menu::MenuRateSums::weightOfEventsPure( size_t triggerNumber ) const
+{
+	return pImple_->weightOfEventsPure.at(triggerNumber);
+}
+
+double l1menu::MenuRateSums::weightSquaredOfEventsPure( size_t triggerNumber ) const
+{
+	return pImple_->weightSquaredOfEventsPure.at(triggerNumber);
+}
+
+bool l1menu::MenuRateSums::hasOverlaps() const
+{
+	return pImple_->hasOverlaps;
+}
+
+double l1menu::MenuRateSums::weightOfEventsPassedBoth( size_t firstTriggerNumber, size_t secondTriggerNumber ) const
+{
+	if( !pImple_->hasOverlaps ) throw std::runtime_error( "MenuRateSums::weightOfEventsPassedBoth - the overlaps are not available for these sums" );
+	if( firstTriggerNumber==secondTriggerNumber ) return weightOfEventsPassed( firstTriggerNumber );
+	if( firstTriggerNumber>secondTriggerNumber ) std::swap( firstTriggerNumber, secondTriggerNumber );
+	if( secondTriggerNumber>=pImple_->menu.numberOfTriggers() ) throw std::out_of_range( "MenuRateSums::weightOfEventsPassedBoth - trigger number out of range" );
+	return pImple_->weightOfEventsPassedBoth[::pairIndex( firstTriggerNumber, secondTriggerNumber, pImple_->menu.numberOfTriggers() )];
+}
+
+double l1menu::MenuRateSums::weightSquaredOfEventsPassedBoth( size_t firstTriggerNumber, size_t secondTriggerNumber ) const
+{
+	if( !pImple_->hasOverlaps ) throw std::runtime_error( "MenuRateSums::weightSquaredOfEventsPassedBoth - the overlaps are not available for these sums" );
+	if( firstTriggerNumber==secondTriggerNumber ) return weightSquaredOfEventsPassed( firstTriggerNumber );
+	if( firstTriggerNumber>secondTriggerNumber ) std::swap( firstTriggerNumber, secondTriggerNumber );
+	if( secondTriggerNumber>=pImple_->menu.numberOfTriggers() ) throw std::out_of_range( "MenuRateSums::weightSquaredOfEventsPassedBoth - trigger number out of range" );
+	return pImple_->weightSquaredOfEventsPassedBoth[::pairIndex( firstTriggerNumber, secondTriggerNumber, pImple_->menu.numberOfTriggers() )];
+}
+
+size_t l1menu::MenuRateSums::numberOfQueries() const
+{
+	return pImple_->queries.size();
+}
+
+const l1menu::TriggerExpression& l1menu::MenuRateSums::query( size_t queryNumber ) const
+{
+	return pImple_->queries.at(queryNumber);
+}
+
+double l1menu::MenuRateSums::weightOfEventsPassingQuery( size_t queryNumber ) const
+{
+	return pImple_->weightOfEventsPassingQuery.at(queryNumber);
+}
+
+double l1menu::MenuRateSums::weightSquaredOfEventsPassingQuery( size_t queryNumber ) const
+{
+	return pImple_->weightSquaredOfEventsPassingQuery.at(queryNumber);
+}
+
+size_t l1menu::MenuRateSums::numberOfBootstrapReplicas() const
+{
+	return pImple_->numberOfBootstrapReplicas;
+}
+
+double l1menu::MenuRateSums::bootstrapTotalFractionError() const
+{
+	return pImple_->bootstrapFractionError( passingAnyIndex, "bootstrapTotalFractionError" );
+}
+
+double l1menu::MenuRateSums::bootstrapFractionError( size_t triggerNumber ) const
+{
+	if( triggerNumber>=pImple_->menu.numberOfTriggers() ) throw std::out_of_range( "MenuRateSums::bootstrapFractionError - trigger number out of range" );
+	return pImple_->bootstrapFractionError( numberOfTotals+triggerNumber*numberOfSumsPerTrigger+passedIndex, "bootstrapFractionError" );
+}
+
+double l1menu::MenuRateSums::bootstrapPureFractionError( size_t triggerNumber ) const
+{
+	if( triggerNumber>=pImple_->menu.numberOfTriggers() ) throw std::out_of_range( "MenuRateSums::bootstrapPureFractionError - trigger number out of range" );
+	return pImple_->bootstrapFractionError( numberOfTotals+triggerNumber*numberOfSumsPerTrigger+pureIndex, "bootstrapPureFractionError" );
+}
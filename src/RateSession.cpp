@@ -0,0 +1,331 @@
+#include "l1menu/RateSession.h"
+
+#include <vector>
+#include <stdexcept>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <algorithm>
+#include "l1menu/TriggerMenu.h"
+#include "l1menu/ITrigger.h"
+#include "l1menu/ITriggerDescription.h"
+#include "l1menu/ICachedTrigger.h"
+#include "l1menu/ISample.h"
+#include "l1menu/IEvent.h"
+#include "l1menu/ReducedSample.h"
+#include "./implementation/MenuRateImplementation.h"
+#include "./implementation/ColumnScanMenu.h"
+
+namespace l1menu
+{
+	/** @brief Private members for the RateSession class
+	 */
+	class RateSessionPrivateMembers
+	{
+	public:
+		/** @brief The type used to count and identify triggers per event, so limits the number of triggers. */
+		typedef uint16_t TriggerIndex;
+
+		RateSessionPrivateMembers( const l1menu::TriggerMenu& newMenu, const l1menu::ISample& newSample );
+
+		/** @brief Calls the function with the event number and event for every event in the sample, in order. */
+		void forEachEvent( const std::function<void(size_t,const l1menu::IEvent&)>& function ) const;
+		/** @brief Applies the trigger to every event again, and updates the sums for any that changed. */
+		void reapplyTrigger( size_t triggerNumber );
+		/** @brief Updates the bits and sums for an event that now passes or fails the trigger when it didn't before. */
+		void flipEvent( size_t triggerNumber, size_t eventNumber, bool passesNow );
+		std::unique_ptr<l1menu::implementation::MenuRateImplementation> createRate() const;
+
+		l1menu::TriggerMenu menu;
+		const l1menu::ISample& sample;
+		/// Only set if the sample is a ReducedSample, in which case whole blocks of events are compared at once
+		std::unique_ptr<l1menu::implementation::ColumnScanMenu> pColumnScanMenu;
+		size_t numberOfEvents;
+		size_t wordsPerTrigger;
+
+		std::vector<uint64_t> passBits; ///< A row of wordsPerTrigger words for each trigger, one bit per event
+		std::vector<double> weights;
+		std::vector<TriggerIndex> numberOfTriggersPassed; ///< For each event
+		/// For each event, the XOR of the numbers of the triggers passed. So if only one passed this is its number.
+		std::vector<TriggerIndex> triggersPassedXOR;
+
+		double sumOfWeights;
+		double weightOfEventsPassingAnyTrigger;
+		double weightSquaredOfEventsPassingAnyTrigger;
+		std::vector<double> weightOfEventsPassed;
+		std::vector<double> weightSquaredOfEventsPassed;
+		std::vector<double> weightOfEventsPure;
+		std::vector<double> weightSquaredOfEventsPure;
+
+		size_t numberOfEventsChangedByLastUpdate;
+	};
+}
+
+l1menu::RateSessionPrivateMembers::RateSessionPrivateMembers( const l1menu::TriggerMenu& newMenu, const l1menu::ISample& newSample )
+	: menu(newMenu), sample(newSample), numberOfEvents(newSample.numberOfEvents()), wordsPerTrigger((numberOfEvents+63)/64),
+	  passBits(menu.numberOfTriggers()*wordsPerTrigger,0), weights(numberOfEvents), numberOfTriggersPassed(numberOfEvents,0),
+	  triggersPassedXOR(numberOfEvents,0), sumOfWeights(0), weightOfEventsPassingAnyTrigger(0), weightSquaredOfEventsPassingAnyTrigger(0),
+	  weightOfEventsPassed(menu.numberOfTriggers(),0), weightSquaredOfEventsPassed(menu.numberOfTriggers(),0),
+	  weightOfEventsPure(menu.numberOfTriggers(),0), weightSquaredOfEventsPure(menu.numberOfTriggers(),0), numberOfEventsChangedByLastUpdate(0)
+{
+	if( menu.numberOfTriggers()>std::numeric_limits<TriggerIndex>::max() ) throw std::runtime_error( "RateSession can't be used with this many triggers" );
+
+	//
+	// First record the weights and which triggers each event passes
+	//
+	const l1menu::ReducedSample* pReducedSample=dynamic_cast<const l1menu::ReducedSample*>( &sample );
+	if( pReducedSample!=nullptr )
+	{
+		pColumnScanMenu.reset( new l1menu::implementation::ColumnScanMenu( menu, *pReducedSample ) );
+		const float* sampleWeights=pReducedSample->weightColumn();
+		for( size_t eventNumber=0; eventNumber<numberOfEvents; ++eventNumber ) weights[eventNumber]=sampleWeights[eventNumber];
+
+		for( size_t wordIndex=0; wordIndex<wordsPerTrigger; ++wordIndex )
+		{
+			const size_t numberOfEventsInWord=std::min<size_t>( 64, numberOfEvents-wordIndex*64 );
+			for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+			{
+				passBits[triggerNumber*wordsPerTrigger+wordIndex]=pColumnScanMenu->applyTrigger( triggerNumber, wordIndex*64, numberOfEventsInWord );
+			}
+		}
+	}
+	else
+	{
+		std::vector< std::unique_ptr<l1menu::ICachedTrigger> > cachedTriggers;
+		for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+		{
+			cachedTriggers.push_back( sample.createCachedTrigger( menu.getTrigger( triggerNumber ) ) );
+		}
+
+		forEachEvent( [&]( size_t eventNumber, const l1menu::IEvent& event )
+			{
+				weights[eventNumber]=event.weight();
+				for( size_t triggerNumber=0; triggerNumber<cachedTriggers.size(); ++triggerNumber )
+				{
+					if( cachedTriggers[triggerNumber]->apply(event) ) passBits[triggerNumber*wordsPerTrigger+eventNumber/64]|=static_cast<uint64_t>(1)<<(eventNumber%64);
+				}
+			} );
+	}
+
+	//
+	// Then work out the sums from those
+	//
+	for( size_t eventNumber=0; eventNumber<numberOfEvents; ++eventNumber )
+	{
+		const double weight=weights[eventNumber];
+		sumOfWeights+=weight;
+
+		for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+		{
+			if( ( passBits[triggerNumber*wordsPerTrigger+eventNumber/64] & (static_cast<uint64_t>(1)<<(eventNumber%64)) )==0 ) continue;
+
+			++numberOfTriggersPassed[eventNumber];
+			triggersPassedXOR[eventNumber]^=static_cast<TriggerIndex>(triggerNumber);
+			weightOfEventsPassed[triggerNumber]+=weight;
+			weightSquaredOfEventsPassed[triggerNumber]+=weight*weight;
+		}
+
+		if( numberOfTriggersPassed[eventNumber]==1 )
+		{
+			weightOfEventsPure[triggersPassedXOR[eventNumber]]+=weight;
+			weightSquaredOfEventsPure[triggersPassedXOR[eventNumber]]+=weight*weight;
+		}
+		if( numberOfTriggersPassed[eventNumber]>0 )
+		{
+			weightOfEventsPassingAnyTrigger+=weight;
+			weightSquaredOfEventsPassingAnyTrigger+=weight*weight;
+		}
+	}
+}
+
+void l1menu::RateSessionPrivateMembers::forEachEvent( const std::function<void(size_t,const l1menu::IEvent&)>& function ) const
+{
+	// ReducedSample has a quicker way of looping over the events than getEvent
+	const l1menu::ReducedSample* pReducedSample=dynamic_cast<const l1menu::ReducedSample*>( &sample );
+	if( pReducedSample!=nullptr )
+	{
+		size_t eventNumber=0;
+		pReducedSample->forEachEvent( 0, numberOfEvents, [&]( const l1menu::IEvent& event ){ function( eventNumber++, event ); } );
+	}
+	else
+	{
+		for( size_t eventNumber=0; eventNumber<numberOfEvents; ++eventNumber ) function( eventNumber, sample.getEvent(eventNumber) );
+	}
+}
+
+void l1menu::RateSessionPrivateMembers::reapplyTrigger( size_t triggerNumber )
+{
+	uint64_t* triggerBits=&passBits[triggerNumber*wordsPerTrigger];
+
+	if( pColumnScanMenu!=nullptr )
+	{
+		// Compare a whole word of events at a time, and only look at the events that changed
+		pColumnScanMenu->updateTrigger( triggerNumber, menu.getTrigger( triggerNumber ) );
+		for( size_t wordIndex=0; wordIndex<wordsPerTrigger; ++wordIndex )
+		{
+			const size_t numberOfEventsInWord=std::min<size_t>( 64, numberOfEvents-wordIndex*64 );
+			const uint64_t newBits=pColumnScanMenu->applyTrigger( triggerNumber, wordIndex*64, numberOfEventsInWord );
+			for( uint64_t changedBits=newBits^triggerBits[wordIndex]; changedBits!=0; changedBits&=changedBits-1 )
+			{
+				const size_t bitNumber=__builtin_ctzll(changedBits);
+				flipEvent( triggerNumber, wordIndex*64+bitNumber, ( newBits>>bitNumber ) & 1 );
+			}
+		}
+		return;
+	}
+
+	std::unique_ptr<l1menu::ICachedTrigger> pCachedTrigger=sample.createCachedTrigger( menu.getTrigger( triggerNumber ) );
+	forEachEvent( [&]( size_t eventNumber, const l1menu::IEvent& event )
+		{
+			const bool passedBefore=( triggerBits[eventNumber/64] & (static_cast<uint64_t>(1)<<(eventNumber%64)) )!=0;
+			const bool passesNow=pCachedTrigger->apply(event);
+			if( passedBefore!=passesNow ) flipEvent( triggerNumber, eventNumber, passesNow );
+		} );
+}
+
+void l1menu::RateSessionPrivateMembers::flipEvent( size_t triggerNumber, size_t eventNumber, bool passesNow )
+{
+	++numberOfEventsChangedByLastUpdate;
+	passBits[triggerNumber*wordsPerTrigger+eventNumber/64]^=static_cast<uint64_t>(1)<<(eventNumber%64);
+	const TriggerIndex thisTrigger=static_cast<TriggerIndex>(triggerNumber);
+	const double weight=weights[eventNumber];
+	const double weightSquared=weight*weight;
+	TriggerIndex& numberPassed=numberOfTriggersPassed[eventNumber];
+	TriggerIndex& passedXOR=triggersPassedXOR[eventNumber];
+
+	if( passesNow )
+	{
+		weightOfEventsPassed[triggerNumber]+=weight;
+		weightSquaredOfEventsPassed[triggerNumber]+=weightSquared;
+		if( numberPassed==0 )
+		{
+			// Nothing else passed, so this is now the only one
+			weightOfEventsPassingAnyTrigger+=weight;
+			weightSquaredOfEventsPassingAnyTrigger+=weightSquared;
+			weightOfEventsPure[triggerNumber]+=weight;
+			weightSquaredOfEventsPure[triggerNumber]+=weightSquared;
+		}
+		else if( numberPassed==1 )
+		{
+			// The trigger that passed on its own is no longer pure for this event
+			weightOfEventsPure[passedXOR]-=weight;
+			weightSquaredOfEventsPure[passedXOR]-=weightSquared;
+		}
+		++numberPassed;
+		passedXOR^=thisTrigger;
+	}
+	else
+	{
+		weightOfEventsPassed[triggerNumber]-=weight;
+		weightSquaredOfEventsPassed[triggerNumber]-=weightSquared;
+		--numberPassed;
+		passedXOR^=thisTrigger;
+		if( numberPassed==0 )
+		{
+			// This was the only trigger that passed
+			weightOfEventsPassingAnyTrigger-=weight;
+			weightSquaredOfEventsPassingAnyTrigger-=weightSquared;
+			weightOfEventsPure[triggerNumber]-=weight;
+			weightSquaredOfEventsPure[triggerNumber]-=weightSquared;
+		}
+		else if( numberPassed==1 )
+		{
+			// The one left is now pure for this event
+			weightOfEventsPure[passedXOR]+=weight;
+			weightSquaredOfEventsPure[passedXOR]+=weightSquared;
+		}
+	}
+}
+
+std::unique_ptr<l1menu::implementation::MenuRateImplementation> l1menu::RateSessionPrivateMembers::createRate() const
+{
+	std::unique_ptr<l1menu::implementation::MenuRateImplementation> pRate( new l1menu::implementation::MenuRateImplementation );
+	const float scaling=sample.eventRate();
+
+	// Subtracting can leave tiny negative numbers instead of zero, which would give NaN errors
+	auto sqrtOrZero=[]( double value ){ return value>0 ? std::sqrt(value) : 0; };
+
+	for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+	{
+		float fraction=weightOfEventsPassed[triggerNumber]/sumOfWeights;
+		float fractionError=sqrtOrZero(weightSquaredOfEventsPassed[triggerNumber])/sumOfWeights;
+		float pureFraction=weightOfEventsPure[triggerNumber]/sumOfWeights;
+		float pureFractionError=sqrtOrZero(weightSquaredOfEventsPure[triggerNumber])/sumOfWeights;
+		pRate->addTriggerRate( l1menu::implementation::TriggerRateImplementation(menu.getTrigger(triggerNumber),fraction,fractionError,fraction*scaling,fractionError*scaling,pureFraction,pureFractionError,pureFraction*scaling,pureFractionError*scaling) );
+	}
+
+	float totalFraction=weightOfEventsPassingAnyTrigger/sumOfWeights;
+	float totalFractionError=sqrtOrZero(weightSquaredOfEventsPassingAnyTrigger)/sumOfWeights;
+	pRate->setTotalFraction( totalFraction );
+	pRate->setTotalFractionError( totalFractionError );
+	pRate->setTotalRate( totalFraction*scaling );
+	pRate->setTotalRateError( totalFractionError*scaling );
+
+	return pRate;
+}
+
+l1menu::RateSession::RateSession( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample )
+	: pImple_( new l1menu::RateSessionPrivateMembers( menu, sample ) )
+{
+	// No operation besides the initialiser list
+}
+
+l1menu::RateSession::~RateSession()
+{
+	// No operation. Just need one defined otherwise the default one messes up
+	// the unique_ptr deletion because RateSessionPrivateMembers isn't
+	// defined elsewhere.
+}
+
+const l1menu::TriggerMenu& l1menu::RateSession::menu() const
+{
+	return pImple_->menu;
+}
+
+void l1menu::RateSession::setParameter( size_t triggerNumber, const std::string& parameterName, float value )
+{
+	float& parameter=pImple_->menu.getTrigger( triggerNumber ).parameter( parameterName );
+	pImple_->numberOfEventsChangedByLastUpdate=0;
+	if( parameter==value ) return;
+	parameter=value;
+	pImple_->reapplyTrigger( triggerNumber );
+}
+
+void l1menu::RateSession::setTrigger( size_t triggerNumber, const l1menu::ITriggerDescription& trigger )
+{
+	l1menu::ITrigger& triggerInMenu=pImple_->menu.getTrigger( triggerNumber );
+	if( trigger.name()!=triggerInMenu.name() || trigger.version()!=triggerInMenu.version() )
+	{
+		throw std::runtime_error( "RateSession::setTrigger - trigger "+trigger.name()+" is not the same as the one in the menu ("+triggerInMenu.name()+")" );
+	}
+
+	bool anythingChanged=false;
+	for( const auto& parameterName : triggerInMenu.parameterNames() )
+	{
+		float& parameter=triggerInMenu.parameter( parameterName );
+		if( parameter==trigger.parameter( parameterName ) ) continue;
+		parameter=trigger.parameter( parameterName );
+		anythingChanged=true;
+	}
+
+	pImple_->numberOfEventsChangedByLastUpdate=0;
+	if( anythingChanged ) pImple_->reapplyTrigger( triggerNumber );
+}
+
+size_t l1menu::RateSession::numberOfEventsChangedByLastUpdate() const
+{
+	return pImple_->numberOfEventsChangedByLastUpdate;
+}
+
+std::shared_ptr<const l1menu::IMenuRate> l1menu::RateSession::rate() const
+{
+	return std::shared_ptr<const l1menu::IMenuRate>( pImple_->createRate().release() );
+}
+
+std::shared_ptr<const l1menu::IMenuRate> l1menu::RateSession::rate( const l1menu::MenuRatePlots& ratePlots ) const
+{
+	std::unique_ptr<l1menu::implementation::MenuRateImplementation> pRate=pImple_->createRate();
+	pRate->setThresholdErrors( ratePlots );
+	return std::shared_ptr<const l1menu::IMenuRate>( pRate.release() );
+}
@@ -39,6 +39,16 @@ float l1menu::ReducedEvent::weight() const
 	else return 1;
 }
 
+unsigned int l1menu::ReducedEvent::run() const
+{
+	return pProtobufEvent_->run();
+}
+
+unsigned int l1menu::ReducedEvent::lumiSection() const
+{
+	return pProtobufEvent_->lumi_section();
+}
+
 const l1menu::ISample& l1menu::ReducedEvent::sample() const
 {
 	return sample_;
@@ -6,6 +6,9 @@
 #include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <mutex>
+#include <cmath>
+#include <limits>
 #include "l1menu/ReducedEvent.h"
 #include "l1menu/FullSample.h"
 #include "l1menu/TriggerMenu.h"
@@ -15,6 +18,7 @@
 #include "l1menu/IEvent.h"
 #include "l1menu/IMenuRate.h"
 #include "l1menu/ITriggerRate.h"
+#include "l1menu/MenuRateSums.h"
 #include "l1menu/tools/miscellaneous.h"
 #include "./implementation/MenuRateImplementation.h"
 #include "protobuf/l1menu.pb.h"
@@ -74,6 +78,46 @@ namespace // unnamed namespace
 		std::vector< std::pair<l1menu::ReducedEvent::ParameterID,const float*> > identifiers_;
 	}; // end of class ReducedSampleCachedTrigger
 
+	/** @brief The values of one parameter for every event sorted in ascending order, with the sum of the
+	 * weights (and weights squared) of all the events from each position to the end.
+	 *
+	 * sumOfWeightsFrom has one more entry than sortedValues, with the last being zero. NaN is stored as
+	 * infinity, since it passes every threshold.
+	 */
+	struct ThresholdIndex
+	{
+		std::vector<float> sortedValues;
+		std::vector<double> sumOfWeightsFrom;
+		std::vector<double> sumOfWeightsSquaredFrom;
+		/** @brief The position of the first value that passes the threshold. */
+		size_t firstPassing( float threshold ) const
+		{
+			return std::lower_bound( sortedValues.begin(), sortedValues.end(), threshold )-sortedValues.begin();
+		}
+	};
+
+	/** @brief Copies of the weights, runs and lumi sections of every event, one contiguous column each.
+	 */
+	struct EventColumns
+	{
+		std::vector<float> weights;
+		std::vector< std::vector<float> > namedWeights; ///< In the order of weight_name in the sample header
+		std::vector<unsigned int> runs; ///< Zero where the event doesn't know its run
+		std::vector<unsigned int> lumiSections;
+	};
+
+	/** @brief A copy of one parameter for every event, with the lowest and highest value in each zone.
+	 *
+	 * Only made for parameters that are asked for, which is normally just the ones in the menu being
+	 * scanned, so that the whole sample isn't held twice.
+	 */
+	struct ParameterColumn
+	{
+		std::vector<float> values;
+		std::vector<float> zoneMinima;
+		std::vector<float> zoneMaxima;
+	};
+
 	float sumWeights( const l1menuprotobuf::Run& run )
 	{
 		float returnValue=0;
@@ -108,11 +152,32 @@ namespace l1menu
 		l1menuprotobuf::SampleHeader protobufSampleHeader;
 		// Protobuf doesn't implement move semantics so I'll use pointers
 		std::vector<std::unique_ptr<l1menuprotobuf::Run> > protobufRuns;
+		/// Indices made by thresholdIndex(), cleared whenever events are added.
+		std::map<l1menu::ReducedEvent::ParameterID,std::unique_ptr<const ::ThresholdIndex> > thresholdIndices;
+		std::mutex thresholdIndicesMutex;
+		/** @brief Returns the index for the parameter, making it first if required. Safe to call from several threads. */
+		const ::ThresholdIndex& thresholdIndex( const l1menu::ReducedSample& sample, l1menu::ReducedEvent::ParameterID parameterID );
+		/// Made by eventColumns(), and reset whenever events are added.
+		std::unique_ptr<const ::EventColumns> pEventColumns;
+		std::mutex eventColumnsMutex;
+		/** @brief Returns the columns, making them first if required. Safe to call from several threads. */
+		const ::EventColumns& eventColumns();
+		/// Made by parameterColumn(), and cleared whenever events are added.
+		std::map<l1menu::ReducedEvent::ParameterID,std::unique_ptr<const ::ParameterColumn> > parameterColumns;
+		std::mutex parameterColumnsMutex;
+		/** @brief Returns the column for the parameter, making it first if required. Returns nullptr if the sample
+		 * is empty, and throws a std::runtime_error if the parameter isn't valid. Safe to call from several threads. */
+		const ::ParameterColumn* parameterColumn( l1menu::ReducedEvent::ParameterID parameterID, const std::string& caller );
+		/** @brief The position of the named weight in each event, or throws a std::runtime_error if there isn't one. */
+		size_t weightIndex( const std::string& weightName, const std::string& caller ) const;
+		/** @brief Clears anything made from the events, for when events are added. */
+		void clearCaches();
 		const static int EVENTS_PER_RUN;
 		const static char PROTOBUF_MESSAGE_DELIMETER;
 		const static std::string FILE_FORMAT_MAGIC_NUMBER;
 	};
 
+	const size_t ReducedSample::eventsPerZone;
 	const int ReducedSamplePrivateMembers::EVENTS_PER_RUN=20000;
 	const char ReducedSamplePrivateMembers::PROTOBUF_MESSAGE_DELIMETER='\n';
 	const std::string ReducedSamplePrivateMembers::FILE_FORMAT_MAGIC_NUMBER="l1menuReducedSample";
@@ -264,6 +329,148 @@ l1menu::ReducedSamplePrivateMembers::ReducedSamplePrivateMembers( const l1menu::
 
 }
 
+const ::ThresholdIndex& l1menu::ReducedSamplePrivateMembers::thresholdIndex( const l1menu::ReducedSample& sample, l1menu::ReducedEvent::ParameterID parameterID )
+{
+	std::lock_guard<std::mutex> lock( thresholdIndicesMutex );
+
+	auto iFoundIndex=thresholdIndices.find( parameterID );
+	if( iFoundIndex!=thresholdIndices.end() ) return *iFoundIndex->second;
+
+	// Every event has the same number of parameters, so check against the first one
+	if( !protobufRuns.empty() && protobufRuns.front()->event_size()>0 && parameterID>=static_cast<size_t>(protobufRuns.front()->event(0).threshold_size()) )
+	{
+		throw std::runtime_error( "ReducedSample::thresholdIndex - the parameter ID is not valid for this sample" );
+	}
+
+	// NaN passes any threshold, so count it as the highest possible value like the zone maps do. It
+	// can't be sorted as it is anyway, since it isn't ordered with respect to anything.
+	std::vector< std::pair<float,float> > valuesAndWeights;
+	valuesAndWeights.reserve( sample.numberOfEvents() );
+	sample.forEachEvent( 0, sample.numberOfEvents(), [&]( const l1menu::IEvent& event )
+	{
+		const l1menu::ReducedEvent& reducedEvent=static_cast<const l1menu::ReducedEvent&>(event);
+		const float value=reducedEvent.parameterValue(parameterID);
+		valuesAndWeights.push_back( std::make_pair( std::isnan(value) ? std::numeric_limits<float>::infinity() : value, reducedEvent.weight() ) );
+	} );
+	std::sort( valuesAndWeights.begin(), valuesAndWeights.end() );
+
+	std::unique_ptr< ::ThresholdIndex > pNewIndex( new ::ThresholdIndex );
+	pNewIndex->sortedValues.resize( valuesAndWeights.size() );
+	pNewIndex->sumOfWeightsFrom.resize( valuesAndWeights.size()+1 );
+	pNewIndex->sumOfWeightsSquaredFrom.resize( valuesAndWeights.size()+1 );
+	pNewIndex->sumOfWeightsFrom.back()=0;
+	pNewIndex->sumOfWeightsSquaredFrom.back()=0;
+	for( size_t index=valuesAndWeights.size(); index>0; --index )
+	{
+		const auto& valueAndWeight=valuesAndWeights[index-1];
+		pNewIndex->sortedValues[index-1]=valueAndWeight.first;
+		pNewIndex->sumOfWeightsFrom[index-1]=pNewIndex->sumOfWeightsFrom[index]+valueAndWeight.second;
+		pNewIndex->sumOfWeightsSquaredFrom[index-1]=pNewIndex->sumOfWeightsSquaredFrom[index]+valueAndWeight.second*valueAndWeight.second;
+	}
+
+	const ::ThresholdIndex& newIndex=*pNewIndex;
+	thresholdIndices[parameterID]=std::move(pNewIndex);
+	return newIndex;
+}
+
+const ::EventColumns& l1menu::ReducedSamplePrivateMembers::eventColumns()
+{
+	std::lock_guard<std::mutex> lock( eventColumnsMutex );
+	if( pEventColumns!=nullptr ) return *pEventColumns;
+
+	size_t numberOfEvents=0;
+	for( const auto& pRun : protobufRuns ) numberOfEvents+=pRun->event_size();
+
+	std::unique_ptr< ::EventColumns > pNewColumns( new ::EventColumns );
+	pNewColumns->weights.resize( numberOfEvents );
+	pNewColumns->namedWeights.resize( protobufSampleHeader.weight_name_size(), std::vector<float>(numberOfEvents) );
+	pNewColumns->runs.resize( numberOfEvents );
+	pNewColumns->lumiSections.resize( numberOfEvents );
+
+	size_t eventNumber=0;
+	for( const auto& pRun : protobufRuns )
+	{
+		for( const auto& event : pRun->event() )
+		{
+			pNewColumns->weights[eventNumber]=( event.has_weight() ? event.weight() : 1 );
+			for( size_t weightIndex=0; weightIndex<pNewColumns->namedWeights.size(); ++weightIndex )
+			{
+				pNewColumns->namedWeights[weightIndex][eventNumber]=event.named_weight(weightIndex);
+			}
+			pNewColumns->runs[eventNumber]=event.run();
+			pNewColumns->lumiSections[eventNumber]=event.lumi_section();
+			++eventNumber;
+		}
+	}
+
+	pEventColumns=std::move(pNewColumns);
+	return *pEventColumns;
+}
+
+const ::ParameterColumn* l1menu::ReducedSamplePrivateMembers::parameterColumn( l1menu::ReducedEvent::ParameterID parameterID, const std::string& caller )
+{
+	std::lock_guard<std::mutex> lock( parameterColumnsMutex );
+
+	auto iFoundColumn=parameterColumns.find( parameterID );
+	if( iFoundColumn!=parameterColumns.end() ) return iFoundColumn->second.get();
+
+	size_t numberOfEvents=0;
+	for( const auto& pRun : protobufRuns ) numberOfEvents+=pRun->event_size();
+	// An empty sample doesn't know how many parameters there are, but there's nothing to read either.
+	// Every event has the same number of parameters, so check against the first one.
+	if( numberOfEvents==0 ) return nullptr;
+	const l1menuprotobuf::Run& firstRun=**std::find_if( protobufRuns.begin(), protobufRuns.end(), []( const std::unique_ptr<l1menuprotobuf::Run>& pRun ){ return pRun->event_size()>0; } );
+	if( parameterID>=static_cast<size_t>(firstRun.event(0).threshold_size()) ) throw std::runtime_error( "ReducedSample::"+caller+" - the parameter ID is not valid for this sample" );
+
+	std::unique_ptr< ::ParameterColumn > pNewColumn( new ::ParameterColumn );
+	std::vector<float>& column=pNewColumn->values;
+	column.reserve( numberOfEvents );
+	for( const auto& pRun : protobufRuns )
+	{
+		for( const auto& event : pRun->event() ) column.push_back( event.threshold(parameterID) );
+	}
+
+	// Summarise each zone of events so that scans can skip them. NaN passes any threshold so
+	// count it as the highest possible value.
+	const size_t numberOfZones=(numberOfEvents+l1menu::ReducedSample::eventsPerZone-1)/l1menu::ReducedSample::eventsPerZone;
+	pNewColumn->zoneMinima.resize( numberOfZones );
+	pNewColumn->zoneMaxima.resize( numberOfZones );
+	for( size_t zone=0; zone<numberOfZones; ++zone )
+	{
+		float minimum=std::numeric_limits<float>::infinity();
+		float maximum=-std::numeric_limits<float>::infinity();
+		const size_t endOfZone=std::min( numberOfEvents, (zone+1)*l1menu::ReducedSample::eventsPerZone );
+		for( size_t eventNumber=zone*l1menu::ReducedSample::eventsPerZone; eventNumber<endOfZone; ++eventNumber )
+		{
+			const float value=( std::isnan(column[eventNumber]) ? std::numeric_limits<float>::infinity() : column[eventNumber] );
+			minimum=std::min( minimum, value );
+			maximum=std::max( maximum, value );
+		}
+		pNewColumn->zoneMinima[zone]=minimum;
+		pNewColumn->zoneMaxima[zone]=maximum;
+	}
+
+	const ::ParameterColumn* pColumn=pNewColumn.get();
+	parameterColumns[parameterID]=std::move(pNewColumn);
+	return pColumn;
+}
+
+size_t l1menu::ReducedSamplePrivateMembers::weightIndex( const std::string& weightName, const std::string& caller ) const
+{
+	for( int index=0; index<protobufSampleHeader.weight_name_size(); ++index )
+	{
+		if( protobufSampleHeader.weight_name(index)==weightName ) return index;
+	}
+	throw std::runtime_error( "ReducedSample::"+caller+" - there is no weight called \""+weightName+"\"" );
+}
+
+void l1menu::ReducedSamplePrivateMembers::clearCaches()
+{
+	thresholdIndices.clear();
+	pEventColumns.reset();
+	parameterColumns.clear();
+}
+
 l1menu::ReducedSample::ReducedSample( const l1menu::FullSample& originalSample, const l1menu::TriggerMenu& triggerMenu )
 	: pImple_( new l1menu::ReducedSamplePrivateMembers( *this, triggerMenu ) )
 {
@@ -292,9 +499,38 @@ l1menu::ReducedSample::~ReducedSample()
 
 void l1menu::ReducedSample::addSample( const l1menu::FullSample& originalSample )
 {
+	addSample( originalSample, 0, originalSample.numberOfEvents() );
+}
+
+void l1menu::ReducedSample::addSample( const l1menu::FullSample& originalSample, size_t firstEvent, size_t numberOfEvents )
+{
+	if( pImple_->protobufSampleHeader.weight_name_size()>0 ) throw std::runtime_error( "ReducedSample::addSample - cannot add events from a FullSample to a sample with named weights" );
+
 	l1menuprotobuf::Run* pCurrentRun=pImple_->protobufRuns.back().get();
+	pImple_->clearCaches();
+
+	// Truncate the range if it goes off the end of the sample. Written this way
+	// so that a very large numberOfEvents doesn't overflow.
+	size_t endEvent=originalSample.numberOfEvents();
+	if( firstEvent>endEvent ) firstEvent=endEvent;
+	if( numberOfEvents<endEvent-firstEvent ) endEvent=firstEvent+numberOfEvents;
+
+	// Copying triggers and looking up parameters by name is slow, so do it once before
+	// the event loop. setTriggerThresholdsAsTightAsPossible() modifies the thresholds (and
+	// uses their ratios if they're correlated) so keep the original values to reset them
+	// before each event.
+	std::vector< std::unique_ptr<l1menu::ITrigger> > triggers;
+	std::vector< std::vector<l1menu::ITrigger::ParameterHandle> > thresholdHandles;
+	std::vector< std::vector<float> > originalThresholds;
+	for( size_t triggerNumber=0; triggerNumber<pImple_->triggerMenu.numberOfTriggers(); ++triggerNumber )
+	{
+		triggers.push_back( pImple_->triggerMenu.getTriggerCopy(triggerNumber) );
+		thresholdHandles.push_back( l1menu::tools::getThresholdHandles(*triggers.back()) );
+		originalThresholds.push_back( std::vector<float>() );
+		for( const auto& handle : thresholdHandles.back() ) originalThresholds.back().push_back( triggers.back()->parameter(handle) );
+	}
 
-	for( size_t eventNumber=0; eventNumber<originalSample.numberOfEvents(); ++eventNumber )
+	for( size_t eventNumber=firstEvent; eventNumber<endEvent; ++eventNumber )
 	{
 		if(eventNumber%100==0)  std::cout<<"Event Number..." << eventNumber << "\r" << std::flush; 
 		// Split the events up into groups in arbitrary numbers. This is to get around
@@ -311,28 +547,31 @@ void l1menu::ReducedSample::addSample( const l1menu::FullSample& originalSample
 		const l1menu::L1TriggerDPGEvent& event=originalSample.getFullEvent( eventNumber );
 		l1menuprotobuf::Event* pProtobufEvent=pCurrentRun->add_event();
 		if( event.weight()!=1 ) pProtobufEvent->set_weight( event.weight() );
+		if( event.run()!=0 ) pProtobufEvent->set_run( event.run() );
+		if( event.lumiSection()!=0 ) pProtobufEvent->set_lumi_section( event.lumiSection() );
 
 		// Loop over all of the triggers
-		for( size_t triggerNumber=0; triggerNumber<pImple_->triggerMenu.numberOfTriggers(); ++triggerNumber )
+		for( size_t triggerNumber=0; triggerNumber<triggers.size(); ++triggerNumber )
 		{
-			std::unique_ptr<l1menu::ITrigger> pTrigger=pImple_->triggerMenu.getTriggerCopy(triggerNumber);
-			std::vector<std::string> thresholdNames=l1menu::tools::getThresholdNames(*pTrigger);
+			l1menu::ITrigger& trigger=*triggers[triggerNumber];
+			const auto& handles=thresholdHandles[triggerNumber];
+			for( size_t index=0; index<handles.size(); ++index ) trigger.parameter(handles[index])=originalThresholds[triggerNumber][index];
 
 			try
 			{
-				l1menu::tools::setTriggerThresholdsAsTightAsPossible( event, *pTrigger, 0.001 );
+				l1menu::tools::setTriggerThresholdsAsTightAsPossible( event, trigger, 0.001 );
 				// Set all of the parameters to match the thresholds in the trigger
-				for( const auto& thresholdName : thresholdNames )
+				for( const auto& handle : handles )
 				{
-					pProtobufEvent->add_threshold( pTrigger->parameter(thresholdName) );
+					pProtobufEvent->add_threshold( trigger.parameter(handle) );
 				}
 			}
 			catch( std::exception& error )
 			{
 				// setTriggerThresholdsAsTightAsPossible() couldn't find thresholds so record
 				// -1 for everything.
-				// Range based for loop gives me a warning because I don't use the thresholdName.
-				for( size_t index=0; index<thresholdNames.size(); ++index ) pProtobufEvent->add_threshold(-1);
+				// Range based for loop gives me a warning because I don't use the handle.
+				for( size_t index=0; index<handles.size(); ++index ) pProtobufEvent->add_threshold(-1);
 			} // end of try block that sets the trigger thresholds
 
 		} // end of loop over triggers
@@ -341,6 +580,57 @@ void l1menu::ReducedSample::addSample( const l1menu::FullSample& originalSample
 	} // end of loop over events
 }
 
+void l1menu::ReducedSample::addSample( const l1menu::ReducedSample& otherSample )
+{
+	// The thresholds in each event are stored in the order given by the header, so if the
+	// headers are identical the events can be copied straight across.
+	if( otherSample.pImple_->protobufSampleHeader.SerializeAsString()!=pImple_->protobufSampleHeader.SerializeAsString() )
+	{
+		throw std::runtime_error( "ReducedSample::addSample - cannot add a ReducedSample that was made with a different menu" );
+	}
+
+	l1menuprotobuf::Run* pCurrentRun=pImple_->protobufRuns.back().get();
+	pImple_->clearCaches();
+
+	for( const auto& pOtherRun : otherSample.pImple_->protobufRuns )
+	{
+		for( const auto& otherEvent : pOtherRun->event() )
+		{
+			// Keep to the same arbitrary limit of events per run as addSample( FullSample ).
+			if( pCurrentRun->event_size() >= pImple_->EVENTS_PER_RUN )
+			{
+				std::unique_ptr<l1menuprotobuf::Run> pNewRun( new l1menuprotobuf::Run );
+				pImple_->protobufRuns.push_back( std::move( pNewRun ) );
+				pCurrentRun=pImple_->protobufRuns.back().get();
+			}
+			pCurrentRun->add_event()->CopyFrom( otherEvent );
+		}
+	}
+
+	pImple_->sumOfWeights+=otherSample.pImple_->sumOfWeights;
+}
+
+void l1menu::ReducedSample::addWeightColumn( const std::string& weightName, const std::vector<float>& weights )
+{
+	if( weightName.empty() ) throw std::runtime_error( "ReducedSample::addWeightColumn - the weight name is empty" );
+	if( weights.size()!=numberOfEvents() ) throw std::runtime_error( "ReducedSample::addWeightColumn - the number of weights for \""+weightName+"\" is not the same as the number of events" );
+	const std::vector<std::string> existingNames=weightNames();
+	if( std::find( existingNames.begin(), existingNames.end(), weightName )!=existingNames.end() ) throw std::runtime_error( "ReducedSample::addWeightColumn - there is already a weight called \""+weightName+"\"" );
+
+	pImple_->clearCaches();
+	pImple_->protobufSampleHeader.add_weight_name( weightName );
+	size_t eventNumber=0;
+	for( auto& pRun : pImple_->protobufRuns )
+	{
+		for( int index=0; index<pRun->event_size(); ++index ) pRun->mutable_event(index)->add_named_weight( weights[eventNumber++] );
+	}
+}
+
+std::vector<std::string> l1menu::ReducedSample::weightNames() const
+{
+	return std::vector<std::string>( pImple_->protobufSampleHeader.weight_name().begin(), pImple_->protobufSampleHeader.weight_name().end() );
+}
+
 void l1menu::ReducedSample::saveToFile( const std::string& filename ) const
 {
 	// Open the file. Parameters are filename, write ability and create, rw-r--r-- permissions.
@@ -388,6 +678,111 @@ size_t l1menu::ReducedSample::numberOfEvents() const
 	return numberOfEvents;
 }
 
+void l1menu::ReducedSample::forEachEvent( size_t firstEvent, size_t numberOfEvents, const std::function<void(const l1menu::IEvent&)>& function ) const
+{
+	l1menu::ReducedEvent event( *this );
+
+	// Find the run the first event is in, and then just carry on from there
+	size_t eventNumberInRun=firstEvent;
+	auto iRun=pImple_->protobufRuns.begin();
+	while( iRun!=pImple_->protobufRuns.end() && eventNumberInRun>=static_cast<size_t>((*iRun)->event_size()) )
+	{
+		eventNumberInRun-=(*iRun)->event_size();
+		++iRun;
+	}
+
+	for( ; iRun!=pImple_->protobufRuns.end() && numberOfEvents>0; ++iRun, eventNumberInRun=0 )
+	{
+		for( ; eventNumberInRun<static_cast<size_t>((*iRun)->event_size()) && numberOfEvents>0; ++eventNumberInRun, --numberOfEvents )
+		{
+			event.pProtobufEvent_=(*iRun)->mutable_event(eventNumberInRun);
+			function( event );
+		}
+	}
+}
+
+double l1menu::ReducedSample::sumOfWeightsPassing( ReducedEvent::ParameterID parameterID, float threshold ) const
+{
+	const ::ThresholdIndex& index=pImple_->thresholdIndex( *this, parameterID );
+	return index.sumOfWeightsFrom[index.firstPassing(threshold)];
+}
+
+double l1menu::ReducedSample::sumOfWeightsSquaredPassing( ReducedEvent::ParameterID parameterID, float threshold ) const
+{
+	const ::ThresholdIndex& index=pImple_->thresholdIndex( *this, parameterID );
+	return index.sumOfWeightsSquaredFrom[index.firstPassing(threshold)];
+}
+
+float l1menu::ReducedSample::thresholdForSumOfWeights( ReducedEvent::ParameterID parameterID, double targetSumOfWeights ) const
+{
+	const ::ThresholdIndex& index=pImple_->thresholdIndex( *this, parameterID );
+	const std::vector<float>& values=index.sortedValues;
+	if( values.empty() ) return 0;
+
+	// sumOfWeightsFrom never increases, so find the first position where it's within the target.
+	// The last entry is zero so that will do if nothing else does.
+	size_t position=std::partition_point( index.sumOfWeightsFrom.begin(), index.sumOfWeightsFrom.end(),
+			[targetSumOfWeights]( double sum ){ return sum>targetSumOfWeights; } )-index.sumOfWeightsFrom.begin();
+
+	// Setting the threshold to a value lets through every event with the same value, so if this
+	// position is part way through a run of equal values the next distinct value is needed.
+	if( position>0 && position<values.size() && values[position]==values[position-1] )
+	{
+		position=std::upper_bound( values.begin(), values.end(), values[position] )-values.begin();
+	}
+
+	if( position<values.size() ) return values[position];
+	else return std::nextafter( values.back(), std::numeric_limits<float>::infinity() );
+}
+
+const float* l1menu::ReducedSample::parameterColumn( ReducedEvent::ParameterID parameterID ) const
+{
+	const ::ParameterColumn* pColumn=pImple_->parameterColumn( parameterID, "parameterColumn" );
+	return ( pColumn==nullptr ? nullptr : pColumn->values.data() );
+}
+
+const float* l1menu::ReducedSample::parameterZoneMinima( ReducedEvent::ParameterID parameterID ) const
+{
+	const ::ParameterColumn* pColumn=pImple_->parameterColumn( parameterID, "parameterZoneMinima" );
+	return ( pColumn==nullptr ? nullptr : pColumn->zoneMinima.data() );
+}
+
+const float* l1menu::ReducedSample::parameterZoneMaxima( ReducedEvent::ParameterID parameterID ) const
+{
+	const ::ParameterColumn* pColumn=pImple_->parameterColumn( parameterID, "parameterZoneMaxima" );
+	return ( pColumn==nullptr ? nullptr : pColumn->zoneMaxima.data() );
+}
+
+const float* l1menu::ReducedSample::weightColumn() const
+{
+	return pImple_->eventColumns().weights.data();
+}
+
+const float* l1menu::ReducedSample::weightColumn( const std::string& weightName ) const
+{
+	const size_t weightIndex=pImple_->weightIndex( weightName, "weightColumn" );
+	return pImple_->eventColumns().namedWeights[weightIndex].data();
+}
+
+const unsigned int* l1menu::ReducedSample::runColumn() const
+{
+	return pImple_->eventColumns().runs.data();
+}
+
+const unsigned int* l1menu::ReducedSample::lumiSectionColumn() const
+{
+	return pImple_->eventColumns().lumiSections.data();
+}
+
+float l1menu::ReducedSample::sumOfWeights( const std::string& weightName ) const
+{
+	const size_t weightIndex=pImple_->weightIndex( weightName, "sumOfWeights" );
+	const std::vector<float>& weights=pImple_->eventColumns().namedWeights[weightIndex];
+	double sum=0;
+	for( const auto weight : weights ) sum+=weight;
+	return sum;
+}
+
 const l1menu::TriggerMenu& l1menu::ReducedSample::getTriggerMenu() const
 {
 	return pImple_->triggerMenu;
@@ -541,3 +936,23 @@ std::shared_ptr<const l1menu::IMenuRate> l1menu::ReducedSample::rate( const l1me
 	// TODO make sure the TriggerMenu is valid for this sample
 	return std::shared_ptr<const l1menu::IMenuRate>( new l1menu::implementation::MenuRateImplementation( menu, *this, ratePlots ) );
 }
+
+std::vector< std::shared_ptr<const l1menu::IMenuRate> > l1menu::ReducedSample::rates( const std::vector<l1menu::TriggerMenu>& menus ) const
+{
+	std::vector< std::shared_ptr<const l1menu::IMenuRate> > menuRates;
+	for( const auto& menuRateSums : l1menu::MenuRateSums::forEachMenu( menus, *this ) ) menuRates.push_back( menuRateSums.rate() );
+	return menuRates;
+}
+
+std::shared_ptr<const l1menu::IMenuRate> l1menu::ReducedSample::progressiveRate( const l1menu::TriggerMenu& menu, const std::function<bool(const l1menu::IMenuRate&)>& progressCallback, float relativeErrorTolerance ) const
+{
+	auto sumsCallback=[&]( const l1menu::MenuRateSums& sumsSoFar ){ return !progressCallback || progressCallback( *sumsSoFar.rate() ); };
+	return l1menu::MenuRateSums::progressive( menu, *this, sumsCallback, relativeErrorTolerance ).rate();
+}
+
+std::vector< std::shared_ptr<const l1menu::IMenuRate> > l1menu::ReducedSample::rateForEachWeight( const l1menu::TriggerMenu& menu ) const
+{
+	std::vector< std::shared_ptr<const l1menu::IMenuRate> > rates;
+	for( const auto& menuRateSums : l1menu::MenuRateSums::forEachWeight( menu, *this ) ) rates.push_back( menuRateSums.rate() );
+	return rates;
+}
@@ -0,0 +1,155 @@
+#include "l1menu/SampleRange.h"
+
+#include <stdexcept>
+#include <vector>
+#include "l1menu/IEvent.h"
+#include "l1menu/ICachedTrigger.h"
+#include "l1menu/MenuRateSums.h"
+#include "l1menu/tools/stringManipulation.h"
+#include "./implementation/MenuRateImplementation.h"
+
+namespace l1menu
+{
+	/** @brief Private members for the SampleRange class
+	 */
+	class SampleRangePrivateMembers
+	{
+	public:
+		SampleRangePrivateMembers( const l1menu::ISample& newSample, size_t newFirstEvent, size_t newNumberOfEvents );
+		const l1menu::ISample& sample;
+		size_t firstEvent;
+		size_t numberOfEvents;
+		float eventRate;
+		float sumOfWeights; ///< Calculated lazily, -1 until then.
+	};
+}
+
+l1menu::SampleRangePrivateMembers::SampleRangePrivateMembers( const l1menu::ISample& newSample, size_t newFirstEvent, size_t newNumberOfEvents )
+	: sample(newSample), firstEvent(newFirstEvent), numberOfEvents(0), eventRate(newSample.eventRate()), sumOfWeights(-1)
+{
+	size_t totalEvents=sample.numberOfEvents();
+	if( firstEvent>totalEvents ) firstEvent=totalEvents;
+	// Truncate the range if it goes off the end of the sample. Written this way so that
+	// a numberOfEvents of std::numeric_limits<size_t>::max() doesn't overflow.
+	if( newNumberOfEvents>totalEvents-firstEvent ) numberOfEvents=totalEvents-firstEvent;
+	else numberOfEvents=newNumberOfEvents;
+}
+
+l1menu::SampleRange::SampleRange( const l1menu::ISample& sample, size_t firstEvent, size_t numberOfEvents )
+	: pImple_( new l1menu::SampleRangePrivateMembers( sample, firstEvent, numberOfEvents ) )
+{
+	// No operation besides the initialiser list
+}
+
+l1menu::SampleRange::~SampleRange()
+{
+	// No operation. Just need one defined otherwise the default one messes up
+	// the unique_ptr deletion because SampleRangePrivateMembers isn't
+	// defined elsewhere.
+}
+
+size_t l1menu::SampleRange::firstEvent() const
+{
+	return pImple_->firstEvent;
+}
+
+const l1menu::ISample& l1menu::SampleRange::underlyingSample() const
+{
+	return pImple_->sample;
+}
+
+std::pair<size_t,size_t> l1menu::SampleRange::shardRange( size_t shardNumber, size_t numberOfShards, size_t totalEvents )
+{
+	if( numberOfShards==0 ) throw std::runtime_error( "SampleRange::shardRange - the number of shards cannot be zero" );
+	if( shardNumber>=numberOfShards ) throw std::runtime_error( "SampleRange::shardRange - the shard number must be less than the number of shards" );
+
+	// Spread the remainder over the first few shards so that no two shards differ
+	// by more than one event.
+	size_t eventsPerShard=totalEvents/numberOfShards;
+	size_t remainder=totalEvents%numberOfShards;
+
+	size_t firstEvent=shardNumber*eventsPerShard+( shardNumber<remainder ? shardNumber : remainder );
+	size_t numberOfEvents=eventsPerShard+( shardNumber<remainder ? 1 : 0 );
+
+	return std::make_pair( firstEvent, numberOfEvents );
+}
+
+std::pair<size_t,size_t> l1menu::SampleRange::parseShardSpecification( const std::string& shardSpecification )
+{
+	std::vector<std::string> parts=l1menu::tools::splitByDelimeters( shardSpecification, "/" );
+	if( parts.size()!=2 ) throw std::runtime_error( "The shard specification \""+shardSpecification+"\" is not of the form \"<shard number>/<number of shards>\"" );
+
+	size_t shardNumber=l1menu::tools::convertStringToSize( parts[0] );
+	size_t numberOfShards=l1menu::tools::convertStringToSize( parts[1] );
+	if( numberOfShards==0 || shardNumber>=numberOfShards ) throw std::runtime_error( "The shard specification \""+shardSpecification+"\" is invalid. The shard number should count from zero and be less than the number of shards." );
+
+	return std::make_pair( shardNumber, numberOfShards );
+}
+
+size_t l1menu::SampleRange::numberOfEvents() const
+{
+	return pImple_->numberOfEvents;
+}
+
+const l1menu::IEvent& l1menu::SampleRange::getEvent( size_t eventNumber ) const
+{
+	if( eventNumber>=pImple_->numberOfEvents ) throw std::runtime_error( "SampleRange::getEvent - requested event number is out of range" );
+	return pImple_->sample.getEvent( pImple_->firstEvent+eventNumber );
+}
+
+std::unique_ptr<l1menu::ICachedTrigger> l1menu::SampleRange::createCachedTrigger( const l1menu::ITrigger& trigger ) const
+{
+	// The events are the underlying sample's events, so its cached triggers work unchanged.
+	return pImple_->sample.createCachedTrigger( trigger );
+}
+
+float l1menu::SampleRange::eventRate() const
+{
+	return pImple_->eventRate;
+}
+
+void l1menu::SampleRange::setEventRate( float rate )
+{
+	pImple_->eventRate=rate;
+}
+
+float l1menu::SampleRange::sumOfWeights() const
+{
+	if( pImple_->sumOfWeights==-1 )
+	{
+		// If the range covers the whole sample then the underlying sample might have
+		// a quicker way of getting the sum.
+		if( pImple_->firstEvent==0 && pImple_->numberOfEvents==pImple_->sample.numberOfEvents() ) return pImple_->sumOfWeights=pImple_->sample.sumOfWeights();
+
+		pImple_->sumOfWeights=0;
+		for( size_t eventNumber=0; eventNumber<pImple_->numberOfEvents; ++eventNumber )
+		{
+			pImple_->sumOfWeights+=getEvent(eventNumber).weight();
+		}
+	}
+
+	return pImple_->sumOfWeights;
+}
+
+std::shared_ptr<const l1menu::IMenuRate> l1menu::SampleRange::rate( const l1menu::TriggerMenu& menu ) const
+{
+	return std::shared_ptr<const l1menu::IMenuRate>( new l1menu::implementation::MenuRateImplementation( menu, *this ) );
+}
+
+std::shared_ptr<const l1menu::IMenuRate> l1menu::SampleRange::rate( const l1menu::TriggerMenu& menu, const l1menu::MenuRatePlots& ratePlots ) const
+{
+	return std::shared_ptr<const l1menu::IMenuRate>( new l1menu::implementation::MenuRateImplementation( menu, *this, ratePlots ) );
+}
+
+std::vector< std::shared_ptr<const l1menu::IMenuRate> > l1menu::SampleRange::rates( const std::vector<l1menu::TriggerMenu>& menus ) const
+{
+	std::vector< std::shared_ptr<const l1menu::IMenuRate> > menuRates;
+	for( const auto& menuRateSums : l1menu::MenuRateSums::forEachMenu( menus, *this ) ) menuRates.push_back( menuRateSums.rate() );
+	return menuRates;
+}
+
+std::shared_ptr<const l1menu::IMenuRate> l1menu::SampleRange::progressiveRate( const l1menu::TriggerMenu& menu, const std::function<bool(const l1menu::IMenuRate&)>& progressCallback, float relativeErrorTolerance ) const
+{
+	auto sumsCallback=[&]( const l1menu::MenuRateSums& sumsSoFar ){ return !progressCallback || progressCallback( *sumsSoFar.rate() ); };
+	return l1menu::MenuRateSums::progressive( menu, *this, sumsCallback, relativeErrorTolerance ).rate();
+}
@@ -0,0 +1,152 @@
+#include "l1menu/TotalRateCalculator.h"
+
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "l1menu/TriggerMenu.h"
+#include "l1menu/ICachedTrigger.h"
+#include "l1menu/ISample.h"
+#include "l1menu/IEvent.h"
+#include "l1menu/ReducedSample.h"
+
+namespace // unnamed namespace
+{
+	/** @brief What has been seen of a trigger, used to decide the order the triggers are tried in. */
+	struct TriggerStatistics
+	{
+		double numberTried; ///< Events the trigger was applied to, i.e. that no earlier trigger passed
+		double numberPassed;
+		double numberTimed;
+		double nanosecondsTaken; ///< For the numberTimed calls only
+	};
+}
+
+namespace l1menu
+{
+	/** @brief Private members for the TotalRateCalculator class
+	 */
+	class TotalRateCalculatorPrivateMembers
+	{
+	public:
+		/// Only one in this many events has each trigger call timed, since the clock isn't free either
+		static const size_t eventsBetweenTimings=64;
+		/// How often the triggers are sorted again
+		static const size_t eventsBetweenReorders=4096;
+
+		TotalRateCalculatorPrivateMembers( const l1menu::ISample& newSample ) : sample(newSample) {}
+		/** @brief Sorts triggerOrder by pass probability over cost, and then halves the statistics so that
+		 * they mostly reflect the new order. Whether a trigger passes is only recorded for the events that
+		 * the triggers before it failed, so the pass probabilities change when the order does. */
+		void reorder();
+
+		const l1menu::ISample& sample;
+		std::vector< ::TriggerStatistics > statistics; ///< In the same order as the menu
+		std::vector<size_t> triggerOrder; ///< The trigger numbers in the order they're tried
+	};
+}
+
+const size_t l1menu::TotalRateCalculatorPrivateMembers::eventsBetweenTimings;
+const size_t l1menu::TotalRateCalculatorPrivateMembers::eventsBetweenReorders;
+
+void l1menu::TotalRateCalculatorPrivateMembers::reorder()
+{
+	// Use one pass in two tries and a nanosecond per call until something's known, so that new
+	// triggers get tried somewhere in the middle.
+	std::vector<double> scores;
+	for( const auto& triggerStatistics : statistics )
+	{
+		const double passProbability=(triggerStatistics.numberPassed+1)/(triggerStatistics.numberTried+2);
+		const double cost=(triggerStatistics.numberTimed>0 ? std::max( 1.0, triggerStatistics.nanosecondsTaken/triggerStatistics.numberTimed ) : 1.0 );
+		scores.push_back( passProbability/cost );
+	}
+	std::stable_sort( triggerOrder.begin(), triggerOrder.end(), [&]( size_t first, size_t second ){ return scores[first]>scores[second]; } );
+
+	for( auto& triggerStatistics : statistics )
+	{
+		triggerStatistics.numberTried/=2;
+		triggerStatistics.numberPassed/=2;
+		triggerStatistics.numberTimed/=2;
+		triggerStatistics.nanosecondsTaken/=2;
+	}
+}
+
+l1menu::TotalRateCalculator::TotalRateCalculator( const l1menu::ISample& sample )
+	: pImple_( new l1menu::TotalRateCalculatorPrivateMembers( sample ) )
+{
+	// No operation besides the initialiser list
+}
+
+l1menu::TotalRateCalculator::~TotalRateCalculator()
+{
+	// No operation. Just need one defined otherwise the default one messes up
+	// the unique_ptr deletion because TotalRateCalculatorPrivateMembers isn't
+	// defined elsewhere.
+}
+
+float l1menu::TotalRateCalculator::totalFraction( const l1menu::TriggerMenu& menu )
+{
+	if( pImple_->statistics.size()!=menu.numberOfTriggers() )
+	{
+		pImple_->statistics.assign( menu.numberOfTriggers(), ::TriggerStatistics{0,0,0,0} );
+		pImple_->triggerOrder.clear();
+		for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber ) pImple_->triggerOrder.push_back( triggerNumber );
+	}
+
+	std::vector< std::unique_ptr<l1menu::ICachedTrigger> > cachedTriggers;
+	for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+	{
+		cachedTriggers.push_back( pImple_->sample.createCachedTrigger( menu.getTrigger( triggerNumber ) ) );
+	}
+
+	double sumOfWeights=0;
+	double weightOfEventsPassingAnyTrigger=0;
+	size_t eventNumber=0;
+	auto processEvent=[&]( const l1menu::IEvent& event )
+	{
+		const double weight=event.weight();
+		sumOfWeights+=weight;
+
+		const bool timeThisEvent=( eventNumber%TotalRateCalculatorPrivateMembers::eventsBetweenTimings==0 );
+		for( const auto triggerNumber : pImple_->triggerOrder )
+		{
+			::TriggerStatistics& triggerStatistics=pImple_->statistics[triggerNumber];
+			triggerStatistics.numberTried+=1;
+
+			bool passed;
+			if( timeThisEvent )
+			{
+				const auto startTime=std::chrono::steady_clock::now();
+				passed=cachedTriggers[triggerNumber]->apply(event);
+				triggerStatistics.nanosecondsTaken+=std::chrono::duration<double,std::nano>( std::chrono::steady_clock::now()-startTime ).count();
+				triggerStatistics.numberTimed+=1;
+			}
+			else passed=cachedTriggers[triggerNumber]->apply(event);
+
+			if( passed )
+			{
+				triggerStatistics.numberPassed+=1;
+				weightOfEventsPassingAnyTrigger+=weight;
+				break;
+			}
+		}
+
+		++eventNumber;
+		if( eventNumber%TotalRateCalculatorPrivateMembers::eventsBetweenReorders==0 ) pImple_->reorder();
+	};
+
+	// ReducedSample has a quicker way of looping over the events than getEvent
+	const l1menu::ReducedSample* pReducedSample=dynamic_cast<const l1menu::ReducedSample*>( &pImple_->sample );
+	if( pReducedSample!=nullptr ) pReducedSample->forEachEvent( 0, pReducedSample->numberOfEvents(), processEvent );
+	else
+	{
+		for( size_t index=0; index<pImple_->sample.numberOfEvents(); ++index ) processEvent( pImple_->sample.getEvent(index) );
+	}
+
+	if( sumOfWeights==0 ) return 0;
+	return weightOfEventsPassingAnyTrigger/sumOfWeights;
+}
+
+float l1menu::TotalRateCalculator::totalRate( const l1menu::TriggerMenu& menu )
+{
+	return totalFraction( menu )*pImple_->sample.eventRate();
+}
@@ -0,0 +1,230 @@
+#include "l1menu/TriggerExpression.h"
+
+#include <stdexcept>
+#include <cctype>
+#include <algorithm>
+#include "l1menu/TriggerMenu.h"
+#include "l1menu/ITrigger.h"
+
+namespace // unnamed namespace
+{
+	/** @brief Whether the name matches the pattern, where "*" in the pattern matches any number of characters. */
+	bool wildcardMatch( const char* pattern, const char* name )
+	{
+		if( *pattern=='\0' ) return *name=='\0';
+		if( *pattern=='*' ) return wildcardMatch( pattern+1, name ) || ( *name!='\0' && wildcardMatch( pattern, name+1 ) );
+		return *name==*pattern && wildcardMatch( pattern+1, name+1 );
+	}
+
+	std::string toUpper( std::string string )
+	{
+		std::transform( string.begin(), string.end(), string.begin(), [](char character){ return std::toupper(character); } );
+		return string;
+	}
+
+	std::string trim( const std::string& string )
+	{
+		size_t start=string.find_first_not_of( " \t\n" );
+		if( start==std::string::npos ) return "";
+		size_t end=string.find_last_not_of( " \t\n" );
+		return string.substr( start, end-start+1 );
+	}
+
+	/** @brief Recursive descent parser that converts the expression into reverse Polish notation.
+	 *
+	 * The grammar is
+	 * @code
+	 * orExpression  := andExpression ( OR andExpression )*
+	 * andExpression := notExpression ( AND notExpression )*
+	 * notExpression := NOT notExpression | "(" orExpression ")" | triggerName
+	 * @endcode
+	 */
+	template<class T_Step, class T_Operation>
+	class ExpressionParser
+	{
+	public:
+		ExpressionParser( const std::string& expression, const l1menu::TriggerMenu& menu, std::vector<T_Step>& steps )
+			: expression_(expression), menu_(menu), steps_(steps), position_(0), depth_(0), maximumDepth_(0)
+		{
+			tokenise();
+			if( tokens_.empty() ) error( "the expression is empty" );
+			parseOr();
+			if( position_!=tokens_.size() ) error( "unexpected \""+tokens_[position_]+"\"" );
+		}
+		size_t maximumDepth() const { return maximumDepth_; }
+	private:
+		void error( const std::string& message ) const
+		{
+			throw std::runtime_error( "Invalid trigger expression \""+expression_+"\": "+message );
+		}
+
+		void tokenise()
+		{
+			for( size_t index=0; index<expression_.size(); )
+			{
+				char character=expression_[index];
+				if( std::isspace(character) ) ++index;
+				else if( character=='(' || character==')' || character=='!' )
+				{
+					tokens_.push_back( std::string(1,character) );
+					++index;
+				}
+				else if( character=='&' || character=='|' )
+				{
+					// Allow both single and double characters
+					tokens_.push_back( std::string(1,character) );
+					++index;
+					if( index<expression_.size() && expression_[index]==character ) ++index;
+				}
+				else if( std::isalnum(character) || character=='_' || character=='*' )
+				{
+					size_t start=index;
+					while( index<expression_.size() && ( std::isalnum(expression_[index]) || expression_[index]=='_' || expression_[index]=='*' ) ) ++index;
+					tokens_.push_back( expression_.substr( start, index-start ) );
+				}
+				else error( std::string("unexpected character '")+character+"'" );
+			}
+		}
+
+		bool nextTokenIs( const std::string& symbol, const std::string& word )
+		{
+			if( position_>=tokens_.size() ) return false;
+			if( tokens_[position_]!=symbol && ::toUpper(tokens_[position_])!=word ) return false;
+			++position_;
+			return true;
+		}
+
+		void push( T_Operation operation, size_t triggerNumber=0 )
+		{
+			// Keep track of how big the stack gets when evaluating
+			if( operation==T_Operation::PUSH_TRIGGER ) maximumDepth_=std::max( maximumDepth_, ++depth_ );
+			else if( operation!=T_Operation::NOT ) --depth_;
+			steps_.push_back( T_Step{ operation, triggerNumber } );
+		}
+
+		void parseOr()
+		{
+			parseAnd();
+			while( nextTokenIs( "|", "OR" ) )
+			{
+				parseAnd();
+				push( T_Operation::OR );
+			}
+		}
+
+		void parseAnd()
+		{
+			parseNot();
+			while( nextTokenIs( "&", "AND" ) )
+			{
+				parseNot();
+				push( T_Operation::AND );
+			}
+		}
+
+		void parseNot()
+		{
+			if( position_>=tokens_.size() ) error( "unexpected end of the expression" );
+
+			if( nextTokenIs( "!", "NOT" ) )
+			{
+				parseNot();
+				push( T_Operation::NOT );
+			}
+			else if( nextTokenIs( "(", "(" ) )
+			{
+				parseOr();
+				if( !nextTokenIs( ")", ")" ) ) error( "missing \")\"" );
+			}
+			else
+			{
+				const std::string& triggerName=tokens_[position_];
+				if( triggerName==")" || triggerName=="&" || triggerName=="|" || toUpper(triggerName)=="AND" || toUpper(triggerName)=="OR" ) error( "expected a trigger name but got \""+triggerName+"\"" );
+				++position_;
+
+				// A wildcard is the OR of everything it matches
+				size_t numberOfMatches=0;
+				for( size_t triggerNumber=0; triggerNumber<menu_.numberOfTriggers(); ++triggerNumber )
+				{
+					if( ::wildcardMatch( triggerName.c_str(), menu_.getTrigger(triggerNumber).name().c_str() ) )
+					{
+						push( T_Operation::PUSH_TRIGGER, triggerNumber );
+						if( ++numberOfMatches>1 ) push( T_Operation::OR );
+					}
+				}
+				if( numberOfMatches==0 ) error( "there is no trigger in the menu matching \""+triggerName+"\"" );
+			}
+		}
+
+		const std::string& expression_;
+		const l1menu::TriggerMenu& menu_;
+		std::vector<T_Step>& steps_;
+		std::vector<std::string> tokens_;
+		size_t position_;
+		size_t depth_;
+		size_t maximumDepth_;
+	};
+
+} // end of the unnamed namespace
+
+l1menu::TriggerExpression::TriggerExpression( const std::string& expression, const l1menu::TriggerMenu& menu )
+	: expression_(expression)
+{
+	// Check for a name first. "=" can't be part of an expression so it's not ambiguous.
+	std::string expressionWithoutName=expression;
+	size_t equalsPosition=expression.find('=');
+	if( equalsPosition!=std::string::npos )
+	{
+		name_=::trim( expression.substr( 0, equalsPosition ) );
+		expressionWithoutName=expression.substr( equalsPosition+1 );
+		if( name_.empty() ) throw std::runtime_error( "Invalid trigger expression \""+expression+"\": the name before \"=\" is empty" );
+	}
+	else name_=::trim( expression );
+
+	::ExpressionParser<Step,Operation> parser( expressionWithoutName, menu, steps_ );
+	if( parser.maximumDepth()>maximumStackDepth ) throw std::runtime_error( "Invalid trigger expression \""+expression+"\": it is too deeply nested" );
+}
+
+const std::string& l1menu::TriggerExpression::name() const
+{
+	return name_;
+}
+
+const std::string& l1menu::TriggerExpression::expression() const
+{
+	return expression_;
+}
+
+bool l1menu::TriggerExpression::evaluate( const std::vector<bool>& triggerResults ) const
+{
+	bool stack[maximumStackDepth];
+	size_t stackSize=0;
+	for( const auto& step : steps_ )
+	{
+		switch( step.operation )
+		{
+			case Operation::PUSH_TRIGGER: stack[stackSize++]=triggerResults[step.triggerNumber]; break;
+			case Operation::AND: --stackSize; stack[stackSize-1]=stack[stackSize-1] && stack[stackSize]; break;
+			case Operation::OR: --stackSize; stack[stackSize-1]=stack[stackSize-1] || stack[stackSize]; break;
+			case Operation::NOT: stack[stackSize-1]=!stack[stackSize-1]; break;
+		}
+	}
+	return stack[0];
+}
+
+uint64_t l1menu::TriggerExpression::evaluate( const uint64_t* triggerBits, size_t stride, size_t wordIndex ) const
+{
+	uint64_t stack[maximumStackDepth];
+	size_t stackSize=0;
+	for( const auto& step : steps_ )
+	{
+		switch( step.operation )
+		{
+			case Operation::PUSH_TRIGGER: stack[stackSize++]=triggerBits[step.triggerNumber*stride+wordIndex]; break;
+			case Operation::AND: --stackSize; stack[stackSize-1]&=stack[stackSize]; break;
+			case Operation::OR: --stackSize; stack[stackSize-1]|=stack[stackSize]; break;
+			case Operation::NOT: stack[stackSize-1]=~stack[stackSize-1]; break;
+		}
+	}
+	return stack[0];
+}
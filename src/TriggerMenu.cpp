@@ -233,16 +233,13 @@ std::unique_ptr<l1menu::ITrigger> l1menu::TriggerMenu::getTriggerCopy( size_t po
 
 bool l1menu::TriggerMenu::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	bool atLeastOneTriggerHasFired=false;
-
+	// The individual results aren't kept, so there's no need to carry on once one has fired
 	for( size_t triggerNumber=0; triggerNumber<pImple_->triggers_.size(); ++triggerNumber )
 	{
-		bool result=pImple_->triggers_[triggerNumber]->apply(event);
-//		pImple_->triggerResults_[triggerNumber]=result;
-		if( result ) atLeastOneTriggerHasFired=true;
+		if( pImple_->triggers_[triggerNumber]->apply(event) ) return true;
 	}
 
-	return atLeastOneTriggerHasFired;
+	return false;
 }
 
 l1menu::TriggerConstraint& l1menu::TriggerMenu::getTriggerConstraint( size_t position )
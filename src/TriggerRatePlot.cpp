@@ -5,6 +5,7 @@
 #include "l1menu/L1TriggerDPGEvent.h"
 #include "l1menu/IEvent.h"
 #include "l1menu/ISample.h"
+#include "l1menu/ReducedSample.h"
 #include "l1menu/TriggerTable.h"
 #include "l1menu/tools/miscellaneous.h"
 #include "l1menu/tools/stringManipulation.h"
@@ -12,6 +13,21 @@
 #include <sstream>
 #include <algorithm>
 #include <stdexcept>
+#include <cmath>
+
+namespace // unnamed namespace
+{
+	/** @brief Whether any event in the zone could pass all of the cuts, going by the ReducedSample zone maps.
+	 * The cuts are pairs of parameter ID and the lowest value that passes. */
+	bool zoneCanPass( const l1menu::ReducedSample& sample, size_t zone, const std::vector< std::pair<size_t,float> >& cuts )
+	{
+		for( const auto& cut : cuts )
+		{
+			if( sample.parameterZoneMaxima(cut.first)[zone]<cut.second ) return false;
+		}
+		return true;
+	}
+} // end of the unnamed namespace
 
 l1menu::TriggerRatePlot::TriggerRatePlot( const l1menu::ITriggerDescription& trigger, std::unique_ptr<TH1> pHistogram, const std::string& versusParameter, const std::vector<std::string> scaledParameters )
 	: pHistogram_( std::move(pHistogram) ), versusParameter_(versusParameter), histogramOwnedByMe_(true)
@@ -109,7 +125,9 @@ l1menu::TriggerRatePlot::TriggerRatePlot( l1menu::TriggerRatePlot&& otherTrigger
 	: pTrigger_( std::move(otherTriggerRatePlot.pTrigger_) ),
 	  pHistogram_( std::move(otherTriggerRatePlot.pHistogram_) ),
 	  versusParameter_( std::move(otherTriggerRatePlot.versusParameter_) ),
-	  pParameter_(&pTrigger_->parameter(versusParameter_)),
+	  pParameter_(otherTriggerRatePlot.pParameter_), // Trigger is on the heap so this pointer is still valid
+	  versusParameterHandle_(otherTriggerRatePlot.versusParameterHandle_),
+	  binLowEdges_( std::move(otherTriggerRatePlot.binLowEdges_) ),
 	  otherScaledParameters_( std::move(otherTriggerRatePlot.otherScaledParameters_) ),
 	  otherParameterScalings_( std::move(otherTriggerRatePlot.otherParameterScalings_) ),
 	  histogramOwnedByMe_(otherTriggerRatePlot.histogramOwnedByMe_)
@@ -128,7 +146,9 @@ l1menu::TriggerRatePlot& l1menu::TriggerRatePlot::operator=( l1menu::TriggerRate
 	pTrigger_=std::move(otherTriggerRatePlot.pTrigger_);
 	pHistogram_=std::move(otherTriggerRatePlot.pHistogram_);
 	versusParameter_=std::move(otherTriggerRatePlot.versusParameter_);
-	pParameter_=&pTrigger_->parameter(versusParameter_);
+	pParameter_=otherTriggerRatePlot.pParameter_; // Trigger is on the heap so this pointer is still valid
+	versusParameterHandle_=otherTriggerRatePlot.versusParameterHandle_;
+	binLowEdges_=std::move(otherTriggerRatePlot.binLowEdges_);
 	otherScaledParameters_=std::move(otherTriggerRatePlot.otherScaledParameters_);
 	otherParameterScalings_=std::move(otherTriggerRatePlot.otherParameterScalings_);
 	histogramOwnedByMe_=otherTriggerRatePlot.histogramOwnedByMe_;
@@ -149,6 +169,10 @@ void l1menu::TriggerRatePlot::initiate( const l1menu::ITriggerDescription& trigg
 	// throw an exception. Take a pointer to the parameter so I don't need to keep performing
 	// expensive string comparisons.
 	pParameter_=&pTrigger_->parameter(versusParameter_);
+	versusParameterHandle_=pTrigger_->parameterIndex(versusParameter_);
+
+	binLowEdges_.clear();
+	for( int binNumber=1; binNumber<=pHistogram_->GetNbinsX(); ++binNumber ) binLowEdges_.push_back( pHistogram_->GetBinLowEdge(binNumber) );
 
 	// If any parameters have been requested to be scaled along with the versusParameter, figure
 	// out what the scaling should be and take a note of pointers.
@@ -174,17 +198,19 @@ void l1menu::TriggerRatePlot::initiate( const l1menu::ITriggerDescription& trigg
 	for( std::vector<std::string>::const_iterator iName=parameterNames.begin(); iName!=parameterNames.end(); ++iName )
 	{
 		if( *iName==versusParameter_ ) continue; // Don't bother adding the parameter I'm plotting against
+		// The handle is the position in parameterNames(), so no need for a string lookup
+		const l1menu::ITrigger::ParameterHandle handle=iName-parameterNames.begin();
 
 		// First check to see if this is one of the parameters that are being scaled
 		if( std::find(scaledParameters.begin(),scaledParameters.end(),*iName)==scaledParameters.end() )
 		{
 			// This parameter isn't being scaled, so write the absoulte value in the description
-			description << *iName << "=" << pTrigger_->parameter(*iName);
+			description << *iName << "=" << pTrigger_->parameter(handle);
 		}
 		else
 		{
 			// This parameter is being scaled, so write what the scaling is in the description
-			description << *iName << "=x*" << pTrigger_->parameter(*iName)/(*pParameter_);
+			description << *iName << "=x*" << pTrigger_->parameter(handle)/(*pParameter_);
 		}
 
 		if( iName+1!=parameterNames.end() ) description << ","; // Add delimeter between parameter names
@@ -222,18 +248,60 @@ void l1menu::TriggerRatePlot::addSample( const l1menu::ISample& sample )
 {
 	float weightPerEvent=sample.eventRate()/sample.sumOfWeights();
 
+	// If the sample can give the rate at each bin edge directly there's no need to loop over the events
+	if( addSampleUsingIndex( sample, weightPerEvent ) ) return;
+
 	// Create a cached trigger, which depending on the concrete type of the ISample
 	// may or may not significantly increase the speed at which this next loop happens.
 	std::unique_ptr<l1menu::ICachedTrigger> pCachedTrigger=sample.createCachedTrigger( *pTrigger_ );
 
+	// For a ReducedSample, whole zones of events that can't even pass the lowest bin can be skipped
+	const l1menu::ReducedSample* pReducedSample=dynamic_cast<const l1menu::ReducedSample*>( &sample );
+	const std::vector< std::pair<size_t,float> > cuts=lowestBinCuts( sample );
+
 	for( size_t eventNumber=0; eventNumber<sample.numberOfEvents(); ++eventNumber )
 	{
+		if( pReducedSample!=nullptr && eventNumber%l1menu::ReducedSample::eventsPerZone==0
+				&& !::zoneCanPass( *pReducedSample, eventNumber/l1menu::ReducedSample::eventsPerZone, cuts ) )
+		{
+			eventNumber+=l1menu::ReducedSample::eventsPerZone-1;
+			continue;
+		}
 		addEvent( sample.getEvent(eventNumber), pCachedTrigger, weightPerEvent );
 	} // end of loop over events
 
 }
 
 void l1menu::TriggerRatePlot::addEvent( const l1menu::IEvent& event, const std::unique_ptr<l1menu::ICachedTrigger>& pCachedTrigger, float weightPerEvent )
+{
+	//
+	// If this is a full event and there are no other parameters to scale, the trigger can work
+	// out which bins pass all in one go. For most triggers that does the same bisection as below,
+	// but some can do it with much less work.
+	//
+	const l1menu::L1TriggerDPGEvent* pFullEvent=dynamic_cast<const l1menu::L1TriggerDPGEvent*>( &event );
+	if( pFullEvent!=nullptr && otherParameterScalings_.empty() )
+	{
+		pTrigger_->applyBatch( *pFullEvent, versusParameterHandle_, binLowEdges_, binPassed_ );
+		for( size_t index=0; index<binPassed_.size() && binPassed_[index]; ++index )
+		{
+			pHistogram_->Fill( pHistogram_->GetBinCenter(index+1), event.weight()*weightPerEvent );
+		}
+		return;
+	}
+
+	//
+	// Now I know which bins need filling, loop over them and fill.
+	//
+	const size_t highestBin=highestPassingBin( event, pCachedTrigger );
+	for( size_t binNumber=1; binNumber<=highestBin; ++binNumber )
+	{
+		pHistogram_->Fill( pHistogram_->GetBinCenter(binNumber), event.weight()*weightPerEvent );
+	}
+
+}
+
+size_t l1menu::TriggerRatePlot::highestPassingBin( const l1menu::IEvent& event, const std::unique_ptr<l1menu::ICachedTrigger>& pCachedTrigger )
 {
 	//
 	// Use bisection to find the bin that passes the trigger and the one
@@ -251,7 +319,7 @@ void l1menu::TriggerRatePlot::addEvent( const l1menu::IEvent& event, const std::
 	// in parameterScalingPair, 'first' is a pointer to the threshold to be changed
 	// and 'second' is the ratio of the first threshold it should be.
 	for( const auto& parameterScalingPair : otherParameterScalings_ ) *(parameterScalingPair.first)=parameterScalingPair.second*(*pParameter_);
-	if( !pCachedTrigger->apply(event) ) return;
+	if( !pCachedTrigger->apply(event) ) return 0;
 
 	//
 	// Also check the highest bin. If that passes then I just fill every bin,
@@ -260,29 +328,66 @@ void l1menu::TriggerRatePlot::addEvent( const l1menu::IEvent& event, const std::
 	(*pParameter_)=pHistogram_->GetBinLowEdge(highBin);
 	for( const auto& parameterScalingPair : otherParameterScalings_ ) *(parameterScalingPair.first)=parameterScalingPair.second*(*pParameter_);
 
-	if( pCachedTrigger->apply(event) ) lowBin=highBin;
-	else
+	if( pCachedTrigger->apply(event) ) return highBin;
+
+	while( highBin-lowBin>1 ) // Loop until I find two bins next to each other
 	{
-		while( highBin-lowBin>1 ) // Loop until I find two bins next to each other
-		{
-			size_t middleBin=(highBin+lowBin)/2;
+		size_t middleBin=(highBin+lowBin)/2;
 
-			(*pParameter_)=pHistogram_->GetBinLowEdge(middleBin);
-			for( const auto& parameterScalingPair : otherParameterScalings_ ) *(parameterScalingPair.first)=parameterScalingPair.second*(*pParameter_);
+		(*pParameter_)=pHistogram_->GetBinLowEdge(middleBin);
+		for( const auto& parameterScalingPair : otherParameterScalings_ ) *(parameterScalingPair.first)=parameterScalingPair.second*(*pParameter_);
 
-			if( pCachedTrigger->apply(event) ) lowBin=middleBin;
-			else highBin=middleBin;
-		}
+		if( pCachedTrigger->apply(event) ) lowBin=middleBin;
+		else highBin=middleBin;
 	}
+	return lowBin;
+}
 
+bool l1menu::TriggerRatePlot::addSampleUsingIndex( const l1menu::ISample& sample, float weightPerEvent )
+{
 	//
-	// Now I know which bins need filling, loop over them and fill.
+	// This only works for a ReducedSample when versusParameter_ is the only threshold, because then
+	// the rate at each bin edge is just the weight of the events with the parameter at or above it.
 	//
-	for( size_t binNumber=1; binNumber<=lowBin; ++binNumber )
+	const l1menu::ReducedSample* pReducedSample=dynamic_cast<const l1menu::ReducedSample*>( &sample );
+	if( pReducedSample==nullptr || !otherParameterScalings_.empty() ) return false;
+	if( !pReducedSample->containsTrigger( *pTrigger_ ) ) return false;
+
+	const auto parameterIdentifiers=pReducedSample->getTriggerParameterIdentifiers( *pTrigger_ );
+	if( parameterIdentifiers.size()!=1 || parameterIdentifiers.begin()->first!=versusParameter_ ) return false;
+	const l1menu::ReducedEvent::ParameterID parameterID=parameterIdentifiers.begin()->second;
+
+	// Filling with weights would have turned this on, so do the same to get the same errors
+	if( pHistogram_->GetSumw2N()==0 ) pHistogram_->Sumw2();
+
+	for( int binNumber=1; binNumber<=pHistogram_->GetNbinsX(); ++binNumber )
 	{
-		pHistogram_->Fill( pHistogram_->GetBinCenter(binNumber), event.weight()*weightPerEvent );
+		const float binLowEdge=pHistogram_->GetBinLowEdge(binNumber);
+		const double weight=pReducedSample->sumOfWeightsPassing( parameterID, binLowEdge )*weightPerEvent;
+		if( weight==0 ) break; // No higher bins will have anything either
+		const double weightSquared=pReducedSample->sumOfWeightsSquaredPassing( parameterID, binLowEdge )*weightPerEvent*weightPerEvent;
+
+		const double binError=pHistogram_->GetBinError(binNumber);
+		pHistogram_->SetBinContent( binNumber, pHistogram_->GetBinContent(binNumber)+weight );
+		pHistogram_->SetBinError( binNumber, std::sqrt( binError*binError+weightSquared ) );
 	}
 
+	return true;
+}
+
+std::vector< std::pair<size_t,float> > l1menu::TriggerRatePlot::lowestBinCuts( const l1menu::ISample& sample )
+{
+	std::vector< std::pair<size_t,float> > cuts;
+	const l1menu::ReducedSample* pReducedSample=dynamic_cast<const l1menu::ReducedSample*>( &sample );
+	if( pReducedSample==nullptr ) return cuts;
+
+	(*pParameter_)=pHistogram_->GetBinLowEdge(1);
+	for( const auto& parameterScalingPair : otherParameterScalings_ ) *(parameterScalingPair.first)=parameterScalingPair.second*(*pParameter_);
+	for( const auto& identifier : pReducedSample->getTriggerParameterIdentifiers( *pTrigger_ ) )
+	{
+		cuts.push_back( std::make_pair( identifier.second, pTrigger_->parameter(identifier.first) ) );
+	}
+	return cuts;
 }
 
 const l1menu::ITriggerDescription& l1menu::TriggerRatePlot::getTrigger() const
@@ -318,13 +423,17 @@ bool l1menu::TriggerRatePlot::triggerMatches( const l1menu::ITriggerDescription&
 	// If control gets this far, then it's the same trigger but the parameters could still be different.
 	// First check all of the parameters that aren't the versus parameter or a parameter that scales with
 	// the versus parameter.
-	for( const auto& parameterName : pTrigger_->parameterNames() )
+	const std::vector<std::string> parameterNames=pTrigger_->parameterNames();
+	for( l1menu::ITrigger::ParameterHandle handle=0; handle<parameterNames.size(); ++handle )
 	{
+		const std::string& parameterName=parameterNames[handle];
 		// Skip over versus parameter and scaled parameters
 		if( parameterName==versusParameter_ ) continue;
 		if( std::find( otherScaledParameters_.begin(), otherScaledParameters_.end(), parameterName )!=otherScaledParameters_.end() ) continue;
 
-		if( pTrigger_->parameter(parameterName)!=trigger.parameter(parameterName) ) return false;
+		// Could be any implementation of ITriggerDescription with a different parameter
+		// order, so have to look up by name for the other trigger.
+		if( pTrigger_->parameter(handle)!=trigger.parameter(parameterName) ) return false;
 	}
 
 	// Now need to check that any scaled parameters are scaled the same
@@ -496,25 +605,97 @@ void l1menu::TriggerRatePlot::addSample( const l1menu::ISample& sample, std::vec
 {
 	float weightPerEvent=sample.eventRate()/sample.sumOfWeights();
 
+	// Fill any plots that can be filled without looping over the events, and only keep the
+	// others for the event loop.
+	std::vector<TriggerRatePlot*> plotsToLoopOver;
+	for( auto& ratePlot : ratePlots )
+	{
+		if( !ratePlot.addSampleUsingIndex( sample, weightPerEvent ) ) plotsToLoopOver.push_back( &ratePlot );
+	}
+	if( plotsToLoopOver.empty() ) return;
+
 	// Create cached triggers for each of the rate plots, which depending on the concrete type
 	// of the ISample may or may not significantly increase the speed at which this next loop happens.
 	std::vector< std::unique_ptr<l1menu::ICachedTrigger> > cachedTriggers;
-	for( const auto& ratePlot : ratePlots ) cachedTriggers.push_back( sample.createCachedTrigger( *ratePlot.pTrigger_ ) );
+	for( const auto pRatePlot : plotsToLoopOver ) cachedTriggers.push_back( sample.createCachedTrigger( *pRatePlot->pTrigger_ ) );
+
+	// For a ReducedSample, zones where no event can pass the lowest bin of any of the plots can be skipped
+	const l1menu::ReducedSample* pReducedSample=dynamic_cast<const l1menu::ReducedSample*>( &sample );
+	std::vector< std::vector< std::pair<size_t,float> > > cuts;
+	for( const auto pRatePlot : plotsToLoopOver ) cuts.push_back( pRatePlot->lowestBinCuts( sample ) );
 
 	// Now instead of calling addSample() for each TriggerRatePlot individually, get each IEvent from the sample
 	// and pass that to each rate plot. This is because (depending on the ISample concrete type) getting the
 	// IEvent can be computationally expensive.
 	std::vector< std::unique_ptr<l1menu::ICachedTrigger> >::const_iterator iTrigger;
-	std::vector<TriggerRatePlot>::iterator iRatePlot;
+	std::vector<TriggerRatePlot*>::iterator iRatePlot;
 	for( size_t eventNumber=0; eventNumber<sample.numberOfEvents(); ++eventNumber )
 	{
+		if( pReducedSample!=nullptr && eventNumber%l1menu::ReducedSample::eventsPerZone==0 )
+		{
+			const size_t zone=eventNumber/l1menu::ReducedSample::eventsPerZone;
+			if( std::none_of( cuts.begin(), cuts.end(), [&]( const std::vector< std::pair<size_t,float> >& plotCuts ){ return ::zoneCanPass( *pReducedSample, zone, plotCuts ); } ) )
+			{
+				eventNumber+=l1menu::ReducedSample::eventsPerZone-1;
+				continue;
+			}
+		}
+
 		const l1menu::IEvent& event=sample.getEvent(eventNumber);
 
-		for( iTrigger=cachedTriggers.begin(), iRatePlot=ratePlots.begin();
-			iTrigger!=cachedTriggers.end() && iRatePlot!=ratePlots.end();
+		for( iTrigger=cachedTriggers.begin(), iRatePlot=plotsToLoopOver.begin();
+			iTrigger!=cachedTriggers.end() && iRatePlot!=plotsToLoopOver.end();
 			++iTrigger, ++iRatePlot )
 		{
-			iRatePlot->addEvent( event, *iTrigger, weightPerEvent );
+			(*iRatePlot)->addEvent( event, *iTrigger, weightPerEvent );
+		}
+	} // end of loop over events
+
+}
+
+void l1menu::TriggerRatePlot::addSampleForEachWeight( const l1menu::ReducedSample& sample, std::vector<TriggerRatePlot>& ratePlots )
+{
+	if( ratePlots.empty() ) return;
+	const std::vector<std::string> weightNames=sample.weightNames();
+	if( ratePlots.size()>weightNames.size()+1 ) throw std::runtime_error( "TriggerRatePlot::addSampleForEachWeight - there are more rate plots than sets of weights in the sample" );
+
+	// The bins are only found for the first plot, so the others must be exactly the same
+	TriggerRatePlot& firstPlot=ratePlots.front();
+	for( const auto& ratePlot : ratePlots )
+	{
+		if( ratePlot.versusParameter_!=firstPlot.versusParameter_ || !firstPlot.triggerMatches( *ratePlot.pTrigger_ )
+				|| ratePlot.binLowEdges_!=firstPlot.binLowEdges_ )
+		{
+			throw std::runtime_error( "TriggerRatePlot::addSampleForEachWeight - all of the rate plots must be for the same trigger with the same binning" );
+		}
+	}
+
+	// The weight column and the normalisation for each plot
+	std::vector<const float*> weightColumns( 1, sample.weightColumn() );
+	std::vector<float> weightsPerEvent( 1, sample.eventRate()/sample.sumOfWeights() );
+	for( size_t plotNumber=1; plotNumber<ratePlots.size(); ++plotNumber )
+	{
+		weightColumns.push_back( sample.weightColumn( weightNames[plotNumber-1] ) );
+		weightsPerEvent.push_back( sample.eventRate()/sample.sumOfWeights( weightNames[plotNumber-1] ) );
+	}
+
+	std::unique_ptr<l1menu::ICachedTrigger> pCachedTrigger=sample.createCachedTrigger( *firstPlot.pTrigger_ );
+	const std::vector< std::pair<size_t,float> > cuts=firstPlot.lowestBinCuts( sample );
+
+	for( size_t eventNumber=0; eventNumber<sample.numberOfEvents(); ++eventNumber )
+	{
+		if( eventNumber%l1menu::ReducedSample::eventsPerZone==0 && !::zoneCanPass( sample, eventNumber/l1menu::ReducedSample::eventsPerZone, cuts ) )
+		{
+			eventNumber+=l1menu::ReducedSample::eventsPerZone-1;
+			continue;
+		}
+
+		const size_t highestBin=firstPlot.highestPassingBin( sample.getEvent(eventNumber), pCachedTrigger );
+		for( size_t plotNumber=0; plotNumber<ratePlots.size(); ++plotNumber )
+		{
+			TH1* pHistogram=ratePlots[plotNumber].pHistogram_.get();
+			const float weight=weightColumns[plotNumber][eventNumber]*weightsPerEvent[plotNumber];
+			for( size_t binNumber=1; binNumber<=highestBin; ++binNumber ) pHistogram->Fill( pHistogram->GetBinCenter(binNumber), weight );
 		}
 	} // end of loop over events
 
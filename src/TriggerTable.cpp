@@ -4,6 +4,10 @@
 
 #include <sstream>
 #include <stdexcept>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
 
 //
 // Declare the pimple class
@@ -16,7 +20,7 @@ namespace l1menu
 		struct TriggerRegistryEntry
 		{
 			l1menu::TriggerTable::TriggerDetails details;
-			std::unique_ptr<l1menu::ITrigger> (*creationFunctionPointer)();
+			std::function<std::unique_ptr<l1menu::ITrigger>()> creationFunction;
 		};
 		struct SuggestedBinning
 		{
@@ -24,15 +28,52 @@ namespace l1menu
 			float lowerEdge;
 			float upperEdge;
 		};
-		std::vector<TriggerRegistryEntry> registeredTriggers;
+		/** @brief Everything needed to look up a trigger. Never changed once it has been published. */
+		struct Registry
+		{
+			/** @brief The registered triggers, keyed by name and then version. Entries are shared between versions of the registry. */
+			std::unordered_map< std::string, std::map<unsigned int,std::shared_ptr<const TriggerRegistryEntry> > > triggers;
+			std::vector<l1menu::TriggerTable::TriggerDetails> registrationOrder; ///< So that listTriggers() doesn't change order
+		};
+		TriggerTablePrivateMembers();
+		/** @brief The registry that lookups use, read without taking any lock.
+		 *
+		 * Anything that changes the table copies the current registry, changes the copy and then points
+		 * this at it. A lookup in another thread could still be using the old one, so every version is
+		 * kept in allRegistries until the table is destroyed. Nearly all triggers are registered once at
+		 * startup, so that's one small map per trigger. */
+		std::atomic<const Registry*> pCurrentRegistry;
+		std::vector< std::unique_ptr<const Registry> > allRegistries;
+		/** @brief Only read when making plots, so it's simpler to keep this behind the lock. */
 		std::map<std::string,std::map<std::string,SuggestedBinning> > suggestedBinning_;
-		const SuggestedBinning& getSuggestedBinning( const std::string& triggerName, const std::string& parameterName );
+		/** @brief Taken by anything that changes the table, and to read the suggested binning. */
+		mutable std::mutex mutex_;
+		/** @brief Returns a copy rather than a reference because another thread could change it. */
+		SuggestedBinning getSuggestedBinning( const std::string& triggerName, const std::string& parameterName ) const;
+		/** @brief The entry for the trigger, or nullptr if there isn't one.
+		 *
+		 * Registries are kept until the table is destroyed, so the pointer stays valid even if the
+		 * trigger is unregistered afterwards. */
+		const TriggerRegistryEntry* findEntry( const std::string& name, unsigned int version ) const;
+		void addEntry( const l1menu::TriggerTable::TriggerDetails& newTriggerDetails, std::function<std::unique_ptr<l1menu::ITrigger>()> creationFunction );
+		/** @brief Makes pNewRegistry the one that lookups use. The caller must hold the lock. */
+		void publish( std::unique_ptr<const Registry> pNewRegistry );
+		/** @brief Creates a new trigger and copies the parameters from triggerToCopy into it. */
+		static std::unique_ptr<l1menu::ITrigger> createAndCopyParameters( const TriggerRegistryEntry& entry, const l1menu::ITriggerDescription& triggerToCopy );
 	};
 
 } // end of namespace l1menu
 
-const l1menu::TriggerTablePrivateMembers::SuggestedBinning& l1menu::TriggerTablePrivateMembers::getSuggestedBinning( const std::string& triggerName, const std::string& parameterName )
+l1menu::TriggerTablePrivateMembers::TriggerTablePrivateMembers()
+{
+	allRegistries.push_back( std::unique_ptr<const Registry>( new Registry ) );
+	pCurrentRegistry.store( allRegistries.back().get() );
+}
+
+l1menu::TriggerTablePrivateMembers::SuggestedBinning l1menu::TriggerTablePrivateMembers::getSuggestedBinning( const std::string& triggerName, const std::string& parameterName ) const
 {
+	std::lock_guard<std::mutex> lock( mutex_ );
+
 	const auto& iTriggerFindResult=suggestedBinning_.find(triggerName);
 	if( iTriggerFindResult==suggestedBinning_.end() )
 	{
@@ -48,6 +89,76 @@ const l1menu::TriggerTablePrivateMembers::SuggestedBinning& l1menu::TriggerTable
 	return iParameterFindResult->second;
 }
 
+const l1menu::TriggerTablePrivateMembers::TriggerRegistryEntry* l1menu::TriggerTablePrivateMembers::findEntry( const std::string& name, unsigned int version ) const
+{
+	const Registry& registry=*pCurrentRegistry.load( std::memory_order_acquire );
+
+	const auto iNameFindResult=registry.triggers.find( name );
+	if( iNameFindResult==registry.triggers.end() ) return nullptr;
+
+	const auto iVersionFindResult=iNameFindResult->second.find( version );
+	if( iVersionFindResult==iNameFindResult->second.end() ) return nullptr;
+
+	return iVersionFindResult->second.get();
+}
+
+void l1menu::TriggerTablePrivateMembers::addEntry( const l1menu::TriggerTable::TriggerDetails& newTriggerDetails, std::function<std::unique_ptr<l1menu::ITrigger>()> creationFunction )
+{
+	std::lock_guard<std::mutex> lock( mutex_ );
+
+	// First make sure there is not a trigger with the same name and version already registered
+	std::unique_ptr<Registry> pNewRegistry( new Registry( *pCurrentRegistry.load() ) );
+	std::map<unsigned int,std::shared_ptr<const TriggerRegistryEntry> >& versions=pNewRegistry->triggers[newTriggerDetails.name];
+	if( versions.find(newTriggerDetails.version)!=versions.end() )
+	{
+		std::stringstream errorMessage;
+		errorMessage << "A trigger called \"" << newTriggerDetails.name << "\" with version " << newTriggerDetails.version << " has already been registered in the trigger table.";
+		throw std::logic_error( errorMessage.str() );
+	}
+
+	// If program flow has reached this point then there are no triggers with the same name
+	// and version already registered, so it's okay to add the trigger as requested.
+	versions.insert( std::make_pair( newTriggerDetails.version, std::make_shared<const TriggerRegistryEntry>( TriggerRegistryEntry{newTriggerDetails,std::move(creationFunction)} ) ) );
+	pNewRegistry->registrationOrder.push_back( newTriggerDetails );
+	publish( std::move(pNewRegistry) );
+}
+
+void l1menu::TriggerTablePrivateMembers::publish( std::unique_ptr<const Registry> pNewRegistry )
+{
+	allRegistries.push_back( std::move(pNewRegistry) );
+	pCurrentRegistry.store( allRegistries.back().get(), std::memory_order_release );
+}
+
+std::unique_ptr<l1menu::ITrigger> l1menu::TriggerTablePrivateMembers::createAndCopyParameters( const TriggerRegistryEntry& entry, const l1menu::ITriggerDescription& triggerToCopy )
+{
+	std::unique_ptr<l1menu::ITrigger> newTrigger=entry.creationFunction();
+
+	//
+	// Now copy all of the parameters over.
+	//
+	// Get the parameter names
+	std::vector<std::string> parameterNames=triggerToCopy.parameterNames();
+	if( parameterNames==newTrigger->parameterNames() )
+	{
+		// Parameters are in the same order (almost always the case since it's the same trigger
+		// implementation), so the handles are the same and I can skip the string lookups.
+		for( l1menu::ITrigger::ParameterHandle handle=0; handle<parameterNames.size(); ++handle )
+		{
+			newTrigger->parameter(handle)=triggerToCopy.parameter(handle);
+		}
+	}
+	else
+	{
+		// Otherwise run through and copy the value of each one by name
+		for( std::vector<std::string>::const_iterator iName=parameterNames.begin(); iName!=parameterNames.end(); ++iName )
+		{
+			newTrigger->parameter(*iName)=triggerToCopy.parameter(*iName);
+		}
+	}
+
+	return newTrigger;
+}
+
 l1menu::TriggerTable& l1menu::TriggerTable::instance()
 {
 	static TriggerTable onlyInstance;
@@ -71,104 +182,82 @@ bool l1menu::TriggerTable::TriggerDetails::operator==( const l1menu::TriggerTabl
 
 std::unique_ptr<l1menu::ITrigger> l1menu::TriggerTable::getTrigger( const std::string& name ) const
 {
-//	std::cout << "Looking for latest version of " << name << std::endl;
-
-	std::unique_ptr<l1menu::ITrigger> returnValue;
-	unsigned int highestVersionNumber=0; // The highest version of the trigger encountered in the list so far
-
-	for( std::vector<TriggerTablePrivateMembers::TriggerRegistryEntry>::const_iterator iRegistryEntry=pImple_->registeredTriggers.begin(); iRegistryEntry!=pImple_->registeredTriggers.end(); ++iRegistryEntry )
-	{
-		if( iRegistryEntry->details.name==name && iRegistryEntry->details.version>=highestVersionNumber )
-		{
-			returnValue=(*iRegistryEntry->creationFunctionPointer)();
-			highestVersionNumber=iRegistryEntry->details.version;
-		}
-	}
+	const TriggerTablePrivateMembers::Registry& registry=*pImple_->pCurrentRegistry.load( std::memory_order_acquire );
 
-	return returnValue;
+	const auto iNameFindResult=registry.triggers.find( name );
+	if( iNameFindResult==registry.triggers.end() ) return std::unique_ptr<l1menu::ITrigger>();
+	// The versions are sorted, so the latest is the last one
+	else return iNameFindResult->second.rbegin()->second->creationFunction();
 }
 
 std::unique_ptr<l1menu::ITrigger> l1menu::TriggerTable::getTrigger( const std::string& name, unsigned int version ) const
 {
-	TriggerDetails requestedTriggerDetails{ name, version };
+	const TriggerTablePrivateMembers::TriggerRegistryEntry* pEntry=pImple_->findEntry( name, version );
 
-	// Delegate to the other overload
-	return getTrigger( requestedTriggerDetails );
+	// If there are no triggers registered that match the criteria return an empty pointer.
+	if( pEntry==nullptr ) return std::unique_ptr<l1menu::ITrigger>();
+	else return pEntry->creationFunction();
 }
 
 std::unique_ptr<l1menu::ITrigger> l1menu::TriggerTable::getTrigger( const TriggerDetails& details ) const
 {
-//	std::cout << "Looking for version " << details.version << " of " << details.name << std::endl;
-
-	for( std::vector<TriggerTablePrivateMembers::TriggerRegistryEntry>::const_iterator iRegistryEntry=pImple_->registeredTriggers.begin(); iRegistryEntry!=pImple_->registeredTriggers.end(); ++iRegistryEntry )
-	{
-		if( iRegistryEntry->details==details )
-		{
-			return (*iRegistryEntry->creationFunctionPointer)();
-		}
-	}
-
-	// If program flow has reached this point then there are no triggers registered that
-	// match the criteria. Return an empty pointer.
-	return std::unique_ptr<l1menu::ITrigger>();
+	// Delegate to the other overload
+	return getTrigger( details.name, details.version );
 }
 
 std::unique_ptr<l1menu::ITrigger> l1menu::TriggerTable::copyTrigger( const l1menu::ITriggerDescription& triggerToCopy ) const
 {
-	// First create a trigger with the matching name and version
-	std::unique_ptr<l1menu::ITrigger> newTrigger=getTrigger( triggerToCopy.name(), triggerToCopy.version() );
-
-	if( newTrigger.get()==NULL ) throw std::runtime_error( "Unable to copy trigger "+triggerToCopy.name() );
+	// If it's a full trigger it can copy itself, which is a lot quicker
+	const l1menu::ITrigger* pTriggerToCopy=dynamic_cast<const l1menu::ITrigger*>( &triggerToCopy );
+	if( pTriggerToCopy!=nullptr ) return pTriggerToCopy->clone();
 
-	//
-	// Now copy all of the parameters over.
-	//
-	// Get the parameter names
-	std::vector<std::string> parameterNames=triggerToCopy.parameterNames();
-	// Then run through and copy the value of each one
-	for( std::vector<std::string>::const_iterator iName=parameterNames.begin(); iName!=parameterNames.end(); ++iName )
-	{
-		newTrigger->parameter(*iName)=triggerToCopy.parameter(*iName);
-	}
+	const TriggerTablePrivateMembers::TriggerRegistryEntry* pEntry=pImple_->findEntry( triggerToCopy.name(), triggerToCopy.version() );
+	if( pEntry==nullptr ) throw std::runtime_error( "Unable to copy trigger "+triggerToCopy.name() );
 
-	return newTrigger;
+	return TriggerTablePrivateMembers::createAndCopyParameters( *pEntry, triggerToCopy );
 }
 
 std::vector<l1menu::TriggerTable::TriggerDetails> l1menu::TriggerTable::listTriggers() const
 {
-	std::vector<TriggerDetails> returnValue;
+	return pImple_->pCurrentRegistry.load( std::memory_order_acquire )->registrationOrder;
+}
 
-	// Copy the relevant parts from the registered triggers into the return value
-	for( std::vector<TriggerTablePrivateMembers::TriggerRegistryEntry>::const_iterator iRegistryEntry=pImple_->registeredTriggers.begin(); iRegistryEntry!=pImple_->registeredTriggers.end(); ++iRegistryEntry )
-	{
-		returnValue.push_back( iRegistryEntry->details );
-	}
+void l1menu::TriggerTable::registerTrigger( const std::string& name, unsigned int version, std::unique_ptr<l1menu::ITrigger> (*creationFunctionPointer)() )
+{
+	pImple_->addEntry( TriggerDetails{ name, version }, std::function<std::unique_ptr<l1menu::ITrigger>()>(creationFunctionPointer) );
+}
 
-	return returnValue;
+void l1menu::TriggerTable::registerTrigger( const std::string& name, unsigned int version, std::function<std::unique_ptr<l1menu::ITrigger>()> creationFunction )
+{
+	pImple_->addEntry( TriggerDetails{ name, version }, std::move(creationFunction) );
 }
 
-void l1menu::TriggerTable::registerTrigger( const std::string& name, unsigned int version, std::unique_ptr<l1menu::ITrigger> (*creationFunctionPointer)() )
+bool l1menu::TriggerTable::unregisterTrigger( const std::string& name, unsigned int version )
 {
-	TriggerDetails newTriggerDetails{ name, version };
+	std::lock_guard<std::mutex> lock( pImple_->mutex_ );
 
-	// First make sure there is not a trigger with the same name and version already registered
-	for( std::vector<TriggerTablePrivateMembers::TriggerRegistryEntry>::const_iterator iRegistryEntry=pImple_->registeredTriggers.begin(); iRegistryEntry!=pImple_->registeredTriggers.end(); ++iRegistryEntry )
+	std::unique_ptr<TriggerTablePrivateMembers::Registry> pNewRegistry( new TriggerTablePrivateMembers::Registry( *pImple_->pCurrentRegistry.load() ) );
+	const auto iNameFindResult=pNewRegistry->triggers.find( name );
+	if( iNameFindResult==pNewRegistry->triggers.end() ) return false;
+	if( iNameFindResult->second.erase( version )==0 ) return false;
+
+	// If that was the last version the binning suggestions aren't for anything anymore
+	if( iNameFindResult->second.empty() )
 	{
-		if( iRegistryEntry->details==newTriggerDetails )
-		{
-			std::stringstream errorMessage;
-			errorMessage << "A trigger called \"" << newTriggerDetails.name << "\" with version " << newTriggerDetails.version << " has already been registered in the trigger table.";
-			throw std::logic_error( errorMessage.str() );
-		}
+		pNewRegistry->triggers.erase( iNameFindResult );
+		pImple_->suggestedBinning_.erase( name );
 	}
 
-	// If program flow has reached this point then there are no triggers with the same name
-	// and version already registered, so it's okay to add the trigger as requested.
-	pImple_->registeredTriggers.push_back( TriggerTablePrivateMembers::TriggerRegistryEntry{newTriggerDetails,creationFunctionPointer} );
+	const TriggerDetails removedDetails{ name, version };
+	std::vector<TriggerDetails>& registrationOrder=pNewRegistry->registrationOrder;
+	registrationOrder.erase( std::remove( registrationOrder.begin(), registrationOrder.end(), removedDetails ), registrationOrder.end() );
+	pImple_->publish( std::move(pNewRegistry) );
+	return true;
 }
 
 void l1menu::TriggerTable::registerSuggestedBinning( const std::string& triggerName, const std::string& parameterName, unsigned int numberOfBins, float lowerEdge, float upperEdge )
 {
+	std::lock_guard<std::mutex> lock( pImple_->mutex_ );
 	pImple_->suggestedBinning_[triggerName][parameterName]={ numberOfBins, lowerEdge, upperEdge };
 }
 
@@ -0,0 +1,129 @@
+#include "ColumnScanMenu.h"
+
+#include <stdexcept>
+#include "l1menu/TriggerMenu.h"
+#include "l1menu/ITrigger.h"
+#include "l1menu/ReducedSample.h"
+
+// The same as in vectorisedKernels.cpp, the vectorised version uses the gcc "target" attribute
+// so that it is in the library whatever the compiler flags are. It's chosen at runtime.
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define L1MENU_HAVE_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+// Blocks mustn't go over the edge of a zone
+static_assert( l1menu::ReducedSample::eventsPerZone%l1menu::implementation::ColumnScanMenu::eventsPerBlock==0, "ReducedSample zones must be a whole number of ColumnScanMenu blocks" );
+
+const size_t l1menu::implementation::ColumnScanMenu::eventsPerBlock;
+
+namespace // Use the unnamed namespace for things only used in this file
+{
+	typedef uint64_t (*PassMaskFunction)( const float*, float, size_t );
+
+	// "Not less than" rather than "greater or equal" so that NaN passes, the same as the cached trigger
+	uint64_t passMaskScalar( const float* values, float threshold, size_t numberOfValues )
+	{
+		uint64_t mask=0;
+		for( size_t index=0; index<numberOfValues; ++index )
+		{
+			if( !(values[index]<threshold) ) mask|=static_cast<uint64_t>(1)<<index;
+		}
+		return mask;
+	}
+
+#ifdef L1MENU_HAVE_X86_KERNELS
+	__attribute__((target("avx2")))
+	uint64_t passMaskAVX2( const float* values, float threshold, size_t numberOfValues )
+	{
+		uint64_t mask=0;
+		size_t index=0;
+		const __m256 thresholds=_mm256_set1_ps( threshold );
+		for( ; index+8<=numberOfValues; index+=8 )
+		{
+			const __m256 passed=_mm256_cmp_ps( _mm256_loadu_ps(values+index), thresholds, _CMP_NLT_UQ );
+			mask|=static_cast<uint64_t>( _mm256_movemask_ps(passed) )<<index;
+		}
+		_mm256_zeroupper();
+		// Shifting by 64 isn't defined, so only do the rest if there is any
+		if( index<numberOfValues ) mask|=passMaskScalar( values+index, threshold, numberOfValues-index )<<index;
+		return mask;
+	}
+#endif
+
+	PassMaskFunction passMaskFunction( l1menu::tools::InstructionSet instructionSet )
+	{
+		if( !l1menu::tools::instructionSetIsAvailable( instructionSet ) ) throw std::runtime_error( "ColumnScanMenu::passMask - the requested instruction set is not available on this machine" );
+
+#ifdef L1MENU_HAVE_X86_KERNELS
+		// There isn't a separate SSE4 version, 64 compares aren't worth it
+		if( instructionSet==l1menu::tools::InstructionSet::AVX2 ) return &passMaskAVX2;
+#endif
+		return &passMaskScalar;
+	}
+}
+
+l1menu::implementation::ColumnScanMenu::ColumnScanMenu( const l1menu::TriggerMenu& menu, const l1menu::ReducedSample& sample )
+	: sample_(sample)
+{
+	for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+	{
+		triggerCuts_.push_back( createCuts( menu.getTrigger(triggerNumber) ) );
+	}
+}
+
+size_t l1menu::implementation::ColumnScanMenu::numberOfTriggers() const
+{
+	return triggerCuts_.size();
+}
+
+void l1menu::implementation::ColumnScanMenu::updateTrigger( size_t triggerNumber, const l1menu::ITrigger& trigger )
+{
+	triggerCuts_.at(triggerNumber)=createCuts( trigger );
+}
+
+uint64_t l1menu::implementation::ColumnScanMenu::applyTrigger( size_t triggerNumber, size_t firstEvent, size_t numberOfEvents ) const
+{
+	// A trigger with no thresholds passes everything, the same as the cached trigger
+	uint64_t passed=( numberOfEvents==eventsPerBlock ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1)<<numberOfEvents)-1 );
+	const size_t zone=firstEvent/l1menu::ReducedSample::eventsPerZone;
+	for( const auto& cut : triggerCuts_[triggerNumber] )
+	{
+		if( cut.pZoneMaxima[zone]<cut.threshold ) return 0; // Nothing in the zone can pass
+		if( !(cut.pZoneMinima[zone]<cut.threshold) ) continue; // Everything in the zone passes
+
+		passed&=passMask( cut.pColumn+firstEvent, cut.threshold, numberOfEvents );
+		if( passed==0 ) break;
+	}
+	return passed;
+}
+
+void l1menu::implementation::ColumnScanMenu::applyBlock( size_t firstEvent, size_t numberOfEvents, uint64_t* triggerBits ) const
+{
+	for( size_t triggerNumber=0; triggerNumber<triggerCuts_.size(); ++triggerNumber )
+	{
+		triggerBits[triggerNumber]=applyTrigger( triggerNumber, firstEvent, numberOfEvents );
+	}
+}
+
+uint64_t l1menu::implementation::ColumnScanMenu::passMask( const float* values, float threshold, size_t numberOfValues )
+{
+	static const ::PassMaskFunction bestFunction=::passMaskFunction( l1menu::tools::bestInstructionSet() );
+	return bestFunction( values, threshold, numberOfValues );
+}
+
+uint64_t l1menu::implementation::ColumnScanMenu::passMask( const float* values, float threshold, size_t numberOfValues, l1menu::tools::InstructionSet instructionSet )
+{
+	return ::passMaskFunction( instructionSet )( values, threshold, numberOfValues );
+}
+
+std::vector<l1menu::implementation::ColumnScanMenu::Cut> l1menu::implementation::ColumnScanMenu::createCuts( const l1menu::ITrigger& trigger ) const
+{
+	std::vector<Cut> cuts;
+	for( const auto& identifier : sample_.getTriggerParameterIdentifiers(trigger) )
+	{
+		cuts.push_back( Cut{ sample_.parameterColumn(identifier.second), sample_.parameterZoneMinima(identifier.second),
+				sample_.parameterZoneMaxima(identifier.second), trigger.parameter(identifier.first) } );
+	}
+	return cuts;
+}
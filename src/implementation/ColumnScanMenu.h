@@ -0,0 +1,86 @@
+#ifndef l1menu_implementation_ColumnScanMenu_h
+#define l1menu_implementation_ColumnScanMenu_h
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "l1menu/tools/vectorisedKernels.h"
+
+//
+// Forward declarations
+//
+namespace l1menu
+{
+	class ITrigger;
+	class TriggerMenu;
+	class ReducedSample;
+}
+
+
+namespace l1menu
+{
+	namespace implementation
+	{
+		/** @brief Applies a whole menu to the parameter columns of a ReducedSample, 64 events at a time.
+		 *
+		 * An event in a ReducedSample passes a trigger if each of the trigger's thresholds is at or below the
+		 * value stored for it. So instead of a virtual ICachedTrigger::apply per event per trigger, this takes
+		 * the columns from ReducedSample::parameterColumn and compares a block of consecutive events to each
+		 * threshold in one go. The comparisons give a bit mask, and the masks for a trigger's thresholds are
+		 * ANDed. On CPUs with AVX2 the compares are done eight events at a time, otherwise there's a plain
+		 * loop. Which is used is decided at runtime, like the kernels in l1menu/tools/vectorisedKernels.h.
+		 * Before comparing, the zone maps from the sample are checked so that blocks where no event can pass
+		 * a threshold, or where every event does, aren't looked at.
+		 *
+		 * The results are exactly the same as the ReducedSample's cached triggers. The thresholds are copied
+		 * when this is created, so changes to the menu afterwards need updateTrigger. The sample must outlive
+		 * this object and not have events added while it's in use.
+		 */
+		class ColumnScanMenu
+		{
+		public:
+			static const size_t eventsPerBlock=64;
+
+			ColumnScanMenu( const l1menu::TriggerMenu& menu, const l1menu::ReducedSample& sample );
+
+			size_t numberOfTriggers() const;
+
+			/** @brief Copies the thresholds again from the trigger, which must be the same trigger with
+			 * different thresholds. Throws a std::runtime_error if the sample wasn't made with it. */
+			void updateTrigger( size_t triggerNumber, const l1menu::ITrigger& trigger );
+
+			/** @brief Whether each event in the block passed the trigger, with bit "n" for event firstEvent+n.
+			 * The events can't go over a multiple of eventsPerBlock, so that they're all in the same zone, and
+			 * numberOfEvents must be no more than eventsPerBlock. */
+			uint64_t applyTrigger( size_t triggerNumber, size_t firstEvent, size_t numberOfEvents ) const;
+
+			/** @brief Applies every trigger to the block of events, setting triggerBits[triggerNumber] to the
+			 * result of applyTrigger. */
+			void applyBlock( size_t firstEvent, size_t numberOfEvents, uint64_t* triggerBits ) const;
+
+			/** @brief Sets a bit for every value that is not less than the threshold, with bit "n" for values[n].
+			 * numberOfValues must be no more than eventsPerBlock. */
+			static uint64_t passMask( const float* values, float threshold, size_t numberOfValues );
+			/** @brief Same as the other passMask but forces the instruction set used, for testing. Throws a
+			 * std::runtime_error if the instruction set is not available on this machine. */
+			static uint64_t passMask( const float* values, float threshold, size_t numberOfValues, l1menu::tools::InstructionSet instructionSet );
+		private:
+			/** @brief A column and the threshold to compare it to. */
+			struct Cut
+			{
+				const float* pColumn;
+				const float* pZoneMinima; ///< See ReducedSample::parameterZoneMinima
+				const float* pZoneMaxima;
+				float threshold;
+			};
+			/** @brief Looks up the columns for the trigger thresholds in the sample. */
+			std::vector<Cut> createCuts( const l1menu::ITrigger& trigger ) const;
+
+			const l1menu::ReducedSample& sample_;
+			std::vector< std::vector<Cut> > triggerCuts_;
+		};
+
+	} // end of namespace implementation
+} // end of namespace l1menu
+
+#endif
@@ -0,0 +1,209 @@
+#include "CompiledMenu.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include "l1menu/ITrigger.h"
+#include "l1menu/TriggerMenu.h"
+#include "l1menu/L1TriggerDPGEvent.h"
+#include "../triggers/CrossTrigger.h"
+#include "../triggers/SingleObjectTrigger.h"
+#include "../triggers/DeclarativeTrigger.h"
+
+namespace // Use the unnamed namespace for things only used in this file
+{
+	/** @brief Something that is the same for two triggers if, and only if, they have the same name, version
+	 * and parameters. The parameter with skipHandle is left out, if it's a valid handle.
+	 *
+	 * The bytes of the floats are used rather than the values, which means that e.g. 0 and -0 count as
+	 * different. That's fine, it just means the two don't get shared. */
+	std::string selectionKey( const l1menu::ITrigger& trigger, size_t skipHandle )
+	{
+		std::string key=trigger.name()+"\n"+std::to_string( trigger.version() )+"\n";
+		const size_t numberOfParameters=trigger.parameterNames().size();
+		for( size_t handle=0; handle<numberOfParameters; ++handle )
+		{
+			if( handle==skipHandle ) continue;
+			const float value=trigger.parameter( handle );
+			key.append( reinterpret_cast<const char*>(&value), sizeof(value) );
+		}
+		return key;
+	}
+}
+
+l1menu::implementation::CompiledMenu::CompiledMenu( const l1menu::TriggerMenu& menu )
+{
+	// The keys are only needed while compiling, so there's no point keeping them as a member
+	std::map<std::string,size_t> selectionIndices;
+	for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+	{
+		triggerLegs_.push_back( std::vector<Leg>() );
+		addLegs( menu.getTrigger(triggerNumber), triggerLegs_.back(), selectionIndices );
+	}
+
+	highestPassingEt_.resize( selections_.size() );
+	selectionPassed_.resize( selections_.size() );
+	fusedNumberFound_.resize( fusedLegs_.size() );
+}
+
+void l1menu::implementation::CompiledMenu::addLegs( const l1menu::ITrigger& trigger, std::vector<Leg>& legs, std::map<std::string,size_t>& selectionIndices )
+{
+	// The result of a cross trigger is always the AND of its legs (CrossTrigger::apply is final), which
+	// could be cross triggers themselves.
+	const l1menu::triggers::CrossTrigger* pCrossTrigger=dynamic_cast<const l1menu::triggers::CrossTrigger*>( &trigger );
+	if( pCrossTrigger!=nullptr )
+	{
+		addLegs( pCrossTrigger->leg1(), legs, selectionIndices );
+		addLegs( pCrossTrigger->leg2(), legs, selectionIndices );
+		return;
+	}
+
+	// Single object triggers are shared regardless of the threshold, everything else has to have
+	// all parameters the same.
+	const l1menu::triggers::SingleObjectTrigger* pSingleObjectTrigger=dynamic_cast<const l1menu::triggers::SingleObjectTrigger*>( &trigger );
+	const size_t skipHandle=( pSingleObjectTrigger!=nullptr ? l1menu::triggers::SingleObjectTrigger::threshold1Handle : static_cast<size_t>(-1) );
+
+	Leg leg;
+	// If this is a new selection insert will add it with the next index, otherwise it returns the existing one
+	auto insertResult=selectionIndices.insert( std::make_pair( selectionKey( trigger, skipHandle ), selections_.size() ) );
+	leg.selectionIndex=insertResult.first->second;
+	if( insertResult.second )
+	{
+		const l1menu::triggers::DeclarativeTrigger* pDeclarativeTrigger=dynamic_cast<const l1menu::triggers::DeclarativeTrigger*>( &trigger );
+		if( pDeclarativeTrigger!=nullptr ) addFusedSelection( leg.selectionIndex, *pDeclarativeTrigger );
+		selections_.push_back( Selection{ &trigger, pSingleObjectTrigger, pDeclarativeTrigger } );
+	}
+	leg.threshold=( pSingleObjectTrigger!=nullptr ? trigger.parameter( l1menu::triggers::SingleObjectTrigger::threshold1Handle ) : 0 );
+	legs.push_back( leg );
+}
+
+void l1menu::implementation::CompiledMenu::addFusedSelection( size_t selectionIndex, const l1menu::triggers::DeclarativeTrigger& trigger )
+{
+	const l1menu::triggers::DeclarativeTriggerPlan& plan=trigger.plan();
+	const float* parameters=trigger.parameterValues();
+	fusedSelections_.push_back( FusedSelection{ selectionIndex, &plan, std::vector<float>( parameters, parameters+plan.parameterNames.size() ), fusedLegs_.size() } );
+
+	for( size_t legIndex=0; legIndex<plan.legs.size(); ++legIndex )
+	{
+		const l1menu::triggers::DeclarativeTriggerPlan::Leg& leg=plan.legs[legIndex];
+
+		// Find the loop over this leg's collection, or start a new one
+		auto iCollection=fusedCollections_.begin();
+		while( iCollection!=fusedCollections_.end() && iCollection->pColumns!=leg.pColumns ) ++iCollection;
+		if( iCollection==fusedCollections_.end() )
+		{
+			fusedCollections_.push_back( FusedCollection{ leg.pColumns, std::vector<size_t>() } );
+			iCollection=fusedCollections_.end()-1;
+		}
+		iCollection->fusedLegIndices.push_back( fusedLegs_.size() );
+
+		fusedLegs_.push_back( FusedLeg{ fusedSelections_.size()-1, legIndex, fusedLeading_.size() } );
+		fusedLeading_.resize( fusedLeading_.size()+leg.multiplicity );
+	}
+}
+
+void l1menu::implementation::CompiledMenu::applyFused( const l1menu::L1TriggerDPGEvent& event, size_t eventIndex ) const
+{
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias )
+	{
+		for( const auto& fusedSelection : fusedSelections_ ) selectionPassed_[fusedSelection.selectionIndex][eventIndex]=false;
+		return;
+	}
+
+	// One pass over each collection, with every leg that uses it looking at each object in turn
+	std::fill( fusedNumberFound_.begin(), fusedNumberFound_.end(), 0 );
+	for( const auto& fusedCollection : fusedCollections_ )
+	{
+		const l1menu::L1TriggerDPGEvent::ObjectColumns& columns=objects.*fusedCollection.pColumns;
+		for( size_t objectIndex=0; objectIndex<columns.et.size(); ++objectIndex )
+		{
+			for( const size_t fusedLegIndex : fusedCollection.fusedLegIndices )
+			{
+				const FusedLeg& fusedLeg=fusedLegs_[fusedLegIndex];
+				const FusedSelection& fusedSelection=fusedSelections_[fusedLeg.fusedSelectionIndex];
+				const l1menu::triggers::DeclarativeTriggerPlan::Leg& leg=fusedSelection.pPlan->legs[fusedLeg.legIndex];
+				if( fusedSelection.pPlan->objectPasses( leg, columns, objectIndex, fusedSelection.parameters.data() ) )
+				{
+					l1menu::triggers::DeclarativeTriggerPlan::addToLeading( &fusedLeading_[fusedLeg.firstLeading], fusedNumberFound_[fusedLegIndex], leg.multiplicity, columns.et[objectIndex] );
+				}
+			}
+		}
+	}
+
+	// Then combine the legs for each selection
+	for( const auto& fusedSelection : fusedSelections_ )
+	{
+		const l1menu::triggers::DeclarativeTriggerPlan& plan=*fusedSelection.pPlan;
+		bool passed=plan.requireAllLegs;
+		for( size_t legIndex=0; legIndex<plan.legs.size(); ++legIndex )
+		{
+			const size_t fusedLegIndex=fusedSelection.firstLeg+legIndex;
+			const bool legPassed=plan.thresholdsPass( plan.legs[legIndex], &fusedLeading_[fusedLegs_[fusedLegIndex].firstLeading], fusedNumberFound_[fusedLegIndex], fusedSelection.parameters.data() );
+			if( legPassed!=plan.requireAllLegs )
+			{
+				passed=legPassed;
+				break;
+			}
+		}
+		selectionPassed_[fusedSelection.selectionIndex][eventIndex]=passed;
+	}
+}
+
+size_t l1menu::implementation::CompiledMenu::numberOfTriggers() const
+{
+	return triggerLegs_.size();
+}
+
+size_t l1menu::implementation::CompiledMenu::numberOfSelections() const
+{
+	return selections_.size();
+}
+
+void l1menu::implementation::CompiledMenu::applyBatch( const std::vector<const l1menu::L1TriggerDPGEvent*>& events, std::vector< std::vector<bool> >& results ) const
+{
+	// First evaluate each selection once for all of the events
+	for( size_t selectionIndex=0; selectionIndex<selections_.size(); ++selectionIndex )
+	{
+		const Selection& selection=selections_[selectionIndex];
+		if( selection.pSingleObjectTrigger!=nullptr )
+		{
+			std::vector<float>& highestPassingEt=highestPassingEt_[selectionIndex];
+			highestPassingEt.resize( events.size() );
+			for( size_t index=0; index<events.size(); ++index ) highestPassingEt[index]=selection.pSingleObjectTrigger->highestPassingEt( *events[index] );
+		}
+		else if( selection.pDeclarativeTrigger!=nullptr ) selectionPassed_[selectionIndex].resize( events.size() );
+		else selection.pTrigger->applyBatch( events, selectionPassed_[selectionIndex] );
+	}
+	if( !fusedSelections_.empty() )
+	{
+		for( size_t index=0; index<events.size(); ++index ) applyFused( *events[index], index );
+	}
+
+	// Then combine them for each trigger
+	results.resize( triggerLegs_.size() );
+	for( size_t triggerNumber=0; triggerNumber<triggerLegs_.size(); ++triggerNumber )
+	{
+		std::vector<bool>& triggerResults=results[triggerNumber];
+		triggerResults.assign( events.size(), true );
+		for( const auto& leg : triggerLegs_[triggerNumber] )
+		{
+			if( selections_[leg.selectionIndex].pSingleObjectTrigger!=nullptr )
+			{
+				const std::vector<float>& highestPassingEt=highestPassingEt_[leg.selectionIndex];
+				for( size_t index=0; index<events.size(); ++index )
+				{
+					if( !(highestPassingEt[index]>=leg.threshold) ) triggerResults[index]=false;
+				}
+			}
+			else
+			{
+				const std::vector<bool>& selectionPassed=selectionPassed_[leg.selectionIndex];
+				for( size_t index=0; index<events.size(); ++index )
+				{
+					if( !selectionPassed[index] ) triggerResults[index]=false;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,116 @@
+#ifndef l1menu_implementation_CompiledMenu_h
+#define l1menu_implementation_CompiledMenu_h
+
+#include <vector>
+#include <map>
+#include <string>
+#include <cstddef>
+#include "l1menu/L1TriggerDPGEvent.h"
+
+//
+// Forward declarations
+//
+namespace l1menu
+{
+	class ITrigger;
+	class TriggerMenu;
+	namespace triggers
+	{
+		class SingleObjectTrigger;
+		class DeclarativeTrigger;
+		class DeclarativeTriggerPlan;
+	}
+}
+
+
+namespace l1menu
+{
+	namespace implementation
+	{
+		/** @brief Version of a TriggerMenu that evaluates selections shared between triggers only once per event.
+		 *
+		 * Cross triggers are split into their legs, and each trigger or leg is a "selection". Selections
+		 * that are the same trigger with the same parameters are only evaluated once. For single object
+		 * triggers the threshold isn't part of the selection: the highest passing Et is found once and
+		 * compared to the threshold of each trigger or leg that uses it. So e.g. L1_SingleIsoEG and the
+		 * isolated EG leg of L1_IsoEG_Mu share the work if they have the same region cut.
+		 *
+		 * The results are exactly the same as calling apply on each trigger. The menu must outlive this
+		 * object and not be changed while it's in use, since the thresholds are copied when it's created.
+		 */
+		class CompiledMenu
+		{
+		public:
+			explicit CompiledMenu( const l1menu::TriggerMenu& menu );
+
+			size_t numberOfTriggers() const;
+			/** @brief The number of distinct selections that get evaluated for each event. */
+			size_t numberOfSelections() const;
+
+			/** @brief Applies every trigger in the menu to each of the events.
+			 *
+			 * @param[in]  events   The events to apply the menu to.
+			 * @param[out] results  Resized to numberOfTriggers(), and results[triggerNumber][eventIndex] is set
+			 *                      to whether that trigger passed that event.
+			 */
+			void applyBatch( const std::vector<const l1menu::L1TriggerDPGEvent*>& events, std::vector< std::vector<bool> >& results ) const;
+		private:
+			/** @brief A distinct trigger, or leg of a cross trigger, that is evaluated once per event. */
+			struct Selection
+			{
+				const l1menu::ITrigger* pTrigger;
+				/// Not null if the selection is a single object trigger, in which case the threshold isn't applied here.
+				const l1menu::triggers::SingleObjectTrigger* pSingleObjectTrigger;
+				/// Not null if the selection is evaluated as part of the fused declarative trigger pass.
+				const l1menu::triggers::DeclarativeTrigger* pDeclarativeTrigger;
+			};
+			/** @brief A selection used by a trigger, and the threshold to use if it's a single object trigger. */
+			struct Leg
+			{
+				size_t selectionIndex;
+				float threshold;
+			};
+
+			/** @brief A declarative trigger selection, with a copy of its parameters. Its legs are a range in fusedLegs_. */
+			struct FusedSelection
+			{
+				size_t selectionIndex;
+				const l1menu::triggers::DeclarativeTriggerPlan* pPlan;
+				std::vector<float> parameters;
+				size_t firstLeg;
+			};
+			/** @brief A leg of a declarative trigger, and where its leading objects are kept in fusedLeading_. */
+			struct FusedLeg
+			{
+				size_t fusedSelectionIndex;
+				size_t legIndex; ///< The index in the plan's legs
+				size_t firstLeading;
+			};
+			/** @brief All of the fused legs that look at one collection. */
+			struct FusedCollection
+			{
+				l1menu::L1TriggerDPGEvent::ObjectColumns l1menu::L1TriggerDPGEvent::PrefilteredObjects::* pColumns;
+				std::vector<size_t> fusedLegIndices;
+			};
+
+			void addLegs( const l1menu::ITrigger& trigger, std::vector<Leg>& legs, std::map<std::string,size_t>& selectionIndices );
+			void addFusedSelection( size_t selectionIndex, const l1menu::triggers::DeclarativeTrigger& trigger );
+			/** @brief Sets selectionPassed_[...][eventIndex] for all of the declarative trigger selections. */
+			void applyFused( const l1menu::L1TriggerDPGEvent& event, size_t eventIndex ) const;
+
+			std::vector<Selection> selections_;
+			std::vector< std::vector<Leg> > triggerLegs_; ///< The trigger passes if all of its legs pass
+			mutable std::vector< std::vector<float> > highestPassingEt_; ///< Per event results for the single object selections
+			mutable std::vector< std::vector<bool> > selectionPassed_; ///< Per event results for all other selections
+
+			std::vector<FusedSelection> fusedSelections_;
+			std::vector<FusedLeg> fusedLegs_;
+			std::vector<FusedCollection> fusedCollections_;
+			mutable std::vector<float> fusedLeading_; ///< Leading object Et for each fused leg
+			mutable std::vector<size_t> fusedNumberFound_; ///< How many entries of fusedLeading_ each fused leg has filled
+		};
+
+	} // end of namespace implementation
+} // end of namespace l1menu
+
+#endif
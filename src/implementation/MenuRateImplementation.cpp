@@ -14,6 +14,7 @@
 #include "l1menu/IEvent.h"
 #include "l1menu/TriggerRatePlot.h"
 #include "l1menu/MenuRatePlots.h"
+#include "l1menu/MenuRateSums.h"
 #include "TriggerRateImplementation.h"
 #include "TriggerDescriptionWithErrorsFromXML.h"
 #include "l1menu/tools/XMLFile.h"
@@ -21,95 +22,78 @@
 #include "l1menu/tools/fileIO.h"
 
 
-void l1menu::implementation::MenuRateImplementation::commonConstruction( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample )
+void l1menu::implementation::MenuRateImplementation::commonConstruction( const l1menu::MenuRateSums& menuRateSums )
 {
+	// All of the event loop work is done in MenuRateSums, so that the sums can be
+	// merged from several jobs first if required. All that's left is to normalise, and
+	// take the errors from the spread of the bootstrap replicas if there are any.
+	const l1menu::TriggerMenu& menu=menuRateSums.menu();
+	double weightOfAllEvents=menuRateSums.sumOfWeights();
+	float scaling=menuRateSums.eventRate();
+	const bool useBootstrap=( menuRateSums.numberOfBootstrapReplicas()>0 );
 
-	// The sum of event weights that pass each trigger
-	std::vector<float> weightOfEventsPassed( menu.numberOfTriggers() );
-	// The sume of weights squared that pass each trigger. Used to calculate the error.
-	std::vector<float> weightSquaredOfEventsPassed( menu.numberOfTriggers() );
-
-	// The number of events that only pass the given trigger
-	std::vector<float> weightOfEventsPure( menu.numberOfTriggers() );
-	std::vector<float> weightSquaredOfEventsPure( menu.numberOfTriggers() );
-
-	float weightOfEventsPassingAnyTrigger=0;
-	float weightSquaredOfEventsPassingAnyTrigger=0;
-	float weightOfAllEvents=0;
-
-	// Using cached triggers significantly increases speed for ReducedSample
-	// because it cuts out expensive string comparisons when querying the trigger
-	// parameters.
-	std::vector< std::unique_ptr<l1menu::ICachedTrigger> > cachedTriggers;
 	for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
 	{
-		cachedTriggers.push_back( sample.createCachedTrigger( menu.getTrigger( triggerNumber ) ) );
-	}
-
-	size_t numberOfLastPassedTrigger=0; // This is just so I can work out the pure rate
-
-	for( size_t eventNumber=0; eventNumber<sample.numberOfEvents(); ++eventNumber )
-	{
-		const l1menu::IEvent& event=sample.getEvent(eventNumber);
-		float weight=event.weight();
-		weightOfAllEvents+=weight;
-
-		size_t numberOfTriggersPassed=0;
-
-		for( size_t triggerNumber=0; triggerNumber<cachedTriggers.size(); ++triggerNumber )
+		float fraction=menuRateSums.weightOfEventsPassed(triggerNumber)/weightOfAllEvents;
+		float fractionError=std::sqrt(menuRateSums.weightSquaredOfEventsPassed(triggerNumber))/weightOfAllEvents;
+		float pureFraction=menuRateSums.weightOfEventsPure(triggerNumber)/weightOfAllEvents;
+		float pureFractionError=std::sqrt(menuRateSums.weightSquaredOfEventsPure(triggerNumber))/weightOfAllEvents;
+		if( useBootstrap )
 		{
-			if( cachedTriggers[triggerNumber]->apply(event) )
-			{
-				// If the event passes the trigger, increment the counters
-				++numberOfTriggersPassed;
-				weightOfEventsPassed[triggerNumber]+=weight;
-				weightSquaredOfEventsPassed[triggerNumber]+=(weight*weight);
-				numberOfLastPassedTrigger=triggerNumber; // If only one event passes, this is used to increment the pure counter
-			}
-		}
-
-		// See if I should increment any of the pure or total counters
-		if( numberOfTriggersPassed==1 )
-		{
-			weightOfEventsPure[numberOfLastPassedTrigger]+=weight;
-			weightSquaredOfEventsPure[numberOfLastPassedTrigger]+=(weight*weight);
-		}
-		if( numberOfTriggersPassed>0 )
-		{
-			weightOfEventsPassingAnyTrigger+=weight;
-			weightSquaredOfEventsPassingAnyTrigger+=(weight*weight);
+			fractionError=menuRateSums.bootstrapFractionError(triggerNumber);
+			pureFractionError=menuRateSums.bootstrapPureFractionError(triggerNumber);
 		}
-	}
-
-	float scaling=sample.eventRate();
-
-	for( size_t triggerNumber=0; triggerNumber<cachedTriggers.size(); ++triggerNumber )
-	{
-		float fraction=weightOfEventsPassed[triggerNumber]/weightOfAllEvents;
-		float fractionError=std::sqrt(weightSquaredOfEventsPassed[triggerNumber])/weightOfAllEvents;
-		float pureFraction=weightOfEventsPure[triggerNumber]/weightOfAllEvents;
-		float pureFractionError=std::sqrt(weightSquaredOfEventsPure[triggerNumber])/weightOfAllEvents;
 		triggerRates_.push_back( std::move(TriggerRateImplementation(menu.getTrigger(triggerNumber),fraction,fractionError,fraction*scaling,fractionError*scaling,pureFraction,pureFractionError,pureFraction*scaling,pureFractionError*scaling) ) );
-		//triggerRates_.push_back( std::move(TriggerRateImplementation(menu.getTrigger(triggerNumber),weightOfEventsPassed[triggerNumber],weightSquaredOfEventsPassed[triggerNumber],weightOfEventsPure[triggerNumber],weightSquaredOfEventsPure[triggerNumber],*this)) );
 	}
 
 	//
 	// Now I have everything I need to calculate all of the values required by the interface
 	//
-	totalFraction_=weightOfEventsPassingAnyTrigger/weightOfAllEvents;
-	totalFractionError_=std::sqrt(weightSquaredOfEventsPassingAnyTrigger)/weightOfAllEvents;
+	totalFraction_=menuRateSums.weightOfEventsPassingAnyTrigger()/weightOfAllEvents;
+	totalFractionError_=std::sqrt(menuRateSums.weightSquaredOfEventsPassingAnyTrigger())/weightOfAllEvents;
+	if( useBootstrap ) totalFractionError_=menuRateSums.bootstrapTotalFractionError();
 	totalRate_=totalFraction_*scaling;
 	totalRateError_=totalFractionError_*scaling;
+
+	if( menuRateSums.hasOverlaps() )
+	{
+		const size_t numberOfTriggers=menu.numberOfTriggers();
+		overlapFractions_.resize( numberOfTriggers*numberOfTriggers );
+		overlapFractionErrors_.resize( numberOfTriggers*numberOfTriggers );
+		overlapRates_.resize( numberOfTriggers*numberOfTriggers );
+		overlapRateErrors_.resize( numberOfTriggers*numberOfTriggers );
+		for( size_t firstTriggerNumber=0; firstTriggerNumber<numberOfTriggers; ++firstTriggerNumber )
+		{
+			for( size_t secondTriggerNumber=0; secondTriggerNumber<numberOfTriggers; ++secondTriggerNumber )
+			{
+				size_t index=firstTriggerNumber*numberOfTriggers+secondTriggerNumber;
+				overlapFractions_[index]=menuRateSums.weightOfEventsPassedBoth(firstTriggerNumber,secondTriggerNumber)/weightOfAllEvents;
+				overlapFractionErrors_[index]=std::sqrt(menuRateSums.weightSquaredOfEventsPassedBoth(firstTriggerNumber,secondTriggerNumber))/weightOfAllEvents;
+				overlapRates_[index]=overlapFractions_[index]*scaling;
+				overlapRateErrors_[index]=overlapFractionErrors_[index]*scaling;
+			}
+		}
+	}
 }
 
 l1menu::implementation::MenuRateImplementation::MenuRateImplementation( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample )
 {
-	commonConstruction( menu, sample );
+	commonConstruction( l1menu::MenuRateSums( menu, sample ) );
+}
+
+l1menu::implementation::MenuRateImplementation::MenuRateImplementation( const l1menu::MenuRateSums& menuRateSums )
+{
+	commonConstruction( menuRateSums );
 }
 
 l1menu::implementation::MenuRateImplementation::MenuRateImplementation( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample, const l1menu::MenuRatePlots& menuRatePlots )
 {
-	commonConstruction( menu, sample );
+	commonConstruction( l1menu::MenuRateSums( menu, sample ) );
+	setThresholdErrors( menuRatePlots );
+}
+
+void l1menu::implementation::MenuRateImplementation::setThresholdErrors( const l1menu::MenuRatePlots& menuRatePlots )
+{
 	// Loop over each of the trigger rates and try to set their threshold errors
 	// from the information in the rate plots.
 	for( auto& triggerRate : triggerRates_ )
@@ -205,6 +189,56 @@ l1menu::implementation::MenuRateImplementation::MenuRateImplementation( const l1
 
 		triggerRates_.push_back( std::move(TriggerRateImplementation(triggerDescription,fraction,fractionError,rate,rateError,pureFraction,pureFractionError,pureRate,pureRateError) ) );
 	}
+
+	// The overlaps are optional, and only the upper triangle is stored
+	parameterElements=xmlDescription.getChildren("TriggerOverlap");
+	if( !parameterElements.empty() )
+	{
+		const size_t numberOfTriggers=triggerRates_.size();
+		overlapFractions_.resize( numberOfTriggers*numberOfTriggers );
+		overlapFractionErrors_.resize( numberOfTriggers*numberOfTriggers );
+		overlapRates_.resize( numberOfTriggers*numberOfTriggers );
+		overlapRateErrors_.resize( numberOfTriggers*numberOfTriggers );
+		for( size_t triggerNumber=0; triggerNumber<numberOfTriggers; ++triggerNumber )
+		{
+			size_t index=triggerNumber*numberOfTriggers+triggerNumber;
+			overlapFractions_[index]=triggerRates_[triggerNumber].fraction();
+			overlapFractionErrors_[index]=triggerRates_[triggerNumber].fractionError();
+			overlapRates_[index]=triggerRates_[triggerNumber].rate();
+			overlapRateErrors_[index]=triggerRates_[triggerNumber].rateError();
+		}
+
+		for( const auto& overlapElement : parameterElements )
+		{
+			int first=overlapElement.getIntAttribute("first");
+			int second=overlapElement.getIntAttribute("second");
+			if( first<0 || second<0 || static_cast<size_t>(first)>=numberOfTriggers || static_cast<size_t>(second)>=numberOfTriggers ) throw std::runtime_error( "Failed to create IMenuRate from XML because one of the TriggerOverlap elements has trigger numbers out of range." );
+
+			std::vector<l1menu::tools::XMLElement> overlapElements=overlapElement.getChildren("fraction");
+			if( overlapElements.size()!=1 ) throw std::runtime_error( "Failed to create IMenuRate from XML because one of the TriggerOverlap elements did not have one and only one 'fraction' child." );
+			float fraction=overlapElements.front().getFloatValue();
+
+			overlapElements=overlapElement.getChildren("fractionError");
+			if( overlapElements.size()!=1 ) throw std::runtime_error( "Failed to create IMenuRate from XML because one of the TriggerOverlap elements did not have one and only one 'fractionError' child." );
+			float fractionError=overlapElements.front().getFloatValue();
+
+			overlapElements=overlapElement.getChildren("rate");
+			if( overlapElements.size()!=1 ) throw std::runtime_error( "Failed to create IMenuRate from XML because one of the TriggerOverlap elements did not have one and only one 'rate' child." );
+			float rate=overlapElements.front().getFloatValue();
+
+			overlapElements=overlapElement.getChildren("rateError");
+			if( overlapElements.size()!=1 ) throw std::runtime_error( "Failed to create IMenuRate from XML because one of the TriggerOverlap elements did not have one and only one 'rateError' child." );
+			float rateError=overlapElements.front().getFloatValue();
+
+			for( size_t index : { first*numberOfTriggers+second, second*numberOfTriggers+first } )
+			{
+				overlapFractions_[index]=fraction;
+				overlapFractionErrors_[index]=fractionError;
+				overlapRates_[index]=rate;
+				overlapRateErrors_[index]=rateError;
+			}
+		}
+	}
 }
 
 void l1menu::implementation::MenuRateImplementation::setTotalFraction( float totalFraction )
@@ -273,3 +307,36 @@ const std::vector<const l1menu::ITriggerRate*>& l1menu::implementation::MenuRate
 
 	return baseClassPointers_;
 }
+
+const l1menu::IMenuRateOverlaps* l1menu::implementation::MenuRateImplementation::overlaps() const
+{
+	if( overlapFractions_.empty() || overlapFractions_.size()!=triggerRates_.size()*triggerRates_.size() ) return nullptr;
+	else return this;
+}
+
+size_t l1menu::implementation::MenuRateImplementation::overlapIndex( size_t firstTriggerNumber, size_t secondTriggerNumber ) const
+{
+	if( overlaps()==nullptr ) throw std::logic_error( "MenuRateImplementation - the trigger overlaps were requested but they are not available" );
+	if( firstTriggerNumber>=triggerRates_.size() || secondTriggerNumber>=triggerRates_.size() ) throw std::out_of_range( "MenuRateImplementation - trigger number for the overlaps is out of range" );
+	return firstTriggerNumber*triggerRates_.size()+secondTriggerNumber;
+}
+
+float l1menu::implementation::MenuRateImplementation::overlapFraction( size_t firstTriggerNumber, size_t secondTriggerNumber ) const
+{
+	return overlapFractions_[overlapIndex(firstTriggerNumber,secondTriggerNumber)];
+}
+
+float l1menu::implementation::MenuRateImplementation::overlapFractionError( size_t firstTriggerNumber, size_t secondTriggerNumber ) const
+{
+	return overlapFractionErrors_[overlapIndex(firstTriggerNumber,secondTriggerNumber)];
+}
+
+float l1menu::implementation::MenuRateImplementation::overlapRate( size_t firstTriggerNumber, size_t secondTriggerNumber ) const
+{
+	return overlapRates_[overlapIndex(firstTriggerNumber,secondTriggerNumber)];
+}
+
+float l1menu::implementation::MenuRateImplementation::overlapRateError( size_t firstTriggerNumber, size_t secondTriggerNumber ) const
+{
+	return overlapRateErrors_[overlapIndex(firstTriggerNumber,secondTriggerNumber)];
+}
@@ -2,6 +2,7 @@
 #define l1menu_implementation_MenuRateImplementation_h
 
 #include "l1menu/IMenuRate.h"
+#include "l1menu/IMenuRateOverlaps.h"
 #include <vector>
 #include "TriggerRateImplementation.h"
 
@@ -15,6 +16,7 @@ namespace l1menu
 	class TriggerMenu;
 	class ISample;
 	class MenuRatePlots;
+	class MenuRateSums;
 	namespace tools
 	{
 		class XMLElement;
@@ -27,17 +29,22 @@ namespace l1menu
 	namespace implementation
 	{
 		/** @brief Implementation of the IMenuRate interface.
+		 *
+		 * Also implements IMenuRateOverlaps if the overlaps are known, i.e. when created from MenuRateSums
+		 * that have them or from XML that includes them.
 		 *
 		 * @author Mark Grimes (mark.grimes@bristol.ac.uk)
 		 * @date 28/Jun/2013
 		 */
-		class MenuRateImplementation : public l1menu::IMenuRate
+		class MenuRateImplementation : public l1menu::IMenuRate, public l1menu::IMenuRateOverlaps
 		{
 		public:
 			MenuRateImplementation();
 			MenuRateImplementation( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample );
 			MenuRateImplementation( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample, const l1menu::MenuRatePlots& menuRatePlots );
 			MenuRateImplementation( const l1menu::tools::XMLElement& xmlDescription );
+			/** @brief Calculates the fractions and rates from previously accumulated (and possibly merged) raw sums. */
+			explicit MenuRateImplementation( const l1menu::MenuRateSums& menuRateSums );
 
 			// Methods to allow modification of the underlying data
 			void setTotalFraction( float totalFraction );
@@ -45,6 +52,8 @@ namespace l1menu
 			void setTotalRate( float totalRate );
 			void setTotalRateError( float totalRateError );
 			void addTriggerRate( l1menu::implementation::TriggerRateImplementation&& triggerRate );
+			/** @brief Sets the errors on the main threshold of each trigger from the matching rate plot, where there is one. */
+			void setThresholdErrors( const l1menu::MenuRatePlots& menuRatePlots );
 
 			// Methods required by the l1menu::IMenuRate interface
 			virtual float totalFraction() const;
@@ -52,14 +61,28 @@ namespace l1menu
 			virtual float totalRate() const;
 			virtual float totalRateError() const;
 			virtual const std::vector<const l1menu::ITriggerRate*>& triggerRates() const;
+			virtual const l1menu::IMenuRateOverlaps* overlaps() const;
+
+			// Methods required by the l1menu::IMenuRateOverlaps interface
+			virtual float overlapFraction( size_t firstTriggerNumber, size_t secondTriggerNumber ) const;
+			virtual float overlapFractionError( size_t firstTriggerNumber, size_t secondTriggerNumber ) const;
+			virtual float overlapRate( size_t firstTriggerNumber, size_t secondTriggerNumber ) const;
+			virtual float overlapRateError( size_t firstTriggerNumber, size_t secondTriggerNumber ) const;
 		protected:
 			float totalFraction_;
 			float totalFractionError_;
 			float totalRate_;
 			float totalRateError_;
 			std::vector<TriggerRateImplementation> triggerRates_;
+			/// Full (symmetric) matrices, numberOfTriggers by numberOfTriggers, indexed first*numberOfTriggers+second. Empty if unknown.
+			std::vector<float> overlapFractions_;
+			std::vector<float> overlapFractionErrors_;
+			std::vector<float> overlapRates_;
+			std::vector<float> overlapRateErrors_;
 		private:
-			void commonConstruction( const l1menu::TriggerMenu& menu, const l1menu::ISample& sample );
+			void commonConstruction( const l1menu::MenuRateSums& menuRateSums );
+			/** @brief Index into the overlap matrices, checking that the overlaps are known and the numbers are in range. */
+			size_t overlapIndex( size_t firstTriggerNumber, size_t secondTriggerNumber ) const;
 			mutable std::vector<const l1menu::ITriggerRate*> baseClassPointers_; ///< Vector to return for calls to triggerRates()
 		};
 
@@ -5,13 +5,14 @@
 #include "l1menu/TriggerMenu.h"
 #include "l1menu/ITrigger.h"
 #include "l1menu/TriggerConstraint.h"
+#include "l1menu/IMenuRateOverlaps.h"
 #include "./MenuRateImplementation.h"
 
-l1menu::implementation::XMLL1MenuFile::XMLL1MenuFile( std::ostream& outputStream ) : pOutputStream_(&outputStream)
+l1menu::implementation::XMLL1MenuFile::XMLL1MenuFile( std::ostream& outputStream, bool includeOverlaps ) : pOutputStream_(&outputStream), includeOverlaps_(includeOverlaps)
 {
 }
 
-l1menu::implementation::XMLL1MenuFile::XMLL1MenuFile( const std::string& filename, bool outputOnly ) : pOutputStream_(nullptr)
+l1menu::implementation::XMLL1MenuFile::XMLL1MenuFile( const std::string& filename, bool outputOnly, bool includeOverlaps ) : pOutputStream_(nullptr), includeOverlaps_(includeOverlaps)
 {
 	if( outputOnly ) filenameForOutput_=filename;
 	else outputFile_.parseFromFile(filename);
@@ -148,6 +149,27 @@ l1menu::tools::XMLElement l1menu::implementation::XMLL1MenuFile::convertToXML( c
 		convertToXML( *pTriggerRate, thisElement );
 	}
 
+	// If the overlaps were asked for and are available add those too. The matrix is symmetric and the
+	// diagonal is the same as the trigger rates, so only the upper triangle is written.
+	const l1menu::IMenuRateOverlaps* pOverlaps=( includeOverlaps_ ? object.overlaps() : nullptr );
+	if( pOverlaps!=nullptr )
+	{
+		const size_t numberOfTriggers=object.triggerRates().size();
+		for( size_t firstTriggerNumber=0; firstTriggerNumber<numberOfTriggers; ++firstTriggerNumber )
+		{
+			for( size_t secondTriggerNumber=firstTriggerNumber+1; secondTriggerNumber<numberOfTriggers; ++secondTriggerNumber )
+			{
+				l1menu::tools::XMLElement overlapElement=thisElement.createChild( "TriggerOverlap" );
+				overlapElement.setAttribute( "first", static_cast<int>(firstTriggerNumber) );
+				overlapElement.setAttribute( "second", static_cast<int>(secondTriggerNumber) );
+				overlapElement.createChild( "fraction" ).setValue( pOverlaps->overlapFraction(firstTriggerNumber,secondTriggerNumber) );
+				overlapElement.createChild( "fractionError" ).setValue( pOverlaps->overlapFractionError(firstTriggerNumber,secondTriggerNumber) );
+				overlapElement.createChild( "rate" ).setValue( pOverlaps->overlapRate(firstTriggerNumber,secondTriggerNumber) );
+				overlapElement.createChild( "rateError" ).setValue( pOverlaps->overlapRateError(firstTriggerNumber,secondTriggerNumber) );
+			}
+		}
+	}
+
 	return thisElement;
 }
 
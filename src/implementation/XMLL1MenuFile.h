@@ -22,6 +22,9 @@ namespace l1menu
 	namespace implementation
 	{
 		/** @brief Implementation of the IL1MenuFile interface for XML files.
+		 *
+		 * The overlaps between pairs of triggers are only written if includeOverlaps is set in the
+		 * constructor. They're always read if they're in the file.
 		 *
 		 * @author Mark Grimes (mark.grimes@bristol.ac.uk)
 		 * @date 21/Nov/2013
@@ -29,8 +32,8 @@ namespace l1menu
 		class XMLL1MenuFile : public l1menu::IL1MenuFile
 		{
 		public:
-			XMLL1MenuFile( std::ostream& outputStream );
-			XMLL1MenuFile( const std::string& filename, bool outputOnly );
+			XMLL1MenuFile( std::ostream& outputStream, bool includeOverlaps=false );
+			XMLL1MenuFile( const std::string& filename, bool outputOnly, bool includeOverlaps=false );
 			virtual ~XMLL1MenuFile();
 			virtual void add( const l1menu::TriggerMenu& menu );
 			virtual void add( const l1menu::IMenuRate& menuRate );
@@ -45,6 +48,7 @@ namespace l1menu
 			l1menu::tools::XMLFile outputFile_;
 			std::ostream* pOutputStream_;
 			std::string filenameForOutput_;
+			bool includeOverlaps_;
 		};
 
 
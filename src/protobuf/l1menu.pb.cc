@@ -77,9 +77,12 @@ void protobuf_AssignDesc_l1menu_2eproto() {
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(Trigger_TriggerParameter));
   Event_descriptor_ = file->message_type(1);
-  static const int Event_offsets_[2] = {
+  static const int Event_offsets_[5] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Event, threshold_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Event, weight_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Event, named_weight_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Event, run_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Event, lumi_section_),
   };
   Event_reflection_ =
     new ::google::protobuf::internal::GeneratedMessageReflection(
@@ -108,8 +111,9 @@ void protobuf_AssignDesc_l1menu_2eproto() {
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(Run));
   SampleHeader_descriptor_ = file->message_type(3);
-  static const int SampleHeader_offsets_[1] = {
+  static const int SampleHeader_offsets_[2] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(SampleHeader, trigger_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(SampleHeader, weight_name_),
   };
   SampleHeader_reflection_ =
     new ::google::protobuf::internal::GeneratedMessageReflection(
@@ -173,10 +177,12 @@ void protobuf_AddDesc_l1menu_2eproto() {
     "ameter\030\003 \003(\0132(.l1menuprotobuf.Trigger.Tr"
     "iggerParameter\022\031\n\021varying_parameter\030\004 \003("
     "\t\032/\n\020TriggerParameter\022\014\n\004name\030\001 \002(\t\022\r\n\005v"
-    "alue\030\002 \002(\002\"*\n\005Event\022\021\n\tthreshold\030\001 \003(\002\022\016"
-    "\n\006weight\030\002 \001(\002\"+\n\003Run\022$\n\005event\030\001 \003(\0132\025.l"
-    "1menuprotobuf.Event\"8\n\014SampleHeader\022(\n\007t"
-    "rigger\030\001 \003(\0132\027.l1menuprotobuf.Trigger", 357);
+    "alue\030\002 \002(\002\"c\n\005Event\022\021\n\tthreshold\030\001 \003(\002\022\016"
+    "\n\006weight\030\002 \001(\002\022\024\n\014named_weight\030\003 \003(\002\022\013\n\003"
+    "run\030\004 \001(\r\022\024\n\014lumi_section\030\005 \001(\r\"+\n\003Run\022$"
+    "\n\005event\030\001 \003(\0132\025.l1menuprotobuf.Event\"M\n\014"
+    "SampleHeader\022(\n\007trigger\030\001 \003(\0132\027.l1menupr"
+    "otobuf.Trigger\022\023\n\013weight_name\030\002 \003(\t", 435);
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
     "l1menu.proto", &protobuf_RegisterTypes);
   Trigger::default_instance_ = new Trigger();
@@ -823,6 +829,9 @@ void Trigger::Swap(Trigger* other) {
 #ifndef _MSC_VER
 const int Event::kThresholdFieldNumber;
 const int Event::kWeightFieldNumber;
+const int Event::kNamedWeightFieldNumber;
+const int Event::kRunFieldNumber;
+const int Event::kLumiSectionFieldNumber;
 #endif  // !_MSC_VER
 
 Event::Event()
@@ -842,6 +851,8 @@ Event::Event(const Event& from)
 void Event::SharedCtor() {
   _cached_size_ = 0;
   weight_ = 0;
+  run_ = 0u;
+  lumi_section_ = 0u;
   ::memset(_has_bits_, 0, sizeof(_has_bits_));
 }
 
@@ -877,8 +888,11 @@ Event* Event::New() const {
 void Event::Clear() {
   if (_has_bits_[1 / 32] & (0xffu << (1 % 32))) {
     weight_ = 0;
+    run_ = 0u;
+    lumi_section_ = 0u;
   }
   threshold_.Clear();
+  named_weight_.Clear();
   ::memset(_has_bits_, 0, sizeof(_has_bits_));
   mutable_unknown_fields()->Clear();
 }
@@ -923,6 +937,60 @@ bool Event::MergePartialFromCodedStream(
         } else {
           goto handle_uninterpreted;
         }
+        if (input->ExpectTag(29)) goto parse_named_weight;
+        break;
+      }
+      
+      // repeated float named_weight = 3;
+      case 3: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_FIXED32) {
+         parse_named_weight:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadRepeatedPrimitive<
+                   float, ::google::protobuf::internal::WireFormatLite::TYPE_FLOAT>(
+                 1, 29, input, this->mutable_named_weight())));
+        } else if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag)
+                   == ::google::protobuf::internal::WireFormatLite::
+                      WIRETYPE_LENGTH_DELIMITED) {
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPackedPrimitiveNoInline<
+                   float, ::google::protobuf::internal::WireFormatLite::TYPE_FLOAT>(
+                 input, this->mutable_named_weight())));
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(29)) goto parse_named_weight;
+        if (input->ExpectTag(32)) goto parse_run;
+        break;
+      }
+      
+      // optional uint32 run = 4;
+      case 4: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_run:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &run_)));
+          set_has_run();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(40)) goto parse_lumi_section;
+        break;
+      }
+      
+      // optional uint32 lumi_section = 5;
+      case 5: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_lumi_section:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &lumi_section_)));
+          set_has_lumi_section();
+        } else {
+          goto handle_uninterpreted;
+        }
         if (input->ExpectAtEnd()) return true;
         break;
       }
@@ -956,6 +1024,22 @@ void Event::SerializeWithCachedSizes(
     ::google::protobuf::internal::WireFormatLite::WriteFloat(2, this->weight(), output);
   }
   
+  // repeated float named_weight = 3;
+  for (int i = 0; i < this->named_weight_size(); i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteFloat(
+      3, this->named_weight(i), output);
+  }
+  
+  // optional uint32 run = 4;
+  if (has_run()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(4, this->run(), output);
+  }
+  
+  // optional uint32 lumi_section = 5;
+  if (has_lumi_section()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(5, this->lumi_section(), output);
+  }
+  
   if (!unknown_fields().empty()) {
     ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
         unknown_fields(), output);
@@ -975,6 +1059,22 @@ void Event::SerializeWithCachedSizes(
     target = ::google::protobuf::internal::WireFormatLite::WriteFloatToArray(2, this->weight(), target);
   }
   
+  // repeated float named_weight = 3;
+  for (int i = 0; i < this->named_weight_size(); i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteFloatToArray(3, this->named_weight(i), target);
+  }
+  
+  // optional uint32 run = 4;
+  if (has_run()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(4, this->run(), target);
+  }
+  
+  // optional uint32 lumi_section = 5;
+  if (has_lumi_section()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(5, this->lumi_section(), target);
+  }
+  
   if (!unknown_fields().empty()) {
     target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
         unknown_fields(), target);
@@ -991,6 +1091,20 @@ int Event::ByteSize() const {
       total_size += 1 + 4;
     }
     
+    // optional uint32 run = 4;
+    if (has_run()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt32Size(
+          this->run());
+    }
+    
+    // optional uint32 lumi_section = 5;
+    if (has_lumi_section()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt32Size(
+          this->lumi_section());
+    }
+    
   }
   // repeated float threshold = 1;
   {
@@ -999,6 +1113,13 @@ int Event::ByteSize() const {
     total_size += 1 * this->threshold_size() + data_size;
   }
   
+  // repeated float named_weight = 3;
+  {
+    int data_size = 0;
+    data_size = 4 * this->named_weight_size();
+    total_size += 1 * this->named_weight_size() + data_size;
+  }
+  
   if (!unknown_fields().empty()) {
     total_size +=
       ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
@@ -1025,10 +1146,17 @@ void Event::MergeFrom(const ::google::protobuf::Message& from) {
 void Event::MergeFrom(const Event& from) {
   GOOGLE_CHECK_NE(&from, this);
   threshold_.MergeFrom(from.threshold_);
+  named_weight_.MergeFrom(from.named_weight_);
   if (from._has_bits_[1 / 32] & (0xffu << (1 % 32))) {
     if (from.has_weight()) {
       set_weight(from.weight());
     }
+    if (from.has_run()) {
+      set_run(from.run());
+    }
+    if (from.has_lumi_section()) {
+      set_lumi_section(from.lumi_section());
+    }
   }
   mutable_unknown_fields()->MergeFrom(from.unknown_fields());
 }
@@ -1054,6 +1182,9 @@ void Event::Swap(Event* other) {
   if (other != this) {
     threshold_.Swap(&other->threshold_);
     std::swap(weight_, other->weight_);
+    named_weight_.Swap(&other->named_weight_);
+    std::swap(run_, other->run_);
+    std::swap(lumi_section_, other->lumi_section_);
     std::swap(_has_bits_[0], other->_has_bits_[0]);
     _unknown_fields_.Swap(&other->_unknown_fields_);
     std::swap(_cached_size_, other->_cached_size_);
@@ -1275,6 +1406,7 @@ void Run::Swap(Run* other) {
 
 #ifndef _MSC_VER
 const int SampleHeader::kTriggerFieldNumber;
+const int SampleHeader::kWeightNameFieldNumber;
 #endif  // !_MSC_VER
 
 SampleHeader::SampleHeader()
@@ -1327,6 +1459,7 @@ SampleHeader* SampleHeader::New() const {
 
 void SampleHeader::Clear() {
   trigger_.Clear();
+  weight_name_.Clear();
   ::memset(_has_bits_, 0, sizeof(_has_bits_));
   mutable_unknown_fields()->Clear();
 }
@@ -1348,6 +1481,24 @@ bool SampleHeader::MergePartialFromCodedStream(
           goto handle_uninterpreted;
         }
         if (input->ExpectTag(10)) goto parse_trigger;
+        if (input->ExpectTag(18)) goto parse_weight_name;
+        break;
+      }
+      
+      // repeated string weight_name = 2;
+      case 2: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+         parse_weight_name:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
+                input, this->add_weight_name()));
+          ::google::protobuf::internal::WireFormat::VerifyUTF8String(
+            this->weight_name(0).data(), this->weight_name(0).length(),
+            ::google::protobuf::internal::WireFormat::PARSE);
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(18)) goto parse_weight_name;
         if (input->ExpectAtEnd()) return true;
         break;
       }
@@ -1376,6 +1527,15 @@ void SampleHeader::SerializeWithCachedSizes(
       1, this->trigger(i), output);
   }
   
+  // repeated string weight_name = 2;
+  for (int i = 0; i < this->weight_name_size(); i++) {
+  ::google::protobuf::internal::WireFormat::VerifyUTF8String(
+    this->weight_name(i).data(), this->weight_name(i).length(),
+    ::google::protobuf::internal::WireFormat::SERIALIZE);
+    ::google::protobuf::internal::WireFormatLite::WriteString(
+      2, this->weight_name(i), output);
+  }
+  
   if (!unknown_fields().empty()) {
     ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
         unknown_fields(), output);
@@ -1391,6 +1551,15 @@ void SampleHeader::SerializeWithCachedSizes(
         1, this->trigger(i), target);
   }
   
+  // repeated string weight_name = 2;
+  for (int i = 0; i < this->weight_name_size(); i++) {
+    ::google::protobuf::internal::WireFormat::VerifyUTF8String(
+      this->weight_name(i).data(), this->weight_name(i).length(),
+      ::google::protobuf::internal::WireFormat::SERIALIZE);
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteStringToArray(2, this->weight_name(i), target);
+  }
+  
   if (!unknown_fields().empty()) {
     target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
         unknown_fields(), target);
@@ -1409,6 +1578,13 @@ int SampleHeader::ByteSize() const {
         this->trigger(i));
   }
   
+  // repeated string weight_name = 2;
+  total_size += 1 * this->weight_name_size();
+  for (int i = 0; i < this->weight_name_size(); i++) {
+    total_size += ::google::protobuf::internal::WireFormatLite::StringSize(
+      this->weight_name(i));
+  }
+  
   if (!unknown_fields().empty()) {
     total_size +=
       ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
@@ -1435,6 +1611,7 @@ void SampleHeader::MergeFrom(const ::google::protobuf::Message& from) {
 void SampleHeader::MergeFrom(const SampleHeader& from) {
   GOOGLE_CHECK_NE(&from, this);
   trigger_.MergeFrom(from.trigger_);
+  weight_name_.MergeFrom(from.weight_name_);
   mutable_unknown_fields()->MergeFrom(from.unknown_fields());
 }
 
@@ -1461,6 +1638,7 @@ bool SampleHeader::IsInitialized() const {
 void SampleHeader::Swap(SampleHeader* other) {
   if (other != this) {
     trigger_.Swap(&other->trigger_);
+    weight_name_.Swap(&other->weight_name_);
     std::swap(_has_bits_[0], other->_has_bits_[0]);
     _unknown_fields_.Swap(&other->_unknown_fields_);
     std::swap(_cached_size_, other->_cached_size_);
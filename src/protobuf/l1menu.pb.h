@@ -337,18 +337,51 @@ class Event : public ::google::protobuf::Message {
   inline float weight() const;
   inline void set_weight(float value);
   
+  // repeated float named_weight = 3;
+  inline int named_weight_size() const;
+  inline void clear_named_weight();
+  static const int kNamedWeightFieldNumber = 3;
+  inline float named_weight(int index) const;
+  inline void set_named_weight(int index, float value);
+  inline void add_named_weight(float value);
+  inline const ::google::protobuf::RepeatedField< float >&
+      named_weight() const;
+  inline ::google::protobuf::RepeatedField< float >*
+      mutable_named_weight();
+  
+  // optional uint32 run = 4;
+  inline bool has_run() const;
+  inline void clear_run();
+  static const int kRunFieldNumber = 4;
+  inline ::google::protobuf::uint32 run() const;
+  inline void set_run(::google::protobuf::uint32 value);
+  
+  // optional uint32 lumi_section = 5;
+  inline bool has_lumi_section() const;
+  inline void clear_lumi_section();
+  static const int kLumiSectionFieldNumber = 5;
+  inline ::google::protobuf::uint32 lumi_section() const;
+  inline void set_lumi_section(::google::protobuf::uint32 value);
+  
   // @@protoc_insertion_point(class_scope:l1menuprotobuf.Event)
  private:
   inline void set_has_weight();
   inline void clear_has_weight();
+  inline void set_has_run();
+  inline void clear_has_run();
+  inline void set_has_lumi_section();
+  inline void clear_has_lumi_section();
   
   ::google::protobuf::UnknownFieldSet _unknown_fields_;
   
   ::google::protobuf::RepeatedField< float > threshold_;
+  ::google::protobuf::RepeatedField< float > named_weight_;
   float weight_;
+  ::google::protobuf::uint32 run_;
+  ::google::protobuf::uint32 lumi_section_;
   
   mutable int _cached_size_;
-  ::google::protobuf::uint32 _has_bits_[(2 + 31) / 32];
+  ::google::protobuf::uint32 _has_bits_[(5 + 31) / 32];
   
   friend void  protobuf_AddDesc_l1menu_2eproto();
   friend void protobuf_AssignDesc_l1menu_2eproto();
@@ -510,15 +543,32 @@ class SampleHeader : public ::google::protobuf::Message {
   inline ::google::protobuf::RepeatedPtrField< ::l1menuprotobuf::Trigger >*
       mutable_trigger();
   
+  // repeated string weight_name = 2;
+  inline int weight_name_size() const;
+  inline void clear_weight_name();
+  static const int kWeightNameFieldNumber = 2;
+  inline const ::std::string& weight_name(int index) const;
+  inline ::std::string* mutable_weight_name(int index);
+  inline void set_weight_name(int index, const ::std::string& value);
+  inline void set_weight_name(int index, const char* value);
+  inline void set_weight_name(int index, const char* value, size_t size);
+  inline ::std::string* add_weight_name();
+  inline void add_weight_name(const ::std::string& value);
+  inline void add_weight_name(const char* value);
+  inline void add_weight_name(const char* value, size_t size);
+  inline const ::google::protobuf::RepeatedPtrField< ::std::string>& weight_name() const;
+  inline ::google::protobuf::RepeatedPtrField< ::std::string>* mutable_weight_name();
+  
   // @@protoc_insertion_point(class_scope:l1menuprotobuf.SampleHeader)
  private:
   
   ::google::protobuf::UnknownFieldSet _unknown_fields_;
   
   ::google::protobuf::RepeatedPtrField< ::l1menuprotobuf::Trigger > trigger_;
+  ::google::protobuf::RepeatedPtrField< ::std::string> weight_name_;
   
   mutable int _cached_size_;
-  ::google::protobuf::uint32 _has_bits_[(1 + 31) / 32];
+  ::google::protobuf::uint32 _has_bits_[(2 + 31) / 32];
   
   friend void  protobuf_AddDesc_l1menu_2eproto();
   friend void protobuf_AssignDesc_l1menu_2eproto();
@@ -818,6 +868,75 @@ inline void Event::set_weight(float value) {
   weight_ = value;
 }
 
+// repeated float named_weight = 3;
+inline int Event::named_weight_size() const {
+  return named_weight_.size();
+}
+inline void Event::clear_named_weight() {
+  named_weight_.Clear();
+}
+inline float Event::named_weight(int index) const {
+  return named_weight_.Get(index);
+}
+inline void Event::set_named_weight(int index, float value) {
+  named_weight_.Set(index, value);
+}
+inline void Event::add_named_weight(float value) {
+  named_weight_.Add(value);
+}
+inline const ::google::protobuf::RepeatedField< float >&
+Event::named_weight() const {
+  return named_weight_;
+}
+inline ::google::protobuf::RepeatedField< float >*
+Event::mutable_named_weight() {
+  return &named_weight_;
+}
+
+// optional uint32 run = 4;
+inline bool Event::has_run() const {
+  return (_has_bits_[0] & 0x00000008u) != 0;
+}
+inline void Event::set_has_run() {
+  _has_bits_[0] |= 0x00000008u;
+}
+inline void Event::clear_has_run() {
+  _has_bits_[0] &= ~0x00000008u;
+}
+inline void Event::clear_run() {
+  run_ = 0u;
+  clear_has_run();
+}
+inline ::google::protobuf::uint32 Event::run() const {
+  return run_;
+}
+inline void Event::set_run(::google::protobuf::uint32 value) {
+  set_has_run();
+  run_ = value;
+}
+
+// optional uint32 lumi_section = 5;
+inline bool Event::has_lumi_section() const {
+  return (_has_bits_[0] & 0x00000010u) != 0;
+}
+inline void Event::set_has_lumi_section() {
+  _has_bits_[0] |= 0x00000010u;
+}
+inline void Event::clear_has_lumi_section() {
+  _has_bits_[0] &= ~0x00000010u;
+}
+inline void Event::clear_lumi_section() {
+  lumi_section_ = 0u;
+  clear_has_lumi_section();
+}
+inline ::google::protobuf::uint32 Event::lumi_section() const {
+  return lumi_section_;
+}
+inline void Event::set_lumi_section(::google::protobuf::uint32 value) {
+  set_has_lumi_section();
+  lumi_section_ = value;
+}
+
 // -------------------------------------------------------------------
 
 // Run
@@ -876,6 +995,50 @@ SampleHeader::mutable_trigger() {
   return &trigger_;
 }
 
+// repeated string weight_name = 2;
+inline int SampleHeader::weight_name_size() const {
+  return weight_name_.size();
+}
+inline void SampleHeader::clear_weight_name() {
+  weight_name_.Clear();
+}
+inline const ::std::string& SampleHeader::weight_name(int index) const {
+  return weight_name_.Get(index);
+}
+inline ::std::string* SampleHeader::mutable_weight_name(int index) {
+  return weight_name_.Mutable(index);
+}
+inline void SampleHeader::set_weight_name(int index, const ::std::string& value) {
+  weight_name_.Mutable(index)->assign(value);
+}
+inline void SampleHeader::set_weight_name(int index, const char* value) {
+  weight_name_.Mutable(index)->assign(value);
+}
+inline void SampleHeader::set_weight_name(int index, const char* value, size_t size) {
+  weight_name_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+}
+inline ::std::string* SampleHeader::add_weight_name() {
+  return weight_name_.Add();
+}
+inline void SampleHeader::add_weight_name(const ::std::string& value) {
+  weight_name_.Add()->assign(value);
+}
+inline void SampleHeader::add_weight_name(const char* value) {
+  weight_name_.Add()->assign(value);
+}
+inline void SampleHeader::add_weight_name(const char* value, size_t size) {
+  weight_name_.Add()->assign(reinterpret_cast<const char*>(value), size);
+}
+inline const ::google::protobuf::RepeatedPtrField< ::std::string>&
+SampleHeader::weight_name() const {
+  return weight_name_;
+}
+inline ::google::protobuf::RepeatedPtrField< ::std::string>*
+SampleHeader::mutable_weight_name() {
+  return &weight_name_;
+}
+
 
 // @@protoc_insertion_point(namespace_scope)
 
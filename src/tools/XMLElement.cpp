@@ -2,6 +2,8 @@
 
 #include <stdexcept>
 #include <sstream>
+#include <iomanip>
+#include <limits>
 #include <iostream>
 #include <xercesc/util/PlatformUtils.hpp>
 #include <xercesc/parsers/XercesDOMParser.hpp>
@@ -238,6 +240,11 @@ float l1menu::tools::XMLElement::getFloatValue() const
 	return l1menu::tools::convertStringToFloat( getValue() );
 }
 
+double l1menu::tools::XMLElement::getDoubleValue() const
+{
+	return l1menu::tools::convertStringToDouble( getValue() );
+}
+
 void l1menu::tools::XMLElement::setValue( const std::string& value )
 {
 	// TODO - write something to clear any children in case there was something here before
@@ -259,3 +266,10 @@ void l1menu::tools::XMLElement::setValue( float value )
 	stringConverter << value;
 	setValue( stringConverter.str() );
 }
+
+void l1menu::tools::XMLElement::setValue( double value )
+{
+	std::stringstream stringConverter;
+	stringConverter << std::setprecision( std::numeric_limits<double>::max_digits10 ) << value;
+	setValue( stringConverter.str() );
+}
@@ -3,17 +3,46 @@
 #include <exception>
 #include <stdexcept>
 #include <fstream>
+#include <ostream>
 #include "l1menu/TriggerMenu.h"
+#include "l1menu/IMenuRate.h"
+#include "l1menu/IMenuRateOverlaps.h"
+#include "l1menu/ITriggerRate.h"
+#include "l1menu/ITriggerDescriptionWithErrors.h"
 #include "l1menu/FullSample.h"
 #include "l1menu/ReducedSample.h"
+#include "l1menu/tools/XMLFile.h"
+#include "l1menu/tools/XMLElement.h"
+#include "../triggers/DeclarativeTrigger.h"
 
 
-void l1menu::tools::dumpTriggerRates( std::ostream& output, const l1menu::IMenuRate& menuRates, l1menu::IL1MenuFile::FileFormat format )
+void l1menu::tools::dumpTriggerRates( std::ostream& output, const l1menu::IMenuRate& menuRates, l1menu::IL1MenuFile::FileFormat format, bool includeOverlaps )
 {
-	std::unique_ptr<l1menu::IL1MenuFile> pOutputL1MenuFile=l1menu::IL1MenuFile::getOutputFile( format, output );
+	std::unique_ptr<l1menu::IL1MenuFile> pOutputL1MenuFile=l1menu::IL1MenuFile::getOutputFile( format, output, includeOverlaps );
 	pOutputL1MenuFile->add( menuRates );
 }
 
+void l1menu::tools::dumpTriggerOverlaps( std::ostream& output, const l1menu::IMenuRate& menuRates, char delimeter )
+{
+	const l1menu::IMenuRateOverlaps* pOverlaps=menuRates.overlaps();
+	if( pOverlaps==nullptr ) throw std::runtime_error( "l1menu::tools::dumpTriggerOverlaps - the overlaps between triggers are not available for these rates" );
+
+	const auto& triggerRates=menuRates.triggerRates();
+	output << "firstTrigger" << delimeter << "secondTrigger" << delimeter << "fraction" << delimeter << "fractionError" << delimeter << "rate" << delimeter << "rateError" << "\n";
+	for( size_t firstTriggerNumber=0; firstTriggerNumber<triggerRates.size(); ++firstTriggerNumber )
+	{
+		for( size_t secondTriggerNumber=firstTriggerNumber; secondTriggerNumber<triggerRates.size(); ++secondTriggerNumber )
+		{
+			output << triggerRates[firstTriggerNumber]->trigger().name() << delimeter << triggerRates[secondTriggerNumber]->trigger().name()
+					<< delimeter << pOverlaps->overlapFraction(firstTriggerNumber,secondTriggerNumber)
+					<< delimeter << pOverlaps->overlapFractionError(firstTriggerNumber,secondTriggerNumber)
+					<< delimeter << pOverlaps->overlapRate(firstTriggerNumber,secondTriggerNumber)
+					<< delimeter << pOverlaps->overlapRateError(firstTriggerNumber,secondTriggerNumber) << "\n";
+		}
+	}
+	output.flush();
+}
+
 void l1menu::tools::dumpTriggerMenu( std::ostream& output, const l1menu::TriggerMenu& menu, l1menu::IL1MenuFile::FileFormat format )
 {
 	std::unique_ptr<l1menu::IL1MenuFile> pOutputL1MenuFile=l1menu::IL1MenuFile::getOutputFile( format, output );
@@ -68,3 +97,26 @@ std::unique_ptr<l1menu::TriggerMenu> l1menu::tools::loadMenu( const std::string&
 	if( menusFromFile.empty() ) throw std::runtime_error( "l1menu::tools::loadMenu(\""+filename+"\") - Unable to load the menu" );
 	return std::move( menusFromFile.front() );
 }
+
+std::vector<l1menu::TriggerTable::TriggerDetails> l1menu::tools::loadTriggerDefinitions( const std::string& filename )
+{
+	l1menu::tools::XMLFile inputFile( filename );
+	l1menu::TriggerTable& triggerTable=l1menu::TriggerTable::instance();
+
+	std::vector<l1menu::TriggerTable::TriggerDetails> returnValue;
+	for( const auto& definitionElement : inputFile.rootElement().getChildren("TriggerDefinition") )
+	{
+		// Compile the definition once, and all instances of the trigger share it
+		std::shared_ptr<const l1menu::triggers::DeclarativeTriggerPlan> pPlan( new l1menu::triggers::DeclarativeTriggerPlan(definitionElement) );
+
+		triggerTable.registerTrigger( pPlan->name, pPlan->version, [pPlan](){ return std::unique_ptr<l1menu::ITrigger>( new l1menu::triggers::DeclarativeTrigger(pPlan) ); } );
+		for( const auto& binning : pPlan->suggestedBinning )
+		{
+			triggerTable.registerSuggestedBinning( pPlan->name, binning.parameterName, binning.numberOfBins, binning.lowerEdge, binning.upperEdge );
+		}
+
+		returnValue.push_back( l1menu::TriggerTable::TriggerDetails{ pPlan->name, pPlan->version } );
+	}
+
+	return returnValue;
+}
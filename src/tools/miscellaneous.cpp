@@ -16,6 +16,7 @@
 #include "l1menu/ITriggerRate.h"
 #include "l1menu/FullSample.h"
 #include "l1menu/ReducedSample.h"
+#include "../triggers/SingleObjectTrigger.h"
 
 
 std::vector<std::string> l1menu::tools::getThresholdNames( const l1menu::ITriggerDescription& trigger )
@@ -23,46 +24,52 @@ std::vector<std::string> l1menu::tools::getThresholdNames( const l1menu::ITrigge
 	std::vector<std::string> returnValue;
 
 	//
-	// I don't know how many thresholds there are, so I'll try and get every possible one and catch
-	// the exception when I eventually hit a threshold that doesn't exist.
+	// I don't know how many thresholds there are, so I'll try every possible name in
+	// order until I hit a threshold that isn't in the list of parameter names. This used
+	// to ask the trigger for each one and catch the exception, but exceptions are far
+	// too slow for something called this often.
 	//
+	const std::vector<std::string> parameterNames=trigger.parameterNames();
+	auto isParameter=[&parameterNames]( const std::string& name ){ return std::find( parameterNames.begin(), parameterNames.end(), name )!=parameterNames.end(); };
 
 	std::stringstream stringConverter;
-	// I plan in the future to implement cross triggers with "leg1threshold1", "leg2threshold1" etcetera,
-	// so I'll loop over those possible prefixes.
-	for( size_t legNumber=0; true; ++legNumber ) // Loop continuously until the exception handler calls "break"
+	// Cross triggers have "leg1threshold1", "leg2threshold1" etcetera, so I'll loop over
+	// those possible prefixes.
+	for( size_t legNumber=0; true; ++legNumber ) // Loop continuously until "break"
 	{
+		// Loop over all possible numbers of thresholds
 		size_t thresholdNumber;
-		try
+		for( thresholdNumber=1; true; ++thresholdNumber ) // Loop continuously until the threshold doesn't exist
 		{
-			// Loop over all possible numbers of thresholds
-			for( thresholdNumber=1; true; ++thresholdNumber ) // Loop continuously until I hit an exception
-			{
-				stringConverter.str("");
-				if( legNumber!=0 ) stringConverter << "leg" << legNumber; // For triggers with only one leg I don't want to prefix anything.
+			stringConverter.str("");
+			if( legNumber!=0 ) stringConverter << "leg" << legNumber; // For triggers with only one leg I don't want to prefix anything.
 
-				stringConverter << "threshold" << thresholdNumber;
+			stringConverter << "threshold" << thresholdNumber;
 
-				trigger.parameter(stringConverter.str());
-				// If the threshold doesn't exist the statement above will throw an exception, so
-				// I've reached this far then the threshold name must exist.
-				returnValue.push_back( stringConverter.str() );
-			}
-
-		}
-		catch( std::exception& error )
-		{
-			// If this exception is from the first threshold tried then the prefix (e.g. "leg1") does not
-			// exist, so I know I've finished. If it isn't from the first threshold then there could be
-			// other prefixes (e.g. "leg2") that have thresholds that can be modified, in which case I
-			// need to continue.
-			if( thresholdNumber==1 && legNumber!=0 ) break;
+			if( !isParameter( stringConverter.str() ) ) break;
+			returnValue.push_back( stringConverter.str() );
 		}
+
+		// If the first threshold tried doesn't exist then the prefix (e.g. "leg1") does not
+		// exist, so I know I've finished. If it isn't the first threshold then there could be
+		// other prefixes (e.g. "leg2") that have thresholds that can be modified, in which case I
+		// need to continue.
+		if( thresholdNumber==1 && legNumber!=0 ) break;
 	}
 
 	return returnValue;
 }
 
+std::vector<l1menu::ITriggerDescription::ParameterHandle> l1menu::tools::getThresholdHandles( const l1menu::ITriggerDescription& trigger )
+{
+	std::vector<l1menu::ITriggerDescription::ParameterHandle> returnValue;
+
+	std::vector<std::string> thresholdNames=getThresholdNames( trigger );
+	for( const auto& thresholdName : thresholdNames ) returnValue.push_back( trigger.parameterIndex(thresholdName) );
+
+	return returnValue;
+}
+
 std::vector<std::string> l1menu::tools::getNonThresholdParameterNames( const l1menu::ITriggerDescription& trigger )
 {
 	std::vector<std::string> returnValue;
@@ -86,7 +93,9 @@ std::vector<std::string> l1menu::tools::getNonThresholdParameterNames( const l1m
 void l1menu::tools::setTriggerThresholdsAsTightAsPossible( const l1menu::L1TriggerDPGEvent& event, l1menu::ITrigger& trigger, float tolerance )
 {
 	std::vector<std::string> thresholdNames=l1menu::tools::getThresholdNames( trigger );
-	std::map<std::string,float> tightestPossibleThresholds;
+	std::vector<l1menu::ITrigger::ParameterHandle> thresholdHandles;
+	for( const auto& thresholdName : thresholdNames ) thresholdHandles.push_back( trigger.parameterIndex(thresholdName) );
+	std::vector<float> tightestPossibleThresholds; // Same order as thresholdHandles
 
 	//
 	// If the thresholds are correlated, then I can't modify them individually to see if an event will pass
@@ -97,40 +106,50 @@ void l1menu::tools::setTriggerThresholdsAsTightAsPossible( const l1menu::L1Trigg
 	if( trigger.thresholdsAreCorrelated() )
 	{
 		// Use the first threshold as the one to vary
-		std::string versusParameter=thresholdNames[0];
-		float parameterValue=trigger.parameter(versusParameter); // Take a copy to save constantly looking it up
+		float parameterValue=trigger.parameter(thresholdHandles[0]); // Take a copy to save constantly looking it up
 
 		// Then scale all of the other ones against that
-		for( const auto& parameterToScale : thresholdNames )
+		for( size_t index=1; index<thresholdHandles.size(); ++index )
 		{
-			if( parameterToScale!=versusParameter )
-			{
-				otherParameterScalings.push_back( std::make_pair( &trigger.parameter(parameterToScale), trigger.parameter(parameterToScale)/parameterValue ) );
-			}
+			float& parameterToScale=trigger.parameter(thresholdHandles[index]);
+			otherParameterScalings.push_back( std::make_pair( &parameterToScale, parameterToScale/parameterValue ) );
 		}
 
-		// Now clear the list of tresholdNames of everything except the main one.
+		// Now clear the list of tresholds of everything except the main one.
 		// Everything else will be scaled against this.
 		thresholdNames.resize(1);
+		thresholdHandles.resize(1);
 	}
 
 	// First set all of the thresholds to zero
-	for( const auto& thresholdName : thresholdNames ) trigger.parameter(thresholdName)=0;
+	for( const auto& thresholdHandle : thresholdHandles ) trigger.parameter(thresholdHandle)=0;
+
+	// Single object triggers can say straight away what the lowest threshold that passes is, which
+	// is a lot quicker than calling apply for every step of the bisection below. I still go through
+	// the bisection with this so that the result is exactly the same as for any other trigger.
+	const l1menu::triggers::SingleObjectTrigger* pSingleObjectTrigger=nullptr;
+	if( thresholdHandles.size()==1 ) pSingleObjectTrigger=dynamic_cast<const l1menu::triggers::SingleObjectTrigger*>( &trigger );
+	const float highestPassingEt=( pSingleObjectTrigger ? pSingleObjectTrigger->highestPassingEt( event ) : 0 );
 
 	// Now run through each threshold at a time and figure out how low it can be and still
 	// pass the event.
-	for( const auto& thresholdName : thresholdNames )
+	for( size_t index=0; index<thresholdHandles.size(); ++index )
 	{
 		// Note that this is a reference, so when this is changed the trigger is modified
-		float& threshold=trigger.parameter(thresholdName);
+		float& threshold=trigger.parameter(thresholdHandles[index]);
+		auto triggerPasses=[&]()->bool
+		{
+			if( pSingleObjectTrigger ) return highestPassingEt>=threshold;
+			else return trigger.apply( event );
+		};
 
 		float lowThreshold=0;
 		float highThreshold=500;
 		// See if an indication of the range of the trigger has been set
 		try // These calls will throw an exception if no suggestion has been set
 		{
-			lowThreshold=l1menu::TriggerTable::instance().getSuggestedLowerEdge( trigger.name(), thresholdName );
-			highThreshold=l1menu::TriggerTable::instance().getSuggestedUpperEdge( trigger.name(), thresholdName );
+			lowThreshold=l1menu::TriggerTable::instance().getSuggestedLowerEdge( trigger.name(), thresholdNames[index] );
+			highThreshold=l1menu::TriggerTable::instance().getSuggestedUpperEdge( trigger.name(), thresholdNames[index] );
 		}
 		catch( std::exception& error ) { /* No indication set. Do nothing and just use the defaults I set previously. */ }
 		highThreshold*=5; // Make sure the high threshold is very high, to catch all tails
@@ -140,11 +159,11 @@ void l1menu::tools::setTriggerThresholdsAsTightAsPossible( const l1menu::L1Trigg
 		// Scale any other parameters required. There will only be something in this vector if the trigger thresholds are correlated.
 		for( const auto& parameterScalingPair : otherParameterScalings ) *(parameterScalingPair.first)=parameterScalingPair.second*threshold;
 		// Test the trigger
-		bool lowTest=trigger.apply( event );
+		bool lowTest=triggerPasses();
 
 		threshold=highThreshold;
 		for( const auto& parameterScalingPair : otherParameterScalings ) *(parameterScalingPair.first)=parameterScalingPair.second*threshold;
-		bool highTest=trigger.apply( event );
+		bool highTest=triggerPasses();
 
 		if( lowTest==highTest ) throw std::runtime_error( "l1menu::tools::setTriggerThresholdsAsTightAsPossible() - couldn't find a set of thresholds to pass the given event.");
 
@@ -153,15 +172,15 @@ void l1menu::tools::setTriggerThresholdsAsTightAsPossible( const l1menu::L1Trigg
 		{
 			threshold=(highThreshold+lowThreshold)/2;
 			for( const auto& parameterScalingPair : otherParameterScalings ) *(parameterScalingPair.first)=parameterScalingPair.second*threshold;
-			bool midTest=trigger.apply(event);
+			bool midTest=triggerPasses();
 
 			if( lowTest==midTest && highTest!=midTest ) lowThreshold=threshold;
 			else if( highTest==midTest ) highThreshold=threshold;
 			else throw std::runtime_error( std::string("Something fucked up while testing ")+trigger.name() );
 		}
 
-		// Record what this value was for the parameter named
-		tightestPossibleThresholds[thresholdName]=highThreshold;
+		// Record what this value was for this threshold
+		tightestPossibleThresholds.push_back( highThreshold );
 		// Then set back to zero ready to test the other thresholds
 		threshold=0;
 	}
@@ -170,11 +189,11 @@ void l1menu::tools::setTriggerThresholdsAsTightAsPossible( const l1menu::L1Trigg
 	// Now that I've figured out what all of the thresholds need to be, run
 	// through and set the trigger up with these thresholds.
 	//
-	for( const auto& parameterValuePair : tightestPossibleThresholds )
+	for( size_t index=0; index<thresholdHandles.size(); ++index )
 	{
-		trigger.parameter(parameterValuePair.first)=parameterValuePair.second;
+		trigger.parameter(thresholdHandles[index])=tightestPossibleThresholds[index];
 		// And also set any of the scaled parameters to reflect what they should be at this value
-		for( const auto& parameterScalingPair : otherParameterScalings ) *(parameterScalingPair.first)=parameterScalingPair.second*parameterValuePair.second;
+		for( const auto& parameterScalingPair : otherParameterScalings ) *(parameterScalingPair.first)=parameterScalingPair.second*tightestPossibleThresholds[index];
 	}
 }
 
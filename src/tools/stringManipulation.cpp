@@ -19,6 +19,15 @@ float l1menu::tools::convertStringToFloat( const std::string& string )
 	return returnValue;
 }
 
+double l1menu::tools::convertStringToDouble( const std::string& string )
+{
+	double returnValue;
+	std::stringstream stringConverter( string );
+	stringConverter >> returnValue;
+	if( stringConverter.fail() || !stringConverter.eof() ) throw std::runtime_error( "Unable to convert \""+string+"\" to a double" );
+	return returnValue;
+}
+
 int l1menu::tools::convertStringToInt( const std::string& string )
 {
 	int returnValue;
@@ -28,6 +37,17 @@ int l1menu::tools::convertStringToInt( const std::string& string )
 	return returnValue;
 }
 
+size_t l1menu::tools::convertStringToSize( const std::string& string )
+{
+	// Streaming into an unsigned type accepts a minus sign and wraps, so check for it first
+	if( string.find('-')!=std::string::npos ) throw std::runtime_error( "Unable to convert \""+string+"\" to a size because it is negative" );
+	unsigned long long returnValue;
+	std::stringstream stringConverter( string );
+	stringConverter >> returnValue;
+	if( stringConverter.fail() || !stringConverter.eof() ) throw std::runtime_error( "Unable to convert \""+string+"\" to a size" );
+	return static_cast<size_t>( returnValue );
+}
+
 std::vector<std::string> l1menu::tools::splitByWhitespace( const std::string& stringToSplit )
 {
 	std::vector<std::string> returnValue;
@@ -0,0 +1,280 @@
+#include "l1menu/tools/vectorisedKernels.h"
+
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+// The package is built at -O0 for debugging, but these loops are called for every object
+// of every event so are useless unoptimised. Scram can't set flags for a single file, so
+// ask for optimisation here instead. This only affects the code in this file.
+#if defined(__GNUC__) && !defined(__clang__) && !defined(__OPTIMIZE__)
+#pragma GCC optimize("O2")
+#endif
+
+// The vectorised versions use the gcc "target" attribute so that this file can be compiled for
+// the lowest common denominator but still contain code for newer CPUs. Which one gets used is
+// decided at runtime.
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define L1MENU_HAVE_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace // Use the unnamed namespace for things only used in this file
+{
+	typedef float (*HighestPassingValueFunction)( const float*, size_t, const l1menu::tools::ColumnCut*, size_t );
+	typedef bool (*AnyValuePassingFunction)( const float*, size_t, float, const l1menu::tools::ColumnCut*, size_t );
+
+	/** @brief Does the entries from "start" onwards one at a time, and returns the maximum of those and currentHighest. */
+	float highestPassingValueTail( const float* values, size_t start, size_t size, const l1menu::tools::ColumnCut* cuts, size_t numberOfCuts, float currentHighest )
+	{
+		for( size_t index=start; index<size; ++index )
+		{
+			bool passes=true;
+			for( size_t cutIndex=0; cutIndex<numberOfCuts && passes; ++cutIndex )
+			{
+				const l1menu::tools::ColumnCut& cut=cuts[cutIndex];
+				// Written as "not outside the limits" like the original trigger loops, so a NaN passes. The
+				// vector versions use the unordered "not less than" and "not greater than" compares for the same.
+				passes=( !(cut.values[index]<cut.minimum) && !(cut.values[index]>cut.maximum) );
+			}
+			if( passes && values[index]>currentHighest ) currentHighest=values[index];
+		}
+		return currentHighest;
+	}
+
+	float highestPassingValueScalar( const float* values, size_t size, const l1menu::tools::ColumnCut* cuts, size_t numberOfCuts )
+	{
+		return highestPassingValueTail( values, 0, size, cuts, numberOfCuts, -std::numeric_limits<float>::infinity() );
+	}
+
+	/** @brief Does the entries from "start" onwards one at a time, returning as soon as one passes.
+	 *
+	 * This is the loop the triggers always used. The threshold is checked first because most
+	 * objects fail it, and then the other cuts don't need to be looked at. */
+	bool anyValuePassingTail( const float* values, size_t start, size_t size, float threshold, const l1menu::tools::ColumnCut* cuts, size_t numberOfCuts )
+	{
+		for( size_t index=start; index<size; ++index )
+		{
+			if( !(values[index]>=threshold) ) continue;
+			bool passes=true;
+			for( size_t cutIndex=0; cutIndex<numberOfCuts && passes; ++cutIndex )
+			{
+				const l1menu::tools::ColumnCut& cut=cuts[cutIndex];
+				passes=( !(cut.values[index]<cut.minimum) && !(cut.values[index]>cut.maximum) );
+			}
+			if( passes ) return true;
+		}
+		return false;
+	}
+
+	bool anyValuePassingScalar( const float* values, size_t size, float threshold, const l1menu::tools::ColumnCut* cuts, size_t numberOfCuts )
+	{
+		return anyValuePassingTail( values, 0, size, threshold, cuts, numberOfCuts );
+	}
+
+#ifdef L1MENU_HAVE_X86_KERNELS
+	__attribute__((target("sse4.1")))
+	float highestPassingValueSSE4( const float* values, size_t size, const l1menu::tools::ColumnCut* cuts, size_t numberOfCuts )
+	{
+		const __m128 minusInfinity=_mm_set1_ps( -std::numeric_limits<float>::infinity() );
+		__m128 highest=minusInfinity;
+
+		size_t index=0;
+		for( ; index+4<=size; index+=4 )
+		{
+			__m128 passes=_mm_castsi128_ps( _mm_set1_epi32(-1) );
+			for( size_t cutIndex=0; cutIndex<numberOfCuts; ++cutIndex )
+			{
+				const __m128 cutValues=_mm_loadu_ps( cuts[cutIndex].values+index );
+				passes=_mm_and_ps( passes, _mm_cmpnlt_ps( cutValues, _mm_set1_ps(cuts[cutIndex].minimum) ) );
+				passes=_mm_and_ps( passes, _mm_cmpngt_ps( cutValues, _mm_set1_ps(cuts[cutIndex].maximum) ) );
+			}
+			// maxps gives the second operand if either is NaN, so the candidates go first. Then a
+			// NaN value is ignored like it is in the scalar loop, rather than replacing the highest.
+			highest=_mm_max_ps( _mm_blendv_ps( minusInfinity, _mm_loadu_ps(values+index), passes ), highest );
+		}
+
+		float lanes[4];
+		_mm_storeu_ps( lanes, highest );
+		float result=std::max( std::max(lanes[0],lanes[1]), std::max(lanes[2],lanes[3]) );
+		return highestPassingValueTail( values, index, size, cuts, numberOfCuts, result );
+	}
+
+	__attribute__((target("avx2")))
+	float highestPassingValueAVX2( const float* values, size_t size, const l1menu::tools::ColumnCut* cuts, size_t numberOfCuts )
+	{
+		const __m256 minusInfinity=_mm256_set1_ps( -std::numeric_limits<float>::infinity() );
+		__m256 highest=minusInfinity;
+
+		size_t index=0;
+		for( ; index+8<=size; index+=8 )
+		{
+			__m256 passes=_mm256_castsi256_ps( _mm256_set1_epi32(-1) );
+			for( size_t cutIndex=0; cutIndex<numberOfCuts; ++cutIndex )
+			{
+				const __m256 cutValues=_mm256_loadu_ps( cuts[cutIndex].values+index );
+				passes=_mm256_and_ps( passes, _mm256_cmp_ps( cutValues, _mm256_set1_ps(cuts[cutIndex].minimum), _CMP_NLT_UQ ) );
+				passes=_mm256_and_ps( passes, _mm256_cmp_ps( cutValues, _mm256_set1_ps(cuts[cutIndex].maximum), _CMP_NGT_UQ ) );
+			}
+			// Candidates first so that NaN values are ignored, see highestPassingValueSSE4
+			highest=_mm256_max_ps( _mm256_blendv_ps( minusInfinity, _mm256_loadu_ps(values+index), passes ), highest );
+		}
+
+		// Reduce the 8 lanes to 4, then do another 4 if there are enough left. Collections are
+		// often small so this saves a lot of time in the scalar loop at the end.
+		const __m128 minusInfinityHalf=_mm256_castps256_ps128(minusInfinity);
+		__m128 highestHalf=_mm_max_ps( _mm256_castps256_ps128(highest), _mm256_extractf128_ps(highest,1) );
+		if( index+4<=size )
+		{
+			__m128 passes=_mm_castsi128_ps( _mm_set1_epi32(-1) );
+			for( size_t cutIndex=0; cutIndex<numberOfCuts; ++cutIndex )
+			{
+				const __m128 cutValues=_mm_loadu_ps( cuts[cutIndex].values+index );
+				passes=_mm_and_ps( passes, _mm_cmpnlt_ps( cutValues, _mm_set1_ps(cuts[cutIndex].minimum) ) );
+				passes=_mm_and_ps( passes, _mm_cmpngt_ps( cutValues, _mm_set1_ps(cuts[cutIndex].maximum) ) );
+			}
+			highestHalf=_mm_max_ps( _mm_blendv_ps( minusInfinityHalf, _mm_loadu_ps(values+index), passes ), highestHalf );
+			index+=4;
+		}
+
+		float lanes[4];
+		_mm_storeu_ps( lanes, highestHalf );
+		float result=std::max( std::max(lanes[0],lanes[1]), std::max(lanes[2],lanes[3]) );
+		// gcc doesn't always add this for functions with the target attribute. Without it the
+		// non-AVX code that follows is heavily penalised on a lot of CPUs.
+		_mm256_zeroupper();
+		return highestPassingValueTail( values, index, size, cuts, numberOfCuts, result );
+	}
+
+	__attribute__((target("sse4.1")))
+	bool anyValuePassingSSE4( const float* values, size_t size, float threshold, const l1menu::tools::ColumnCut* cuts, size_t numberOfCuts )
+	{
+		const __m128 thresholds=_mm_set1_ps( threshold );
+
+		size_t index=0;
+		for( ; index+4<=size; index+=4 )
+		{
+			__m128 passes=_mm_cmpge_ps( _mm_loadu_ps(values+index), thresholds );
+			for( size_t cutIndex=0; cutIndex<numberOfCuts; ++cutIndex )
+			{
+				const __m128 cutValues=_mm_loadu_ps( cuts[cutIndex].values+index );
+				passes=_mm_and_ps( passes, _mm_cmpnlt_ps( cutValues, _mm_set1_ps(cuts[cutIndex].minimum) ) );
+				passes=_mm_and_ps( passes, _mm_cmpngt_ps( cutValues, _mm_set1_ps(cuts[cutIndex].maximum) ) );
+			}
+			if( _mm_movemask_ps(passes)!=0 ) return true;
+		}
+		return anyValuePassingTail( values, index, size, threshold, cuts, numberOfCuts );
+	}
+
+	__attribute__((target("avx2")))
+	bool anyValuePassingAVX2( const float* values, size_t size, float threshold, const l1menu::tools::ColumnCut* cuts, size_t numberOfCuts )
+	{
+		const __m256 thresholds=_mm256_set1_ps( threshold );
+		bool result=false;
+
+		size_t index=0;
+		for( ; index+8<=size && !result; index+=8 )
+		{
+			__m256 passes=_mm256_cmp_ps( _mm256_loadu_ps(values+index), thresholds, _CMP_GE_OQ );
+			for( size_t cutIndex=0; cutIndex<numberOfCuts; ++cutIndex )
+			{
+				const __m256 cutValues=_mm256_loadu_ps( cuts[cutIndex].values+index );
+				passes=_mm256_and_ps( passes, _mm256_cmp_ps( cutValues, _mm256_set1_ps(cuts[cutIndex].minimum), _CMP_NLT_UQ ) );
+				passes=_mm256_and_ps( passes, _mm256_cmp_ps( cutValues, _mm256_set1_ps(cuts[cutIndex].maximum), _CMP_NGT_UQ ) );
+			}
+			result=( _mm256_movemask_ps(passes)!=0 );
+		}
+
+		// Same as highestPassingValueAVX2, do another 4 if there are enough left
+		if( !result && index+4<=size )
+		{
+			__m128 passes=_mm_cmpge_ps( _mm_loadu_ps(values+index), _mm256_castps256_ps128(thresholds) );
+			for( size_t cutIndex=0; cutIndex<numberOfCuts; ++cutIndex )
+			{
+				const __m128 cutValues=_mm_loadu_ps( cuts[cutIndex].values+index );
+				passes=_mm_and_ps( passes, _mm_cmpnlt_ps( cutValues, _mm_set1_ps(cuts[cutIndex].minimum) ) );
+				passes=_mm_and_ps( passes, _mm_cmpngt_ps( cutValues, _mm_set1_ps(cuts[cutIndex].maximum) ) );
+			}
+			result=( _mm_movemask_ps(passes)!=0 );
+			index+=4;
+		}
+
+		_mm256_zeroupper();
+		return result || anyValuePassingTail( values, index, size, threshold, cuts, numberOfCuts );
+	}
+#endif
+
+	HighestPassingValueFunction highestPassingValueFunction( l1menu::tools::InstructionSet instructionSet )
+	{
+		if( !l1menu::tools::instructionSetIsAvailable( instructionSet ) ) throw std::runtime_error( "l1menu::tools::highestPassingValue - the requested instruction set is not available on this machine" );
+
+#ifdef L1MENU_HAVE_X86_KERNELS
+		if( instructionSet==l1menu::tools::InstructionSet::AVX2 ) return &highestPassingValueAVX2;
+		if( instructionSet==l1menu::tools::InstructionSet::SSE4 ) return &highestPassingValueSSE4;
+#endif
+		return &highestPassingValueScalar;
+	}
+
+	AnyValuePassingFunction anyValuePassingFunction( l1menu::tools::InstructionSet instructionSet )
+	{
+		if( !l1menu::tools::instructionSetIsAvailable( instructionSet ) ) throw std::runtime_error( "l1menu::tools::anyValuePassing - the requested instruction set is not available on this machine" );
+
+#ifdef L1MENU_HAVE_X86_KERNELS
+		if( instructionSet==l1menu::tools::InstructionSet::AVX2 ) return &anyValuePassingAVX2;
+		if( instructionSet==l1menu::tools::InstructionSet::SSE4 ) return &anyValuePassingSSE4;
+#endif
+		return &anyValuePassingScalar;
+	}
+}
+
+bool l1menu::tools::instructionSetIsAvailable( l1menu::tools::InstructionSet instructionSet )
+{
+	if( instructionSet==InstructionSet::Scalar ) return true;
+#ifdef L1MENU_HAVE_X86_KERNELS
+	// Only ask the CPU once. Function static initialisation is thread safe in C++11.
+	static const bool haveSSE4=( __builtin_cpu_init(), __builtin_cpu_supports("sse4.1") );
+	static const bool haveAVX2=( __builtin_cpu_init(), __builtin_cpu_supports("avx2") );
+	if( instructionSet==InstructionSet::SSE4 ) return haveSSE4;
+	if( instructionSet==InstructionSet::AVX2 ) return haveAVX2;
+#endif
+	return false;
+}
+
+l1menu::tools::InstructionSet l1menu::tools::bestInstructionSet()
+{
+	static const InstructionSet bestAvailable=[]()
+	{
+		if( instructionSetIsAvailable( InstructionSet::AVX2 ) ) return InstructionSet::AVX2;
+		if( instructionSetIsAvailable( InstructionSet::SSE4 ) ) return InstructionSet::SSE4;
+		return InstructionSet::Scalar;
+	}();
+
+	return bestAvailable;
+}
+
+float l1menu::tools::highestPassingValue( const float* values, size_t size, const l1menu::tools::ColumnCut* cuts, size_t numberOfCuts )
+{
+	static const HighestPassingValueFunction bestFunction=highestPassingValueFunction( bestInstructionSet() );
+	return bestFunction( values, size, cuts, numberOfCuts );
+}
+
+float l1menu::tools::highestPassingValue( const float* values, size_t size, const l1menu::tools::ColumnCut* cuts, size_t numberOfCuts, l1menu::tools::InstructionSet instructionSet )
+{
+	return highestPassingValueFunction( instructionSet )( values, size, cuts, numberOfCuts );
+}
+
+float l1menu::tools::highestPassingValue( const std::vector<float>& values, std::initializer_list<l1menu::tools::ColumnCut> cuts )
+{
+	return highestPassingValue( values.data(), values.size(), cuts.begin(), cuts.size() );
+}
+
+bool l1menu::tools::anyValuePassing( const float* values, size_t size, float threshold, const l1menu::tools::ColumnCut* cuts, size_t numberOfCuts )
+{
+	static const AnyValuePassingFunction bestFunction=anyValuePassingFunction( bestInstructionSet() );
+	return bestFunction( values, size, threshold, cuts, numberOfCuts );
+}
+
+bool l1menu::tools::anyValuePassing( const float* values, size_t size, float threshold, const l1menu::tools::ColumnCut* cuts, size_t numberOfCuts, l1menu::tools::InstructionSet instructionSet )
+{
+	return anyValuePassingFunction( instructionSet )( values, size, threshold, cuts, numberOfCuts );
+}
@@ -0,0 +1,40 @@
+#ifndef l1menu_triggers_CloneableTrigger_h
+#define l1menu_triggers_CloneableTrigger_h
+
+#include <memory>
+#include <utility>
+#include "l1menu/ITrigger.h"
+
+namespace l1menu
+{
+	namespace triggers
+	{
+		/** @brief Implements ITrigger::clone() with the copy constructor of T_Derived.
+		 *
+		 * Concrete triggers derive from this rather than directly from their base class, passing
+		 * themselves as the first template parameter, e.g.
+		 * @code
+		 * class ETM_v0 : public CloneableTrigger<ETM_v0,ETM>
+		 * @endcode
+		 * Any constructor arguments are passed on to T_Base, so initialiser lists that called the base
+		 * constructor call CloneableTrigger instead. A trigger that derives from another concrete trigger
+		 * has to do the same again, otherwise its clones would be the base type.
+		 */
+		template<class T_Derived, class T_Base=l1menu::ITrigger>
+		class CloneableTrigger : public T_Base
+		{
+		public:
+			CloneableTrigger() {}
+			template<class... T_Arguments> explicit CloneableTrigger( T_Arguments&&... arguments ) : T_Base( std::forward<T_Arguments>(arguments)... ) {}
+
+			virtual std::unique_ptr<l1menu::ITrigger> clone() const
+			{
+				return std::unique_ptr<l1menu::ITrigger>( new T_Derived( static_cast<const T_Derived&>(*this) ) );
+			}
+		};
+
+	} // end of namespace triggers
+
+} // end of namespace l1menu
+
+#endif
@@ -3,13 +3,19 @@
 #include <stdexcept>
 
 l1menu::triggers::CrossTrigger::CrossTrigger( std::unique_ptr<l1menu::ITrigger> pLeg1, std::unique_ptr<l1menu::ITrigger> pLeg2 )
-: pLeg1_( std::move(pLeg1) ), pLeg2_( std::move(pLeg2) )
+: pLeg1_( std::move(pLeg1) ), pLeg2_( std::move(pLeg2) ), numberOfLeg1Parameters_( pLeg1_->parameterNames().size() )
 {
 	// No operation besides the initialiser list
 }
 
 l1menu::triggers::CrossTrigger::CrossTrigger( l1menu::ITrigger* pLeg1, l1menu::ITrigger* pLeg2 )
-: pLeg1_( pLeg1 ), pLeg2_( pLeg2 )
+: pLeg1_( pLeg1 ), pLeg2_( pLeg2 ), numberOfLeg1Parameters_( pLeg1_->parameterNames().size() )
+{
+	// No operation besides the initialiser list
+}
+
+l1menu::triggers::CrossTrigger::CrossTrigger( const CrossTrigger& otherTrigger )
+: pLeg1_( otherTrigger.pLeg1_->clone() ), pLeg2_( otherTrigger.pLeg2_->clone() ), numberOfLeg1Parameters_( otherTrigger.numberOfLeg1Parameters_ )
 {
 	// No operation besides the initialiser list
 }
@@ -34,24 +40,34 @@ const std::vector<std::string> l1menu::triggers::CrossTrigger::parameterNames()
 
 float& l1menu::triggers::CrossTrigger::parameter( const std::string& parameterName )
 {
-	std::string firstFourCharacters=parameterName.substr(0,4);
-	std::string everythingElse=parameterName.substr(4);
-
-	if( firstFourCharacters=="leg1" ) return pLeg1_->parameter(everythingElse);
-	else if( firstFourCharacters=="leg2" ) return pLeg2_->parameter(everythingElse);
+	// Check the prefix in place rather than making a temporary string for it
+	if( parameterName.compare(0,4,"leg1")==0 ) return pLeg1_->parameter( parameterName.substr(4) );
+	else if( parameterName.compare(0,4,"leg2")==0 ) return pLeg2_->parameter( parameterName.substr(4) );
 	else throw std::logic_error( "Not a valid parameter name (\""+parameterName+"\")" );
 }
 
 const float& l1menu::triggers::CrossTrigger::parameter( const std::string& parameterName ) const
 {
-	std::string firstFourCharacters=parameterName.substr(0,4);
-	std::string everythingElse=parameterName.substr(4);
-
-	if( firstFourCharacters=="leg1" ) return pLeg1_->parameter(everythingElse);
-	else if( firstFourCharacters=="leg2" ) return pLeg2_->parameter(everythingElse);
+	// Check the prefix in place rather than making a temporary string for it
+	if( parameterName.compare(0,4,"leg1")==0 ) return pLeg1_->parameter( parameterName.substr(4) );
+	else if( parameterName.compare(0,4,"leg2")==0 ) return pLeg2_->parameter( parameterName.substr(4) );
 	else throw std::logic_error( "Not a valid parameter name (\""+parameterName+"\")" );
 }
 
+float& l1menu::triggers::CrossTrigger::parameter( ParameterHandle handle )
+{
+	// The leg1 parameters come first in parameterNames(), then the leg2 parameters
+	if( handle<numberOfLeg1Parameters_ ) return pLeg1_->parameter( handle );
+	else return pLeg2_->parameter( handle-numberOfLeg1Parameters_ );
+}
+
+const float& l1menu::triggers::CrossTrigger::parameter( ParameterHandle handle ) const
+{
+	// The leg1 parameters come first in parameterNames(), then the leg2 parameters
+	if( handle<numberOfLeg1Parameters_ ) return pLeg1_->parameter( handle );
+	else return pLeg2_->parameter( handle-numberOfLeg1Parameters_ );
+}
+
 bool l1menu::triggers::CrossTrigger::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
 	return pLeg1_->apply(event) && pLeg2_->apply(event);
@@ -62,3 +78,13 @@ bool l1menu::triggers::CrossTrigger::thresholdsAreCorrelated() const
 	// If any thresholds in either of the legs are correlated then the say the whole trigger is
 	return pLeg1_->thresholdsAreCorrelated() || pLeg2_->thresholdsAreCorrelated();
 }
+
+const l1menu::ITrigger& l1menu::triggers::CrossTrigger::leg1() const
+{
+	return *pLeg1_;
+}
+
+const l1menu::ITrigger& l1menu::triggers::CrossTrigger::leg2() const
+{
+	return *pLeg2_;
+}
@@ -16,6 +16,9 @@ namespace l1menu
 		 * from the l1menu::ITrigger interface. These should be provided by the derived
 		 * class.
 		 *
+		 * apply is final because l1menu::implementation::CompiledMenu relies on the result
+		 * being the AND of the two legs, so that it can share leg results between triggers.
+		 *
 		 * @author Mark Grimes (mark.grimes@bristol.ac.uk)
 		 * @date 03/Jun/2013
 		 */
@@ -25,15 +28,25 @@ namespace l1menu
 			CrossTrigger( std::unique_ptr<l1menu::ITrigger> pLeg1Trigger, std::unique_ptr<l1menu::ITrigger> pLeg2Trigger );
 			/** @brief Constructor using basic pointers. Note that this class takes ownership. */
 			CrossTrigger( l1menu::ITrigger* pLeg1Trigger, l1menu::ITrigger* pLeg2Trigger );
+			/** @brief Copies both legs with their clone() methods, so that derived classes can be cloned with their copy constructors. */
+			CrossTrigger( const CrossTrigger& otherTrigger );
+			CrossTrigger& operator=( const CrossTrigger& otherTrigger ) = delete;
 			virtual ~CrossTrigger();
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
-			virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
+			virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const final;
 			virtual bool thresholdsAreCorrelated() const;
+
+			const l1menu::ITrigger& leg1() const;
+			const l1menu::ITrigger& leg2() const;
 		protected:
 			std::unique_ptr<l1menu::ITrigger> pLeg1_;
 			std::unique_ptr<l1menu::ITrigger> pLeg2_;
+			/// Handles below this are for leg1, the rest are leg2 handles offset by this amount.
+			size_t numberOfLeg1Parameters_;
 		};
 
 	} // end of namespace triggers
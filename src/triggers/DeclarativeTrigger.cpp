@@ -0,0 +1,265 @@
+#include "DeclarativeTrigger.h"
+
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+#include "l1menu/tools/XMLElement.h"
+#include "l1menu/tools/vectorisedKernels.h"
+
+namespace // Use the unnamed namespace for things only used in this file
+{
+	typedef l1menu::L1TriggerDPGEvent::PrefilteredObjects PrefilteredObjects;
+	typedef l1menu::L1TriggerDPGEvent::ObjectColumns ObjectColumns;
+
+	ObjectColumns PrefilteredObjects::* columnsFromName( const std::string& collectionName )
+	{
+		if( collectionName=="centralJets" ) return &PrefilteredObjects::centralJetColumns;
+		else if( collectionName=="tauJets" ) return &PrefilteredObjects::tauJetColumns;
+		else if( collectionName=="egamma" ) return &PrefilteredObjects::egammaColumns;
+		else if( collectionName=="muons" ) return &PrefilteredObjects::muonColumns;
+		else if( collectionName=="trackElectrons" ) return &PrefilteredObjects::trackElectronColumns;
+		else if( collectionName=="trackElectrons2" ) return &PrefilteredObjects::trackElectron2Columns;
+		else if( collectionName=="trackEM" ) return &PrefilteredObjects::trackEMColumns;
+		else if( collectionName=="trackJets" ) return &PrefilteredObjects::trackJetColumns;
+		else if( collectionName=="trackTaus" ) return &PrefilteredObjects::trackTauColumns;
+		else if( collectionName=="trackMuons" ) return &PrefilteredObjects::trackMuonColumns;
+		else throw std::runtime_error( "Unknown collection \""+collectionName+"\" in trigger definition" );
+	}
+
+	std::vector<float> ObjectColumns::* valuesFromName( const std::string& variableName )
+	{
+		if( variableName=="symmetricRegion" ) return &ObjectColumns::symmetricRegion;
+		else if( variableName=="absoluteEta" ) return &ObjectColumns::absoluteEta;
+		else if( variableName=="quality" ) return &ObjectColumns::quality;
+		else if( variableName=="isolated" ) return &ObjectColumns::isolated;
+		else if( variableName=="trackIsolation" ) return &ObjectColumns::trackIsolation;
+		else throw std::runtime_error( "Unknown cut variable \""+variableName+"\" in trigger definition" );
+	}
+
+	/** @brief Converts the text to a constant if it's a number, otherwise looks it up in the parameter names. */
+	l1menu::triggers::DeclarativeTriggerPlan::Value valueFromText( const std::string& text, const std::vector<std::string>& parameterNames )
+	{
+		const auto iFindResult=std::find( parameterNames.begin(), parameterNames.end(), text );
+		if( iFindResult!=parameterNames.end() ) return { static_cast<size_t>(iFindResult-parameterNames.begin()), 0 };
+
+		size_t charactersUsed=0;
+		float constant=0;
+		try{ constant=std::stof( text, &charactersUsed ); }
+		catch( std::exception& ) { charactersUsed=0; }
+		if( charactersUsed==0 || charactersUsed!=text.size() ) throw std::runtime_error( "\""+text+"\" in trigger definition is neither a number nor a parameter name" );
+
+		return { l1menu::triggers::DeclarativeTriggerPlan::noParameter, constant };
+	}
+}
+
+l1menu::triggers::DeclarativeTriggerPlan::DeclarativeTriggerPlan( const l1menu::tools::XMLElement& xmlDefinition )
+	: thresholdsAreCorrelated(false)
+{
+	if( xmlDefinition.name()!="TriggerDefinition" ) throw std::runtime_error( "Cannot create trigger definition from XML because the element provided is not named 'TriggerDefinition'" );
+
+	std::vector<l1menu::tools::XMLElement> childElements=xmlDefinition.getChildren("name");
+	if( childElements.size()!=1 ) throw std::runtime_error( "Trigger definition doesn't have one and only one subelement called 'name'" );
+	name=childElements.front().getValue();
+
+	childElements=xmlDefinition.getChildren("version");
+	if( childElements.size()!=1 ) throw std::runtime_error( "Trigger definition \""+name+"\" doesn't have one and only one subelement called 'version'" );
+	version=childElements.front().getIntValue();
+
+	if( !xmlDefinition.hasAttribute("legs") || xmlDefinition.getAttribute("legs")=="and" ) requireAllLegs=true;
+	else if( xmlDefinition.getAttribute("legs")=="or" ) requireAllLegs=false;
+	else throw std::runtime_error( "Trigger definition \""+name+"\" has a 'legs' attribute that is neither 'and' nor 'or'" );
+
+	for( const auto& parameterElement : xmlDefinition.getChildren("parameter") )
+	{
+		const std::string parameterName=parameterElement.getAttribute("name");
+		if( std::find( parameterNames.begin(), parameterNames.end(), parameterName )!=parameterNames.end() ) throw std::runtime_error( "Trigger definition \""+name+"\" has more than one parameter called \""+parameterName+"\"" );
+		parameterNames.push_back( parameterName );
+		defaultValues.push_back( parameterElement.getFloatValue() );
+
+		if( parameterElement.hasAttribute("numberOfBins") )
+		{
+			suggestedBinning.push_back( Binning{ parameterName, static_cast<unsigned int>(parameterElement.getIntAttribute("numberOfBins")),
+					parameterElement.getFloatAttribute("lowerEdge"), parameterElement.getFloatAttribute("upperEdge") } );
+		}
+	}
+
+	childElements=xmlDefinition.getChildren("leg");
+	if( childElements.empty() ) throw std::runtime_error( "Trigger definition \""+name+"\" doesn't have any legs" );
+	for( const auto& legElement : childElements )
+	{
+		Leg leg;
+		leg.pColumns=columnsFromName( legElement.getAttribute("collection") );
+
+		leg.firstCut=cuts.size();
+		for( const auto& cutElement : legElement.getChildren("cut") )
+		{
+			Cut cut;
+			cut.pValues=valuesFromName( cutElement.getAttribute("variable") );
+			if( cutElement.hasAttribute("minimum") ) cut.minimum=valueFromText( cutElement.getAttribute("minimum"), parameterNames );
+			else cut.minimum=Value{ noParameter, -std::numeric_limits<float>::infinity() };
+			if( cutElement.hasAttribute("maximum") ) cut.maximum=valueFromText( cutElement.getAttribute("maximum"), parameterNames );
+			else cut.maximum=Value{ noParameter, std::numeric_limits<float>::infinity() };
+			cuts.push_back( cut );
+		}
+		leg.numberOfCuts=cuts.size()-leg.firstCut;
+		if( leg.numberOfCuts>maximumCutsPerLeg ) throw std::runtime_error( "Trigger definition \""+name+"\" has a leg with too many cuts" );
+
+		leg.firstThreshold=thresholds.size();
+		const std::vector<l1menu::tools::XMLElement> thresholdElements=legElement.getChildren("threshold");
+		if( legElement.hasAttribute("multiplicity") )
+		{
+			if( thresholdElements.size()!=1 ) throw std::runtime_error( "Trigger definition \""+name+"\" has a leg with a multiplicity attribute, so it must have one and only one threshold" );
+			const int multiplicity=legElement.getIntAttribute("multiplicity");
+			if( multiplicity<1 || multiplicity>static_cast<int>(maximumMultiplicity) ) throw std::runtime_error( "Trigger definition \""+name+"\" has a leg with an invalid multiplicity" );
+			thresholds.insert( thresholds.end(), multiplicity, valueFromText( thresholdElements.front().getValue(), parameterNames ) );
+		}
+		else
+		{
+			for( const auto& thresholdElement : thresholdElements ) thresholds.push_back( valueFromText( thresholdElement.getValue(), parameterNames ) );
+		}
+		leg.multiplicity=thresholds.size()-leg.firstThreshold;
+		if( leg.multiplicity==0 ) throw std::runtime_error( "Trigger definition \""+name+"\" has a leg without a threshold" );
+		if( leg.multiplicity>maximumMultiplicity ) throw std::runtime_error( "Trigger definition \""+name+"\" has a leg with too high a multiplicity" );
+		if( leg.multiplicity>1 ) thresholdsAreCorrelated=true;
+
+		legs.push_back( leg );
+	}
+}
+
+bool l1menu::triggers::DeclarativeTriggerPlan::objectPasses( const Leg& leg, const l1menu::L1TriggerDPGEvent::ObjectColumns& columns, size_t objectIndex, const float* parameters ) const
+{
+	for( size_t cutIndex=leg.firstCut; cutIndex<leg.firstCut+leg.numberOfCuts; ++cutIndex )
+	{
+		const Cut& cut=cuts[cutIndex];
+		const float value=(columns.*cut.pValues)[objectIndex];
+		// Written the same way as the vectorised kernels, so that a NaN passes like it does in the trigger loops
+		if( value<cut.minimum.resolve(parameters) || value>cut.maximum.resolve(parameters) ) return false;
+	}
+	return true;
+}
+
+void l1menu::triggers::DeclarativeTriggerPlan::addToLeading( float* leading, size_t& numberFound, size_t multiplicity, float et )
+{
+	if( numberFound<multiplicity ) ++numberFound;
+	else if( !(et>leading[multiplicity-1]) ) return;
+
+	// Shuffle the lower values down until the right place is found
+	size_t index=numberFound-1;
+	for( ; index>0 && leading[index-1]<et; --index ) leading[index]=leading[index-1];
+	leading[index]=et;
+}
+
+bool l1menu::triggers::DeclarativeTriggerPlan::thresholdsPass( const Leg& leg, const float* leading, size_t numberFound, const float* parameters ) const
+{
+	if( numberFound<leg.multiplicity ) return false;
+	for( size_t index=0; index<leg.multiplicity; ++index )
+	{
+		if( !(leading[index]>=thresholds[leg.firstThreshold+index].resolve(parameters)) ) return false;
+	}
+	return true;
+}
+
+bool l1menu::triggers::DeclarativeTriggerPlan::legPasses( const Leg& leg, const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects, const float* parameters ) const
+{
+	const l1menu::L1TriggerDPGEvent::ObjectColumns& columns=objects.*leg.pColumns;
+
+	if( leg.multiplicity==1 )
+	{
+		// The most common case, which the vectorised kernel can do
+		l1menu::tools::ColumnCut columnCuts[maximumCutsPerLeg];
+		for( size_t index=0; index<leg.numberOfCuts; ++index )
+		{
+			const Cut& cut=cuts[leg.firstCut+index];
+			columnCuts[index]={ (columns.*cut.pValues).data(), cut.minimum.resolve(parameters), cut.maximum.resolve(parameters) };
+		}
+		return l1menu::tools::anyValuePassing( columns.et.data(), columns.et.size(), thresholds[leg.firstThreshold].resolve(parameters), columnCuts, leg.numberOfCuts );
+	}
+
+	float leading[maximumMultiplicity];
+	size_t numberFound=0;
+	for( size_t objectIndex=0; objectIndex<columns.et.size(); ++objectIndex )
+	{
+		if( objectPasses( leg, columns, objectIndex, parameters ) ) addToLeading( leading, numberFound, leg.multiplicity, columns.et[objectIndex] );
+	}
+	return thresholdsPass( leg, leading, numberFound, parameters );
+}
+
+l1menu::triggers::DeclarativeTrigger::DeclarativeTrigger( std::shared_ptr<const DeclarativeTriggerPlan> pPlan )
+	: pPlan_( std::move(pPlan) ), parameters_( pPlan_->defaultValues )
+{
+	// No operation besides the initialiser list
+}
+
+const l1menu::triggers::DeclarativeTriggerPlan& l1menu::triggers::DeclarativeTrigger::plan() const
+{
+	return *pPlan_;
+}
+
+const float* l1menu::triggers::DeclarativeTrigger::parameterValues() const
+{
+	return parameters_.data();
+}
+
+const std::string l1menu::triggers::DeclarativeTrigger::name() const
+{
+	return pPlan_->name;
+}
+
+unsigned int l1menu::triggers::DeclarativeTrigger::version() const
+{
+	return pPlan_->version;
+}
+
+bool l1menu::triggers::DeclarativeTrigger::thresholdsAreCorrelated() const
+{
+	return pPlan_->thresholdsAreCorrelated;
+}
+
+const std::vector<std::string> l1menu::triggers::DeclarativeTrigger::parameterNames() const
+{
+	return pPlan_->parameterNames;
+}
+
+float& l1menu::triggers::DeclarativeTrigger::parameter( const std::string& parameterName )
+{
+	return parameters_[handleFromName(parameterName)];
+}
+
+const float& l1menu::triggers::DeclarativeTrigger::parameter( const std::string& parameterName ) const
+{
+	return parameters_[handleFromName(parameterName)];
+}
+
+float& l1menu::triggers::DeclarativeTrigger::parameter( ParameterHandle handle )
+{
+	if( handle>=parameters_.size() ) throw std::logic_error( "Not a valid parameter handle" );
+	return parameters_[handle];
+}
+
+const float& l1menu::triggers::DeclarativeTrigger::parameter( ParameterHandle handle ) const
+{
+	if( handle>=parameters_.size() ) throw std::logic_error( "Not a valid parameter handle" );
+	return parameters_[handle];
+}
+
+bool l1menu::triggers::DeclarativeTrigger::apply( const l1menu::L1TriggerDPGEvent& event ) const
+{
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
+
+	for( const auto& leg : pPlan_->legs )
+	{
+		const bool legPassed=pPlan_->legPasses( leg, objects, parameters_.data() );
+		// Stop as soon as the result is known
+		if( legPassed!=pPlan_->requireAllLegs ) return legPassed;
+	}
+	return pPlan_->requireAllLegs;
+}
+
+size_t l1menu::triggers::DeclarativeTrigger::handleFromName( const std::string& parameterName ) const
+{
+	const auto iFindResult=std::find( pPlan_->parameterNames.begin(), pPlan_->parameterNames.end(), parameterName );
+	if( iFindResult==pPlan_->parameterNames.end() ) throw std::logic_error( "Not a valid parameter name" );
+	return iFindResult-pPlan_->parameterNames.begin();
+}
@@ -0,0 +1,163 @@
+#ifndef l1menu_triggers_DeclarativeTrigger_h
+#define l1menu_triggers_DeclarativeTrigger_h
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include "l1menu/ITrigger.h"
+#include "l1menu/L1TriggerDPGEvent.h"
+#include "CloneableTrigger.h"
+
+//
+// Forward declarations
+//
+namespace l1menu
+{
+	namespace tools
+	{
+		class XMLElement;
+	}
+}
+
+namespace l1menu
+{
+	namespace triggers
+	{
+		/** @brief The flat evaluation plan for a trigger declared in XML rather than written in C++.
+		 *
+		 * Created from a "TriggerDefinition" XML element, which looks like
+		 * @code
+		 * <TriggerDefinition legs="and">
+		 *     <name>L1_IsoEG_Mu</name>
+		 *     <version>0</version>
+		 *     <parameter name="leg1threshold1" numberOfBins="60" lowerEdge="0" upperEdge="60">20</parameter>
+		 *     <parameter name="leg1regionCut">4.5</parameter>
+		 *     <parameter name="leg2threshold1">10</parameter>
+		 *     <parameter name="leg2etaCut">2.1</parameter>
+		 *     <leg collection="egamma">
+		 *         <threshold>leg1threshold1</threshold>
+		 *         <cut variable="symmetricRegion" minimum="leg1regionCut"/>
+		 *         <cut variable="isolated" minimum="1"/>
+		 *     </leg>
+		 *     <leg collection="muons">
+		 *         <threshold>leg2threshold1</threshold>
+		 *         <cut variable="absoluteEta" maximum="leg2etaCut"/>
+		 *     </leg>
+		 * </TriggerDefinition>
+		 * @endcode
+		 * The parameter elements are the same format as in the menu XML files, with the value being the
+		 * default. The binning attributes are optional and are registered as the suggested binning.
+		 *
+		 * A leg passes if the leading objects in the collection that pass all of its cuts are each above their
+		 * own threshold, highest Et object first. So the number of threshold elements is the multiplicity;
+		 * alternatively a leg can have a single threshold and a "multiplicity" attribute, in which case all
+		 * of the objects have to pass that threshold. "collection" is the name of one of the vectors in
+		 * L1TriggerDPGEvent::PrefilteredObjects, and "variable" one of the ObjectColumns vectors other than
+		 * et. Cut limits and thresholds can be numbers or parameter names. Cuts fail if
+		 * "value<minimum || value>maximum", and either limit can be left out.
+		 *
+		 * The legs are combined with AND unless the "legs" attribute is "or". As with every other trigger
+		 * nothing passes unless the zero bias bit is set.
+		 *
+		 * Everything is resolved when the definition is read, so evaluating a leg is a loop over float
+		 * columns with cuts that are just indices into the parameter array. The members are public so that
+		 * l1menu::implementation::CompiledMenu can fuse the legs from a whole menu.
+		 */
+		class DeclarativeTriggerPlan
+		{
+		public:
+			static const size_t maximumMultiplicity=8;
+			static const size_t maximumCutsPerLeg=8;
+			static const size_t noParameter=static_cast<size_t>(-1);
+
+			/** @brief Either a constant or the index of one of the trigger parameters. */
+			struct Value
+			{
+				size_t parameter;
+				float constant;
+				float resolve( const float* parameters ) const { return parameter==noParameter ? constant : parameters[parameter]; }
+			};
+			struct Cut
+			{
+				std::vector<float> l1menu::L1TriggerDPGEvent::ObjectColumns::* pValues;
+				Value minimum;
+				Value maximum;
+			};
+			/** @brief The cuts and thresholds for a leg are ranges in the flat cuts and thresholds vectors. */
+			struct Leg
+			{
+				l1menu::L1TriggerDPGEvent::ObjectColumns l1menu::L1TriggerDPGEvent::PrefilteredObjects::* pColumns;
+				size_t firstCut;
+				size_t numberOfCuts;
+				size_t firstThreshold;
+				size_t multiplicity;
+			};
+			struct Binning
+			{
+				std::string parameterName;
+				unsigned int numberOfBins;
+				float lowerEdge;
+				float upperEdge;
+			};
+
+			explicit DeclarativeTriggerPlan( const l1menu::tools::XMLElement& xmlDefinition );
+
+			/** @brief Whether the leg passes, given the trigger parameters in the same order as parameterNames. */
+			bool legPasses( const Leg& leg, const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects, const float* parameters ) const;
+			/** @brief Whether the object passes all of the leg's cuts, apart from the thresholds. */
+			bool objectPasses( const Leg& leg, const l1menu::L1TriggerDPGEvent::ObjectColumns& columns, size_t objectIndex, const float* parameters ) const;
+			/** @brief Keeps the "multiplicity" highest Et values seen so far in leading, highest first.
+			 * numberFound should start at zero and is capped at multiplicity. */
+			static void addToLeading( float* leading, size_t& numberFound, size_t multiplicity, float et );
+			/** @brief Whether the leading objects found with addToLeading pass the leg thresholds. */
+			bool thresholdsPass( const Leg& leg, const float* leading, size_t numberFound, const float* parameters ) const;
+
+			std::string name;
+			unsigned int version;
+			std::vector<std::string> parameterNames;
+			std::vector<float> defaultValues;
+			std::vector<Binning> suggestedBinning;
+			bool requireAllLegs;
+			bool thresholdsAreCorrelated; ///< True if any leg has more than one object
+
+			std::vector<Leg> legs;
+			std::vector<Cut> cuts;
+			std::vector<Value> thresholds;
+		};
+
+		/** @brief An ITrigger that applies a DeclarativeTriggerPlan.
+		 *
+		 * All instances with the same name and version share the plan, and only have their own parameter
+		 * values. Create them through the TriggerTable once the definitions have been loaded with
+		 * l1menu::tools::loadTriggerDefinitions.
+		 */
+		class DeclarativeTrigger : public CloneableTrigger<DeclarativeTrigger>
+		{
+		public:
+			explicit DeclarativeTrigger( std::shared_ptr<const DeclarativeTriggerPlan> pPlan );
+
+			const DeclarativeTriggerPlan& plan() const;
+			/** @brief The parameter values, in the same order as the plan's parameterNames. */
+			const float* parameterValues() const;
+
+			virtual const std::string name() const;
+			virtual unsigned int version() const;
+			virtual bool thresholdsAreCorrelated() const;
+			virtual const std::vector<std::string> parameterNames() const;
+			virtual float& parameter( const std::string& parameterName );
+			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
+			virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const;
+		private:
+			size_t handleFromName( const std::string& parameterName ) const;
+
+			std::shared_ptr<const DeclarativeTriggerPlan> pPlan_;
+			std::vector<float> parameters_;
+		};
+
+	} // end of namespace triggers
+} // end of namespace l1menu
+
+#endif
@@ -3,7 +3,6 @@
 #include <stdexcept>
 #include "../implementation/RegisterTriggerMacro.h"
 #include "l1menu/L1TriggerDPGEvent.h"
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
 
 
 namespace l1menu
@@ -36,30 +35,20 @@ namespace l1menu
 
 bool l1menu::triggers::DoubleMu_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw=PhysicsBits[0]; // ZeroBias
-	if( !raw ) return false;
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
 
 	int n1=0;
 	int n2=0;
-	int Nmu=analysisDataFormat.Nmu;
-	for( int imu=0; imu<Nmu; imu++ )
+	for( const auto& muon : objects.muons )
 	{
-		int bx=analysisDataFormat.Bxmu.at( imu );
-		if( bx!=0 ) continue;
-		float pt=analysisDataFormat.Ptmu.at( imu );
-		//float eta=analysisDataFormat.Etamu.at( imu ); // Commented out to stop unused variable compile warning
-		int qual=analysisDataFormat.Qualmu.at( imu );
-		if( qual<muonQuality_ ) continue;
-
+		if( muon.quality<muonQuality_ ) continue;
+		float pt=muon.et;
 		if( pt>=threshold1_ ) n1++;
 		if( pt>=threshold2_ ) n2++;
 	}
 
-	bool ok=( n1>=1 && n2>=2 );
-	return ok;
+	return ( n1>=1 && n2>=2 );
 }
 
 bool l1menu::triggers::DoubleMu_v0::thresholdsAreCorrelated() const
@@ -107,3 +96,25 @@ const float& l1menu::triggers::DoubleMu::parameter( const std::string& parameter
 	else if( parameterName=="muonQuality" ) return muonQuality_;
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::DoubleMu::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return threshold1_;
+		case 1: return threshold2_;
+		case 2: return muonQuality_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::DoubleMu::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return threshold1_;
+		case 1: return threshold2_;
+		case 2: return muonQuality_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
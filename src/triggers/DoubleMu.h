@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include "l1menu/ITrigger.h"
+#include "CloneableTrigger.h"
 
 //
 // Forward declarations
@@ -36,6 +37,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		protected:
 			float threshold1_;
 			float threshold2_;
@@ -47,7 +50,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class DoubleMu_v0 : public DoubleMu
+		class DoubleMu_v0 : public CloneableTrigger<DoubleMu_v0,DoubleMu>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -1,54 +1,30 @@
 #include "../implementation/RegisterTriggerMacro.h"
-#include "l1menu/L1TriggerDPGEvent.h"
-
-#include <stdexcept>
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
-
-#include "l1menu/ITrigger.h"
-
-#include <string>
-#include <vector>
+#include "TriggerFamilies.h"
 
 namespace l1menu
 {
 	namespace triggers
 	{
-		/** @brief Base class for all versions of the DoubleTau trigger.
-		 *
-		 * Note that this class is abstract because it doesn't implement the "version"
-		 * and "apply" methods. That's left up to the implementations of the different
-		 * versions.
+		/** @brief The name and parameters shared by all versions of the DoubleTau trigger.
 		 *
 		 * @author Mark Grimes (mark.grimes@bristol.ac.uk)
 		 * @date 02/Jun/2013
 		 */
-		class DoubleTau : public l1menu::ITrigger
+		struct DoubleTauDefinition
 		{
-		public:
-			DoubleTau();
-
-			virtual const std::string name() const;
-			virtual const std::vector<std::string> parameterNames() const;
-			virtual float& parameter( const std::string& parameterName );
-			virtual const float& parameter( const std::string& parameterName ) const;
-		protected:
-			float leg1threshold1_;
-			float leg2threshold1_;
-			float regionCut_;
-		}; // end of the DoubleTau base class
+			static constexpr const char* name="L1_DoubleTau";
+			static constexpr TriggerParameter parameters[]={ {"leg1threshold1",20}, {"leg2threshold1",20}, {"regionCut",4.5} };
+		};
+		// Storage for the definition, which the family templates need until C++17
+		constexpr const char* DoubleTauDefinition::name;
+		constexpr TriggerParameter DoubleTauDefinition::parameters[];
 
 		/** @brief First version of the DoubleTau trigger.
 		 *
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class DoubleTau_v0 : public DoubleTau
-		{
-		public:
-			virtual unsigned int version() const;
-			virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const;
-			virtual bool thresholdsAreCorrelated() const;
-		}; // end of version 0 class
+		typedef LeadingObjectsFamily<DoubleTauDefinition,0,collections::TauJets,2> DoubleTau_v0;
 
 
 		/* The REGISTER_TRIGGER macro will make sure that the given trigger is registered in the
@@ -72,87 +48,3 @@ namespace l1menu
 	} // end of namespace triggers
 
 } // end of namespace l1menu
-
-
-//----------------------------------------------------------------------------------------
-//----------------------------------------------------------------------------------------
-//----------------------------------------------------------------------------------------
-//---------------  Definitions below         ---------------------------------------------
-//----------------------------------------------------------------------------------------
-//----------------------------------------------------------------------------------------
-//----------------------------------------------------------------------------------------
-
-
-bool l1menu::triggers::DoubleTau_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
-{
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];  // ZeroBias
-	if (! raw) return false;
-
-	int n1=0;
-	int n2=0;
-	int Nj = analysisDataFormat.Njet ;
-	for (int ue=0; ue < Nj; ue++) {
-		int bx = analysisDataFormat.Bxjet[ue];
-		if (bx != 0) continue;
-		bool isTauJet = analysisDataFormat.Taujet[ue];
-		if (! isTauJet) continue;
-		float rank = analysisDataFormat.Etjet[ue];    // the rank of the electron
-		float pt = rank; //CorrectedL1JetPtByGCTregions(analysisDataFormat.Etajet[ue],rank*4.,theL1JetCorrection);
-		float eta = analysisDataFormat.Etajet[ue];
-		if (eta < regionCut_ || eta > 21.-regionCut_) continue;  // eta = 5 - 16
-		if (pt >= leg1threshold1_) n1++;
-		if (pt >= leg2threshold1_) n2++;
-	}  // end loop over jets
-
-	bool ok = ( n1 >=1 && n2 >= 2);
-	return ok;
-}
-
-bool l1menu::triggers::DoubleTau_v0::thresholdsAreCorrelated() const
-{
-	return true;
-}
-
-unsigned int l1menu::triggers::DoubleTau_v0::version() const
-{
-	return 0;
-}
-
-l1menu::triggers::DoubleTau::DoubleTau()
-	: leg1threshold1_(20), leg2threshold1_(20), regionCut_(4.5)
-{
-	// No operation other than the initialiser list
-}
-
-const std::string l1menu::triggers::DoubleTau::name() const
-{
-	return "L1_DoubleTau";
-}
-
-const std::vector<std::string> l1menu::triggers::DoubleTau::parameterNames() const
-{
-	std::vector<std::string> returnValue;
-	returnValue.push_back("leg1threshold1");
-	returnValue.push_back("leg2threshold1");
-	returnValue.push_back("regionCut");
-	return returnValue;
-}
-
-float& l1menu::triggers::DoubleTau::parameter( const std::string& parameterName )
-{
-	if( parameterName=="leg1threshold1" ) return leg1threshold1_;
-	else if( parameterName=="leg2threshold1" ) return leg2threshold1_;
-	else if( parameterName=="regionCut" ) return regionCut_;
-	else throw std::logic_error( "Not a valid parameter name" );
-}
-
-const float& l1menu::triggers::DoubleTau::parameter( const std::string& parameterName ) const
-{
-	if( parameterName=="leg1threshold1" ) return leg1threshold1_;
-	else if( parameterName=="leg2threshold1" ) return leg2threshold1_;
-	else if( parameterName=="regionCut" ) return regionCut_;
-	else throw std::logic_error( "Not a valid parameter name" );
-}
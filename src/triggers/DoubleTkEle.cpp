@@ -1,95 +1,59 @@
 #include "../implementation/RegisterTriggerMacro.h"
-#include "l1menu/L1TriggerDPGEvent.h"
-
-#include <stdexcept>
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
-
-#include "l1menu/ITrigger.h"
-
-#include <string>
-#include <vector>
-#include <cmath>
+#include "TriggerFamilies.h"
 
 namespace l1menu
 {
 	namespace triggers
 	{
-		/** @brief Base class for all versions of the DoubleTkEle trigger.
-		 *
-		 * Note that this class is abstract because it doesn't implement the "version"
-		 * and "apply" methods. That's left up to the implementations of the different
-		 * versions.
+		/** @brief The name and parameters shared by all versions of the DoubleTkEle trigger.
 		 *
 		 * @author Mark Grimes (mark.grimes@bristol.ac.uk)
 		 * @date 02/Jun/2013
 		 */
-		class DoubleTkEle : public l1menu::ITrigger
+		struct DoubleTkEleDefinition
 		{
-		public:
-			DoubleTkEle();
-
-			virtual const std::string name() const;
-			virtual const std::vector<std::string> parameterNames() const;
-			virtual float& parameter( const std::string& parameterName );
-			virtual const float& parameter( const std::string& parameterName ) const;
-		protected:
-			float leg1threshold1_;
-			float leg2threshold1_;
-			float regionCut_;
-			float zVtxCut_;
-		}; // end of the DoubleTkEle base class
+			static constexpr const char* name="L1_DoubleTkEle";
+			static constexpr TriggerParameter parameters[]={ {"leg1threshold1",20}, {"leg2threshold1",20}, {"regionCut",4.5}, {"zVtxCut",9999.} };
+		};
+		// Storage for the definition, which the family templates need until C++17
+		constexpr const char* DoubleTkEleDefinition::name;
+		constexpr TriggerParameter DoubleTkEleDefinition::parameters[];
 
 		/** @brief First version of the DoubleTkEle trigger.
+		 *
+		 * The two leading electrons passing the region cut, zVtxCut isn't used.
 		 *
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class DoubleTkEle_v0 : public DoubleTkEle
-		{
-		public:
-			virtual unsigned int version() const;
-			virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const;
-			virtual bool thresholdsAreCorrelated() const;
-		}; // end of version 0 class
+		typedef LeadingObjectsFamily<DoubleTkEleDefinition,0,collections::TrackElectrons,2> DoubleTkEle_v0;
 
 		/** @brief Second version of the DoubleTkEle trigger.
-		 *             --> Used TkEle Collection with lower Pt cut
+		 *
+		 * The same as version 0 but using the second track electron collection.
+		 *
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class DoubleTkEle_v1 : public DoubleTkEle
-		{
-		public:
-			virtual unsigned int version() const;
-			virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const;
-			virtual bool thresholdsAreCorrelated() const;
-		}; // end of version 1 class
+		typedef LeadingObjectsFamily<DoubleTkEleDefinition,1,collections::TrackElectrons2,2> DoubleTkEle_v1;
 
-		/** @brief Second version of the DoubleTkEle trigger.
-		 *             --> Used a zVtxcut
+		/** @brief Third version of the DoubleTkEle trigger.
+		 *
+		 * Any two electrons passing the region cut that are within zVtxCut of each other.
+		 *
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class DoubleTkEle_v2 : public DoubleTkEle
-		{
-		public:
-			virtual unsigned int version() const;
-			virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const;
-			virtual bool thresholdsAreCorrelated() const;
-		}; // end of version 2 class
+		typedef VertexMatchedPairFamily<DoubleTkEleDefinition,2,collections::TrackElectrons,collections::TrackElectrons,cuts::Region> DoubleTkEle_v2;
 
-		/** @brief Second version of the DoubleTkEle trigger.
-		 *             --> Used TkEle Collection with lower Pt cut and a zVtxcut
+		/** @brief Fourth version of the DoubleTkEle trigger.
+		 *
+		 * The same as version 2 but using the second track electron collection.
+		 *
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class DoubleTkEle_v3 : public DoubleTkEle
-		{
-		public:
-			virtual unsigned int version() const;
-			virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const;
-			virtual bool thresholdsAreCorrelated() const;
-		}; // end of version 3 class
+		typedef VertexMatchedPairFamily<DoubleTkEleDefinition,3,collections::TrackElectrons2,collections::TrackElectrons2,cuts::Region> DoubleTkEle_v3;
 
 
 		/* The REGISTER_TRIGGER macro will make sure that the given trigger is registered in the
@@ -116,232 +80,3 @@ namespace l1menu
 	} // end of namespace triggers
 
 } // end of namespace l1menu
-
-
-//----------------------------------------------------------------------------------------
-//----------------------------------------------------------------------------------------
-//----------------------------------------------------------------------------------------
-//---------------  Definitions below         ---------------------------------------------
-//----------------------------------------------------------------------------------------
-//----------------------------------------------------------------------------------------
-//----------------------------------------------------------------------------------------
-
-
-bool l1menu::triggers::DoubleTkEle_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
-{
-
-
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0]; // ZeroBias
-	if (! raw) return false;
-
-	int n1=0;
-	int n2=0;
-	int Nele = analysisDataFormat.NTkele;
-
-	for (int ue=0; ue < Nele; ue++) {
-		int bx = analysisDataFormat.BxTkel[ue];
-		if (bx != 0) continue;
-		float eta = analysisDataFormat.EtaTkel[ue];
-		if (eta < regionCut_ || eta > 21.-regionCut_) continue; // eta = 5 - 16
-		float rank = analysisDataFormat.EtTkel[ue]; // the rank of the electron
-		float pt = rank ;
-		if (pt >= leg1threshold1_) n1++;
-		if (pt >= leg2threshold1_) n2++;
-	} // end loop over EM objects
-
-	bool ok = ( n1 >= 1 && n2 >= 2) ;
-	//if(ok) printf("Found doubleEG event Run %i Event %i \n",event_->run,event_->event);
-	return ok;
-}
-
-bool l1menu::triggers::DoubleTkEle_v0::thresholdsAreCorrelated() const
-{
-	return true;
-}
-
-unsigned int l1menu::triggers::DoubleTkEle_v0::version() const
-{
-	return 0;
-}
-
-
-bool l1menu::triggers::DoubleTkEle_v1::apply( const l1menu::L1TriggerDPGEvent& event ) const
-{
-
-
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0]; // ZeroBias
-	if (! raw) return false;
-
-	int n1=0;
-	int n2=0;
-	int Nele = analysisDataFormat.NTkele2;
-
-	for (int ue=0; ue < Nele; ue++) {
-		int bx = analysisDataFormat.BxTkel2[ue];
-		if (bx != 0) continue;
-		float eta = analysisDataFormat.EtaTkel2[ue];
-		if (eta < regionCut_ || eta > 21.-regionCut_) continue; // eta = 5 - 16
-		float rank = analysisDataFormat.EtTkel2[ue]; // the rank of the electron
-		float pt = rank ;
-		if (pt >= leg1threshold1_) n1++;
-		if (pt >= leg2threshold1_) n2++;
-	} // end loop over EM objects
-
-	bool ok = ( n1 >= 1 && n2 >= 2) ;
-	//if(ok) printf("Found doubleEG event Run %i Event %i \n",event_->run,event_->event);
-	return ok;
-}
-
-bool l1menu::triggers::DoubleTkEle_v1::thresholdsAreCorrelated() const
-{
-	return true;
-}
-
-unsigned int l1menu::triggers::DoubleTkEle_v1::version() const
-{
-	return 1;
-}
-
-
-
-
-bool l1menu::triggers::DoubleTkEle_v2::apply( const l1menu::L1TriggerDPGEvent& event ) const
-{
-
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];   // ZeroBias
-	if (! raw) return false;
-
-        bool ok = false;
-	
-	int Nele = analysisDataFormat.NTkele;
-	for (int ue=0; ue < Nele; ue++) {
-		int bx = analysisDataFormat.BxTkel[ue];
-		if (bx != 0) continue;
-		float eta = analysisDataFormat.EtaTkel[ue];
-		if (eta < regionCut_ || eta > 21.-regionCut_) continue;  // eta = 5 - 16
-		float rank = analysisDataFormat.EtTkel[ue];    // the rank of the electron
-		float pt = rank ;
-		if (pt >= leg1threshold1_) {
-		
-		      float eleZvtx = analysisDataFormat.zVtxTkel[ue];
-		      for(int ue2=0; ue2< Nele; ue2++) {
-		          if( (ue2 != ue) &&
-			      (fabs(eleZvtx - analysisDataFormat.zVtxTkel[ue2]) < zVtxCut_) )  {
-			      if (analysisDataFormat.BxTkel[ue2]!= 0) continue;
-			      float eta2 = analysisDataFormat.EtaTkel[ue2];
-			      if (eta2 < regionCut_ || eta2 > 21.-regionCut_) continue;  // eta = 5 - 16
-			      float pt2 = analysisDataFormat.EtTkel[ue2];     
-		              if (pt2 >= leg2threshold1_ ) ok=true;
-			   }//end if vtx compatability  
-		      }	//end loop over second object
-		}  //end pt threshold
-	}  // end loop over EM objects
-
-	//if(ok) printf("Found doubleEG event Run %i Event %i \n",event_->run,event_->event);
-	return ok;
-}
-
-bool l1menu::triggers::DoubleTkEle_v2::thresholdsAreCorrelated() const
-{
-	return true;
-}
-
-unsigned int l1menu::triggers::DoubleTkEle_v2::version() const
-{
-	return 2;
-}
-
-bool l1menu::triggers::DoubleTkEle_v3::apply( const l1menu::L1TriggerDPGEvent& event ) const
-{
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];   // ZeroBias
-	if (! raw) return false;
-
-	bool ok =false;
-	int Nele = analysisDataFormat.NTkele2;
-	for (int ue=0; ue < Nele; ue++) {
-		int bx = analysisDataFormat.BxTkel2[ue];
-		if (bx != 0) continue;
-		float eta = analysisDataFormat.EtaTkel2[ue];
-		if (eta < regionCut_ || eta > 21.-regionCut_) continue;  // eta = 5 - 16
-		float rank = analysisDataFormat.EtTkel2[ue];    // the rank of the electron
-		float pt = rank ;
-		if (pt >= leg1threshold1_) {
-		
-		      float eleZvtx = analysisDataFormat.zVtxTkel2[ue];
-		      for(int ue2=0; ue2< Nele; ue2++) {
-		          if( (ue2 != ue) && fabs(eleZvtx - analysisDataFormat.zVtxTkel2[ue2]) < zVtxCut_)  {
-			     if (analysisDataFormat.BxTkel2[ue2]!= 0) continue;
-			     float eta2 = analysisDataFormat.EtaTkel2[ue2];
-			     if (eta2 < regionCut_ || eta2 > 21.-regionCut_) continue;  // eta = 5 - 16
-			     float pt2 = analysisDataFormat.EtTkel2[ue2];     
-		             if (pt2 >= leg2threshold1_ ) ok=true;
-			   }//end if vtx compatability  
-		      }	//end loop over second object
-		}  //end pt threshold
-	}  // end loop over EM objects
-
-	//if(ok) printf("Found doubleEG event Run %i Event %i \n",event_->run,event_->event);
-	return ok;
-}
-
-bool l1menu::triggers::DoubleTkEle_v3::thresholdsAreCorrelated() const
-{
-	return true;
-}
-
-unsigned int l1menu::triggers::DoubleTkEle_v3::version() const
-{
-	return 3;
-}
-
-
-l1menu::triggers::DoubleTkEle::DoubleTkEle()
-	: leg1threshold1_(20), leg2threshold1_(20), regionCut_(4.5), zVtxCut_(9999.)
-{
-	// No operation other than the initialiser list
-}
-
-const std::string l1menu::triggers::DoubleTkEle::name() const
-{
-	return "L1_DoubleTkEle";
-}
-
-const std::vector<std::string> l1menu::triggers::DoubleTkEle::parameterNames() const
-{
-	std::vector<std::string> returnValue;
-	returnValue.push_back("leg1threshold1");
-	returnValue.push_back("leg2threshold1");
-	returnValue.push_back("regionCut");
-	returnValue.push_back("zVtxCut");
-	return returnValue;
-}
-
-float& l1menu::triggers::DoubleTkEle::parameter( const std::string& parameterName )
-{
-	if( parameterName=="leg1threshold1" ) return leg1threshold1_;
-	else if( parameterName=="leg2threshold1" ) return leg2threshold1_;
-	else if( parameterName=="regionCut" ) return regionCut_;
-	else if( parameterName=="zVtxCut" ) return zVtxCut_;
-	else throw std::logic_error( "Not a valid parameter name" );
-}
-
-const float& l1menu::triggers::DoubleTkEle::parameter( const std::string& parameterName ) const
-{
-	if( parameterName=="leg1threshold1" ) return leg1threshold1_;
-	else if( parameterName=="leg2threshold1" ) return leg2threshold1_;
-	else if( parameterName=="regionCut" ) return regionCut_;
-	else if( parameterName=="zVtxCut" ) return zVtxCut_;	
-	else throw std::logic_error( "Not a valid parameter name" );
-}
@@ -3,7 +3,7 @@
 #include <stdexcept>
 #include "../implementation/RegisterTriggerMacro.h"
 #include "l1menu/L1TriggerDPGEvent.h"
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
+#include "VertexMatchedPair.h"
 
 
 namespace l1menu
@@ -37,30 +37,20 @@ namespace l1menu
 
 bool l1menu::triggers::DoubleTkMu_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw=PhysicsBits[0]; // ZeroBias
-	if( !raw ) return false;
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
 
 	int n1=0;
 	int n2=0;
-	int Nmu=analysisDataFormat.NTkmu;
-	for( int imu=0; imu<Nmu; imu++ )
+	for( const auto& muon : objects.trackMuons )
 	{
-		int bx=analysisDataFormat.BxTkmu.at( imu );
-		if( bx!=0 ) continue;
-		float pt=analysisDataFormat.PtTkmu.at( imu );
-		//float eta=analysisDataFormat.Etamu.at( imu ); // Commented out to stop unused variable compile warning
-		int qual=analysisDataFormat.QualTkmu.at( imu );
-		if( qual<muonQuality_ ) continue;
-
+		if( muon.quality<muonQuality_ ) continue;
+		float pt=muon.et;
 		if( pt>=threshold1_ ) n1++;
 		if( pt>=threshold2_ ) n2++;
 	}
 
-	bool ok=( n1>=1 && n2>=2 );
-	return ok;
+	return ( n1>=1 && n2>=2 );
 }
 
 bool l1menu::triggers::DoubleTkMu_v0::thresholdsAreCorrelated() const
@@ -76,44 +66,15 @@ unsigned int l1menu::triggers::DoubleTkMu_v0::version() const
 
 bool l1menu::triggers::DoubleTkMu_v1::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw=PhysicsBits[0]; // ZeroBias
-	if( !raw ) return false;
- 
-        bool ok = false;
-
-	int Nmu=analysisDataFormat.NTkmu;
-	for( int imu=0; imu<Nmu; imu++ )
-	{
-		int bx=analysisDataFormat.BxTkmu.at( imu );
-		if( bx!=0 ) continue;
-		float pt=analysisDataFormat.PtTkmu.at( imu );
-		//float eta=analysisDataFormat.Etamu.at( imu ); // Commented out to stop unused variable compile warning
-		int qual=analysisDataFormat.QualTkmu.at( imu );
-		if( qual<muonQuality_ ) continue;
-
-		if( pt>=threshold1_ ) {
-		     
-		     float muZvtx = analysisDataFormat.zVtxTkmu[imu];
-		     for(int imu2=0; imu2<Nmu; imu2++) {
-		        if( (imu != imu2) && 
-			    fabs(muZvtx - analysisDataFormat.zVtxTkmu[imu2]) < zVtxCut_ ) {
-
-			    if( analysisDataFormat.BxTkmu.at( imu2 )!=0 ) continue;
-			    int qual2=analysisDataFormat.QualTkmu.at( imu2);
-			    if( qual2<muonQuality_ ) continue;
-			    float pt2=analysisDataFormat.PtTkmu.at( imu2 );
-                            if(pt2 >= threshold2_) ok = true;
-			    
-			}//end if over delta z-vtx    
-		     } //end loop over second object
-		} //end if first threshold satisfied
-	} //end loop over primary muon
-
-
-	return ok;
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
+
+	// Two different muons within zVtxCut of each other
+	return l1menu::triggers::vertexMatchedPairExists( event, objects.trackMuons, objects.trackMuons,
+			[this]( const l1menu::L1TriggerDPGEvent::L1Object& leg1 ){ return !(leg1.quality<muonQuality_) && float(leg1.et)>=threshold1_; },
+			[this]( const l1menu::L1TriggerDPGEvent::L1Object& leg1, const l1menu::L1TriggerDPGEvent::L1Object& leg2 )
+				{ return &leg2!=&leg1 && !(leg2.quality<muonQuality_) && float(leg2.et)>=threshold2_; },
+			zVtxCut_ );
 }
 
 bool l1menu::triggers::DoubleTkMu_v1::thresholdsAreCorrelated() const
@@ -164,3 +125,27 @@ const float& l1menu::triggers::DoubleTkMu::parameter( const std::string& paramet
 	else if( parameterName=="zVtxCut" ) return zVtxCut_;
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::DoubleTkMu::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return threshold1_;
+		case 1: return threshold2_;
+		case 2: return muonQuality_;
+		case 3: return zVtxCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::DoubleTkMu::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return threshold1_;
+		case 1: return threshold2_;
+		case 2: return muonQuality_;
+		case 3: return zVtxCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
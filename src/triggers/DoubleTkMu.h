@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include "l1menu/ITrigger.h"
+#include "CloneableTrigger.h"
 #include <cmath>
 
 //
@@ -37,6 +38,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		protected:
 			float threshold1_;
 			float threshold2_;
@@ -49,7 +52,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class DoubleTkMu_v0 : public DoubleTkMu
+		class DoubleTkMu_v0 : public CloneableTrigger<DoubleTkMu_v0,DoubleTkMu>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -62,7 +65,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class DoubleTkMu_v1 : public DoubleTkMu
+		class DoubleTkMu_v1 : public CloneableTrigger<DoubleTkMu_v1,DoubleTkMu>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -1,8 +1,9 @@
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 #include "l1menu/L1TriggerDPGEvent.h"
+#include "TowerOverlap.h"
 
 #include <stdexcept>
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
 
 #include "l1menu/ITrigger.h"
 
@@ -35,6 +36,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		protected:
 			float leg1threshold1_;
 			float leg2threshold1_;
@@ -51,7 +54,7 @@ namespace l1menu
 		 * @author as for v0, but logic error spotted by Brian Winer's unnamed student.
 		 * @date 09/Sep/2013
 		 */
-		class EG_JetCentral_v1 : public EG_JetCentral
+		class EG_JetCentral_v1 : public CloneableTrigger<EG_JetCentral_v1,EG_JetCentral>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -64,7 +67,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class EG_JetCentral_v0 : public EG_JetCentral
+		class EG_JetCentral_v0 : public CloneableTrigger<EG_JetCentral_v0,EG_JetCentral>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -109,51 +112,13 @@ namespace l1menu
 
 bool l1menu::triggers::EG_JetCentral_v1::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];   // ZeroBias
-	if (! raw) return false;
-
-	bool jet=false;
-	bool eg = false;
-	bool ok = false;
-
-	int Nj = analysisDataFormat.Njet ;
-
-	int Nele = analysisDataFormat.Nele;
-	for (int ue=0; ue < Nele; ue++) {
-		int bx = analysisDataFormat.Bxel[ue];
-		if (bx != 0 ) continue;
-		float eta = analysisDataFormat.Etael[ue];
-		if (eta < leg1regionCut_ || eta > 21.-leg1regionCut_) continue;  // eta = 5 - 16
-		float rank = analysisDataFormat.Etel[ue];    // the rank of the electron
-		float pt = rank ;
-		if (pt >= leg1threshold1_){
-
-			eg = true;
-
-			for (int uj=0; uj < Nj; uj++) {
-				int bxj = analysisDataFormat.Bxjet[uj];
-				if (bxj != 0) continue;
-				bool isFwdJet = analysisDataFormat.Fwdjet[uj];
-				if (isFwdJet) continue;
-				bool isTauJet = analysisDataFormat.Taujet[uj];
-				if (isTauJet) continue;
-				float rankj = analysisDataFormat.Etjet[uj];
-				float ptj = rankj; //CorrectedL1JetPtByGCTregions(analysisDataFormat.Etajet[uj],rank*4.,theL1JetCorrection);
-
-				if (analysisDataFormat.Etajet[uj] < leg2regionCut_ || analysisDataFormat.Etajet[uj] > 21.-leg2regionCut_) continue;
-				if (ptj >= leg2threshold1_ &&
-					!(analysisDataFormat.Etajet[uj]==analysisDataFormat.Etael[ue] &&
-					  analysisDataFormat.Phijet[uj]==analysisDataFormat.Phiel[ue]) ) jet = true;
-			}
-
-			ok = eg && jet;
-		} // if good EG
-	}  // end loop over EM objects
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
 
-	return ok;
+	// A central jet that isn't in the same region as the EG
+	return l1menu::triggers::nonOverlappingPairExists( event, objects.egamma,
+			[this]( const l1menu::L1TriggerDPGEvent::L1Object& egamma ){ return !(egamma.symmetricRegion<leg1regionCut_) && float(egamma.et)>=leg1threshold1_; },
+			objects.centralJets, leg2regionCut_, leg2threshold1_ );
 }
 
 bool l1menu::triggers::EG_JetCentral_v1::thresholdsAreCorrelated() const
@@ -168,46 +133,25 @@ unsigned int l1menu::triggers::EG_JetCentral_v1::version() const
 
 bool l1menu::triggers::EG_JetCentral_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];   // ZeroBias
-	if (! raw) return false;
-
-	bool ok = false;
-
-	int Nj = analysisDataFormat.Njet ;
-
-	int Nele = analysisDataFormat.Nele;
-	for (int ue=0; ue < Nele; ue++) {
-		int bx = analysisDataFormat.Bxel[ue];
-		if (bx != 0 ) continue;
-		float eta = analysisDataFormat.Etael[ue];
-		if (eta < leg1regionCut_ || eta > 21.-leg1regionCut_) continue;  // eta = 5 - 16
-		float rank = analysisDataFormat.Etel[ue];    // the rank of the electron
-		float pt = rank ;
-		if (pt >= leg1threshold1_){
-
-
-			for (int uj=0; uj < Nj; uj++) {
-				int bxj = analysisDataFormat.Bxjet[uj];
-				if (bxj != 0) continue;
-				bool isFwdJet = analysisDataFormat.Fwdjet[uj];
-				if (isFwdJet) continue;
-				bool isTauJet = analysisDataFormat.Taujet[uj];
-				if (isTauJet) continue;
-				float rankj = analysisDataFormat.Etjet[uj];
-				float ptj = rankj; //CorrectedL1JetPtByGCTregions(analysisDataFormat.Etajet[uj],rank*4.,theL1JetCorrection);
-
-				if (analysisDataFormat.Etajet[uj] < leg2regionCut_ || analysisDataFormat.Etajet[uj] > 21.-leg2regionCut_) continue;
-				if (ptj >= leg2threshold1_ &&
-					(analysisDataFormat.Etajet[uj]!=analysisDataFormat.Etael[ue]) &&
-					(analysisDataFormat.Phijet[uj]!=analysisDataFormat.Phiel[ue]) ) ok = true;
-			}
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
 
-		
+	bool ok=false;
+
+	for( const auto& egamma : objects.egamma )
+	{
+		if( egamma.symmetricRegion<leg1regionCut_ ) continue;
+		float pt=egamma.et;
+		if( pt>=leg1threshold1_ )
+		{
+			for( const auto& centralJet : objects.centralJets )
+			{
+				if( centralJet.symmetricRegion<leg2regionCut_ ) continue;
+				float ptj=centralJet.et;
+				if( ptj>=leg2threshold1_ && centralJet.eta!=egamma.eta && centralJet.phi!=egamma.phi ) ok=true;
+			}
 		} // if good EG
-	}  // end loop over EM objects
+	} // end loop over EM objects
 
 	return ok;
 }
@@ -260,3 +204,27 @@ const float& l1menu::triggers::EG_JetCentral::parameter( const std::string& para
 	else if( parameterName=="leg2regionCut" ) return leg2regionCut_;
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::EG_JetCentral::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg1regionCut_;
+		case 2: return leg2threshold1_;
+		case 3: return leg2regionCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::EG_JetCentral::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg1regionCut_;
+		case 2: return leg2threshold1_;
+		case 3: return leg2regionCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
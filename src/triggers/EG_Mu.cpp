@@ -2,6 +2,7 @@
 #include "SingleEGEta.h"
 #include "SingleMuEta.h"
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 
 namespace l1menu
 {
@@ -18,7 +19,7 @@ namespace l1menu
 		 * CrossTrigger by Mark Grimes (mark.grimes@bristol.ac.uk).
 		 * @date 03/Jun/2013
 		 */
-		class EG_Mu_v0 : public l1menu::triggers::CrossTrigger
+		class EG_Mu_v0 : public CloneableTrigger<EG_Mu_v0,l1menu::triggers::CrossTrigger>
 		{
 		public:
 			EG_Mu_v0();
@@ -51,7 +52,7 @@ namespace l1menu
 
 
 l1menu::triggers::EG_Mu_v0::EG_Mu_v0()
-	: CrossTrigger( new l1menu::triggers::SingleEGEta_v0, new l1menu::triggers::SingleMuEta_v0 )
+	: CloneableTrigger( new l1menu::triggers::SingleEGEta_v0, new l1menu::triggers::SingleMuEta_v0 )
 {
 	// No operation besides passing the sub-triggers onto the base class
 }
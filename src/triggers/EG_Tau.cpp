@@ -1,8 +1,9 @@
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 #include "l1menu/L1TriggerDPGEvent.h"
+#include "TowerOverlap.h"
 
 #include <stdexcept>
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
 
 #include "l1menu/ITrigger.h"
 
@@ -31,6 +32,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		protected:
 			float leg1threshold1_;
 			float leg2threshold1_;
@@ -43,7 +46,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class EG_Tau_v0 : public EG_Tau
+		class EG_Tau_v0 : public CloneableTrigger<EG_Tau_v0,EG_Tau>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -86,46 +89,13 @@ namespace l1menu
 
 bool l1menu::triggers::EG_Tau_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];    // ZeroBias
-	if (! raw) return false;
-
-
-	bool ok =false;
-
-
-	int Nele = analysisDataFormat.Nele;
-	for (int ue=0; ue < Nele; ue++) {
-		int bx = analysisDataFormat.Bxel[ue];
-		if (bx != 0 ) continue;
-		float eta = analysisDataFormat.Etael[ue];
-		if (eta < leg1regionCut_ || eta > 21.-leg1regionCut_) continue;  // eta = 5 - 16
-		float rank = analysisDataFormat.Etel[ue];    // the rank of the electron
-		float pt = rank ;
-		if (pt >= leg1threshold1_) {
-
-
-			// Now look for a tau that is not the same as this eg
-			int Nj = analysisDataFormat.Njet ;
-			for (int uj=0; uj < Nj; uj++) {
-				bx = analysisDataFormat.Bxjet[uj];
-				if (bx != 0) continue;
-				bool isTauJet = analysisDataFormat.Taujet[uj];
-				if (!isTauJet) continue;
-				float tauEta = analysisDataFormat.Etajet[uj];
-				if (tauEta < leg2regionCut_ || tauEta > 21.-leg2regionCut_) continue;  // tauEta = 5 - 16
-				if (analysisDataFormat.Etajet[uj] == analysisDataFormat.Etael[ue] && analysisDataFormat.Phijet[uj] == analysisDataFormat.Phiel[ue] ) continue;
-				float rankt = analysisDataFormat.Etjet[uj];
-				float ptt = rankt; //CorrectedL1JetPtByGCTregions(analysisDataFormat.Etajet[uj],rank*4.,theL1JetCorrection);
-				if (ptt >= leg2threshold1_) ok = true;
-			}
-
-		}
-	}  // end loop over EM objects
-
-	return ok;
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
+
+	// A tau that isn't in the same region as the EG
+	return l1menu::triggers::nonOverlappingPairExists( event, objects.egamma,
+			[this]( const l1menu::L1TriggerDPGEvent::L1Object& egamma ){ return !(egamma.symmetricRegion<leg1regionCut_) && float(egamma.et)>=leg1threshold1_; },
+			objects.tauJets, leg2regionCut_, leg2threshold1_ );
 }
 
 bool l1menu::triggers::EG_Tau_v0::thresholdsAreCorrelated() const
@@ -176,3 +146,27 @@ const float& l1menu::triggers::EG_Tau::parameter( const std::string& parameterNa
 	else if( parameterName=="leg2regionCut" ) return leg2regionCut_;
 	else throw std::logic_error( "Not a valid parameter name (\""+parameterName+"\")" );
 }
+
+float& l1menu::triggers::EG_Tau::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg1regionCut_;
+		case 2: return leg2threshold1_;
+		case 3: return leg2regionCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::EG_Tau::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg1regionCut_;
+		case 2: return leg2threshold1_;
+		case 3: return leg2regionCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
@@ -95,3 +95,21 @@ const float& l1menu::triggers::HTM::parameter( const std::string& parameterName
 	if( parameterName=="threshold1" ) return threshold1_;
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::HTM::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return threshold1_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::HTM::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return threshold1_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
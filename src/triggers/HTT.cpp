@@ -1,4 +1,5 @@
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 #include "l1menu/L1TriggerDPGEvent.h"
 
 #include <stdexcept>
@@ -31,6 +32,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		protected:
 			float threshold1_;
 		}; // end of the HTT base class
@@ -40,7 +43,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class HTT_v0 : public HTT
+		class HTT_v0 : public CloneableTrigger<HTT_v0,HTT>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -134,3 +137,21 @@ const float& l1menu::triggers::HTT::parameter( const std::string& parameterName
 	if( parameterName=="threshold1" ) return threshold1_;
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::HTT::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return threshold1_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::HTT::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return threshold1_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
@@ -1,8 +1,8 @@
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 #include "l1menu/L1TriggerDPGEvent.h"
 
 #include <stdexcept>
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
 
 #include "l1menu/ITrigger.h"
 
@@ -31,6 +31,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		protected:
 			float leg1threshold1_;
 			float leg2threshold1_;
@@ -42,7 +44,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class IsoEG_EG_v0 : public IsoEG_EG
+		class IsoEG_EG_v0 : public CloneableTrigger<IsoEG_EG_v0,IsoEG_EG>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -85,29 +87,20 @@ namespace l1menu
 
 bool l1menu::triggers::IsoEG_EG_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];   // ZeroBias
-	if (! raw) return false;
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
 
 	int n1=0;
 	int n2=0;
-	int Nele = analysisDataFormat.Nele;
-	for (int ue=0; ue < Nele; ue++) {
-		int bx = analysisDataFormat.Bxel[ue];
-		if (bx != 0) continue;
-		float eta = analysisDataFormat.Etael[ue];
-		if (eta < regionCut_ || eta > 21.-regionCut_) continue;  // eta = 5 - 16
-		float rank = analysisDataFormat.Etel[ue];    // the rank of the electron
-		float pt = rank ;
-		if (pt >= leg1threshold1_ && analysisDataFormat.Isoel[ue]) n1++;
-		if (pt >= leg2threshold1_) n2++;
-	}  // end loop over EM objects
-
-	bool ok = ( n1 >= 1 && n2 >= 2) ;
-	//if(ok) printf("Found doubleEG event Run %i Event %i \n",event_->run,event_->event);
-	return ok;
+	for( const auto& eg : objects.egamma )
+	{
+		if( eg.symmetricRegion<regionCut_ ) continue;
+		float pt=eg.et;
+		if( pt>=leg1threshold1_ && eg.isolated ) n1++;
+		if( pt>=leg2threshold1_ ) n2++;
+	}
+
+	return ( n1>=1 && n2>=2 );
 }
 
 bool l1menu::triggers::IsoEG_EG_v0::thresholdsAreCorrelated() const
@@ -155,3 +148,25 @@ const float& l1menu::triggers::IsoEG_EG::parameter( const std::string& parameter
 	else if( parameterName=="regionCut" ) return regionCut_;
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::IsoEG_EG::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg2threshold1_;
+		case 2: return regionCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::IsoEG_EG::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg2threshold1_;
+		case 2: return regionCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
@@ -2,6 +2,7 @@
 #include "SingleIsoEGEta.h"
 #include "SingleIsoMuEta.h"
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 
 namespace l1menu
 {
@@ -18,7 +19,7 @@ namespace l1menu
 		 * CrossTrigger by Mark Grimes (mark.grimes@bristol.ac.uk).
 		 * @date 03/Jun/2013
 		 */
-		class IsoEG_Mu_v0 : public l1menu::triggers::CrossTrigger
+		class IsoEG_Mu_v0 : public CloneableTrigger<IsoEG_Mu_v0,l1menu::triggers::CrossTrigger>
 		{
 		public:
 			IsoEG_Mu_v0();
@@ -51,7 +52,7 @@ namespace l1menu
 
 
 l1menu::triggers::IsoEG_Mu_v0::IsoEG_Mu_v0()
-	: CrossTrigger( new l1menu::triggers::SingleIsoEGEta_v0, new l1menu::triggers::SingleIsoMuEta_v0 )
+	: CloneableTrigger( new l1menu::triggers::SingleIsoEGEta_v0, new l1menu::triggers::SingleIsoMuEta_v0 )
 {
 	// No operation besides passing the sub-triggers onto the base class
 }
@@ -1,6 +1,7 @@
 #include "DoubleMu.h"
 
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 
 namespace l1menu
 {
@@ -13,7 +14,7 @@ namespace l1menu
 		 * @author Mark Grimes (mark.grimes@bristol.ac.uk)
 		 * @date 04/Jun/2013
 		 */
-		class IsoMu_Mu_v0 : public l1menu::triggers::DoubleMu_v0
+		class IsoMu_Mu_v0 : public CloneableTrigger<IsoMu_Mu_v0,l1menu::triggers::DoubleMu_v0>
 		{
 		public:
 			virtual const std::string name() const;
@@ -1,8 +1,8 @@
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 #include "l1menu/L1TriggerDPGEvent.h"
 
 #include <stdexcept>
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
 
 #include "l1menu/ITrigger.h"
 
@@ -31,6 +31,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		protected:
 			float leg1threshold1_;
 			float leg2threshold1_;
@@ -42,7 +44,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class isoTau_Tau_v0 : public isoTau_Tau
+		class isoTau_Tau_v0 : public CloneableTrigger<isoTau_Tau_v0,isoTau_Tau>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -85,30 +87,20 @@ namespace l1menu
 
 bool l1menu::triggers::isoTau_Tau_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];  // ZeroBias
-	if (! raw) return false;
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
 
 	int n1=0;
 	int n2=0;
-	int Nj = analysisDataFormat.Njet ;
-	for (int ue=0; ue < Nj; ue++) {
-		int bx = analysisDataFormat.Bxjet[ue];
-		if (bx != 0) continue;
-		bool isTauJet = analysisDataFormat.Taujet[ue];
-		if (! isTauJet) continue;
-		float rank = analysisDataFormat.Etjet[ue];    // the rank of the electron
-		float pt = rank; //CorrectedL1JetPtByGCTregions(analysisDataFormat.Etajet[ue],rank*4.,theL1JetCorrection);
-		float eta = analysisDataFormat.Etajet[ue];
-		if (eta < regionCut_ || eta > 21.-regionCut_) continue;  // eta = 5 - 16
-		if (pt >= leg1threshold1_ && analysisDataFormat.isoTaujet[ue]) n1++;
-		if (pt >= leg2threshold1_) n2++;
-	}  // end loop over jets
-
-	bool ok = ( n1 >=1 && n2 >= 2);
-	return ok;
+	for( const auto& tau : objects.tauJets )
+	{
+		if( tau.symmetricRegion<regionCut_ ) continue;
+		float pt=tau.et;
+		if( pt>=leg1threshold1_ && tau.isolated ) n1++;
+		if( pt>=leg2threshold1_ ) n2++;
+	}
+
+	return ( n1>=1 && n2>=2 );
 }
 
 bool l1menu::triggers::isoTau_Tau_v0::thresholdsAreCorrelated() const
@@ -156,3 +148,25 @@ const float& l1menu::triggers::isoTau_Tau::parameter( const std::string& paramet
 	else if( parameterName=="regionCut" ) return regionCut_;
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::isoTau_Tau::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg2threshold1_;
+		case 2: return regionCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::isoTau_Tau::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg2threshold1_;
+		case 2: return regionCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
@@ -2,6 +2,7 @@
 #include "SingleIsoMuEta.h"
 #include "SingleTauJet.h"
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 
 namespace l1menu
 {
@@ -18,7 +19,7 @@ namespace l1menu
 		 * CrossTrigger by Mark Grimes (mark.grimes@bristol.ac.uk).
 		 * @date 03/Jun/2013
 		 */
-		class Mu_Tau_v0 : public l1menu::triggers::CrossTrigger
+		class Mu_Tau_v0 : public CloneableTrigger<Mu_Tau_v0,l1menu::triggers::CrossTrigger>
 		{
 		public:
 			Mu_Tau_v0();
@@ -51,7 +52,7 @@ namespace l1menu
 
 
 l1menu::triggers::Mu_Tau_v0::Mu_Tau_v0()
-	: CrossTrigger( new l1menu::triggers::SingleIsoMuEta_v0, new l1menu::triggers::SingleTauJet_v0 )
+	: CloneableTrigger( new l1menu::triggers::SingleIsoMuEta_v0, new l1menu::triggers::SingleTauJet_v0 )
 {
 	// No operation besides passing the sub-triggers onto the base class
 }
@@ -2,6 +2,7 @@
 #include "SingleJetCentral.h"
 #include "SingleMuEta.h"
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 
 namespace l1menu
 {
@@ -18,7 +19,7 @@ namespace l1menu
 		 * CrossTrigger by Mark Grimes (mark.grimes@bristol.ac.uk).
 		 * @date 03/Jun/2013
 		 */
-		class Muer_JetCentral_v0 : public l1menu::triggers::CrossTrigger
+		class Muer_JetCentral_v0 : public CloneableTrigger<Muer_JetCentral_v0,l1menu::triggers::CrossTrigger>
 		{
 		public:
 			Muer_JetCentral_v0();
@@ -59,7 +60,7 @@ namespace l1menu
 //----------------------------------------------------------------------------------------
 
 l1menu::triggers::Muer_JetCentral_v0::Muer_JetCentral_v0()
-	: CrossTrigger( new l1menu::triggers::SingleMuEta_v0, new l1menu::triggers::SingleJetCentral_v0 )
+	: CloneableTrigger( new l1menu::triggers::SingleMuEta_v0, new l1menu::triggers::SingleJetCentral_v0 )
 {
 	// No operation besides passing the sub-triggers onto the base class
 }
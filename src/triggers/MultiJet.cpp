@@ -2,9 +2,9 @@
 
 
 #include <stdexcept>
+#include <algorithm>
 #include "../implementation/RegisterTriggerMacro.h"
 #include "l1menu/L1TriggerDPGEvent.h"
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
 
 
 namespace l1menu
@@ -40,39 +40,16 @@ namespace l1menu
 
 bool l1menu::triggers::MultiJet_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];   // ZeroBias
-	if (! raw) return false;
-
-	int n1=0;
-	int n2=0;
-	int n3=0;
-	int n4=0;
-
-	int Nj = analysisDataFormat.Njet ;
-	for (int ue=0; ue < Nj; ue++) {
-		int bx = analysisDataFormat.Bxjet[ue];
-		if (bx != 0) continue;
-		bool isFwdJet = analysisDataFormat.Fwdjet[ue];
-		if (isFwdJet) continue;
-		bool isTauJet = analysisDataFormat.Taujet[ue];
-		if (isTauJet) continue;
-
-		float eta = analysisDataFormat.Etajet[ue];
-		if (eta < regionCut_ || eta > 21.-regionCut_) continue;
-
-		float rank = analysisDataFormat.Etjet[ue];
-		float pt = rank; //CorrectedL1JetPtByGCTregions(analysisDataFormat.Etajet[ue],rank*4.,theL1JetCorrection);
-		if (pt >= threshold1_) n1++;
-		if (pt >= threshold2_) n2++;
-		if (pt >= threshold3_) n3++;
-		if (pt >= threshold4_) n4++;
-	}
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
+
+	// The first three thresholds are for the leading three jets. The fourth is a float so
+	// count the number of jets above it rather than assuming it's an integer.
+	const std::vector<float>& et=event.sortedEt( objects.centralJets, regionCut_ );
+	if( et.size()<3 ) return false;
+	const size_t numberAboveThreshold4=std::partition_point( et.begin(), et.end(), [this]( float value ){ return value>=threshold4_; } )-et.begin();
 
-	bool ok = ( n1 >=1 && n2 >= 2 && n3 >= 3 && n4 >= numberOfJets_);
-	return ok;
+	return ( et[0]>=threshold1_ && et[1]>=threshold2_ && et[2]>=threshold3_ && numberAboveThreshold4>=numberOfJets_ );
 }
 
 bool l1menu::triggers::MultiJet_v0::thresholdsAreCorrelated() const
@@ -129,3 +106,31 @@ const float& l1menu::triggers::MultiJet::parameter( const std::string& parameter
 	else if( parameterName=="numberOfJets" ) return numberOfJets_;
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::MultiJet::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return threshold1_;
+		case 1: return threshold2_;
+		case 2: return threshold3_;
+		case 3: return threshold4_;
+		case 4: return regionCut_;
+		case 5: return numberOfJets_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::MultiJet::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return threshold1_;
+		case 1: return threshold2_;
+		case 2: return threshold3_;
+		case 3: return threshold4_;
+		case 4: return regionCut_;
+		case 5: return numberOfJets_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include "l1menu/ITrigger.h"
+#include "CloneableTrigger.h"
 
 //
 // Forward declarations
@@ -35,6 +36,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		protected:
 			float threshold1_;
 			float threshold2_;
@@ -50,7 +53,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class MultiTkJet_v0 : public MultiTkJet
+		class MultiTkJet_v0 : public CloneableTrigger<MultiTkJet_v0,MultiTkJet>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -64,7 +67,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class MultiTkJet_v1 : public MultiTkJet
+		class MultiTkJet_v1 : public CloneableTrigger<MultiTkJet_v1,MultiTkJet>
 		{
 		public:
 			virtual unsigned int version() const;
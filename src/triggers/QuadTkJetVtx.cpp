@@ -3,6 +3,7 @@
 #include <stdexcept>
 #include <algorithm>
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 
 
 namespace l1menu
@@ -16,7 +17,7 @@ namespace l1menu
 		 * @author Mark Grimes (mark.grimes@bristol.ac.uk)
 		 * @date 04/Jun/2013
 		 */
-		class QuadTkJetVtx_v0 : public l1menu::triggers::MultiTkJet_v1
+		class QuadTkJetVtx_v0 : public CloneableTrigger<QuadTkJetVtx_v0,l1menu::triggers::MultiTkJet_v1>
 		{
 		public:
 			QuadTkJetVtx_v0();
@@ -28,6 +29,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		}; // end of version 0 class
 
 		/* The REGISTER_TRIGGER macro will make sure that the given trigger is registered in the
@@ -90,3 +93,17 @@ const float& l1menu::triggers::QuadTkJetVtx_v0::parameter( const std::string& pa
 	if( parameterName!="numberOfJets" ) return MultiTkJet::parameter(parameterName);
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::QuadTkJetVtx_v0::parameter( ParameterHandle handle )
+{
+	// numberOfJets is the last of the seven MultiTkJet parameters, so every other handle is the same
+	if( handle<6 ) return MultiTkJet::parameter( handle );
+	else throw std::logic_error( "Not a valid parameter handle" );
+}
+
+const float& l1menu::triggers::QuadTkJetVtx_v0::parameter( ParameterHandle handle ) const
+{
+	// numberOfJets is the last of the seven MultiTkJet parameters, so every other handle is the same
+	if( handle<6 ) return MultiTkJet::parameter( handle );
+	else throw std::logic_error( "Not a valid parameter handle" );
+}
@@ -1,15 +1,15 @@
 #include "SingleIsoEGEta.h"
 
-#include <stdexcept>
 #include "../implementation/RegisterTriggerMacro.h"
-#include "l1menu/L1TriggerDPGEvent.h"
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
 
 
 namespace l1menu
 {
 	namespace triggers
 	{
+		// Storage for the definition, which the family templates need until C++17
+		constexpr const char* SingleIsoEGEtaDefinition::name;
+		constexpr TriggerParameter SingleIsoEGEtaDefinition::parameters[];
 
 		/* The REGISTER_TRIGGER macro will make sure that the given trigger is registered in the
 		 * l1menu::TriggerTable when the program starts. I also want to provide some suggested binning
@@ -31,73 +31,3 @@ namespace l1menu
 	} // end of namespace triggers
 
 } // end of namespace l1menu
-
-
-
-bool l1menu::triggers::SingleIsoEGEta_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
-{
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];   // ZeroBias
-	if (! raw) return false;
-
-	bool ok=false;
-	int Nele = analysisDataFormat.Nele;
-	for (int ue=0; ue < Nele; ue++) {
-		int bx = analysisDataFormat.Bxel[ue];
-		if (bx != 0) continue;
-		bool iso = analysisDataFormat.Isoel[ue];
-		if (! iso) continue;
-		float eta = analysisDataFormat.Etael[ue];
-		if (eta < regionCut_ || eta > 21.-regionCut_) continue;  // eta = 5 - 16
-		float rank = analysisDataFormat.Etel[ue];    // the rank of the electron
-		float pt = rank ;
-		if (pt >= threshold1_) ok = true;
-	}  // end loop over EM objects
-
-	return ok;
-}
-
-bool l1menu::triggers::SingleIsoEGEta_v0::thresholdsAreCorrelated() const
-{
-	return false;
-}
-
-unsigned int l1menu::triggers::SingleIsoEGEta_v0::version() const
-{
-	return 0;
-}
-
-l1menu::triggers::SingleIsoEGEta::SingleIsoEGEta()
-	: threshold1_(20), regionCut_(4.5)
-{
-	// No operation other than the initialiser list
-}
-
-const std::string l1menu::triggers::SingleIsoEGEta::name() const
-{
-	return "L1_SingleIsoEG";
-}
-
-const std::vector<std::string> l1menu::triggers::SingleIsoEGEta::parameterNames() const
-{
-	std::vector<std::string> returnValue;
-	returnValue.push_back("threshold1");
-	returnValue.push_back("regionCut");
-	return returnValue;
-}
-
-float& l1menu::triggers::SingleIsoEGEta::parameter( const std::string& parameterName )
-{
-	if( parameterName=="threshold1" ) return threshold1_;
-	else if( parameterName=="regionCut" ) return regionCut_;
-	else throw std::logic_error( "Not a valid parameter name" );
-}
-
-const float& l1menu::triggers::SingleIsoEGEta::parameter( const std::string& parameterName ) const
-{
-	if( parameterName=="threshold1" ) return threshold1_;
-	else if( parameterName=="regionCut" ) return regionCut_;
-	else throw std::logic_error( "Not a valid parameter name" );
-}
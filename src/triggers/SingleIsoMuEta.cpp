@@ -2,10 +2,14 @@
 
 #include "../implementation/RegisterTriggerMacro.h"
 
+
 namespace l1menu
 {
 	namespace triggers
 	{
+		// Storage for the definition, which the family templates need until C++17
+		constexpr const char* SingleIsoMuEtaDefinition::name;
+		constexpr TriggerParameter SingleIsoMuEtaDefinition::parameters[];
 
 		/* The REGISTER_TRIGGER macro will make sure that the given trigger is registered in the
 		 * l1menu::TriggerTable when the program starts. I also want to provide some suggested binning
@@ -23,16 +27,7 @@ namespace l1menu
 			} // End of customisation lambda function
 		) // End of REGISTER_TRIGGER_AND_CUSTOMISE macro call
 
+
 	} // end of namespace triggers
 
 } // end of namespace l1menu
-
-const std::string l1menu::triggers::SingleIsoMuEta_v0::name() const
-{
-	return "L1_SingleIsoMu";
-}
-
-unsigned int l1menu::triggers::SingleIsoMuEta_v0::version() const
-{
-	return 0;
-}
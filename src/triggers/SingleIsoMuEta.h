@@ -1,25 +1,26 @@
 #ifndef l1menu_triggers_SingleIsoMuEta_h
 #define l1menu_triggers_SingleIsoMuEta_h
 
-#include "SingleMuEta.h"
+#include "TriggerFamilies.h"
 
 namespace l1menu
 {
 	namespace triggers
 	{
-
-		/** @brief Essentially a copy of the SingleMuEta trigger, but overriding the name, since we
+		/** @brief Essentially a copy of the SingleMuEta trigger, but with a different name, since we
 		 * currently have no isolation on the muons.
 		 *
 		 * @author Mark Grimes (mark.grimes@bristol.ac.uk)
 		 * @date 04/Jun/2013
 		 */
-		class SingleIsoMuEta_v0 : public l1menu::triggers::SingleMuEta_v0
+		struct SingleIsoMuEtaDefinition
 		{
-		public:
-			virtual const std::string name() const;
-			virtual unsigned int version() const;
-		}; // end of version 0 class
+			static constexpr const char* name="L1_SingleIsoMu";
+			static constexpr TriggerParameter parameters[]={ {"threshold1",20}, {"muonQuality",4}, {"etaCut",2.1} };
+		};
+
+		/** @brief First version of the SingleIsoMuEta trigger, the same cuts as SingleMuEta_v0. */
+		typedef SingleObjectFamily<SingleIsoMuEtaDefinition,0,collections::Muons,cuts::MuonQuality,cuts::AbsoluteEta> SingleIsoMuEta_v0;
 
 	} // end of namespace triggers
 
@@ -1,4 +1,5 @@
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 #include "l1menu/L1TriggerDPGEvent.h"
 
 #include <stdexcept>
@@ -31,6 +32,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		protected:
 			float threshold1_;
 			float regionCut_;
@@ -41,7 +44,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class SingleIsoTauJet_v0 : public SingleIsoTauJet
+		class SingleIsoTauJet_v0 : public CloneableTrigger<SingleIsoTauJet_v0,SingleIsoTauJet>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -149,3 +152,23 @@ const float& l1menu::triggers::SingleIsoTauJet::parameter( const std::string& pa
 	else if( parameterName=="regionCut" ) return regionCut_;
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::SingleIsoTauJet::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return threshold1_;
+		case 1: return regionCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::SingleIsoTauJet::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return threshold1_;
+		case 1: return regionCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
@@ -1,74 +1,40 @@
 #ifndef l1menu_triggers_SingleIsoTkEleEta_h
 #define l1menu_triggers_SingleIsoTkEleEta_h
 
-#include <string>
-#include <vector>
-#include "l1menu/ITrigger.h"
-
-//
-// Forward declarations
-//
-namespace l1menu
-{
-	class L1TriggerDPGEvent;
-}
+#include "TriggerFamilies.h"
 
 namespace l1menu
 {
 	namespace triggers
 	{
-		/** @brief Base class for all versions of the SingleIsoTkEleEta trigger.
-		 *
-		 * Note that this class is abstract because it doesn't implement the "version"
-		 * and "apply" methods. That's left up to the implementations of the different
-		 * versions.
+		/** @brief The name and parameters shared by all versions of the SingleIsoTkEleEta trigger.
 		 *
 		 * @author Mark Grimes (mark.grimes@bristol.ac.uk)
 		 * @date 02/Jun/2013
 		 */
-		class SingleIsoTkEleEta : public l1menu::ITrigger
+		struct SingleIsoTkEleEtaDefinition
 		{
-		public:
-			SingleIsoTkEleEta();
-
-			virtual const std::string name() const;
-			virtual const std::vector<std::string> parameterNames() const;
-			virtual float& parameter( const std::string& parameterName );
-			virtual const float& parameter( const std::string& parameterName ) const;
-		protected:
-			float threshold1_;
-			float regionCut_;
-			float trkIsolCut_;
-		}; // end of the SingleIsoTkEleEta base class
+			static constexpr const char* name="L1_SingleIsoTkEle";
+			static constexpr TriggerParameter parameters[]={ {"threshold1",20}, {"regionCut",4.5}, {"trkIsolCut",999.} };
+		};
 
 		/** @brief First version of the SingleIsoTkEleEta trigger.
+		 *
+		 * Uses the isolation flag, so trkIsolCut isn't used.
 		 *
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class SingleIsoTkEleEta_v0 : public SingleIsoTkEleEta
-		{
-		public:
-			virtual unsigned int version() const;
-			virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const;
-			virtual bool thresholdsAreCorrelated() const;
-		}; // end of version 0 class
+		typedef SingleObjectFamily<SingleIsoTkEleEtaDefinition,0,collections::TrackElectrons,cuts::Isolated,cuts::Region> SingleIsoTkEleEta_v0;
 
 		/** @brief Second version of the SingleIsoTkEleEta trigger.
-		 *          use track isolation instead of calo isolation
+		 *
+		 * Uses track isolation instead of calo isolation.
 		 *
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class SingleIsoTkEleEta_v1 : public SingleIsoTkEleEta
-		{
-		public:
-			virtual unsigned int version() const;
-			virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const;
-			virtual bool thresholdsAreCorrelated() const;
-		}; // end of version 0 class
-
-
+		typedef SingleObjectFamily<SingleIsoTkEleEtaDefinition,1,collections::TrackElectrons,cuts::Region,cuts::TrackIsolation> SingleIsoTkEleEta_v1;
 
 	} // end of namespace triggers
 
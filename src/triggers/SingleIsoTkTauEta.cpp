@@ -1,15 +1,15 @@
 #include "SingleIsoTkTauEta.h"
 
-#include <stdexcept>
 #include "../implementation/RegisterTriggerMacro.h"
-#include "l1menu/L1TriggerDPGEvent.h"
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
 
 
 namespace l1menu
 {
 	namespace triggers
 	{
+		// Storage for the definition, which the family templates need until C++17
+		constexpr const char* SingleIsoTkTauEtaDefinition::name;
+		constexpr TriggerParameter SingleIsoTkTauEtaDefinition::parameters[];
 
 		/* The REGISTER_TRIGGER macro will make sure that the given trigger is registered in the
 		 * l1menu::TriggerTable when the program starts. I also want to provide some suggested binning
@@ -31,82 +31,3 @@ namespace l1menu
 	} // end of namespace triggers
 
 } // end of namespace l1menu
-
-
-//----------------------------------------------------------------------------------------
-//----------------------------------------------------------------------------------------
-//----------------------------------------------------------------------------------------
-//---------------  Definitions below         ---------------------------------------------
-//----------------------------------------------------------------------------------------
-//----------------------------------------------------------------------------------------
-//----------------------------------------------------------------------------------------
-
-
-bool l1menu::triggers::SingleIsoTkTauEta_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
-{
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];  // ZeroBias
-	if (! raw) return false;
-
-	int n1=0;
-	int Nt = analysisDataFormat.NTktau ;
-	for (int ue=0; ue < Nt; ue++) {
-		int bx = analysisDataFormat.BxTktau[ue];
-		if (bx != 0) continue;
-		bool iso = analysisDataFormat.IsoTktau[ue];
-		if (! iso) continue;				
-		float rank = analysisDataFormat.EtTktau[ue];    // the rank of the electron
-		float pt = rank; //CorrectedL1JetPtByGCTregions(analysisDataFormat.Etajet[ue],rank*4.,theL1JetCorrection);
-		float eta = analysisDataFormat.EtaTktau[ue];
-		if (eta < regionCut_ || eta > 21.-regionCut_) continue;  // eta = 5 - 16  // eta = 5 - 16
-		if (pt >= threshold1_) n1++;
-	}  // end loop over jets
-
-	bool ok = ( n1 >=1 );
-	return ok;
-}
-
-bool l1menu::triggers::SingleIsoTkTauEta_v0::thresholdsAreCorrelated() const
-{
-	return false;
-}
-
-unsigned int l1menu::triggers::SingleIsoTkTauEta_v0::version() const
-{
-	return 0;
-}
-
-l1menu::triggers::SingleIsoTkTauEta::SingleIsoTkTauEta()
-	: threshold1_(20), regionCut_(4.5)
-{
-	// No operation other than the initialiser list
-}
-
-const std::string l1menu::triggers::SingleIsoTkTauEta::name() const
-{
-	return "L1_SingleIsoTkTau";
-}
-
-const std::vector<std::string> l1menu::triggers::SingleIsoTkTauEta::parameterNames() const
-{
-	std::vector<std::string> returnValue;
-	returnValue.push_back("threshold1");
-	returnValue.push_back("regionCut");
-	return returnValue;
-}
-
-float& l1menu::triggers::SingleIsoTkTauEta::parameter( const std::string& parameterName )
-{
-	if( parameterName=="threshold1" ) return threshold1_;
-	else if( parameterName=="regionCut" ) return regionCut_;
-	else throw std::logic_error( "Not a valid parameter name" );
-}
-
-const float& l1menu::triggers::SingleIsoTkTauEta::parameter( const std::string& parameterName ) const
-{
-	if( parameterName=="threshold1" ) return threshold1_;
-	else if( parameterName=="regionCut" ) return regionCut_;
-	else throw std::logic_error( "Not a valid parameter name" );
-}
@@ -0,0 +1,22 @@
+#include "SingleObjectTrigger.h"
+
+#include "l1menu/L1TriggerDPGEvent.h"
+
+void l1menu::triggers::SingleObjectTrigger::applyBatch( const std::vector<const l1menu::L1TriggerDPGEvent*>& events, std::vector<bool>& passed ) const
+{
+	const float threshold=parameter( threshold1Handle );
+
+	passed.resize( events.size() );
+	for( size_t index=0; index<events.size(); ++index ) passed[index]=( highestPassingEt( *events[index] )>=threshold );
+}
+
+void l1menu::triggers::SingleObjectTrigger::applyBatch( const l1menu::L1TriggerDPGEvent& event, ParameterHandle thresholdHandle, const std::vector<float>& values, std::vector<bool>& passed )
+{
+	// Other parameters could be anything, so leave them to the generic implementation
+	if( thresholdHandle!=threshold1Handle ) return l1menu::ITrigger::applyBatch( event, thresholdHandle, values, passed );
+
+	const float highestEt=highestPassingEt( event );
+
+	passed.resize( values.size() );
+	for( size_t index=0; index<values.size(); ++index ) passed[index]=( highestEt>=values[index] );
+}
@@ -0,0 +1,50 @@
+#ifndef l1menu_triggers_SingleObjectTrigger_h
+#define l1menu_triggers_SingleObjectTrigger_h
+
+#include "l1menu/ITrigger.h"
+
+//
+// Forward declarations
+//
+namespace l1menu
+{
+	class L1TriggerDPGEvent;
+}
+
+namespace l1menu
+{
+	namespace triggers
+	{
+		/** @brief Base class for triggers that pass if any single object is above the threshold and passes some other cuts.
+		 *
+		 * For these triggers the tightest threshold that still passes an event is just the highest Et of
+		 * the objects that pass the other cuts. So rather than searching for it by calling apply over and
+		 * over, l1menu::tools::setTriggerThresholdsAsTightAsPossible asks for it directly.
+		 *
+		 * Implementations must only have the one threshold, which has to be the first parameter (i.e. have
+		 * the handle threshold1Handle), and apply must give exactly the same result as
+		 * "highestPassingEt(event)>=threshold1".
+		 *
+		 * The ITrigger::applyBatch methods are overridden so that scanning over threshold values only
+		 * needs highestPassingEt to be calculated once per event.
+		 */
+		class SingleObjectTrigger : public l1menu::ITrigger
+		{
+		public:
+			/** @brief The highest Et (Pt for muons) of the objects that pass all of the cuts apart from the threshold.
+			 *
+			 * Returns minus infinity if no objects pass, or if the event fails the zero bias requirement. */
+			virtual float highestPassingEt( const l1menu::L1TriggerDPGEvent& event ) const = 0;
+
+			/** @brief The handle of the "threshold1" parameter, which all implementations have first. */
+			static const ParameterHandle threshold1Handle=0;
+
+			virtual void applyBatch( const std::vector<const l1menu::L1TriggerDPGEvent*>& events, std::vector<bool>& passed ) const;
+			virtual void applyBatch( const l1menu::L1TriggerDPGEvent& event, ParameterHandle thresholdHandle, const std::vector<float>& values, std::vector<bool>& passed );
+		}; // end of the SingleObjectTrigger class
+
+	} // end of namespace triggers
+
+} // end of namespace l1menu
+
+#endif
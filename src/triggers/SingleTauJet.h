@@ -1,58 +1,29 @@
 #ifndef l1menu_triggers_SingleTauJet_h
 #define l1menu_triggers_SingleTauJet_h
 
-#include <string>
-#include <vector>
-#include "l1menu/ITrigger.h"
-
-//
-// Forward declarations
-//
-namespace l1menu
-{
-	class L1TriggerDPGEvent;
-}
+#include "TriggerFamilies.h"
 
 namespace l1menu
 {
 	namespace triggers
 	{
-		/** @brief Base class for all versions of the SingleTauJet trigger.
-		 *
-		 * Note that this class is abstract because it doesn't implement the "version"
-		 * and "apply" methods. That's left up to the implementations of the different
-		 * versions.
+		/** @brief The name and parameters shared by all versions of the SingleTauJet trigger.
 		 *
 		 * @author Mark Grimes (mark.grimes@bristol.ac.uk)
 		 * @date 04/Jun/2013
 		 */
-		class SingleTauJet : public l1menu::ITrigger
+		struct SingleTauJetDefinition
 		{
-		public:
-			SingleTauJet();
-
-			virtual const std::string name() const;
-			virtual const std::vector<std::string> parameterNames() const;
-			virtual float& parameter( const std::string& parameterName );
-			virtual const float& parameter( const std::string& parameterName ) const;
-		protected:
-			float threshold1_;
-			float regionCut_;
-		}; // end of the SingleTauJet base class
+			static constexpr const char* name="L1_SingleTau";
+			static constexpr TriggerParameter parameters[]={ {"threshold1",20}, {"regionCut",4.5} };
+		};
 
 		/** @brief First version of the SingleTauJet trigger.
 		 *
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class SingleTauJet_v0 : public SingleTauJet
-		{
-		public:
-			virtual unsigned int version() const;
-			virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const;
-			virtual bool thresholdsAreCorrelated() const;
-		}; // end of version 0 class
-
+		typedef SingleObjectFamily<SingleTauJetDefinition,0,collections::TauJets,cuts::Region> SingleTauJet_v0;
 
 	} // end of namespace triggers
 
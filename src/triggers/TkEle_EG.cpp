@@ -1,8 +1,9 @@
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 #include "l1menu/L1TriggerDPGEvent.h"
+#include "TowerOverlap.h"
 
 #include <stdexcept>
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
 
 #include "l1menu/ITrigger.h"
 
@@ -35,6 +36,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		protected:
 			float leg1threshold1_;
 			float leg2threshold1_;
@@ -48,7 +51,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class TkEle_EG_v0 : public TkEle_EG
+		class TkEle_EG_v0 : public CloneableTrigger<TkEle_EG_v0,TkEle_EG>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -62,7 +65,7 @@ namespace l1menu
 		 * @date sometime
 		 */
 
-		class TkEle_EG_v1 : public TkEle_EG
+		class TkEle_EG_v1 : public CloneableTrigger<TkEle_EG_v1,TkEle_EG>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -105,44 +108,13 @@ namespace l1menu
 
 bool l1menu::triggers::TkEle_EG_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];   // ZeroBias
-	if (! raw) return false;
-
-	bool ok = false;
-
-	int Neg = analysisDataFormat.Nele;
-
-	int Nele = analysisDataFormat.NTkele;
-	for (int ue=0; ue < Nele; ue++) {
-		int bx = analysisDataFormat.BxTkel[ue];
-		if (bx != 0 ) continue;
-		float eta = analysisDataFormat.EtaTkel[ue];
-		if (eta < leg1regionCut_ || eta > 21.-leg1regionCut_) continue;  // eta = 5 - 16
-		float rank = analysisDataFormat.EtTkel[ue];    // the rank of the electron
-		float pt = rank ;
-		if (pt >= leg1threshold1_){
-
-                        
-			for (int uj=0; uj < Neg; uj++) {
-				int bxj = analysisDataFormat.Bxel[uj];
-				if (bxj != 0) continue;
-				float rankj = analysisDataFormat.Etel[uj];
-				float ptj = rankj; //CorrectedL1JetPtByGCTregions(analysisDataFormat.Etajet[uj],rank*4.,theL1JetCorrection);
-
-				if (analysisDataFormat.Etael[uj] < leg2regionCut_ || analysisDataFormat.Etael[uj] > 21.-leg2regionCut_) continue;
-				if (ptj >= leg2threshold1_ &&
-					!(analysisDataFormat.Etael[uj]==analysisDataFormat.EtaTkel[ue] &&
-					  analysisDataFormat.Phiel[uj]==analysisDataFormat.PhiTkel[ue]) ) ok = true;
-			}
-
-	
-		} // if good TkEle
-	}  // end loop over TkEle objects
-
-	return ok;
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
+
+	// An EG that isn't in the same region as the track electron
+	return l1menu::triggers::nonOverlappingPairExists( event, objects.trackElectrons,
+			[this]( const l1menu::L1TriggerDPGEvent::L1Object& electron ){ return !(electron.symmetricRegion<leg1regionCut_) && float(electron.et)>=leg1threshold1_; },
+			objects.egamma, leg2regionCut_, leg2threshold1_ );
 }
 
 
@@ -160,43 +132,13 @@ unsigned int l1menu::triggers::TkEle_EG_v0::version() const
 
 bool l1menu::triggers::TkEle_EG_v1::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];   // ZeroBias
-	if (! raw) return false;
-
-	bool ok = false;
-
-	int Neg = analysisDataFormat.Nele;
-
-	int Nele = analysisDataFormat.NTkele2;
-	for (int ue=0; ue < Nele; ue++) {
-		int bx = analysisDataFormat.BxTkel2[ue];
-		if (bx != 0 ) continue;
-		float eta = analysisDataFormat.EtaTkel2[ue];
-		if (eta < leg1regionCut_ || eta > 21.-leg1regionCut_) continue;  // eta = 5 - 16
-		float rank = analysisDataFormat.EtTkel2[ue];    // the rank of the electron
-		float pt = rank ;
-		if (pt >= leg1threshold1_){
-
-                        
-			for (int uj=0; uj < Neg; uj++) {
-				int bxj = analysisDataFormat.Bxel[uj];
-				if (bxj != 0) continue;
-				float rankj = analysisDataFormat.Etel[uj];
-				float ptj = rankj; //CorrectedL1JetPtByGCTregions(analysisDataFormat.Etajet[uj],rank*4.,theL1JetCorrection);
-
-				if (analysisDataFormat.Etael[uj] < leg2regionCut_ || analysisDataFormat.Etael[uj] > 21.-leg2regionCut_) continue;
-				if (ptj >= leg2threshold1_ &&
-					!(analysisDataFormat.Etael[uj]==analysisDataFormat.EtaTkel2[ue] &&
-					  analysisDataFormat.Phiel[uj]==analysisDataFormat.PhiTkel2[ue]) ) ok = true;
-			}
-
-		} // if good TkEle
-	}  // end loop over TkEle objects
-
-	return ok;
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
+
+	// An EG that isn't in the same region as the track electron
+	return l1menu::triggers::nonOverlappingPairExists( event, objects.trackElectrons2,
+			[this]( const l1menu::L1TriggerDPGEvent::L1Object& electron ){ return !(electron.symmetricRegion<leg1regionCut_) && float(electron.et)>=leg1threshold1_; },
+			objects.egamma, leg2regionCut_, leg2threshold1_ );
 }
 
 
@@ -250,3 +192,27 @@ const float& l1menu::triggers::TkEle_EG::parameter( const std::string& parameter
 	else if( parameterName=="leg2regionCut" ) return leg2regionCut_;
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::TkEle_EG::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg1regionCut_;
+		case 2: return leg2threshold1_;
+		case 3: return leg2regionCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::TkEle_EG::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg1regionCut_;
+		case 2: return leg2threshold1_;
+		case 3: return leg2regionCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
@@ -2,6 +2,7 @@
 #include "SingleTkEleEta.h"
 #include "SingleMuEta.h"
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 
 namespace l1menu
 {
@@ -18,7 +19,7 @@ namespace l1menu
 		 * CrossTrigger by Mark Grimes (mark.grimes@bristol.ac.uk).
 		 * @date 03/Jun/2013
 		 */
-		class TkEle_Mu_v0 : public l1menu::triggers::CrossTrigger
+		class TkEle_Mu_v0 : public CloneableTrigger<TkEle_Mu_v0,l1menu::triggers::CrossTrigger>
 		{
 		public:
 			TkEle_Mu_v0();
@@ -32,7 +33,7 @@ namespace l1menu
 		 * L1_SingleTkEG version 1 which used second TkEle Collection with lower Pt cut <br/>
 		 * L1_SingleMu version 0 <br/>
 		*/
-		class TkEle_Mu_v1 : public l1menu::triggers::CrossTrigger
+		class TkEle_Mu_v1 : public CloneableTrigger<TkEle_Mu_v1,l1menu::triggers::CrossTrigger>
 		{
 		public:
 			TkEle_Mu_v1();
@@ -67,7 +68,7 @@ namespace l1menu
 
 
 l1menu::triggers::TkEle_Mu_v0::TkEle_Mu_v0()
-	: CrossTrigger( new l1menu::triggers::SingleTkEleEta_v0, new l1menu::triggers::SingleMuEta_v0 )
+	: CloneableTrigger( new l1menu::triggers::SingleTkEleEta_v0, new l1menu::triggers::SingleMuEta_v0 )
 {
 	// No operation besides passing the sub-triggers onto the base class
 }
@@ -83,7 +84,7 @@ unsigned int l1menu::triggers::TkEle_Mu_v0::version() const
 }
 
 l1menu::triggers::TkEle_Mu_v1::TkEle_Mu_v1()
-	: CrossTrigger( new l1menu::triggers::SingleTkEleEta_v1, new l1menu::triggers::SingleMuEta_v0 )
+	: CloneableTrigger( new l1menu::triggers::SingleTkEleEta_v1, new l1menu::triggers::SingleMuEta_v0 )
 {
 	// No operation besides passing the sub-triggers onto the base class
 }
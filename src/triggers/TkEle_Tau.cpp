@@ -1,9 +1,10 @@
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 #include "l1menu/L1TriggerDPGEvent.h"
 #include <TMath.h>
 
 #include <stdexcept>
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
+#include <cmath>
 
 #include "l1menu/ITrigger.h"
 
@@ -36,6 +37,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		protected:
 			float leg1threshold1_;
 			float leg2threshold1_;
@@ -49,7 +52,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class TkEle_Tau_v0 : public TkEle_Tau
+		class TkEle_Tau_v0 : public CloneableTrigger<TkEle_Tau_v0,TkEle_Tau>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -62,7 +65,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class TkEle_Tau_v1 : public TkEle_Tau
+		class TkEle_Tau_v1 : public CloneableTrigger<TkEle_Tau_v1,TkEle_Tau>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -106,50 +109,33 @@ namespace l1menu
 
 bool l1menu::triggers::TkEle_Tau_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
 
-	bool raw=PhysicsBits[0]; // ZeroBias
-	if( !raw ) return false;
+	bool ok=false;
 
-	bool ok = false;
-
-	int NTkele=analysisDataFormat.NTkele;
-	int Nj=analysisDataFormat.Njet;
-	
-	for( int ie=0; ie<NTkele; ie++ )
+	for( const auto& electron : objects.trackElectrons )
 	{
+		if( electron.symmetricRegion<leg1regionCut_ ) continue;
+		float pt=electron.et;
+		if( pt>=leg1threshold1_ )
+		{
+			for( const auto& tau : objects.tauJets )
+			{
+				if( tau.symmetricRegion<leg2regionCut_ ) continue;
+				float pt2=tau.et;
 
-		int bx=analysisDataFormat.BxTkel.at( ie );
-		if( bx!=0 ) continue;
-		float pt = analysisDataFormat.EtTkel.at( ie );
-		float eta = analysisDataFormat.EtaTkel[ie];
-		if (eta < leg1regionCut_ || eta > 21.-leg1regionCut_) continue;  // eta = 5 - 16  // eta = 5 - 16
-
-		if( pt>=leg1threshold1_ ) {
-
-			for (int ut=0; ut < Nj; ut++) {
-				int bx = analysisDataFormat.Bxjet[ut];
-				if (bx != 0) continue;
-				bool isTauJet = analysisDataFormat.Taujet[ut];
-				if (! isTauJet) continue;
-				float pt2 = analysisDataFormat.Etjet[ut];    // the rank of the electron
-				float eta2 = analysisDataFormat.Etajet[ut];
-				if (eta2 < leg2regionCut_ || eta2 > 21.-leg2regionCut_) continue;  // eta = 5 - 16  // eta = 5 - 16
-
-                                //remove overlap with simple delta R for now.
-                                float delEta = fabs(analysisDataFormat.Etajet[ut]-analysisDataFormat.EtaTkel[ie]);
-				float delPhi = fabs(analysisDataFormat.Phijet[ut]-analysisDataFormat.PhiTkel[ie]);
-				if(delPhi>TMath::Pi()) delPhi = TMath::TwoPi() - delPhi;
-				float delR = sqrt(delEta*delEta + delPhi*delPhi);
-
-				if (pt2 >= leg2threshold1_ && delR>0.5) ok = true;
+				//remove overlap with simple delta R for now.
+				float delEta=std::fabs(tau.eta-electron.eta);
+				float delPhi=std::fabs(tau.phi-electron.phi);
+				if( delPhi>TMath::Pi() ) delPhi=TMath::TwoPi()-delPhi;
+				float delR=sqrt(delEta*delEta+delPhi*delPhi);
+
+				if( pt2>=leg2threshold1_ && delR>0.5 ) ok=true;
 			}
-                } 
-		
+		}
 	}
 
-	
 	return ok;
 }
 
@@ -167,51 +153,33 @@ unsigned int l1menu::triggers::TkEle_Tau_v0::version() const
 
 bool l1menu::triggers::TkEle_Tau_v1::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw=PhysicsBits[0]; // ZeroBias
-	if( !raw ) return false;
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
 
-	bool ok = false;
+	bool ok=false;
 
-	int NTkele=analysisDataFormat.NTkele2;
-	int Nj=analysisDataFormat.Njet;
-	
-	for( int ie=0; ie<NTkele; ie++ )
+	for( const auto& electron : objects.trackElectrons2 )
 	{
+		if( electron.symmetricRegion<leg1regionCut_ ) continue;
+		float pt=electron.et;
+		if( pt>=leg1threshold1_ )
+		{
+			for( const auto& tau : objects.tauJets )
+			{
+				if( tau.symmetricRegion<leg2regionCut_ ) continue;
+				float pt2=tau.et;
 
-		int bx=analysisDataFormat.BxTkel2.at( ie );
-		if( bx!=0 ) continue;
-		float pt = analysisDataFormat.EtTkel2.at( ie );
-		float eta = analysisDataFormat.EtaTkel2[ie];
-		if (eta < leg1regionCut_ || eta > 21.-leg1regionCut_) continue;  // eta = 5 - 16  // eta = 5 - 16
-
-		if( pt>=leg1threshold1_ ) {
-		  
-
-			for (int ut=0; ut < Nj; ut++) {
-				int bx = analysisDataFormat.Bxjet[ut];
-				if (bx != 0) continue;
-				bool isTauJet = analysisDataFormat.Taujet[ut];
-				if (! isTauJet) continue;
-				float pt2 = analysisDataFormat.Etjet[ut];    // the rank of the electron
-				float eta2 = analysisDataFormat.Etajet[ut];
-				if (eta2 < leg2regionCut_ || eta2 > 21.-leg2regionCut_) continue;  // eta = 5 - 16  // eta = 5 - 16
-
-                                //remove overlap with simple delta R for now.
-                                float delEta = fabs(analysisDataFormat.Etajet[ut]-analysisDataFormat.EtaTkel2[ie]);
-				float delPhi = fabs(analysisDataFormat.Phijet[ut]-analysisDataFormat.PhiTkel2[ie]);
-				if(delPhi>TMath::Pi()) delPhi = TMath::TwoPi() - delPhi;
-				float delR = sqrt(delEta*delEta + delPhi*delPhi);
-
-				if (pt2 >= leg2threshold1_ && delR>0.5) ok = true;
+				//remove overlap with simple delta R for now.
+				float delEta=std::fabs(tau.eta-electron.eta);
+				float delPhi=std::fabs(tau.phi-electron.phi);
+				if( delPhi>TMath::Pi() ) delPhi=TMath::TwoPi()-delPhi;
+				float delR=sqrt(delEta*delEta+delPhi*delPhi);
+
+				if( pt2>=leg2threshold1_ && delR>0.5 ) ok=true;
 			}
-                } 
-		
+		}
 	}
 
-	
 	return ok;
 }
 
@@ -267,3 +235,27 @@ const float& l1menu::triggers::TkEle_Tau::parameter( const std::string& paramete
 	else if( parameterName=="leg2regionCut" ) return leg2regionCut_;		
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::TkEle_Tau::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg2threshold1_;
+		case 2: return leg1regionCut_;
+		case 3: return leg2regionCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::TkEle_Tau::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg2threshold1_;
+		case 2: return leg1regionCut_;
+		case 3: return leg2regionCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
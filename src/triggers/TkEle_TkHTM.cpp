@@ -2,6 +2,7 @@
 #include "SingleTkEleEta.h"
 #include "TkHTM.h"
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 
 namespace l1menu
 {
@@ -18,7 +19,7 @@ namespace l1menu
 		 * CrossTrigger by Mark Grimes (mark.grimes@bristol.ac.uk).
 		 * @date 03/Jun/2013
 		 */
-		class TkEle_TkHTM_v0 : public l1menu::triggers::CrossTrigger
+		class TkEle_TkHTM_v0 : public CloneableTrigger<TkEle_TkHTM_v0,l1menu::triggers::CrossTrigger>
 		{
 		public:
 			TkEle_TkHTM_v0();
@@ -51,7 +52,7 @@ namespace l1menu
 
 
 l1menu::triggers::TkEle_TkHTM_v0::TkEle_TkHTM_v0()
-	: CrossTrigger( new l1menu::triggers::SingleTkEleEta_v0, new l1menu::triggers::TkHTM_v0 )
+	: CloneableTrigger( new l1menu::triggers::SingleTkEleEta_v0, new l1menu::triggers::TkHTM_v0 )
 {
 	// No operation besides passing the sub-triggers onto the base class
 }
@@ -1,14 +1,15 @@
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 #include "l1menu/L1TriggerDPGEvent.h"
+#include "TowerOverlap.h"
+#include "VertexMatchedPair.h"
 
 #include <stdexcept>
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
 
 #include "l1menu/ITrigger.h"
 
 #include <string>
 #include <vector>
-#include <cmath>
 
 namespace l1menu
 {
@@ -36,6 +37,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		protected:
 			float leg1threshold1_;
 			float leg2threshold1_;
@@ -48,7 +51,7 @@ namespace l1menu
 		 *
 		 * @date 09/Sep/2013
 		 */
-		class TkEle_TkJet_v1 : public TkEle_TkJet
+		class TkEle_TkJet_v1 : public CloneableTrigger<TkEle_TkJet_v1,TkEle_TkJet>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -61,7 +64,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class TkEle_TkJet_v0 : public TkEle_TkJet
+		class TkEle_TkJet_v0 : public CloneableTrigger<TkEle_TkJet_v0,TkEle_TkJet>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -106,47 +109,15 @@ namespace l1menu
 
 bool l1menu::triggers::TkEle_TkJet_v1::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];   // ZeroBias
-	if (! raw) return false;
-
-	bool ok = false;
-
-	int Nj = analysisDataFormat.NTkjet ;
-
-	int NTkele = analysisDataFormat.NTkele;
-	for (int ue=0; ue < NTkele; ue++) {
-
-		int bx = analysisDataFormat.BxTkel[ue];
-		if (bx != 0) continue;
-		float eta = analysisDataFormat.EtaTkel[ue];
-		if (eta < leg1regionCut_ || eta > 21.-leg1regionCut_) continue;  // eta = 5 - 16
-		float pt = analysisDataFormat.EtTkel[ue];    // the rank of the electron
-		if (pt >= leg1threshold1_){
-
-			
-                        float eleZvtx = analysisDataFormat.zVtxTkel[ue];
-			 
-			for (int uj=0; uj < Nj; uj++) {
-			   if(fabs(eleZvtx - analysisDataFormat.zVtxTkjet[uj]) < zVtxCut_)  {
-				int bxj = analysisDataFormat.BxTkjet[uj];
-				if (bxj != 0) continue;
-				float ptj = analysisDataFormat.EtTkjet[uj];
-
-				if (analysisDataFormat.EtaTkjet[uj] < leg2regionCut_ || analysisDataFormat.EtaTkjet[uj] > 21.-leg2regionCut_) continue;
-				if (ptj >= leg2threshold1_ &&
-					!(analysisDataFormat.EtaTkjet[uj]==analysisDataFormat.EtaTkel[ue] &&
-					  analysisDataFormat.PhiTkjet[uj]==analysisDataFormat.PhiTkel[ue]) ) ok = true;
-			   } //end z-vtx cut
-			}
-
-			
-		} // if good EG
-	}  // end loop over EM objects
-
-	return ok;
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
+
+	// A jet within zVtxCut of the electron, that isn't the electron itself
+	return l1menu::triggers::vertexMatchedPairExists( event, objects.trackElectrons, objects.trackJets,
+			[this]( const l1menu::L1TriggerDPGEvent::L1Object& electron ){ return !(electron.symmetricRegion<leg1regionCut_) && float(electron.et)>=leg1threshold1_; },
+			[this]( const l1menu::L1TriggerDPGEvent::L1Object& electron, const l1menu::L1TriggerDPGEvent::L1Object& jet )
+				{ return !(jet.symmetricRegion<leg2regionCut_) && float(jet.et)>=leg2threshold1_ && !jet.inSameTower(electron); },
+			zVtxCut_ );
 }
 
 bool l1menu::triggers::TkEle_TkJet_v1::thresholdsAreCorrelated() const
@@ -164,42 +135,13 @@ unsigned int l1menu::triggers::TkEle_TkJet_v1::version() const
 
 bool l1menu::triggers::TkEle_TkJet_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
 
-	bool raw = PhysicsBits[0];   // ZeroBias
-	if (! raw) return false;
-
-	bool ok = false;
-
-	int Nj = analysisDataFormat.NTkjet ;
-
-	int NTkele = analysisDataFormat.NTkele;
-	for (int ue=0; ue < NTkele; ue++) {
-		int bx = analysisDataFormat.BxTkel[ue];
-		if (bx != 0) continue;
-		float eta = analysisDataFormat.EtaTkel[ue];
-		if (eta < leg1regionCut_ || eta > 21.-leg1regionCut_) continue;  // eta = 5 - 16
-		float pt = analysisDataFormat.EtTkel[ue];    // the rank of the electron
-		if (pt >= leg1threshold1_){
-
-
-			for (int uj=0; uj < Nj; uj++) {
-				int bxj = analysisDataFormat.BxTkjet[uj];
-				if (bxj != 0) continue;
-				float ptj = analysisDataFormat.EtTkjet[uj];
-
-				if (analysisDataFormat.EtaTkjet[uj] < leg2regionCut_ || analysisDataFormat.EtaTkjet[uj] > 21.-leg2regionCut_) continue;
-				if (ptj >= leg2threshold1_ &&
-					!(analysisDataFormat.EtaTkjet[uj]==analysisDataFormat.EtaTkel[ue] &&
-					  analysisDataFormat.PhiTkjet[uj]==analysisDataFormat.PhiTkel[ue]) ) ok = true;
-			}
-
-			
-		} // if good EG
-	}  // end loop over EM objects
-
-	return ok;
+	// A track jet that isn't in the same region as the track electron
+	return l1menu::triggers::nonOverlappingPairExists( event, objects.trackElectrons,
+			[this]( const l1menu::L1TriggerDPGEvent::L1Object& electron ){ return !(electron.symmetricRegion<leg1regionCut_) && float(electron.et)>=leg1threshold1_; },
+			objects.trackJets, leg2regionCut_, leg2threshold1_ );
 }
 
 bool l1menu::triggers::TkEle_TkJet_v0::thresholdsAreCorrelated() const
@@ -255,3 +197,29 @@ const float& l1menu::triggers::TkEle_TkJet::parameter( const std::string& parame
 	else if( parameterName=="zVtxCut" ) return zVtxCut_;
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::TkEle_TkJet::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg1regionCut_;
+		case 2: return leg2threshold1_;
+		case 3: return leg2regionCut_;
+		case 4: return zVtxCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::TkEle_TkJet::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg1regionCut_;
+		case 2: return leg2threshold1_;
+		case 3: return leg2regionCut_;
+		case 4: return zVtxCut_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
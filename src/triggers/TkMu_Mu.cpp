@@ -1,9 +1,10 @@
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 #include "l1menu/L1TriggerDPGEvent.h"
 #include <TMath.h>
 
 #include <stdexcept>
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
+#include <cmath>
 
 #include "l1menu/ITrigger.h"
 
@@ -36,6 +37,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		protected:
 			float leg1threshold1_;
 			float leg2threshold1_;
@@ -48,7 +51,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class TkMu_Mu_v0 : public TkMu_Mu
+		class TkMu_Mu_v0 : public CloneableTrigger<TkMu_Mu_v0,TkMu_Mu>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -91,49 +94,31 @@ namespace l1menu
 
 bool l1menu::triggers::TkMu_Mu_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
 
-	bool raw=PhysicsBits[0]; // ZeroBias
-	if( !raw ) return false;
+	bool ok=false;
 
-	bool ok = false;
-
-	int NTkmu=analysisDataFormat.NTkmu;
-	int Nmu=analysisDataFormat.Nmu;
-	
-	for( int imu=0; imu<NTkmu; imu++ )
+	for( const auto& trackMuon : objects.trackMuons )
 	{
-		int bx=analysisDataFormat.BxTkmu.at( imu );
-		if( bx!=0 ) continue;
-		float pt=analysisDataFormat.PtTkmu.at( imu );
-		//float eta=analysisDataFormat.Etamu.at( imu ); // Commented out to stop unused variable compile warning
-		int qual=analysisDataFormat.QualTkmu.at( imu );
-		if( qual<muonQuality_ ) continue;
-
-		if( pt>=leg1threshold1_ ) {
-		  
-
-			for (int uj=0; uj < Nmu; uj++) {
-				int bxj = analysisDataFormat.Bxmu[uj];
-				if (bxj != 0) continue;
-
-				float pt2=analysisDataFormat.Ptmu.at( uj );
-				//float eta=analysisDataFormat.Etamu.at( uj ); // Commented out to stop unused variable compile warning
-				int qual=analysisDataFormat.Qualmu.at( uj );
-				if( qual<muonQuality_ ) continue;
-
-                                //remove overlap with simple delta R for now.
-                                float delEta = fabs(analysisDataFormat.Etamu[uj]-analysisDataFormat.EtaTkmu[imu]);
-				float delPhi = fabs(analysisDataFormat.Phimu[uj]-analysisDataFormat.PhiTkmu[imu]);
-				if(delPhi>TMath::Pi()) delPhi = TMath::TwoPi() - delPhi;
-				float delR = sqrt(delEta*delEta + delPhi*delPhi);
-
-				if (pt2 >= leg2threshold1_ && delR>0.5) ok = true;
-			}
-                } 
+		if( trackMuon.quality<muonQuality_ ) continue;
+		float pt=trackMuon.et;
+		if( pt>=leg1threshold1_ )
+		{
+			for( const auto& muon : objects.muons )
+			{
+				float pt2=muon.et;
+				if( muon.quality<muonQuality_ ) continue;
 
-		
+				//remove overlap with simple delta R for now.
+				float delEta=std::fabs(muon.eta-trackMuon.eta);
+				float delPhi=std::fabs(muon.phi-trackMuon.phi);
+				if( delPhi>TMath::Pi() ) delPhi=TMath::TwoPi()-delPhi;
+				float delR=sqrt(delEta*delEta+delPhi*delPhi);
+
+				if( pt2>=leg2threshold1_ && delR>0.5 ) ok=true;
+			}
+		}
 	}
 
 	return ok;
@@ -186,3 +171,25 @@ const float& l1menu::triggers::TkMu_Mu::parameter( const std::string& parameterN
 	else if( parameterName=="muonQuality" ) return muonQuality_;
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::TkMu_Mu::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg2threshold1_;
+		case 2: return muonQuality_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::TkMu_Mu::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg2threshold1_;
+		case 2: return muonQuality_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
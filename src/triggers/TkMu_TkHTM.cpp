@@ -2,6 +2,7 @@
 #include "SingleTkMuEta.h"
 #include "TkHTM.h"
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 
 namespace l1menu
 {
@@ -18,7 +19,7 @@ namespace l1menu
 		 * CrossTrigger by Mark Grimes (mark.grimes@bristol.ac.uk).
 		 * @date 03/Jun/2013
 		 */
-		class TkMu_TkHTM_v0 : public l1menu::triggers::CrossTrigger
+		class TkMu_TkHTM_v0 : public CloneableTrigger<TkMu_TkHTM_v0,l1menu::triggers::CrossTrigger>
 		{
 		public:
 			TkMu_TkHTM_v0();
@@ -51,7 +52,7 @@ namespace l1menu
 
 
 l1menu::triggers::TkMu_TkHTM_v0::TkMu_TkHTM_v0()
-	: CrossTrigger( new l1menu::triggers::SingleTkMuEta_v0, new l1menu::triggers::TkHTM_v0 )
+	: CloneableTrigger( new l1menu::triggers::SingleTkMuEta_v0, new l1menu::triggers::TkHTM_v0 )
 {
 	// No operation besides passing the sub-triggers onto the base class
 }
@@ -1,8 +1,9 @@
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 #include "l1menu/L1TriggerDPGEvent.h"
+#include "VertexMatchedPair.h"
 
 #include <stdexcept>
-#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
 
 #include "l1menu/ITrigger.h"
 
@@ -36,6 +37,8 @@ namespace l1menu
 			virtual const std::vector<std::string> parameterNames() const;
 			virtual float& parameter( const std::string& parameterName );
 			virtual const float& parameter( const std::string& parameterName ) const;
+			virtual float& parameter( ParameterHandle handle );
+			virtual const float& parameter( ParameterHandle handle ) const;
 		protected:
 			float leg1threshold1_;
 			float leg2threshold1_;
@@ -50,7 +53,7 @@ namespace l1menu
 		 *
 		 * @date 09/Sep/2013
 		 */
-		class TkMu_TkJet_v1 : public TkMu_TkJet
+		class TkMu_TkJet_v1 : public CloneableTrigger<TkMu_TkJet_v1,TkMu_TkJet>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -63,7 +66,7 @@ namespace l1menu
 		 * @author probably Brian Winer
 		 * @date sometime
 		 */
-		class TkMu_TkJet_v0 : public TkMu_TkJet
+		class TkMu_TkJet_v0 : public CloneableTrigger<TkMu_TkJet_v0,TkMu_TkJet>
 		{
 		public:
 			virtual unsigned int version() const;
@@ -108,49 +111,15 @@ namespace l1menu
 
 bool l1menu::triggers::TkMu_TkJet_v1::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-        
-	//printf("Cuts: MuPt %f  JetPt  %f  MuEta %f JetEta %f\n",leg1threshold1_,leg2threshold1_,leg1etaCut_,leg2regionCut_);
-
-	bool raw = PhysicsBits[0];   // ZeroBias
-	if (! raw) return false;
-
-	bool ok = false;
-
-	int Nj = analysisDataFormat.NTkjet ;
-
-	int NTkmu = analysisDataFormat.NTkmu;
-	for (int imu=0; imu < NTkmu; imu++) {
-
-		int bx = analysisDataFormat.BxTkmu.at(imu);
-		if (bx != 0) continue;
-		float pt = analysisDataFormat.PtTkmu.at(imu);
-		int qual = analysisDataFormat.QualTkmu.at(imu);
-		if ( qual < muonQuality_) continue;
-		float eta = analysisDataFormat.EtaTkmu.at(imu);
-		if (std::fabs(eta) > leg1etaCut_) continue;
-		
-		if (pt >= leg1threshold1_){
-
-                        float muZvtx = analysisDataFormat.zVtxTkmu[imu];
-			 
-			for (int uj=0; uj < Nj; uj++) {
-			   if(fabs(muZvtx - analysisDataFormat.zVtxTkjet[uj]) < zVtxCut_)  {
-				int bxj = analysisDataFormat.BxTkjet[uj];
-				if (bxj != 0) continue;
-				float ptj = analysisDataFormat.EtTkjet[uj];
-
-				if (analysisDataFormat.EtaTkjet[uj] < leg2regionCut_ || analysisDataFormat.EtaTkjet[uj] > 21.-leg2regionCut_) continue;
-				if (ptj >= leg2threshold1_  ) ok = true;
-			   } //end z-vtx cut
-			}
-
-
-		} // if good Mu
-	}  // end loop over Mu objects
-
-	return ok;
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
+
+	// A jet within zVtxCut of the muon
+	return l1menu::triggers::vertexMatchedPairExists( event, objects.trackMuons, objects.trackJets,
+			[this]( const l1menu::L1TriggerDPGEvent::L1Object& muon ){ return !(muon.quality<muonQuality_) && !(std::fabs(float(muon.eta))>leg1etaCut_) && float(muon.et)>=leg1threshold1_; },
+			[this]( const l1menu::L1TriggerDPGEvent::L1Object&, const l1menu::L1TriggerDPGEvent::L1Object& jet )
+				{ return !(jet.symmetricRegion<leg2regionCut_) && float(jet.et)>=leg2threshold1_; },
+			zVtxCut_ );
 }
 
 bool l1menu::triggers::TkMu_TkJet_v1::thresholdsAreCorrelated() const
@@ -168,42 +137,27 @@ unsigned int l1menu::triggers::TkMu_TkJet_v1::version() const
 
 bool l1menu::triggers::TkMu_TkJet_v0::apply( const l1menu::L1TriggerDPGEvent& event ) const
 {
-	const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
-	const bool* PhysicsBits=event.physicsBits();
-
-	bool raw = PhysicsBits[0];   // ZeroBias
-	if (! raw) return false;
-
-	bool ok = false;
-
-	int Nj = analysisDataFormat.NTkjet ;
-
-	int NTkmu = analysisDataFormat.NTkmu;
-	for (int imu=0; imu < NTkmu; imu++) {
-
-		int bx = analysisDataFormat.BxTkmu.at(imu);
-		if (bx != 0) continue;
-		float pt = analysisDataFormat.PtTkmu.at(imu);
-		int qual = analysisDataFormat.QualTkmu.at(imu);
-		if ( qual < muonQuality_) continue;
-		float eta = analysisDataFormat.EtaTkmu.at(imu);
-		if (std::fabs(eta) > leg1etaCut_) continue;
-		
-		if (pt >= leg1threshold1_){
-
-                     
-			 
-			for (int uj=0; uj < Nj; uj++) {
-				int bxj = analysisDataFormat.BxTkjet[uj];
-				if (bxj != 0) continue;
-				float ptj = analysisDataFormat.EtTkjet[uj];
-
-				if (analysisDataFormat.EtaTkjet[uj] < leg2regionCut_ || analysisDataFormat.EtaTkjet[uj] > 21.-leg2regionCut_) continue;
-				if (ptj >= leg2threshold1_  ) ok = true;
-			}
+	const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+	if( !objects.zeroBias ) return false;
+
+	bool ok=false;
 
+	for( const auto& muon : objects.trackMuons )
+	{
+		if( muon.quality<muonQuality_ ) continue;
+		float eta=muon.eta;
+		if( std::fabs(eta)>leg1etaCut_ ) continue;
+		float pt=muon.et;
+		if( pt>=leg1threshold1_ )
+		{
+			for( const auto& jet : objects.trackJets )
+			{
+				if( jet.symmetricRegion<leg2regionCut_ ) continue;
+				float ptj=jet.et;
+				if( ptj>=leg2threshold1_ ) ok=true;
+			}
 		} // if good Mu
-	}  // end loop over Mu objects
+	} // end loop over Mu objects
 
 	return ok;
 }
@@ -264,3 +218,31 @@ const float& l1menu::triggers::TkMu_TkJet::parameter( const std::string& paramet
 	else if( parameterName=="muonQuality" ) return muonQuality_;	
 	else throw std::logic_error( "Not a valid parameter name" );
 }
+
+float& l1menu::triggers::TkMu_TkJet::parameter( ParameterHandle handle )
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg1etaCut_;
+		case 2: return leg2threshold1_;
+		case 3: return leg2regionCut_;
+		case 4: return zVtxCut_;
+		case 5: return muonQuality_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
+
+const float& l1menu::triggers::TkMu_TkJet::parameter( ParameterHandle handle ) const
+{
+	switch( handle )
+	{
+		case 0: return leg1threshold1_;
+		case 1: return leg1etaCut_;
+		case 2: return leg2threshold1_;
+		case 3: return leg2regionCut_;
+		case 4: return zVtxCut_;
+		case 5: return muonQuality_;
+		default: throw std::logic_error( "Not a valid parameter handle" );
+	}
+}
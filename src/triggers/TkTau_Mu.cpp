@@ -2,6 +2,7 @@
 #include "SingleMuEta.h"
 #include "SingleTkTauEta.h"
 #include "../implementation/RegisterTriggerMacro.h"
+#include "CloneableTrigger.h"
 
 namespace l1menu
 {
@@ -18,7 +19,7 @@ namespace l1menu
 		 * CrossTrigger by Mark Grimes (mark.grimes@bristol.ac.uk).
 		 * @date 03/Jun/2013
 		 */
-		class TkTau_Mu_v0 : public l1menu::triggers::CrossTrigger
+		class TkTau_Mu_v0 : public CloneableTrigger<TkTau_Mu_v0,l1menu::triggers::CrossTrigger>
 		{
 		public:
 			TkTau_Mu_v0();
@@ -29,7 +30,7 @@ namespace l1menu
                 /*  A second version where the muon is the primary leg (satisfies leg1threshold)
 		*   Allows easier comparison with trigger without tracking
 		*/
-		class TkTau_Mu_v1 : public l1menu::triggers::CrossTrigger
+		class TkTau_Mu_v1 : public CloneableTrigger<TkTau_Mu_v1,l1menu::triggers::CrossTrigger>
 		{
 		public:
 			TkTau_Mu_v1();
@@ -62,7 +63,7 @@ namespace l1menu
 
 
 l1menu::triggers::TkTau_Mu_v0::TkTau_Mu_v0()
-	: CrossTrigger( new l1menu::triggers::SingleTkTauEta_v0, new l1menu::triggers::SingleMuEta_v0 )
+	: CloneableTrigger( new l1menu::triggers::SingleTkTauEta_v0, new l1menu::triggers::SingleMuEta_v0 )
 {
 	// No operation besides passing the sub-triggers onto the base class
 }
@@ -78,7 +79,7 @@ unsigned int l1menu::triggers::TkTau_Mu_v0::version() const
 }
 
 l1menu::triggers::TkTau_Mu_v1::TkTau_Mu_v1()
-	: CrossTrigger(  new l1menu::triggers::SingleMuEta_v0, new l1menu::triggers::SingleTkTauEta_v0 )
+	: CloneableTrigger(  new l1menu::triggers::SingleMuEta_v0, new l1menu::triggers::SingleTkTauEta_v0 )
 {
 	// No operation besides passing the sub-triggers onto the base class
 }
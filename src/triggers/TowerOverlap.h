@@ -0,0 +1,64 @@
+#ifndef l1menu_triggers_TowerOverlap_h
+#define l1menu_triggers_TowerOverlap_h
+
+#include <vector>
+#include "l1menu/L1TriggerDPGEvent.h"
+
+namespace l1menu
+{
+	namespace triggers
+	{
+		/** @brief Whether there is a leg 1 object passing its cuts and a leg 2 object above threshold that isn't in the same tower.
+		 *
+		 * Gives exactly the same result as the nested loop the cross triggers used to have, i.e.
+		 * @code
+		 * for( const auto& leg1 : leg1Collection )
+		 * {
+		 *     if( !leg1Passes(leg1) ) continue;
+		 *     for( const auto& leg2 : leg2Collection )
+		 *     {
+		 *         if( leg2.symmetricRegion<leg2RegionCut ) continue;
+		 *         float pt=leg2.et;
+		 *         if( pt>=leg2Threshold && !(leg2.eta==leg1.eta && leg2.phi==leg1.phi) ) return true;
+		 *     }
+		 * }
+		 * return false;
+		 * @endcode
+		 * The leg 2 objects are taken from L1TriggerDPGEvent::sortedObjects though, highest Et first. So
+		 * for each leg 1 object it's normally enough to check that the leading leg 2 object isn't in the
+		 * same tower. The next leading object only needs checking if it is, and so on.
+		 *
+		 * @param[in] event          The event the collections came from.
+		 * @param[in] leg1Collection One of the collections in event.prefilteredObjects().
+		 * @param[in] leg1Passes     Callable with signature bool(const L1Object&), the threshold and other cuts for leg 1.
+		 * @param[in] leg2Collection One of the collections in event.prefilteredObjects().
+		 * @param[in] leg2RegionCut  Region cut for leg 2 objects.
+		 * @param[in] leg2Threshold  Et threshold for leg 2 objects.
+		 */
+		template<class T_Leg1Cuts>
+		bool nonOverlappingPairExists( const l1menu::L1TriggerDPGEvent& event, const std::vector<l1menu::L1TriggerDPGEvent::L1Object>& leg1Collection,
+				T_Leg1Cuts leg1Passes, const std::vector<l1menu::L1TriggerDPGEvent::L1Object>& leg2Collection, float leg2RegionCut, float leg2Threshold )
+		{
+			const std::vector<float>& leg2Et=event.sortedEt( leg2Collection, leg2RegionCut );
+			// If the leading leg 2 object is below threshold then nothing can pass
+			if( leg2Et.empty() || !(leg2Et.front()>=leg2Threshold) ) return false;
+			const std::vector<const l1menu::L1TriggerDPGEvent::L1Object*>& leg2Objects=event.sortedObjects( leg2Collection, leg2RegionCut );
+
+			for( const auto& leg1 : leg1Collection )
+			{
+				if( !leg1Passes(leg1) ) continue;
+
+				for( size_t index=0; index<leg2Objects.size() && leg2Et[index]>=leg2Threshold; ++index )
+				{
+					if( !leg2Objects[index]->inSameTower(leg1) ) return true;
+				}
+			}
+
+			return false;
+		}
+
+	} // end of namespace triggers
+
+} // end of namespace l1menu
+
+#endif
@@ -0,0 +1,349 @@
+#ifndef l1menu_triggers_TriggerFamilies_h
+#define l1menu_triggers_TriggerFamilies_h
+
+#include <string>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <stdexcept>
+#include "l1menu/ITrigger.h"
+#include "l1menu/L1TriggerDPGEvent.h"
+#include "l1menu/tools/vectorisedKernels.h"
+#include "SingleObjectTrigger.h"
+#include "VertexMatchedPair.h"
+#include "CloneableTrigger.h"
+
+/** @file
+ *
+ * Templates for the families of triggers that only differ in which collection they look at, which
+ * cuts they apply and what the trigger and its parameters are called. A new version of one of these
+ * is a typedef, e.g.
+ * @code
+ * typedef SingleObjectFamily<SingleEGEtaDefinition,0,collections::EGamma,cuts::Region> SingleEGEta_v0;
+ * REGISTER_TRIGGER( SingleEGEta_v0 )
+ * @endcode
+ * Everything is known at compile time so the cuts are inlined into apply, rather than going through
+ * virtual functions or looking up parameters by name. The families derive from CloneableTrigger, so
+ * clone() is the copy constructor of the final type.
+ *
+ * The "definition" template parameter gives the trigger name and its parameters, all versions of a
+ * trigger should use the same one. It needs to look like
+ * @code
+ * struct SingleEGEtaDefinition
+ * {
+ *     static constexpr const char* name="L1_SingleEG";
+ *     static constexpr TriggerParameter parameters[]={ {"threshold1",20}, {"regionCut",4.5} };
+ * };
+ * @endcode
+ * and, until C++17, the two members also need definitions in one of the source files. Each family
+ * says which parameters it expects in which position.
+ */
+
+namespace l1menu
+{
+	namespace triggers
+	{
+		/** @brief The name and default value of a trigger parameter, see ParameterisedTrigger. */
+		struct TriggerParameter
+		{
+			const char* name;
+			float defaultValue;
+		};
+
+		/** @brief Implements the name and parameter methods of ITrigger from a definition struct.
+		 *
+		 * T_Definition needs a static "name" and static array "parameters" of TriggerParameter. Parameter
+		 * handles are the indices in that array. The values are kept in parameters_ for subclasses to use.
+		 */
+		template<class T_Definition, class T_Base=l1menu::ITrigger>
+		class ParameterisedTrigger : public T_Base
+		{
+		public:
+			typedef typename T_Base::ParameterHandle ParameterHandle;
+			static const size_t numberOfParameters=sizeof(T_Definition::parameters)/sizeof(TriggerParameter);
+
+			ParameterisedTrigger()
+			{
+				for( size_t index=0; index<numberOfParameters; ++index ) parameters_[index]=T_Definition::parameters[index].defaultValue;
+			}
+
+			virtual const std::string name() const { return T_Definition::name; }
+
+			virtual const std::vector<std::string> parameterNames() const
+			{
+				std::vector<std::string> returnValue;
+				for( const auto& parameter : T_Definition::parameters ) returnValue.push_back( parameter.name );
+				return returnValue;
+			}
+
+			virtual float& parameter( const std::string& parameterName ) { return parameters_[handleFromName(parameterName)]; }
+			virtual const float& parameter( const std::string& parameterName ) const { return parameters_[handleFromName(parameterName)]; }
+
+			virtual float& parameter( ParameterHandle handle )
+			{
+				if( handle>=numberOfParameters ) throw std::logic_error( "Not a valid parameter handle" );
+				return parameters_[handle];
+			}
+
+			virtual const float& parameter( ParameterHandle handle ) const
+			{
+				if( handle>=numberOfParameters ) throw std::logic_error( "Not a valid parameter handle" );
+				return parameters_[handle];
+			}
+		protected:
+			float parameters_[numberOfParameters];
+		private:
+			static size_t handleFromName( const std::string& parameterName )
+			{
+				for( size_t index=0; index<numberOfParameters; ++index )
+				{
+					if( parameterName==T_Definition::parameters[index].name ) return index;
+				}
+				throw std::logic_error( "Not a valid parameter name" );
+			}
+		};
+
+		/** @brief Collection accessors for the family templates.
+		 *
+		 * Each one gives the objects() and columns() of one of the collections in
+		 * L1TriggerDPGEvent::PrefilteredObjects. */
+		namespace collections
+		{
+#define L1MENU_DEFINE_COLLECTION_ACCESSOR( NAME, OBJECTS, COLUMNS ) struct NAME \
+			{ \
+				static const std::vector<l1menu::L1TriggerDPGEvent::L1Object>& objects( const l1menu::L1TriggerDPGEvent::PrefilteredObjects& prefiltered ) { return prefiltered.OBJECTS; } \
+				static const l1menu::L1TriggerDPGEvent::ObjectColumns& columns( const l1menu::L1TriggerDPGEvent::PrefilteredObjects& prefiltered ) { return prefiltered.COLUMNS; } \
+			};
+
+			L1MENU_DEFINE_COLLECTION_ACCESSOR( CentralJets, centralJets, centralJetColumns )
+			L1MENU_DEFINE_COLLECTION_ACCESSOR( TauJets, tauJets, tauJetColumns )
+			L1MENU_DEFINE_COLLECTION_ACCESSOR( EGamma, egamma, egammaColumns )
+			L1MENU_DEFINE_COLLECTION_ACCESSOR( Muons, muons, muonColumns )
+			L1MENU_DEFINE_COLLECTION_ACCESSOR( TrackElectrons, trackElectrons, trackElectronColumns )
+			L1MENU_DEFINE_COLLECTION_ACCESSOR( TrackElectrons2, trackElectrons2, trackElectron2Columns )
+			L1MENU_DEFINE_COLLECTION_ACCESSOR( TrackEM, trackEM, trackEMColumns )
+			L1MENU_DEFINE_COLLECTION_ACCESSOR( TrackJets, trackJets, trackJetColumns )
+			L1MENU_DEFINE_COLLECTION_ACCESSOR( TrackTaus, trackTaus, trackTauColumns )
+			L1MENU_DEFINE_COLLECTION_ACCESSOR( TrackMuons, trackMuons, trackMuonColumns )
+
+#undef L1MENU_DEFINE_COLLECTION_ACCESSOR
+		} // end of namespace collections
+
+		/** @brief Cut policies for the family templates.
+		 *
+		 * Each one says how many trigger parameters it uses, and is given a pointer to the first of those.
+		 * columnCut() is the cut for the l1menu::tools kernels and passes() is the same cut on a
+		 * single object. Cuts pass if "value<cut" or "value>cut" is false, which is how the triggers have
+		 * always been written and what the kernels do, so a NaN passes either way. Upper limits compare the
+		 * same float values that are in the columns. */
+		namespace cuts
+		{
+			/** @brief Cut on L1Object::symmetricRegion, the parameter is normally called "regionCut". */
+			struct Region
+			{
+				static const size_t numberOfParameters=1;
+				static l1menu::tools::ColumnCut columnCut( const l1menu::L1TriggerDPGEvent::ObjectColumns& columns, const float* parameter )
+				{
+					return { columns.symmetricRegion.data(), parameter[0], std::numeric_limits<float>::infinity() };
+				}
+				static bool passes( const l1menu::L1TriggerDPGEvent::L1Object& object, const float* parameter ) { return !(object.symmetricRegion<parameter[0]); }
+			};
+
+			/** @brief Requires the isolation flag, so doesn't have a parameter. */
+			struct Isolated
+			{
+				static const size_t numberOfParameters=0;
+				static l1menu::tools::ColumnCut columnCut( const l1menu::L1TriggerDPGEvent::ObjectColumns& columns, const float* )
+				{
+					return { columns.isolated.data(), 1, std::numeric_limits<float>::infinity() };
+				}
+				static bool passes( const l1menu::L1TriggerDPGEvent::L1Object& object, const float* ) { return object.isolated; }
+			};
+
+			/** @brief Minimum muon quality, the parameter is normally called "muonQuality". */
+			struct MuonQuality
+			{
+				static const size_t numberOfParameters=1;
+				static l1menu::tools::ColumnCut columnCut( const l1menu::L1TriggerDPGEvent::ObjectColumns& columns, const float* parameter )
+				{
+					return { columns.quality.data(), parameter[0], std::numeric_limits<float>::infinity() };
+				}
+				static bool passes( const l1menu::L1TriggerDPGEvent::L1Object& object, const float* parameter ) { return !(object.quality<parameter[0]); }
+			};
+
+			/** @brief Maximum |eta|, the parameter is normally called "etaCut". */
+			struct AbsoluteEta
+			{
+				static const size_t numberOfParameters=1;
+				static l1menu::tools::ColumnCut columnCut( const l1menu::L1TriggerDPGEvent::ObjectColumns& columns, const float* parameter )
+				{
+					return { columns.absoluteEta.data(), -std::numeric_limits<float>::infinity(), parameter[0] };
+				}
+				static bool passes( const l1menu::L1TriggerDPGEvent::L1Object& object, const float* parameter ) { float eta=object.eta; return !(std::fabs(eta)>parameter[0]); }
+			};
+
+			/** @brief Maximum track isolation, the parameter is normally called "trkIsolCut". */
+			struct TrackIsolation
+			{
+				static const size_t numberOfParameters=1;
+				static l1menu::tools::ColumnCut columnCut( const l1menu::L1TriggerDPGEvent::ObjectColumns& columns, const float* parameter )
+				{
+					return { columns.trackIsolation.data(), -std::numeric_limits<float>::infinity(), parameter[0] };
+				}
+				static bool passes( const l1menu::L1TriggerDPGEvent::L1Object& object, const float* parameter ) { return !(float(object.trackIsolation)>parameter[0]); }
+			};
+		} // end of namespace cuts
+
+		/** @brief Applies a list of cut policies, with their parameters taken in order starting at T_firstParameter. */
+		template<size_t T_firstParameter, class... T_Cuts>
+		struct CutList
+		{
+			static const size_t endParameter=T_firstParameter;
+			static void columnCuts( const l1menu::L1TriggerDPGEvent::ObjectColumns&, const float*, l1menu::tools::ColumnCut* ) {}
+			static bool passes( const l1menu::L1TriggerDPGEvent::L1Object&, const float* ) { return true; }
+		};
+
+		template<size_t T_firstParameter, class T_Cut, class... T_OtherCuts>
+		struct CutList<T_firstParameter,T_Cut,T_OtherCuts...>
+		{
+			typedef CutList<T_firstParameter+T_Cut::numberOfParameters,T_OtherCuts...> OtherCuts;
+			static const size_t endParameter=OtherCuts::endParameter;
+
+			static void columnCuts( const l1menu::L1TriggerDPGEvent::ObjectColumns& columns, const float* parameters, l1menu::tools::ColumnCut* output )
+			{
+				output[0]=T_Cut::columnCut( columns, parameters+T_firstParameter );
+				OtherCuts::columnCuts( columns, parameters, output+1 );
+			}
+
+			static bool passes( const l1menu::L1TriggerDPGEvent::L1Object& object, const float* parameters )
+			{
+				return T_Cut::passes( object, parameters+T_firstParameter ) && OtherCuts::passes( object, parameters );
+			}
+		};
+
+		/** @brief Passes if any single object in the collection is above threshold and passes all of the cuts.
+		 *
+		 * The first parameter is the threshold, followed by the parameters for each of the cuts in order.
+		 * The definition can have more parameters after those, which are left unused.
+		 */
+		template<class T_Definition, unsigned int T_version, class T_Collection, class... T_Cuts>
+		class SingleObjectFamily : public CloneableTrigger<SingleObjectFamily<T_Definition,T_version,T_Collection,T_Cuts...>,ParameterisedTrigger<T_Definition,l1menu::triggers::SingleObjectTrigger> >
+		{
+			typedef ParameterisedTrigger<T_Definition,l1menu::triggers::SingleObjectTrigger> Base;
+			typedef CutList<1,T_Cuts...> Cuts;
+			static_assert( Cuts::endParameter<=Base::numberOfParameters, "The trigger definition doesn't have enough parameters for the cuts" );
+		public:
+			virtual unsigned int version() const { return T_version; }
+			virtual bool thresholdsAreCorrelated() const { return false; }
+			virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const
+			{
+				const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+				if( !objects.zeroBias ) return false;
+
+				const l1menu::L1TriggerDPGEvent::ObjectColumns& columns=T_Collection::columns( objects );
+				l1menu::tools::ColumnCut columnCuts[sizeof...(T_Cuts)+1];
+				Cuts::columnCuts( columns, this->parameters_, columnCuts );
+				return l1menu::tools::anyValuePassing( columns.et.data(), columns.et.size(), this->parameters_[0], columnCuts, sizeof...(T_Cuts) );
+			}
+
+			virtual float highestPassingEt( const l1menu::L1TriggerDPGEvent& event ) const
+			{
+				const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+				if( !objects.zeroBias ) return -std::numeric_limits<float>::infinity();
+
+				const l1menu::L1TriggerDPGEvent::ObjectColumns& columns=T_Collection::columns( objects );
+				// One extra so that the array isn't zero sized if there are no cuts
+				l1menu::tools::ColumnCut columnCuts[sizeof...(T_Cuts)+1];
+				Cuts::columnCuts( columns, this->parameters_, columnCuts );
+				return l1menu::tools::highestPassingValue( columns.et.data(), columns.et.size(), columnCuts, sizeof...(T_Cuts) );
+			}
+		};
+
+		/** @brief Passes if the T_numberOfObjects leading objects passing the region cut are each above their own threshold.
+		 *
+		 * The first T_numberOfObjects parameters are the thresholds, highest Et object first, followed by
+		 * the region cut.
+		 */
+		template<class T_Definition, unsigned int T_version, class T_Collection, size_t T_numberOfObjects>
+		class LeadingObjectsFamily : public CloneableTrigger<LeadingObjectsFamily<T_Definition,T_version,T_Collection,T_numberOfObjects>,ParameterisedTrigger<T_Definition> >
+		{
+			typedef ParameterisedTrigger<T_Definition> Base;
+			static const size_t regionCutHandle=T_numberOfObjects;
+			static_assert( regionCutHandle<Base::numberOfParameters, "The trigger definition doesn't have enough parameters for the thresholds and region cut" );
+		public:
+			virtual unsigned int version() const { return T_version; }
+			virtual bool thresholdsAreCorrelated() const { return true; }
+
+			virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const
+			{
+				const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+				if( !objects.zeroBias ) return false;
+
+				const std::vector<float>& et=event.sortedEt( T_Collection::objects(objects), this->parameters_[regionCutHandle] );
+				if( et.size()<T_numberOfObjects ) return false;
+				for( size_t index=0; index<T_numberOfObjects; ++index )
+				{
+					if( !(et[index]>=this->parameters_[index]) ) return false;
+				}
+				return true;
+			}
+
+			using Base::applyBatch;
+			/** @brief Scanning one of the thresholds only needs the sorted Et list once, rather than the bisection in ITrigger. */
+			virtual void applyBatch( const l1menu::L1TriggerDPGEvent& event, l1menu::ITrigger::ParameterHandle thresholdHandle, const std::vector<float>& values, std::vector<bool>& passed )
+			{
+				// Changing the region cut changes the list, so leave that to the generic implementation
+				if( thresholdHandle>=T_numberOfObjects ) return Base::applyBatch( event, thresholdHandle, values, passed );
+
+				passed.assign( values.size(), false );
+				const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+				if( !objects.zeroBias ) return;
+
+				const std::vector<float>& et=event.sortedEt( T_Collection::objects(objects), this->parameters_[regionCutHandle] );
+				if( et.size()<T_numberOfObjects ) return;
+				for( size_t index=0; index<T_numberOfObjects; ++index )
+				{
+					if( index!=thresholdHandle && !(et[index]>=this->parameters_[index]) ) return;
+				}
+
+				const float scannedEt=et[thresholdHandle];
+				for( size_t index=0; index<values.size(); ++index ) passed[index]=( scannedEt>=values[index] );
+			}
+		};
+
+		/** @brief Passes if there is a pair of different objects, one from each collection, that pass their thresholds and are within the z vertex cut.
+		 *
+		 * The parameters are the leg 1 threshold, the leg 2 threshold, then the parameters for each of the cuts
+		 * (applied to both legs) in order, then the maximum z separation. The two collections can be the same.
+		 * Uses vertexMatchedPairExists so only the objects close in z get compared.
+		 */
+		template<class T_Definition, unsigned int T_version, class T_Leg1Collection, class T_Leg2Collection, class... T_Cuts>
+		class VertexMatchedPairFamily : public CloneableTrigger<VertexMatchedPairFamily<T_Definition,T_version,T_Leg1Collection,T_Leg2Collection,T_Cuts...>,ParameterisedTrigger<T_Definition> >
+		{
+			typedef ParameterisedTrigger<T_Definition> Base;
+			typedef CutList<2,T_Cuts...> Cuts;
+			static const size_t zVtxCutHandle=Cuts::endParameter;
+			static_assert( zVtxCutHandle<Base::numberOfParameters, "The trigger definition doesn't have enough parameters for the cuts and z vertex cut" );
+		public:
+			virtual unsigned int version() const { return T_version; }
+			virtual bool thresholdsAreCorrelated() const { return true; }
+
+			virtual bool apply( const l1menu::L1TriggerDPGEvent& event ) const
+			{
+				const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+				if( !objects.zeroBias ) return false;
+
+				const float* parameters=this->parameters_;
+				return l1menu::triggers::vertexMatchedPairExists( event, T_Leg1Collection::objects(objects), T_Leg2Collection::objects(objects),
+						[parameters]( const l1menu::L1TriggerDPGEvent::L1Object& leg1 ){ return Cuts::passes(leg1,parameters) && float(leg1.et)>=parameters[0]; },
+						[parameters]( const l1menu::L1TriggerDPGEvent::L1Object& leg1, const l1menu::L1TriggerDPGEvent::L1Object& leg2 )
+							{ return &leg2!=&leg1 && Cuts::passes(leg2,parameters) && float(leg2.et)>=parameters[1]; },
+						parameters[zVtxCutHandle] );
+			}
+		};
+
+	} // end of namespace triggers
+
+} // end of namespace l1menu
+
+#endif
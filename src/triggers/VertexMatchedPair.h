@@ -0,0 +1,93 @@
+#ifndef l1menu_triggers_VertexMatchedPair_h
+#define l1menu_triggers_VertexMatchedPair_h
+
+#include <vector>
+#include <cmath>
+#include "l1menu/L1TriggerDPGEvent.h"
+
+namespace l1menu
+{
+	namespace triggers
+	{
+		/** @brief Whether there is a pair of objects that pass their cuts and have "std::fabs(leg1 zVtx-leg2 zVtx)<zVtxCut".
+		 *
+		 * Gives exactly the same result as the nested loop the track pair triggers used to have, i.e.
+		 * @code
+		 * for( const auto& leg1 : leg1Collection )
+		 * {
+		 *     if( !leg1Passes(leg1) ) continue;
+		 *     float leg1Zvtx=leg1.zVtx;
+		 *     for( const auto& leg2 : leg2Collection )
+		 *     {
+		 *         if( std::fabs(leg1Zvtx-leg2.zVtx)<zVtxCut && leg2Passes(leg1,leg2) ) return true;
+		 *     }
+		 * }
+		 * return false;
+		 * @endcode
+		 * but both collections are looked at in order of z (see L1TriggerDPGEvent::zVertexOrder), so that
+		 * only the leg2 objects inside the z window of each leg1 object are tested. The window slides
+		 * forward as the leg1 objects are stepped through.
+		 *
+		 * Objects with a NaN zVtx never match anything, the same as in the loop above, and the sweep stops
+		 * when it gets to them.
+		 *
+		 * If both legs are from the same collection, leg2Passes needs to check that the two objects aren't
+		 * the same one (comparing addresses is enough).
+		 *
+		 * @param[in] event           The event the collections came from.
+		 * @param[in] leg1Collection  One of the collections in event.prefilteredObjects().
+		 * @param[in] leg2Collection  One of the collections in event.prefilteredObjects(), can be the same as leg1Collection.
+		 * @param[in] leg1Passes      Callable with signature bool(const L1Object&), the threshold and other cuts for leg 1.
+		 * @param[in] leg2Passes      Callable with signature bool(const L1Object& leg1,const L1Object& leg2), the cuts for leg 2.
+		 * @param[in] zVtxCut         The maximum separation in z.
+		 */
+		template<class T_Leg1Cuts, class T_Leg2Cuts>
+		bool vertexMatchedPairExists( const l1menu::L1TriggerDPGEvent& event, const std::vector<l1menu::L1TriggerDPGEvent::L1Object>& leg1Collection,
+				const std::vector<l1menu::L1TriggerDPGEvent::L1Object>& leg2Collection, T_Leg1Cuts leg1Passes, T_Leg2Cuts leg2Passes, float zVtxCut )
+		{
+			const std::vector<size_t>& leg1Order=event.zVertexOrder( leg1Collection );
+			const std::vector<size_t>& leg2Order=event.zVertexOrder( leg2Collection );
+
+			// The window of leg 2 objects to check is [windowStart,windowEnd) in leg2Order. The z
+			// separation is monotonic in the leg 2 z (floating point rounding can't change the order)
+			// so the objects inside the cut are always a contiguous range in z order. Both ends of
+			// the window only ever move forward because the leg 1 z values are increasing.
+			size_t windowStart=0;
+			size_t windowEnd=0;
+
+			for( const size_t leg1Index : leg1Order )
+			{
+				const l1menu::L1TriggerDPGEvent::L1Object& leg1=leg1Collection[leg1Index];
+				// NaNs are sorted to the end and can't be within zVtxCut of anything, so there's
+				// nothing left to find. This also keeps leg1Zvtx a number for the window below.
+				if( std::isnan(leg1.zVtx) ) break;
+				if( !leg1Passes(leg1) ) continue;
+				// Keep this as a float to give the same rounding as the original implementation
+				const float leg1Zvtx=leg1.zVtx;
+
+				// Anything below leg1Zvtx that is out of range can never be in range for later, higher, leg 1 objects
+				while( windowStart<leg2Order.size() && leg2Collection[leg2Order[windowStart]].zVtx<leg1Zvtx
+						&& !( std::fabs(leg1Zvtx-leg2Collection[leg2Order[windowStart]].zVtx)<zVtxCut ) ) ++windowStart;
+				if( windowEnd<windowStart ) windowEnd=windowStart;
+				// Extend the end until the first object above leg1Zvtx that is out of range, or the
+				// first NaN since those are all at the end.
+				while( windowEnd<leg2Order.size() && ( leg2Collection[leg2Order[windowEnd]].zVtx<=leg1Zvtx
+						|| std::fabs(leg1Zvtx-leg2Collection[leg2Order[windowEnd]].zVtx)<zVtxCut ) ) ++windowEnd;
+
+				for( size_t position=windowStart; position<windowEnd; ++position )
+				{
+					const l1menu::L1TriggerDPGEvent::L1Object& leg2=leg2Collection[leg2Order[position]];
+					// Still need to check the cut because the window can include a few out of range
+					// objects that are close to leg1Zvtx, e.g. if zVtxCut is zero.
+					if( std::fabs(leg1Zvtx-leg2.zVtx)<zVtxCut && leg2Passes(leg1,leg2) ) return true;
+				}
+			}
+
+			return false;
+		}
+
+	} // end of namespace triggers
+
+} // end of namespace l1menu
+
+#endif
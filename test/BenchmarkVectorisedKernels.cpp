@@ -0,0 +1,157 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include "l1menu/L1TriggerDPGEvent.h"
+#include "l1menu/tools/vectorisedKernels.h"
+
+/** @file
+ * Times the single object trigger kernels for the different instruction sets, and compares them to
+ * the loop over l1menu::L1TriggerDPGEvent::L1Object that the triggers used before. The collections
+ * are random but sized like the ones in PU140 samples, where the track collections have a few tens
+ * of objects per event and the calorimeter collections a little over ten.
+ *
+ * The "dispatched" column is l1menu::tools::anyValuePassing without an instruction set, which is
+ * exactly what the triggers' apply methods call, so includes the cost of choosing the instruction set.
+ */
+
+namespace
+{
+	/** @brief A set of events for one collection, stored both ways. */
+	struct BenchmarkCollection
+	{
+		std::vector< std::vector<l1menu::L1TriggerDPGEvent::L1Object> > objects;
+		std::vector<l1menu::L1TriggerDPGEvent::ObjectColumns> columns;
+	};
+
+	BenchmarkCollection createCollection( size_t numberOfEvents, size_t objectsPerEvent, std::mt19937& randomGenerator )
+	{
+		std::exponential_distribution<double> etDistribution( 1/15.0 );
+		std::uniform_int_distribution<int> etaDistribution( 0, 21 );
+		std::uniform_int_distribution<int> isolationDistribution( 0, 1 );
+		// Vary the number of objects a bit around the mean
+		std::poisson_distribution<size_t> sizeDistribution( objectsPerEvent );
+
+		BenchmarkCollection collection;
+		for( size_t eventNumber=0; eventNumber<numberOfEvents; ++eventNumber )
+		{
+			std::vector<l1menu::L1TriggerDPGEvent::L1Object> objects( sizeDistribution(randomGenerator) );
+			l1menu::L1TriggerDPGEvent::ObjectColumns columns;
+			for( auto& object : objects )
+			{
+				object.et=std::floor( etDistribution(randomGenerator)*2 )/2;
+				object.eta=etaDistribution(randomGenerator);
+				object.symmetricRegion=std::min( object.eta, 21-object.eta );
+				object.isolated=isolationDistribution(randomGenerator);
+				columns.et.push_back( object.et );
+				columns.symmetricRegion.push_back( object.symmetricRegion );
+				columns.isolated.push_back( object.isolated ? 1 : 0 );
+			}
+			collection.objects.push_back( objects );
+			collection.columns.push_back( columns );
+		}
+		return collection;
+	}
+
+	/** @brief Returns the time per event in nanoseconds, and the number of passing events in "passed" to make sure the work isn't optimised away. */
+	template<class T_Function>
+	double timePerEvent( size_t numberOfEvents, size_t repeats, T_Function function, size_t& passed )
+	{
+		passed=0;
+		auto start=std::chrono::steady_clock::now();
+		for( size_t repeat=0; repeat<repeats; ++repeat )
+		{
+			for( size_t eventNumber=0; eventNumber<numberOfEvents; ++eventNumber ) passed+=function(eventNumber);
+		}
+		auto end=std::chrono::steady_clock::now();
+		return std::chrono::duration<double,std::nano>( end-start ).count()/( numberOfEvents*repeats );
+	}
+}
+
+int main()
+{
+	const size_t numberOfEvents=10000;
+	const size_t repeats=50;
+	const float threshold=30;
+	const float regionCut=4.5;
+	const float infinity=std::numeric_limits<float>::infinity();
+
+	std::mt19937 randomGenerator( 42 );
+
+	std::cout << "Best instruction set available: ";
+	switch( l1menu::tools::bestInstructionSet() )
+	{
+		case l1menu::tools::InstructionSet::AVX2 : std::cout << "AVX2" << std::endl; break;
+		case l1menu::tools::InstructionSet::SSE4 : std::cout << "SSE4" << std::endl; break;
+		default : std::cout << "none (scalar)" << std::endl;
+	}
+	std::cout << "Time per event in ns for an isolated, region cut, single object trigger:" << "\n"
+			<< std::setw(10) << "objects" << std::setw(12) << "old loop" << std::setw(12) << "scalar"
+			<< std::setw(12) << "SSE4" << std::setw(12) << "AVX2" << std::setw(12) << "dispatched" << std::setw(12) << "speed-up" << std::endl;
+
+	for( size_t objectsPerEvent : { 4, 12, 30, 60 } )
+	{
+		BenchmarkCollection collection=createCollection( numberOfEvents, objectsPerEvent, randomGenerator );
+
+		// This is how SingleIsoEGEta_v0 etcetera used to loop over the objects
+		size_t oldPassed;
+		double oldTime=timePerEvent( numberOfEvents, repeats, [&]( size_t eventNumber )->bool
+			{
+				for( const auto& object : collection.objects[eventNumber] )
+				{
+					if( !object.isolated ) continue;
+					if( object.symmetricRegion<regionCut ) continue;
+					float pt=object.et;
+					if( pt>=threshold ) return true;
+				}
+				return false;
+			}, oldPassed );
+
+		std::cout << std::setw(10) << objectsPerEvent << std::setw(12) << std::fixed << std::setprecision(1) << oldTime;
+
+		for( const auto instructionSet : { l1menu::tools::InstructionSet::Scalar, l1menu::tools::InstructionSet::SSE4, l1menu::tools::InstructionSet::AVX2 } )
+		{
+			if( !l1menu::tools::instructionSetIsAvailable( instructionSet ) )
+			{
+				std::cout << std::setw(12) << "n/a";
+				continue;
+			}
+
+			size_t kernelPassed;
+			double kernelTime=timePerEvent( numberOfEvents, repeats, [&]( size_t eventNumber )->bool
+				{
+					const l1menu::L1TriggerDPGEvent::ObjectColumns& columns=collection.columns[eventNumber];
+					const l1menu::tools::ColumnCut cuts[]={ {columns.isolated.data(),1,infinity}, {columns.symmetricRegion.data(),regionCut,infinity} };
+					return l1menu::tools::anyValuePassing( columns.et.data(), columns.et.size(), threshold, cuts, 2, instructionSet );
+				}, kernelPassed );
+
+			if( kernelPassed!=oldPassed )
+			{
+				std::cerr << "\nThe kernel gave a different result to the old loop" << std::endl;
+				return -1;
+			}
+			std::cout << std::setw(12) << kernelTime;
+		}
+
+		size_t dispatchedPassed;
+		double dispatchedTime=timePerEvent( numberOfEvents, repeats, [&]( size_t eventNumber )->bool
+			{
+				const l1menu::L1TriggerDPGEvent::ObjectColumns& columns=collection.columns[eventNumber];
+				const l1menu::tools::ColumnCut cuts[]={ {columns.isolated.data(),1,infinity}, {columns.symmetricRegion.data(),regionCut,infinity} };
+				return l1menu::tools::anyValuePassing( columns.et.data(), columns.et.size(), threshold, cuts, 2 );
+			}, dispatchedPassed );
+		if( dispatchedPassed!=oldPassed )
+		{
+			std::cerr << "\nThe dispatched kernel gave a different result to the old loop" << std::endl;
+			return -1;
+		}
+		std::cout << std::setw(12) << dispatchedTime << std::setw(11) << oldTime/dispatchedTime << "x" << std::endl;
+	}
+
+	return 0;
+}
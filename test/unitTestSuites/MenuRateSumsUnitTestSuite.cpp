@@ -0,0 +1,304 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include "l1menu/TriggerMenu.h"
+
+//
+// Forward definitions
+//
+namespace l1menu
+{
+	class ISample;
+}
+
+/** @brief A cppunit TestFixture to test MenuRateSums objects.
+ */
+class MenuRateSumsUnitTestSuite : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE(MenuRateSumsUnitTestSuite);
+	CPPUNIT_TEST(testCopyAndMove);
+	CPPUNIT_TEST(testSampleRanges);
+	CPPUNIT_TEST(testOverlaps);
+	CPPUNIT_TEST(testLumiSectionSums);
+	CPPUNIT_TEST(testLuminosityBins);
+	CPPUNIT_TEST(testBootstrapErrors);
+	CPPUNIT_TEST_SUITE_END();
+
+protected:
+	std::ostream* pVerboseOutput_;
+	std::unique_ptr<l1menu::ISample> pSample_;
+	std::unique_ptr<l1menu::TriggerMenu> pTriggerMenu_;
+public:
+	MenuRateSumsUnitTestSuite();
+	void setUp();
+
+protected:
+	void testCopyAndMove();
+	void testSampleRanges();
+	void testOverlaps();
+	void testLumiSectionSums();
+	void testLuminosityBins();
+	void testBootstrapErrors();
+};
+
+
+
+
+
+#include <cppunit/config/SourcePrefix.h>
+#include <stdexcept>
+#include <utility>
+#include <sstream>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include "l1menu/ISample.h"
+#include "l1menu/IEvent.h"
+#include "l1menu/ICachedTrigger.h"
+#include "l1menu/IMenuRate.h"
+#include "l1menu/MenuRateSums.h"
+#include "l1menu/SampleRange.h"
+#include "l1menu/tools/fileIO.h"
+#include "TestParameters.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MenuRateSumsUnitTestSuite);
+
+MenuRateSumsUnitTestSuite::MenuRateSumsUnitTestSuite()
+{
+	pVerboseOutput_=nullptr;
+	//pVerboseOutput_=&std::cout;
+}
+
+void MenuRateSumsUnitTestSuite::setUp()
+{
+	std::string inputSampleFilename=TestParameters<std::string>::instance().getParameter( "TEST_SAMPLE_FILENAME" );
+	std::string inputMenuFilename=TestParameters<std::string>::instance().getParameter( "TEST_MENU_FILENAME" );
+
+	// Add a newline, because cppunit starts this function with half a line already written
+	if( pVerboseOutput_!=nullptr ) *pVerboseOutput_ << "\n";
+
+	if( pVerboseOutput_!=nullptr ) *pVerboseOutput_ << "Loading sample from file " << inputSampleFilename << std::endl;
+	CPPUNIT_ASSERT_NO_THROW( pSample_=l1menu::tools::loadSample( inputSampleFilename ) );
+	CPPUNIT_ASSERT_MESSAGE( "Trying to load sample from disk gave a null pointer", pSample_!=nullptr );
+
+	if( pVerboseOutput_!=nullptr ) *pVerboseOutput_ << "Loading menu from file " << inputMenuFilename << std::endl;
+	CPPUNIT_ASSERT_NO_THROW( pTriggerMenu_=l1menu::tools::loadMenu( inputMenuFilename ) );
+	CPPUNIT_ASSERT_MESSAGE( "TriggerMenu supplied needs at least one trigger for the tests", pTriggerMenu_->numberOfTriggers()>=1 );
+}
+
+void MenuRateSumsUnitTestSuite::testCopyAndMove()
+{
+	const l1menu::MenuRateSums sums( *pTriggerMenu_, *pSample_ );
+
+	l1menu::MenuRateSums movedSums( sums );
+	l1menu::MenuRateSums moveDestination( std::move(movedSums) );
+	CPPUNIT_ASSERT_EQUAL( sums.weightOfEventsPassingAnyTrigger(), moveDestination.weightOfEventsPassingAnyTrigger() );
+
+	// Assigning to the moved from instance should make it usable again
+	movedSums=sums;
+	CPPUNIT_ASSERT_EQUAL( sums.numberOfEvents(), movedSums.numberOfEvents() );
+	CPPUNIT_ASSERT_EQUAL( sums.weightOfEventsPassingAnyTrigger(), movedSums.weightOfEventsPassingAnyTrigger() );
+	for( size_t triggerNumber=0; triggerNumber<pTriggerMenu_->numberOfTriggers(); ++triggerNumber )
+	{
+		CPPUNIT_ASSERT_EQUAL( sums.weightOfEventsPassed(triggerNumber), movedSums.weightOfEventsPassed(triggerNumber) );
+	}
+
+	// Move assignment back and forth should leave the original values
+	moveDestination=std::move(movedSums);
+	movedSums=std::move(moveDestination);
+	CPPUNIT_ASSERT_EQUAL( sums.sumOfWeights(), movedSums.sumOfWeights() );
+}
+
+void MenuRateSumsUnitTestSuite::testSampleRanges()
+{
+	// Split the sample so that the second range doesn't start on a block or word boundary. The ranges
+	// added together should give the same as the whole sample, apart from rounding.
+	const size_t splitEvent=37;
+	CPPUNIT_ASSERT_MESSAGE( "The test sample needs more events for this test", pSample_->numberOfEvents()>splitEvent );
+	const l1menu::SampleRange firstRange( *pSample_, 0, splitEvent );
+	const l1menu::SampleRange secondRange( *pSample_, splitEvent, pSample_->numberOfEvents() );
+
+	const l1menu::MenuRateSums wholeSampleSums( *pTriggerMenu_, *pSample_ );
+	l1menu::MenuRateSums rangeSums( *pTriggerMenu_, firstRange );
+	CPPUNIT_ASSERT_EQUAL( splitEvent, rangeSums.numberOfEvents() );
+	rangeSums.add( l1menu::MenuRateSums( *pTriggerMenu_, secondRange ) );
+
+	const double tolerance=1e-9*wholeSampleSums.sumOfWeights();
+	CPPUNIT_ASSERT_EQUAL( wholeSampleSums.numberOfEvents(), rangeSums.numberOfEvents() );
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( wholeSampleSums.sumOfWeights(), rangeSums.sumOfWeights(), tolerance );
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( wholeSampleSums.weightOfEventsPassingAnyTrigger(), rangeSums.weightOfEventsPassingAnyTrigger(), tolerance );
+	for( size_t triggerNumber=0; triggerNumber<pTriggerMenu_->numberOfTriggers(); ++triggerNumber )
+	{
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( wholeSampleSums.weightOfEventsPassed(triggerNumber), rangeSums.weightOfEventsPassed(triggerNumber), tolerance );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( wholeSampleSums.weightOfEventsPure(triggerNumber), rangeSums.weightOfEventsPure(triggerNumber), tolerance );
+		for( size_t otherTriggerNumber=0; otherTriggerNumber<triggerNumber; ++otherTriggerNumber )
+		{
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( wholeSampleSums.weightOfEventsPassedBoth(triggerNumber,otherTriggerNumber), rangeSums.weightOfEventsPassedBoth(triggerNumber,otherTriggerNumber), tolerance );
+		}
+	}
+
+	// The number of threads shouldn't make any difference to a range either
+	const l1menu::MenuRateSums singleThreadSums( *pTriggerMenu_, secondRange, 1 );
+	const l1menu::MenuRateSums multiThreadSums( *pTriggerMenu_, secondRange, 4 );
+	CPPUNIT_ASSERT_EQUAL( singleThreadSums.weightOfEventsPassingAnyTrigger(), multiThreadSums.weightOfEventsPassingAnyTrigger() );
+
+	// Ranges use the event numbers of the underlying sample for the bootstrap, so with the same seed
+	// the replicas of the ranges add up to the replicas of the whole sample.
+	const size_t numberOfReplicas=20;
+	const l1menu::MenuRateSums wholeSampleReplicas=l1menu::MenuRateSums::withBootstrap( *pTriggerMenu_, *pSample_, numberOfReplicas, 7 );
+	l1menu::MenuRateSums rangeReplicas=l1menu::MenuRateSums::withBootstrap( *pTriggerMenu_, firstRange, numberOfReplicas, 7 );
+	rangeReplicas.add( l1menu::MenuRateSums::withBootstrap( *pTriggerMenu_, secondRange, numberOfReplicas, 7 ) );
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( wholeSampleReplicas.bootstrapTotalFractionError(), rangeReplicas.bootstrapTotalFractionError(), 1e-9 );
+}
+
+void MenuRateSumsUnitTestSuite::testOverlaps()
+{
+	const l1menu::MenuRateSums sums( *pTriggerMenu_, *pSample_ );
+	CPPUNIT_ASSERT( sums.hasOverlaps() );
+
+	// Work out the weight passing each pair of triggers with the simplest possible loop over the events
+	const size_t numberOfTriggers=pTriggerMenu_->numberOfTriggers();
+	std::vector< std::unique_ptr<l1menu::ICachedTrigger> > cachedTriggers;
+	for( size_t triggerNumber=0; triggerNumber<numberOfTriggers; ++triggerNumber )
+	{
+		cachedTriggers.push_back( pSample_->createCachedTrigger( pTriggerMenu_->getTrigger(triggerNumber) ) );
+	}
+	std::vector<double> expectedWeights( numberOfTriggers*numberOfTriggers, 0 );
+	std::vector<bool> passed( numberOfTriggers );
+	for( size_t eventNumber=0; eventNumber<pSample_->numberOfEvents(); ++eventNumber )
+	{
+		const l1menu::IEvent& event=pSample_->getEvent(eventNumber);
+		for( size_t triggerNumber=0; triggerNumber<numberOfTriggers; ++triggerNumber ) passed[triggerNumber]=cachedTriggers[triggerNumber]->apply(event);
+		for( size_t firstTriggerNumber=0; firstTriggerNumber<numberOfTriggers; ++firstTriggerNumber )
+		{
+			if( !passed[firstTriggerNumber] ) continue;
+			for( size_t secondTriggerNumber=0; secondTriggerNumber<numberOfTriggers; ++secondTriggerNumber )
+			{
+				if( passed[secondTriggerNumber] ) expectedWeights[firstTriggerNumber*numberOfTriggers+secondTriggerNumber]+=event.weight();
+			}
+		}
+	}
+
+	const double tolerance=1e-9*sums.sumOfWeights();
+	for( size_t firstTriggerNumber=0; firstTriggerNumber<numberOfTriggers; ++firstTriggerNumber )
+	{
+		for( size_t secondTriggerNumber=0; secondTriggerNumber<numberOfTriggers; ++secondTriggerNumber )
+		{
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( expectedWeights[firstTriggerNumber*numberOfTriggers+secondTriggerNumber], sums.weightOfEventsPassedBoth(firstTriggerNumber,secondTriggerNumber), tolerance );
+		}
+	}
+
+	// The overlaps should only be in XML output if they're asked for
+	std::stringstream defaultOutput, overlapsOutput;
+	l1menu::tools::dumpTriggerRates( defaultOutput, *sums.rate(), l1menu::IL1MenuFile::FileFormat::XML );
+	l1menu::tools::dumpTriggerRates( overlapsOutput, *sums.rate(), l1menu::IL1MenuFile::FileFormat::XML, true );
+	CPPUNIT_ASSERT( defaultOutput.str().find("TriggerOverlap")==std::string::npos );
+	if( numberOfTriggers>1 ) CPPUNIT_ASSERT( overlapsOutput.str().find("TriggerOverlap")!=std::string::npos );
+}
+
+void MenuRateSumsUnitTestSuite::testLumiSectionSums()
+{
+	const std::map< std::pair<unsigned int,unsigned int>, l1menu::MenuRateSums > lumiSectionSums=l1menu::MenuRateSums::forEachLumiSection( *pTriggerMenu_, *pSample_ );
+	CPPUNIT_ASSERT( !lumiSectionSums.empty() );
+
+	// Adding all of the lumi sections together should give the same as the whole sample in one go
+	l1menu::MenuRateSums addedSums( lumiSectionSums.begin()->second );
+	for( auto iSums=std::next(lumiSectionSums.begin()); iSums!=lumiSectionSums.end(); ++iSums ) addedSums.add( iSums->second );
+	CPPUNIT_ASSERT( !addedSums.hasOverlaps() );
+
+	const l1menu::MenuRateSums wholeSampleSums( *pTriggerMenu_, *pSample_ );
+	CPPUNIT_ASSERT_EQUAL( wholeSampleSums.numberOfEvents(), addedSums.numberOfEvents() );
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( wholeSampleSums.sumOfWeights(), addedSums.sumOfWeights(), wholeSampleSums.sumOfWeights()*1e-9 );
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( wholeSampleSums.weightOfEventsPassingAnyTrigger(), addedSums.weightOfEventsPassingAnyTrigger(), wholeSampleSums.sumOfWeights()*1e-9 );
+	for( size_t triggerNumber=0; triggerNumber<pTriggerMenu_->numberOfTriggers(); ++triggerNumber )
+	{
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( wholeSampleSums.weightOfEventsPassed(triggerNumber), addedSums.weightOfEventsPassed(triggerNumber), wholeSampleSums.sumOfWeights()*1e-9 );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( wholeSampleSums.weightOfEventsPure(triggerNumber), addedSums.weightOfEventsPure(triggerNumber), wholeSampleSums.sumOfWeights()*1e-9 );
+	}
+	CPPUNIT_ASSERT_THROW( addedSums.weightOfEventsPassedBoth( 0, 1 ), std::runtime_error );
+}
+
+void MenuRateSumsUnitTestSuite::testLuminosityBins()
+{
+	const std::map< std::pair<unsigned int,unsigned int>, l1menu::MenuRateSums > lumiSectionSums=l1menu::MenuRateSums::forEachLumiSection( *pTriggerMenu_, *pSample_ );
+	CPPUNIT_ASSERT( !lumiSectionSums.empty() );
+
+	// Make up luminosities so that the first half of the lumi sections go in the first bin and the rest in the second
+	std::map< std::pair<unsigned int,unsigned int>, float > luminosities;
+	size_t lumiSectionIndex=0;
+	for( const auto& lumiSectionAndSums : lumiSectionSums ) luminosities[lumiSectionAndSums.first]=10.0f*(lumiSectionIndex++)+5;
+	const size_t firstBinSize=(lumiSectionSums.size()+1)/2;
+	const std::vector<float> binEdges={ 0, 10.0f*firstBinSize, 10.0f*(lumiSectionSums.size()+1) };
+
+	std::vector<l1menu::MenuRateSums> binnedSums;
+	CPPUNIT_ASSERT_NO_THROW( binnedSums=l1menu::MenuRateSums::inLuminosityBins( lumiSectionSums, luminosities, binEdges ) );
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(2), binnedSums.size() );
+
+	// Add up each bin by hand to compare
+	size_t expectedFirstBinEvents=0;
+	double expectedFirstBinWeight=0;
+	double expectedFirstBinPassingAny=0;
+	auto iSums=lumiSectionSums.begin();
+	for( size_t index=0; index<firstBinSize; ++index, ++iSums )
+	{
+		expectedFirstBinEvents+=iSums->second.numberOfEvents();
+		expectedFirstBinWeight+=iSums->second.sumOfWeights();
+		expectedFirstBinPassingAny+=iSums->second.weightOfEventsPassingAnyTrigger();
+	}
+	CPPUNIT_ASSERT_EQUAL( expectedFirstBinEvents, binnedSums[0].numberOfEvents() );
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( expectedFirstBinWeight, binnedSums[0].sumOfWeights(), expectedFirstBinWeight*1e-9 );
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( expectedFirstBinPassingAny, binnedSums[0].weightOfEventsPassingAnyTrigger(), expectedFirstBinWeight*1e-9 );
+
+	// Between them the bins should have everything
+	const l1menu::MenuRateSums wholeSampleSums( *pTriggerMenu_, *pSample_ );
+	l1menu::MenuRateSums addedSums( binnedSums[0] );
+	addedSums.add( binnedSums[1] );
+	CPPUNIT_ASSERT_EQUAL( wholeSampleSums.numberOfEvents(), addedSums.numberOfEvents() );
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( wholeSampleSums.sumOfWeights(), addedSums.sumOfWeights(), wholeSampleSums.sumOfWeights()*1e-9 );
+	for( size_t triggerNumber=0; triggerNumber<pTriggerMenu_->numberOfTriggers(); ++triggerNumber )
+	{
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( wholeSampleSums.weightOfEventsPassed(triggerNumber), addedSums.weightOfEventsPassed(triggerNumber), wholeSampleSums.sumOfWeights()*1e-9 );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( wholeSampleSums.weightOfEventsPure(triggerNumber), addedSums.weightOfEventsPure(triggerNumber), wholeSampleSums.sumOfWeights()*1e-9 );
+	}
+
+	// Lumi sections outside the bins are left out, and the empty bin can still be used
+	CPPUNIT_ASSERT_NO_THROW( binnedSums=l1menu::MenuRateSums::inLuminosityBins( lumiSectionSums, luminosities, { -2, -1 } ) );
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(1), binnedSums.size() );
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(0), binnedSums[0].numberOfEvents() );
+	CPPUNIT_ASSERT_EQUAL( 0.0, binnedSums[0].sumOfWeights() );
+	CPPUNIT_ASSERT_NO_THROW( binnedSums[0].add( lumiSectionSums.begin()->second ) );
+
+	CPPUNIT_ASSERT_THROW( l1menu::MenuRateSums::inLuminosityBins( lumiSectionSums, luminosities, { 0 } ), std::runtime_error );
+	CPPUNIT_ASSERT_THROW( l1menu::MenuRateSums::inLuminosityBins( lumiSectionSums, luminosities, { 0, 10, 10 } ), std::runtime_error );
+	luminosities.erase( luminosities.begin() );
+	CPPUNIT_ASSERT_THROW( l1menu::MenuRateSums::inLuminosityBins( lumiSectionSums, luminosities, binEdges ), std::runtime_error );
+}
+
+void MenuRateSumsUnitTestSuite::testBootstrapErrors()
+{
+	const l1menu::MenuRateSums bootstrapSums=l1menu::MenuRateSums::withBootstrap( *pTriggerMenu_, *pSample_, 50, 1, 1 );
+	const l1menu::MenuRateSums sums( *pTriggerMenu_, *pSample_ );
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(50), bootstrapSums.numberOfBootstrapReplicas() );
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(0), sums.numberOfBootstrapReplicas() );
+	CPPUNIT_ASSERT_THROW( sums.bootstrapTotalFractionError(), std::runtime_error );
+
+	// The replicas shouldn't change the nominal sums, and the errors shouldn't depend on the number of threads
+	const l1menu::MenuRateSums threadedBootstrapSums=l1menu::MenuRateSums::withBootstrap( *pTriggerMenu_, *pSample_, 50, 1, 4 );
+	CPPUNIT_ASSERT_EQUAL( sums.weightOfEventsPassingAnyTrigger(), bootstrapSums.weightOfEventsPassingAnyTrigger() );
+	CPPUNIT_ASSERT_EQUAL( bootstrapSums.bootstrapTotalFractionError(), threadedBootstrapSums.bootstrapTotalFractionError() );
+	for( size_t triggerNumber=0; triggerNumber<pTriggerMenu_->numberOfTriggers(); ++triggerNumber )
+	{
+		CPPUNIT_ASSERT_EQUAL( sums.weightOfEventsPassed(triggerNumber), bootstrapSums.weightOfEventsPassed(triggerNumber) );
+		CPPUNIT_ASSERT_EQUAL( bootstrapSums.bootstrapFractionError(triggerNumber), threadedBootstrapSums.bootstrapFractionError(triggerNumber) );
+		CPPUNIT_ASSERT_EQUAL( bootstrapSums.bootstrapPureFractionError(triggerNumber), threadedBootstrapSums.bootstrapPureFractionError(triggerNumber) );
+	}
+
+	// The bootstrap error on the total should be roughly the same as the simple one, and be used for the rate
+	std::shared_ptr<const l1menu::IMenuRate> pRate=bootstrapSums.rate();
+	const double simpleError=std::sqrt( sums.weightSquaredOfEventsPassingAnyTrigger() )/sums.sumOfWeights();
+	CPPUNIT_ASSERT( bootstrapSums.bootstrapTotalFractionError()>simpleError/3 );
+	CPPUNIT_ASSERT( bootstrapSums.bootstrapTotalFractionError()<simpleError*3 );
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( bootstrapSums.bootstrapTotalFractionError(), pRate->totalFractionError(), simpleError*1e-5 );
+
+	l1menu::MenuRateSums addedSums( bootstrapSums );
+	CPPUNIT_ASSERT_NO_THROW( addedSums.add( threadedBootstrapSums ) );
+	CPPUNIT_ASSERT_THROW( addedSums.add( sums ), std::runtime_error );
+}
@@ -0,0 +1,346 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include "l1menu/TriggerMenu.h"
+
+//
+// Forward definitions
+//
+namespace l1menu
+{
+	class ISample;
+}
+
+/** @brief A cppunit TestFixture to test the things ReducedSample does apart from calculating rates.
+ */
+class ReducedSampleUnitTestSuite : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE(ReducedSampleUnitTestSuite);
+	CPPUNIT_TEST(testReducedSampleIndex);
+	CPPUNIT_TEST(testNaNParameters);
+	CPPUNIT_TEST(testNamedWeights);
+	CPPUNIT_TEST(testSavingNamedWeights);
+	CPPUNIT_TEST_SUITE_END();
+
+protected:
+	std::unique_ptr<l1menu::ISample> pSample_;
+	std::unique_ptr<l1menu::TriggerMenu> pTriggerMenu_;
+public:
+	void setUp();
+
+protected:
+	void testReducedSampleIndex();
+	void testNaNParameters();
+	void testNamedWeights();
+	void testSavingNamedWeights();
+};
+
+
+
+
+
+#include <cppunit/config/SourcePrefix.h>
+#include <stdexcept>
+#include <cstdio>
+#include <cmath>
+#include <limits>
+#include <fstream>
+#include <vector>
+#include "l1menu/ReducedSample.h"
+#include "l1menu/FullSample.h"
+#include "l1menu/MenuRateSums.h"
+#include "l1menu/TriggerRatePlot.h"
+#include "l1menu/IEvent.h"
+#include "l1menu/ICachedTrigger.h"
+#include "l1menu/ITrigger.h"
+#include "l1menu/tools/miscellaneous.h"
+#include "l1menu/tools/fileIO.h"
+#include "protobuf/l1menu.pb.h"
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/io/gzip_stream.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <TH1.h>
+#include "TestParameters.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ReducedSampleUnitTestSuite);
+
+namespace
+{
+	/** @brief Writes a ReducedSample file for a single trigger with one threshold, where each event has
+	 * the given value of the threshold and a weight of one.
+	 *
+	 * ReducedSample has no way of setting the values directly, since they always come from applying the
+	 * trigger to a FullSample, so this writes the file in the same way as ReducedSample::saveToFile. */
+	void writeReducedSampleFile( const std::string& filename, const l1menu::ITrigger& trigger, const std::vector<float>& values )
+	{
+		l1menuprotobuf::SampleHeader header;
+		l1menuprotobuf::Trigger* pTrigger=header.add_trigger();
+		pTrigger->set_name( trigger.name() );
+		pTrigger->set_version( trigger.version() );
+		for( const auto& parameterName : trigger.parameterNames() )
+		{
+			l1menuprotobuf::Trigger_TriggerParameter* pParameter=pTrigger->add_parameter();
+			pParameter->set_name( parameterName );
+			pParameter->set_value( trigger.parameter(parameterName) );
+		}
+		for( const auto& thresholdName : l1menu::tools::getThresholdNames(trigger) ) pTrigger->add_varying_parameter( thresholdName );
+
+		l1menuprotobuf::Run run;
+		for( const float value : values ) run.add_event()->add_threshold( value );
+
+		std::ofstream outputFile( filename, std::ios::binary );
+		google::protobuf::io::OstreamOutputStream fileOutput( &outputFile );
+		{
+			google::protobuf::io::CodedOutputStream codedOutput( &fileOutput );
+			codedOutput.WriteString( "l1menuReducedSample" );
+			codedOutput.WriteVarint32( 1 );
+		}
+		google::protobuf::io::GzipOutputStream gzipOutput( &fileOutput );
+		{
+			google::protobuf::io::CodedOutputStream codedOutput( &gzipOutput );
+			codedOutput.WriteVarint64( header.ByteSize() );
+			header.SerializeToCodedStream( &codedOutput );
+			codedOutput.WriteVarint64( run.ByteSize() );
+			run.SerializeToCodedStream( &codedOutput );
+		}
+		gzipOutput.Close();
+	}
+
+	/** @brief Makes a ReducedSample with the same events as the test sample, for tests that need to change it. */
+	std::unique_ptr<l1menu::ReducedSample> copyAsReducedSample( const l1menu::ISample& sample, const l1menu::TriggerMenu& menu )
+	{
+		std::unique_ptr<l1menu::ReducedSample> pReducedSample;
+		const l1menu::FullSample* pFullSample=dynamic_cast<const l1menu::FullSample*>( &sample );
+		if( pFullSample!=nullptr ) pReducedSample.reset( new l1menu::ReducedSample( *pFullSample, menu ) );
+		else
+		{
+			const l1menu::ReducedSample* pOriginalSample=dynamic_cast<const l1menu::ReducedSample*>( &sample );
+			CPPUNIT_ASSERT( pOriginalSample!=nullptr );
+			pReducedSample.reset( new l1menu::ReducedSample( pOriginalSample->getTriggerMenu() ) );
+			pReducedSample->addSample( *pOriginalSample );
+			pReducedSample->setEventRate( pOriginalSample->eventRate() );
+		}
+		return pReducedSample;
+	}
+}
+
+void ReducedSampleUnitTestSuite::setUp()
+{
+	std::string inputSampleFilename=TestParameters<std::string>::instance().getParameter( "TEST_SAMPLE_FILENAME" );
+	std::string inputMenuFilename=TestParameters<std::string>::instance().getParameter( "TEST_MENU_FILENAME" );
+	CPPUNIT_ASSERT_NO_THROW( pSample_=l1menu::tools::loadSample( inputSampleFilename ) );
+	CPPUNIT_ASSERT_MESSAGE( "Trying to load sample from disk gave a null pointer", pSample_!=nullptr );
+	CPPUNIT_ASSERT_NO_THROW( pTriggerMenu_=l1menu::tools::loadMenu( inputMenuFilename ) );
+	CPPUNIT_ASSERT_MESSAGE( "TriggerMenu supplied needs at least one trigger for the tests", pTriggerMenu_->numberOfTriggers()>=1 );
+}
+
+void ReducedSampleUnitTestSuite::testReducedSampleIndex()
+{
+	//
+	// Compare the sums from the sorted index with looping over the events, for all of
+	// the single threshold triggers in the menu.
+	//
+	std::unique_ptr<l1menu::ReducedSample> pReducedSampleCopy;
+	const l1menu::ReducedSample* pReducedSample=dynamic_cast<const l1menu::ReducedSample*>( pSample_.get() );
+	if( pReducedSample==nullptr )
+	{
+		const l1menu::FullSample* pFullSample=dynamic_cast<const l1menu::FullSample*>( pSample_.get() );
+		CPPUNIT_ASSERT( pFullSample!=nullptr );
+		pReducedSampleCopy.reset( new l1menu::ReducedSample( *pFullSample, *pTriggerMenu_ ) );
+		pReducedSample=pReducedSampleCopy.get();
+	}
+
+	for( size_t triggerNumber=0; triggerNumber<pTriggerMenu_->numberOfTriggers(); ++triggerNumber )
+	{
+		std::unique_ptr<l1menu::ITrigger> pTrigger=pTriggerMenu_->getTriggerCopy( triggerNumber );
+		if( !pReducedSample->containsTrigger( *pTrigger ) ) continue;
+		const auto parameterIdentifiers=pReducedSample->getTriggerParameterIdentifiers( *pTrigger );
+		if( parameterIdentifiers.size()!=1 ) continue;
+		float& threshold=pTrigger->parameter( parameterIdentifiers.begin()->first );
+		const size_t parameterID=parameterIdentifiers.begin()->second;
+
+		std::unique_ptr<l1menu::ICachedTrigger> pCachedTrigger=pReducedSample->createCachedTrigger( *pTrigger );
+
+		// The columns should be copies of what's in the events
+		const float* column=pReducedSample->parameterColumn( parameterID );
+		const float* weightColumn=pReducedSample->weightColumn();
+		for( size_t eventNumber=0; eventNumber<pReducedSample->numberOfEvents(); ++eventNumber )
+		{
+			const l1menu::ReducedEvent& event=static_cast<const l1menu::ReducedEvent&>( pReducedSample->getEvent(eventNumber) );
+			CPPUNIT_ASSERT_EQUAL( event.parameterValue(parameterID), column[eventNumber] );
+			CPPUNIT_ASSERT_EQUAL( event.weight(), weightColumn[eventNumber] );
+		}
+
+		for( float testThreshold : { -2.0f, 0.0f, 10.0f, 25.5f, 60.0f } )
+		{
+			threshold=testThreshold;
+			double expectedSum=0;
+			for( size_t eventNumber=0; eventNumber<pReducedSample->numberOfEvents(); ++eventNumber )
+			{
+				const l1menu::IEvent& event=pReducedSample->getEvent(eventNumber);
+				if( pCachedTrigger->apply(event) ) expectedSum+=event.weight();
+			}
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( expectedSum, pReducedSample->sumOfWeightsPassing( parameterID, testThreshold ), expectedSum*1e-6 );
+
+			// The inverse might not give the same threshold, since the sum only changes at values
+			// in the sample, but it should give the same sum.
+			const float inverseThreshold=pReducedSample->thresholdForSumOfWeights( parameterID, expectedSum );
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( expectedSum, pReducedSample->sumOfWeightsPassing( parameterID, inverseThreshold ), expectedSum*1e-6 );
+		}
+	}
+
+	CPPUNIT_ASSERT_THROW( pReducedSample->sumOfWeightsPassing( 999999, 0 ), std::runtime_error );
+	CPPUNIT_ASSERT_THROW( pReducedSample->parameterColumn( 999999 ), std::runtime_error );
+}
+
+void ReducedSampleUnitTestSuite::testNaNParameters()
+{
+	// Find a trigger with only one threshold, so that the index is all that decides whether it passes
+	const l1menu::ITrigger* pTrigger=nullptr;
+	for( size_t triggerNumber=0; triggerNumber<pTriggerMenu_->numberOfTriggers() && pTrigger==nullptr; ++triggerNumber )
+	{
+		if( l1menu::tools::getThresholdNames( pTriggerMenu_->getTrigger(triggerNumber) ).size()==1 ) pTrigger=&pTriggerMenu_->getTrigger(triggerNumber);
+	}
+	CPPUNIT_ASSERT_MESSAGE( "The test menu needs a trigger with only one threshold", pTrigger!=nullptr );
+
+	// NaN scattered amongst the values, including first and last, so that sorting them would go wrong
+	const float notANumber=std::numeric_limits<float>::quiet_NaN();
+	const std::vector<float> values={ notANumber, 12, 5, notANumber, 30, 5, -1, notANumber, 18, 0, notANumber };
+	const std::string filename="ReducedSampleUnitTestSuite_testNaNParameters.proto";
+	CPPUNIT_ASSERT_NO_THROW( writeReducedSampleFile( filename, *pTrigger, values ) );
+	std::unique_ptr<l1menu::ReducedSample> pSample;
+	CPPUNIT_ASSERT_NO_THROW( pSample.reset( new l1menu::ReducedSample( filename ) ) );
+	std::remove( filename.c_str() );
+	CPPUNIT_ASSERT_EQUAL( values.size(), pSample->numberOfEvents() );
+
+	std::unique_ptr<l1menu::ITrigger> pTriggerCopy=pSample->getTriggerMenu().getTriggerCopy( 0 );
+	const auto parameterIdentifiers=pSample->getTriggerParameterIdentifiers( *pTriggerCopy );
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(1), parameterIdentifiers.size() );
+	float& threshold=pTriggerCopy->parameter( parameterIdentifiers.begin()->first );
+	const size_t parameterID=parameterIdentifiers.begin()->second;
+	std::unique_ptr<l1menu::ICachedTrigger> pCachedTrigger=pSample->createCachedTrigger( *pTriggerCopy );
+
+	// NaN passes everything in the cached trigger, and the index should agree with it
+	for( float testThreshold : { -std::numeric_limits<float>::infinity(), -5.0f, 0.0f, 5.0f, 6.0f, 18.0f, 30.0f, 31.0f, 1e6f } )
+	{
+		threshold=testThreshold;
+		double expectedSum=0;
+		for( size_t eventNumber=0; eventNumber<pSample->numberOfEvents(); ++eventNumber )
+		{
+			if( pCachedTrigger->apply( pSample->getEvent(eventNumber) ) ) expectedSum+=1;
+		}
+		CPPUNIT_ASSERT( expectedSum>=4 );
+		CPPUNIT_ASSERT_EQUAL( expectedSum, pSample->sumOfWeightsPassing( parameterID, testThreshold ) );
+		CPPUNIT_ASSERT_EQUAL( expectedSum, pSample->sumOfWeightsSquaredPassing( parameterID, testThreshold ) );
+
+		const float inverseThreshold=pSample->thresholdForSumOfWeights( parameterID, expectedSum );
+		CPPUNIT_ASSERT( !std::isnan(inverseThreshold) );
+		CPPUNIT_ASSERT_EQUAL( expectedSum, pSample->sumOfWeightsPassing( parameterID, inverseThreshold ) );
+	}
+
+	// Asking for less than the NaN events can give has to pass them anyway
+	CPPUNIT_ASSERT_EQUAL( 4.0, pSample->sumOfWeightsPassing( parameterID, pSample->thresholdForSumOfWeights( parameterID, 0 ) ) );
+}
+
+void ReducedSampleUnitTestSuite::testNamedWeights()
+{
+	// Weights are added to the sample, so work on a copy
+	std::unique_ptr<l1menu::ReducedSample> pReducedSample=copyAsReducedSample( *pSample_, *pTriggerMenu_ );
+	const size_t numberOfEvents=pReducedSample->numberOfEvents();
+	CPPUNIT_ASSERT( numberOfEvents>1 );
+
+	// One set of weights the same as the default, and one with the first half of the events doubled
+	std::vector<float> sameWeights( pReducedSample->weightColumn(), pReducedSample->weightColumn()+numberOfEvents );
+	std::vector<float> changedWeights( sameWeights );
+	for( size_t eventNumber=0; eventNumber<numberOfEvents/2; ++eventNumber ) changedWeights[eventNumber]*=2;
+	pReducedSample->addWeightColumn( "same", sameWeights );
+	pReducedSample->addWeightColumn( "changed", changedWeights );
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(2), pReducedSample->weightNames().size() );
+	CPPUNIT_ASSERT_THROW( pReducedSample->addWeightColumn( "same", sameWeights ), std::runtime_error );
+	CPPUNIT_ASSERT_THROW( pReducedSample->addWeightColumn( "short", std::vector<float>(1) ), std::runtime_error );
+	CPPUNIT_ASSERT_THROW( pReducedSample->weightColumn( "missing" ), std::runtime_error );
+
+	//
+	// The sums for all of the weights from one pass should match doing each separately
+	//
+	const l1menu::TriggerMenu& menu=pReducedSample->getTriggerMenu();
+	const std::vector<l1menu::MenuRateSums> allSums=l1menu::MenuRateSums::forEachWeight( menu, *pReducedSample );
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(3), allSums.size() );
+	const l1menu::MenuRateSums defaultSums( menu, *pReducedSample );
+	for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+	{
+		std::unique_ptr<l1menu::ICachedTrigger> pCachedTrigger=pReducedSample->createCachedTrigger( menu.getTrigger(triggerNumber) );
+		double expectedChangedSum=0;
+		for( size_t eventNumber=0; eventNumber<numberOfEvents; ++eventNumber )
+		{
+			if( pCachedTrigger->apply( pReducedSample->getEvent(eventNumber) ) ) expectedChangedSum+=changedWeights[eventNumber];
+		}
+
+		CPPUNIT_ASSERT_EQUAL( defaultSums.weightOfEventsPassed(triggerNumber), allSums[0].weightOfEventsPassed(triggerNumber) );
+		CPPUNIT_ASSERT_EQUAL( defaultSums.weightOfEventsPassed(triggerNumber), allSums[1].weightOfEventsPassed(triggerNumber) );
+		CPPUNIT_ASSERT_EQUAL( defaultSums.weightOfEventsPure(triggerNumber), allSums[1].weightOfEventsPure(triggerNumber) );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( expectedChangedSum, allSums[2].weightOfEventsPassed(triggerNumber), expectedChangedSum*1e-9 );
+	}
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( pReducedSample->sumOfWeights("changed"), allSums[2].sumOfWeights(), allSums[2].sumOfWeights()*1e-6 );
+
+	//
+	// Same for the rate plots. The plot for the "same" weights should match the default one.
+	//
+	const l1menu::ITrigger& trigger=menu.getTrigger(0);
+	const std::string versusParameter=l1menu::tools::getThresholdNames( trigger ).front();
+	std::vector<l1menu::TriggerRatePlot> ratePlots;
+	for( const auto& name : { "default", "same", "changed" } ) ratePlots.push_back( l1menu::TriggerRatePlot( trigger, name, 50, 0, 100, versusParameter ) );
+	l1menu::TriggerRatePlot::addSampleForEachWeight( *pReducedSample, ratePlots );
+
+	l1menu::TriggerRatePlot separatePlot( trigger, "separate", 50, 0, 100, versusParameter );
+	separatePlot.addSample( *pReducedSample );
+	for( int binNumber=1; binNumber<=50; ++binNumber )
+	{
+		const double expected=separatePlot.getPlot()->GetBinContent(binNumber);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( expected, ratePlots[0].getPlot()->GetBinContent(binNumber), expected*1e-4 );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( expected, ratePlots[1].getPlot()->GetBinContent(binNumber), expected*1e-4 );
+	}
+
+	// Plots for different triggers can't share the loop
+	ratePlots.push_back( l1menu::TriggerRatePlot( menu.getTrigger(1), "different", 50, 0, 100, l1menu::tools::getThresholdNames( menu.getTrigger(1) ).front() ) );
+	ratePlots.erase( ratePlots.begin()+1 );
+	CPPUNIT_ASSERT_THROW( l1menu::TriggerRatePlot::addSampleForEachWeight( *pReducedSample, ratePlots ), std::runtime_error );
+}
+
+void ReducedSampleUnitTestSuite::testSavingNamedWeights()
+{
+	std::unique_ptr<l1menu::ReducedSample> pReducedSample=copyAsReducedSample( *pSample_, *pTriggerMenu_ );
+	const size_t numberOfEvents=pReducedSample->numberOfEvents();
+	CPPUNIT_ASSERT( numberOfEvents>1 );
+
+	// Different values for every event in each column, so that a mix up between events or columns shows
+	std::vector<float> firstWeights, secondWeights;
+	for( size_t eventNumber=0; eventNumber<numberOfEvents; ++eventNumber )
+	{
+		firstWeights.push_back( 0.5f+eventNumber );
+		secondWeights.push_back( pReducedSample->weightColumn()[eventNumber]*(eventNumber%3) );
+	}
+	pReducedSample->addWeightColumn( "first", firstWeights );
+	pReducedSample->addWeightColumn( "second", secondWeights );
+
+	// saveToFile doesn't truncate, so make sure nothing is left from a previous run
+	const std::string filename="ReducedSampleUnitTestSuite_testSavingNamedWeights.proto";
+	std::remove( filename.c_str() );
+	CPPUNIT_ASSERT_NO_THROW( pReducedSample->saveToFile( filename ) );
+	std::unique_ptr<l1menu::ReducedSample> pLoadedSample;
+	CPPUNIT_ASSERT_NO_THROW( pLoadedSample.reset( new l1menu::ReducedSample( filename ) ) );
+	std::remove( filename.c_str() );
+
+	CPPUNIT_ASSERT_EQUAL( numberOfEvents, pLoadedSample->numberOfEvents() );
+	CPPUNIT_ASSERT( pReducedSample->weightNames()==pLoadedSample->weightNames() );
+	const float* loadedDefaultWeights=pLoadedSample->weightColumn();
+	const float* loadedFirstWeights=pLoadedSample->weightColumn( "first" );
+	const float* loadedSecondWeights=pLoadedSample->weightColumn( "second" );
+	for( size_t eventNumber=0; eventNumber<numberOfEvents; ++eventNumber )
+	{
+		CPPUNIT_ASSERT_EQUAL( pReducedSample->weightColumn()[eventNumber], loadedDefaultWeights[eventNumber] );
+		CPPUNIT_ASSERT_EQUAL( firstWeights[eventNumber], loadedFirstWeights[eventNumber] );
+		CPPUNIT_ASSERT_EQUAL( secondWeights[eventNumber], loadedSecondWeights[eventNumber] );
+	}
+	CPPUNIT_ASSERT_EQUAL( pReducedSample->sumOfWeights( "first" ), pLoadedSample->sumOfWeights( "first" ) );
+	CPPUNIT_ASSERT_EQUAL( pReducedSample->sumOfWeights( "second" ), pLoadedSample->sumOfWeights( "second" ) );
+	CPPUNIT_ASSERT_THROW( pLoadedSample->weightColumn( "missing" ), std::runtime_error );
+}
@@ -11,6 +11,7 @@ class StringManipulationUnitTestSuite : public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST_SUITE(StringManipulationUnitTestSuite);
 	CPPUNIT_TEST(testSplitByWhitespace);
 	CPPUNIT_TEST(testConvertStringToFloat);
+	CPPUNIT_TEST(testConvertStringToSize);
 	CPPUNIT_TEST_SUITE_END();
 
 protected:
@@ -21,6 +22,7 @@ public:
 protected:
 	void testSplitByWhitespace();
 	void testConvertStringToFloat();
+	void testConvertStringToSize();
 };
 
 
@@ -70,3 +72,13 @@ void StringManipulationUnitTestSuite::testConvertStringToFloat()
 	CPPUNIT_ASSERT_THROW( l1menu::tools::convertStringToFloat("To the pub!"), std::runtime_error );
 	CPPUNIT_ASSERT_THROW( l1menu::tools::convertStringToFloat("12 blah"), std::runtime_error );
 }
+
+void StringManipulationUnitTestSuite::testConvertStringToSize()
+{
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(12), l1menu::tools::convertStringToSize("12") );
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(0), l1menu::tools::convertStringToSize("0") );
+	// Negative values would otherwise silently wrap to huge event counts
+	CPPUNIT_ASSERT_THROW( l1menu::tools::convertStringToSize("-12"), std::runtime_error );
+	CPPUNIT_ASSERT_THROW( l1menu::tools::convertStringToSize("12a"), std::runtime_error );
+	CPPUNIT_ASSERT_THROW( l1menu::tools::convertStringToSize("two"), std::runtime_error );
+}
@@ -0,0 +1,194 @@
+#ifndef TestEvents_h
+#define TestEvents_h
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include "l1menu/L1TriggerDPGEvent.h"
+#include "UserCode/L1TriggerUpgrade/interface/L1AnalysisDataFormat.h"
+
+/** @brief Makes up full events with random muons and EG objects, for testing triggers that use them.
+ *
+ * The test sample is normally a reduced sample, which doesn't have the objects that the triggers
+ * look at. Et values are whole numbers so that plenty are exactly on the thresholds, one object in
+ * eight is in the wrong bunch crossing, and one event in ten fails the zero bias requirement.
+ *
+ * @param[in] parentSample     The sample the events say they're from. Nothing is taken from it.
+ * @param[in] numberOfEvents   How many events to create.
+ * @param[in] seed             Seed for the random numbers, so that the events are reproducible.
+ */
+inline std::vector<l1menu::L1TriggerDPGEvent> createMuonAndEGammaEvents( const l1menu::ISample& parentSample, size_t numberOfEvents, unsigned int seed )
+{
+	std::mt19937 randomGenerator( seed );
+	std::exponential_distribution<double> etDistribution( 1/12.0 );
+	std::uniform_int_distribution<int> numberDistribution( 0, 4 );
+	std::uniform_int_distribution<int> bxDistribution( 0, 7 );
+	std::uniform_real_distribution<double> muonEtaDistribution( -2.5, 2.5 );
+	std::uniform_int_distribution<int> qualityDistribution( 2, 7 );
+	std::uniform_int_distribution<int> regionDistribution( 0, 21 );
+	std::uniform_int_distribution<int> phiDistribution( 0, 17 );
+	std::uniform_int_distribution<int> flagDistribution( 0, 1 );
+
+	std::vector<l1menu::L1TriggerDPGEvent> events;
+	for( size_t eventNumber=0; eventNumber<numberOfEvents; ++eventNumber )
+	{
+		events.push_back( l1menu::L1TriggerDPGEvent( parentSample ) );
+		L1Analysis::L1AnalysisDataFormat& rawEvent=events.back().rawEvent();
+		rawEvent.Reset();
+		for( int number=numberDistribution(randomGenerator); number>0; --number )
+		{
+			rawEvent.Bxmu.push_back( bxDistribution(randomGenerator)==0 ? 1 : 0 );
+			rawEvent.Ptmu.push_back( std::floor( etDistribution(randomGenerator) ) );
+			rawEvent.Etamu.push_back( muonEtaDistribution(randomGenerator) );
+			rawEvent.Phimu.push_back( 0 );
+			rawEvent.Qualmu.push_back( qualityDistribution(randomGenerator) );
+			rawEvent.Isomu.push_back( flagDistribution(randomGenerator) );
+			rawEvent.Nmu++;
+		}
+		for( int number=numberDistribution(randomGenerator); number>0; --number )
+		{
+			rawEvent.Bxel.push_back( bxDistribution(randomGenerator)==0 ? 1 : 0 );
+			rawEvent.Etel.push_back( std::floor( etDistribution(randomGenerator) ) );
+			rawEvent.Etael.push_back( regionDistribution(randomGenerator) );
+			rawEvent.Phiel.push_back( phiDistribution(randomGenerator) );
+			rawEvent.Isoel.push_back( flagDistribution(randomGenerator) );
+			rawEvent.Nele++;
+		}
+		events.back().physicsBits()[0]=( eventNumber%10!=0 );
+	}
+
+	return events;
+}
+
+/** @brief Makes up full events with random track electrons and track jets, for testing the triggers
+ * that look for pairs of objects from the same vertex.
+ *
+ * The z vertex positions are whole numbers in a small range so that plenty of pairs are exactly the
+ * same or exactly zVtxCut apart, and one object in eight has a NaN z. The electron track isolation is
+ * also a whole number, or NaN for one in eight. Phi only covers a few regions so
+ * that electrons and jets are often in the same tower. Nothing is out of time and every event passes
+ * the zero bias requirement.
+ *
+ * @param[in] parentSample     The sample the events say they're from. Nothing is taken from it.
+ * @param[in] numberOfEvents   How many events to create.
+ * @param[in] seed             Seed for the random numbers, so that the events are reproducible.
+ */
+inline std::vector<l1menu::L1TriggerDPGEvent> createTrackEvents( const l1menu::ISample& parentSample, size_t numberOfEvents, unsigned int seed )
+{
+	std::mt19937 randomGenerator( seed );
+	std::exponential_distribution<double> etDistribution( 1/12.0 );
+	std::uniform_int_distribution<int> numberDistribution( 0, 5 );
+	std::uniform_int_distribution<int> regionDistribution( 0, 21 );
+	std::uniform_int_distribution<int> phiDistribution( 0, 2 );
+	std::uniform_int_distribution<int> zVtxDistribution( -4, 4 );
+	std::uniform_int_distribution<int> trackIsolationDistribution( 0, 4 );
+	std::uniform_int_distribution<int> flagDistribution( 0, 1 );
+	std::uniform_int_distribution<int> nanDistribution( 0, 7 );
+
+	auto orNaN=[&]( std::uniform_int_distribution<int>& distribution )->double
+	{
+		if( nanDistribution(randomGenerator)==0 ) return std::numeric_limits<double>::quiet_NaN();
+		else return distribution(randomGenerator);
+	};
+
+	std::vector<l1menu::L1TriggerDPGEvent> events;
+	for( size_t eventNumber=0; eventNumber<numberOfEvents; ++eventNumber )
+	{
+		events.push_back( l1menu::L1TriggerDPGEvent( parentSample ) );
+		L1Analysis::L1AnalysisDataFormat& rawEvent=events.back().rawEvent();
+		rawEvent.Reset();
+		for( int number=numberDistribution(randomGenerator); number>0; --number )
+		{
+			rawEvent.BxTkel.push_back( 0 );
+			rawEvent.EtTkel.push_back( std::floor( etDistribution(randomGenerator) ) );
+			rawEvent.EtaTkel.push_back( regionDistribution(randomGenerator) );
+			rawEvent.PhiTkel.push_back( phiDistribution(randomGenerator) );
+			rawEvent.zVtxTkel.push_back( orNaN(zVtxDistribution) );
+			rawEvent.tIsoTkel.push_back( orNaN(trackIsolationDistribution) );
+			rawEvent.IsoTkel.push_back( flagDistribution(randomGenerator) );
+			rawEvent.NTkele++;
+		}
+		for( int number=numberDistribution(randomGenerator); number>0; --number )
+		{
+			rawEvent.BxTkjet.push_back( 0 );
+			rawEvent.EtTkjet.push_back( std::floor( etDistribution(randomGenerator) ) );
+			rawEvent.EtaTkjet.push_back( regionDistribution(randomGenerator) );
+			rawEvent.PhiTkjet.push_back( phiDistribution(randomGenerator) );
+			rawEvent.zVtxTkjet.push_back( orNaN(zVtxDistribution) );
+			rawEvent.NTkjet++;
+		}
+		events.back().physicsBits()[0]=true;
+	}
+
+	return events;
+}
+
+/** @brief Makes up full events with random EG, central jets, tau jets and track electrons, for testing
+ * the cross triggers that don't allow both legs to be in the same calorimeter region.
+ *
+ * Eta and phi are picked from a few values so that objects often share a region. Some of the values
+ * are not whole numbers or are outside the region grid, so the objects don't have a tower index and
+ * have to be compared on eta and phi. Nothing is out of time and every event passes the zero bias
+ * requirement.
+ *
+ * @param[in] parentSample     The sample the events say they're from. Nothing is taken from it.
+ * @param[in] numberOfEvents   How many events to create.
+ * @param[in] seed             Seed for the random numbers, so that the events are reproducible.
+ */
+inline std::vector<l1menu::L1TriggerDPGEvent> createOverlappingEvents( const l1menu::ISample& parentSample, size_t numberOfEvents, unsigned int seed )
+{
+	const double etaValues[]={ 3, 4, 5, 3.5, -1, 22 };
+	const double phiValues[]={ 0, 1, 0.5, -1, 18 };
+
+	std::mt19937 randomGenerator( seed );
+	std::exponential_distribution<double> etDistribution( 1/12.0 );
+	std::uniform_int_distribution<int> numberDistribution( 0, 4 );
+	std::uniform_int_distribution<size_t> etaDistribution( 0, std::end(etaValues)-std::begin(etaValues)-1 );
+	std::uniform_int_distribution<size_t> phiDistribution( 0, std::end(phiValues)-std::begin(phiValues)-1 );
+	std::uniform_int_distribution<int> flagDistribution( 0, 1 );
+
+	std::vector<l1menu::L1TriggerDPGEvent> events;
+	for( size_t eventNumber=0; eventNumber<numberOfEvents; ++eventNumber )
+	{
+		events.push_back( l1menu::L1TriggerDPGEvent( parentSample ) );
+		L1Analysis::L1AnalysisDataFormat& rawEvent=events.back().rawEvent();
+		rawEvent.Reset();
+		for( int number=numberDistribution(randomGenerator); number>0; --number )
+		{
+			rawEvent.Bxel.push_back( 0 );
+			rawEvent.Etel.push_back( std::floor( etDistribution(randomGenerator) ) );
+			rawEvent.Etael.push_back( etaValues[etaDistribution(randomGenerator)] );
+			rawEvent.Phiel.push_back( phiValues[phiDistribution(randomGenerator)] );
+			rawEvent.Isoel.push_back( flagDistribution(randomGenerator) );
+			rawEvent.Nele++;
+		}
+		// Half of the jets are tau jets, the rest are central
+		for( int number=2*numberDistribution(randomGenerator); number>0; --number )
+		{
+			rawEvent.Bxjet.push_back( 0 );
+			rawEvent.Etjet.push_back( std::floor( etDistribution(randomGenerator) ) );
+			rawEvent.Etajet.push_back( etaValues[etaDistribution(randomGenerator)] );
+			rawEvent.Phijet.push_back( phiValues[phiDistribution(randomGenerator)] );
+			rawEvent.Taujet.push_back( flagDistribution(randomGenerator) );
+			rawEvent.isoTaujet.push_back( false );
+			rawEvent.Fwdjet.push_back( false );
+			rawEvent.Njet++;
+		}
+		for( int number=numberDistribution(randomGenerator); number>0; --number )
+		{
+			rawEvent.BxTkel.push_back( 0 );
+			rawEvent.EtTkel.push_back( std::floor( etDistribution(randomGenerator) ) );
+			rawEvent.EtaTkel.push_back( etaValues[etaDistribution(randomGenerator)] );
+			rawEvent.PhiTkel.push_back( phiValues[phiDistribution(randomGenerator)] );
+			rawEvent.zVtxTkel.push_back( 0 );
+			rawEvent.NTkele++;
+		}
+		events.back().physicsBits()[0]=true;
+	}
+
+	return events;
+}
+
+#endif
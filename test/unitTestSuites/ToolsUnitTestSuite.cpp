@@ -11,6 +11,9 @@ class ToolsUnitTestSuite : public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST_SUITE(ToolsUnitTestSuite);
 	CPPUNIT_TEST(testLinearFitInputCheck);
 	CPPUNIT_TEST(testLinearFitResult);
+	CPPUNIT_TEST(testShardRange);
+	CPPUNIT_TEST(testVectorisedKernels);
+	CPPUNIT_TEST(testColumnScanPassMask);
 	CPPUNIT_TEST_SUITE_END();
 
 protected:
@@ -21,6 +24,9 @@ public:
 protected:
 	void testLinearFitInputCheck();
 	void testLinearFitResult();
+	void testShardRange();
+	void testVectorisedKernels();
+	void testColumnScanPassMask();
 };
 
 
@@ -31,6 +37,12 @@ protected:
 #include <iostream>
 #include <stdexcept>
 #include "l1menu/tools/miscellaneous.h"
+#include "l1menu/SampleRange.h"
+#include "l1menu/tools/vectorisedKernels.h"
+#include "implementation/ColumnScanMenu.h"
+#include <limits>
+#include <random>
+#include <cmath>
 
 CPPUNIT_TEST_SUITE_REGISTRATION(ToolsUnitTestSuite);
 
@@ -79,3 +91,130 @@ void ToolsUnitTestSuite::testLinearFitResult()
 	CPPUNIT_ASSERT_DOUBLES_EQUAL( 0, slopeInterceptPair.first, delta );
 	CPPUNIT_ASSERT_DOUBLES_EQUAL( 30966.3, slopeInterceptPair.second, delta );
 }
+
+void ToolsUnitTestSuite::testShardRange()
+{
+	// Make sure every event is in one and only one shard, and that the shards are
+	// as even as possible.
+	const size_t totalEvents=1003;
+	const size_t numberOfShards=7;
+	size_t nextEvent=0;
+	for( size_t shardNumber=0; shardNumber<numberOfShards; ++shardNumber )
+	{
+		std::pair<size_t,size_t> range=l1menu::SampleRange::shardRange( shardNumber, numberOfShards, totalEvents );
+		CPPUNIT_ASSERT_EQUAL( nextEvent, range.first );
+		CPPUNIT_ASSERT( range.second==totalEvents/numberOfShards || range.second==totalEvents/numberOfShards+1 );
+		nextEvent+=range.second;
+	}
+	CPPUNIT_ASSERT_EQUAL( totalEvents, nextEvent );
+
+	CPPUNIT_ASSERT_THROW( l1menu::SampleRange::shardRange( 7, 7, totalEvents ), std::runtime_error );
+
+	std::pair<size_t,size_t> shard;
+	CPPUNIT_ASSERT_NO_THROW( shard=l1menu::SampleRange::parseShardSpecification( "3/10" ) );
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(3), shard.first );
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(10), shard.second );
+	CPPUNIT_ASSERT_THROW( l1menu::SampleRange::parseShardSpecification( "10/10" ), std::runtime_error );
+	CPPUNIT_ASSERT_THROW( l1menu::SampleRange::parseShardSpecification( "3" ), std::runtime_error );
+	CPPUNIT_ASSERT_THROW( l1menu::SampleRange::parseShardSpecification( "-1/10" ), std::runtime_error );
+	CPPUNIT_ASSERT_THROW( l1menu::SampleRange::parseShardSpecification( "1/-10" ), std::runtime_error );
+}
+
+void ToolsUnitTestSuite::testVectorisedKernels()
+{
+	const float infinity=std::numeric_limits<float>::infinity();
+	const std::vector<l1menu::tools::InstructionSet> instructionSets={ l1menu::tools::InstructionSet::Scalar, l1menu::tools::InstructionSet::SSE4, l1menu::tools::InstructionSet::AVX2 };
+
+	// Nothing passes an empty collection
+	std::vector<float> empty;
+	CPPUNIT_ASSERT_EQUAL( -infinity, l1menu::tools::highestPassingValue( empty, {} ) );
+
+	// Fill some columns that look like calorimeter objects, with lots of ties so
+	// that the cut boundaries get tested, and the odd NaN Et which should never be
+	// the highest. The odd NaN cut value should pass, like it does in the trigger
+	// loops. Try all sizes up to a few multiples of the vector width so that the
+	// leftover entries get tested too.
+	const float notANumber=std::numeric_limits<float>::quiet_NaN();
+	std::mt19937 randomGenerator( 1234 );
+	std::uniform_int_distribution<int> etDistribution( 0, 100 );
+	std::uniform_int_distribution<int> regionDistribution( 0, 10 );
+	std::uniform_int_distribution<int> flagDistribution( 0, 1 );
+	for( size_t size=0; size<40; ++size )
+	{
+		std::vector<float> et, symmetricRegion, isolated, absoluteEta;
+		for( size_t index=0; index<size; ++index )
+		{
+			et.push_back( index%7==3 ? notANumber : etDistribution(randomGenerator)*0.5 );
+			symmetricRegion.push_back( index%5==2 ? notANumber : regionDistribution(randomGenerator) );
+			isolated.push_back( flagDistribution(randomGenerator) );
+			absoluteEta.push_back( index%6==1 ? notANumber : regionDistribution(randomGenerator)*0.3 );
+		}
+
+		for( float regionCut=0; regionCut<=11; regionCut+=1.5 )
+		{
+			const l1menu::tools::ColumnCut cuts[]={ {symmetricRegion.data(),regionCut,infinity}, {isolated.data(),1,infinity}, {absoluteEta.data(),-infinity,2.1f} };
+
+			// Work out what the answer should be with the simplest possible loop
+			float expected=-infinity;
+			for( size_t index=0; index<size; ++index )
+			{
+				if( symmetricRegion[index]<regionCut || !isolated[index] || absoluteEta[index]>2.1f ) continue;
+				if( et[index]>expected ) expected=et[index];
+			}
+
+			for( const auto& instructionSet : instructionSets )
+			{
+				if( !l1menu::tools::instructionSetIsAvailable( instructionSet ) ) continue;
+				CPPUNIT_ASSERT_EQUAL( expected, l1menu::tools::highestPassingValue( et.data(), et.size(), cuts, 3, instructionSet ) );
+			}
+			CPPUNIT_ASSERT_EQUAL( expected, l1menu::tools::highestPassingValue( et.data(), et.size(), cuts, 3 ) );
+
+			// The early exit version should agree for thresholds either side of, and equal to, the answer.
+			// An infinite threshold isn't comparable, since nothing passing gives minus infinity.
+			for( float threshold : { expected-0.5f, expected, expected+0.5f, 0.0f, 25.0f } )
+			{
+				if( threshold==-infinity ) continue;
+				for( const auto& instructionSet : instructionSets )
+				{
+					if( !l1menu::tools::instructionSetIsAvailable( instructionSet ) ) continue;
+					CPPUNIT_ASSERT_EQUAL( expected>=threshold, l1menu::tools::anyValuePassing( et.data(), et.size(), threshold, cuts, 3, instructionSet ) );
+				}
+				CPPUNIT_ASSERT_EQUAL( expected>=threshold, l1menu::tools::anyValuePassing( et.data(), et.size(), threshold, cuts, 3 ) );
+			}
+		}
+	}
+}
+
+void ToolsUnitTestSuite::testColumnScanPassMask()
+{
+	const std::vector<l1menu::tools::InstructionSet> instructionSets={ l1menu::tools::InstructionSet::Scalar, l1menu::tools::InstructionSet::SSE4, l1menu::tools::InstructionSet::AVX2 };
+
+	// Whole numbers so that lots of values are on the threshold, and some NaN which should always pass
+	std::mt19937 randomGenerator( 4321 );
+	std::uniform_int_distribution<int> valueDistribution( 0, 20 );
+	std::vector<float> values;
+	for( size_t index=0; index<l1menu::implementation::ColumnScanMenu::eventsPerBlock; ++index )
+	{
+		values.push_back( index%9==0 ? std::numeric_limits<float>::quiet_NaN() : valueDistribution(randomGenerator) );
+	}
+
+	// Every length up to a full block, so that the leftover values after the vector loop are tested too
+	for( size_t size=0; size<=values.size(); ++size )
+	{
+		for( float threshold : { -1.0f, 0.0f, 7.0f, 20.0f, 21.0f } )
+		{
+			uint64_t expected=0;
+			for( size_t index=0; index<size; ++index )
+			{
+				if( std::isnan(values[index]) || values[index]>=threshold ) expected|=static_cast<uint64_t>(1)<<index;
+			}
+
+			for( const auto& instructionSet : instructionSets )
+			{
+				if( !l1menu::tools::instructionSetIsAvailable( instructionSet ) ) continue;
+				CPPUNIT_ASSERT_EQUAL( expected, l1menu::implementation::ColumnScanMenu::passMask( values.data(), threshold, size, instructionSet ) );
+			}
+			CPPUNIT_ASSERT_EQUAL( expected, l1menu::implementation::ColumnScanMenu::passMask( values.data(), threshold, size ) );
+		}
+	}
+}
@@ -6,6 +6,8 @@
 namespace l1menu
 {
 	class TriggerMenu;
+	class ISample;
+	class IMenuRate;
 }
 
 /** @brief A cppunit TestFixture to test loading and saving menus and results to a file.
@@ -19,6 +21,15 @@ class TriggerMenuUnitTestSuite : public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST(testFormatsAreEqual);
 	CPPUNIT_TEST(testFormatsGiveSameTriggerConstraints);
 	CPPUNIT_TEST(testFormatsGiveSameResult);
+	CPPUNIT_TEST(testTriggerExpressions);
+	CPPUNIT_TEST(testCompiledMenu);
+	CPPUNIT_TEST(testRateSession);
+	CPPUNIT_TEST(testRateSessionPureRates);
+	CPPUNIT_TEST(testTotalRateCalculator);
+	CPPUNIT_TEST(testTotalRateCalculatorReorder);
+	CPPUNIT_TEST(testProgressiveRate);
+	CPPUNIT_TEST(testProgressiveEarlyStop);
+	CPPUNIT_TEST(testRatesForManyMenus);
 	CPPUNIT_TEST_SUITE_END();
 
 protected:
@@ -30,10 +41,27 @@ protected:
 	void testFormatsAreEqual();
 	void testFormatsGiveSameTriggerConstraints();
 	void testFormatsGiveSameResult();
+	void testTriggerExpressions();
+	void testCompiledMenu();
+	void testRateSession();
+	void testRateSessionPureRates();
+	void testTotalRateCalculator();
+	void testTotalRateCalculatorReorder();
+	void testProgressiveRate();
+	void testProgressiveEarlyStop();
+	void testRatesForManyMenus();
+
+	/** @brief Loads the test sample the first time it's called. Only the tests that calculate rates
+	 * need it, so it isn't loaded in setUp(). */
+	const l1menu::ISample& testSample();
+	/** @brief Checks the total, and each trigger's fraction and pure fraction, are the same in both. */
+	void checkRatesAreEqual( const l1menu::IMenuRate& expected, const l1menu::IMenuRate& actual );
 
 	// These are set in the setUp() method
 	std::unique_ptr<l1menu::TriggerMenu> pMenuFromXMLFormat_;
 	std::unique_ptr<l1menu::TriggerMenu> pMenuFromOldFormat_;
+	// This is set by testSample()
+	std::unique_ptr<l1menu::ISample> pSample_;
 };
 
 
@@ -48,10 +76,23 @@ protected:
 #include "l1menu/TriggerMenu.h"
 #include "l1menu/ITrigger.h"
 #include "l1menu/TriggerConstraint.h"
+#include "l1menu/TriggerExpression.h"
+#include "l1menu/RateSession.h"
+#include "l1menu/TotalRateCalculator.h"
+#include "l1menu/MenuRateSums.h"
+#include "l1menu/IMenuRate.h"
+#include "l1menu/ITriggerRate.h"
+#include "l1menu/tools/miscellaneous.h"
 #include "l1menu/ICachedTrigger.h"
 #include "l1menu/ISample.h"
 #include "l1menu/IEvent.h"
 #include "l1menu/tools/fileIO.h"
+#include "l1menu/L1TriggerDPGEvent.h"
+#include "l1menu/ReducedSample.h"
+#include "implementation/CompiledMenu.h"
+#include "TestEvents.h"
+#include <string>
+#include <cmath>
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TriggerMenuUnitTestSuite);
 
@@ -177,3 +218,291 @@ void TriggerMenuUnitTestSuite::testFormatsGiveSameResult()
 		}
 	}
 }
+
+void TriggerMenuUnitTestSuite::testTriggerExpressions()
+{
+	l1menu::TriggerMenu menu;
+	menu.addTrigger( "L1_SingleMu" );
+	menu.addTrigger( "L1_DoubleMu" );
+	menu.addTrigger( "L1_HTT" );
+
+	std::unique_ptr<l1menu::TriggerExpression> pExpression;
+	CPPUNIT_ASSERT_NO_THROW( pExpression.reset( new l1menu::TriggerExpression( "(L1_SingleMu OR L1_DoubleMu) AND NOT L1_HTT", menu ) ) );
+	CPPUNIT_ASSERT_EQUAL( std::string("(L1_SingleMu OR L1_DoubleMu) AND NOT L1_HTT"), pExpression->name() );
+
+	// Loop over every combination of trigger results and check against the C++ version
+	for( unsigned int combination=0; combination<8; ++combination )
+	{
+		std::vector<bool> results{ (combination&1)!=0, (combination&2)!=0, (combination&4)!=0 };
+		CPPUNIT_ASSERT_EQUAL( (results[0] || results[1]) && !results[2], pExpression->evaluate( results ) );
+	}
+
+	// Same thing with the bitwise version, where each bit is one of the combinations
+	uint64_t triggerBits[3]={ 0xAA, 0xCC, 0xF0 };
+	CPPUNIT_ASSERT_EQUAL( static_cast<uint64_t>(0x0E), pExpression->evaluate( triggerBits, 1, 0 ) & 0xFF );
+
+	// Names, wildcards and the alternative operators
+	CPPUNIT_ASSERT_NO_THROW( pExpression.reset( new l1menu::TriggerExpression( " muons = L1_*Mu", menu ) ) );
+	CPPUNIT_ASSERT_EQUAL( std::string("muons"), pExpression->name() );
+	CPPUNIT_ASSERT_EQUAL( static_cast<uint64_t>(0xEE), pExpression->evaluate( triggerBits, 1, 0 ) & 0xFF );
+	CPPUNIT_ASSERT_NO_THROW( pExpression.reset( new l1menu::TriggerExpression( "L1_SingleMu && !(L1_DoubleMu || L1_HTT)", menu ) ) );
+	CPPUNIT_ASSERT_EQUAL( static_cast<uint64_t>(0x02), pExpression->evaluate( triggerBits, 1, 0 ) & 0xFF );
+
+	// Invalid expressions
+	CPPUNIT_ASSERT_THROW( l1menu::TriggerExpression( "L1_SingleEG", menu ), std::runtime_error );
+	CPPUNIT_ASSERT_THROW( l1menu::TriggerExpression( "L1_SingleMu AND", menu ), std::runtime_error );
+	CPPUNIT_ASSERT_THROW( l1menu::TriggerExpression( "(L1_SingleMu", menu ), std::runtime_error );
+	CPPUNIT_ASSERT_THROW( l1menu::TriggerExpression( "L1_SingleMu L1_HTT", menu ), std::runtime_error );
+	CPPUNIT_ASSERT_THROW( l1menu::TriggerExpression( "=L1_SingleMu", menu ), std::runtime_error );
+}
+
+void TriggerMenuUnitTestSuite::testCompiledMenu()
+{
+	//
+	// The single muon triggers that only differ in threshold should share one selection, the one with
+	// a different quality cut needs its own, and the legs of the cross trigger should share with the
+	// single object triggers that have the same cuts. The leg triggers are version 0, so ask for that
+	// version of the single object triggers.
+	//
+	l1menu::TriggerMenu menu;
+	for( float threshold : { 10.0f, 16.0f, 20.0f } ) menu.addTrigger( "L1_SingleMu", 0 ).parameter( "threshold1" )=threshold;
+	menu.addTrigger( "L1_SingleMu", 0 ).parameter( "muonQuality" )=6;
+	menu.addTrigger( "L1_SingleIsoMu", 0 ).parameter( "threshold1" )=14;
+	menu.addTrigger( "L1_SingleEG", 0 ).parameter( "threshold1" )=25;
+	l1menu::ITrigger& crossTrigger=menu.addTrigger( "L1_isoMu_EG", 0 );
+	crossTrigger.parameter( "leg1threshold1" )=8;
+	crossTrigger.parameter( "leg2threshold1" )=12;
+	l1menu::ITrigger& doubleEG=menu.addTrigger( "L1_DoubleEG", 0 );
+	doubleEG.parameter( "leg1threshold1" )=15;
+	doubleEG.parameter( "leg2threshold1" )=10;
+
+	l1menu::implementation::CompiledMenu compiledMenu( menu );
+	CPPUNIT_ASSERT_EQUAL( menu.numberOfTriggers(), compiledMenu.numberOfTriggers() );
+	// Two single muon selections, the isolated muon, the EG and the double EG
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(5), compiledMenu.numberOfSelections() );
+
+	l1menu::ReducedSample parentSample( menu ); // Only needed because the events have to have a sample
+	const std::vector<l1menu::L1TriggerDPGEvent> events=createMuonAndEGammaEvents( parentSample, 2000, 5678 );
+	std::vector<const l1menu::L1TriggerDPGEvent*> eventPointers;
+	for( const auto& event : events ) eventPointers.push_back( &event );
+
+	//
+	// The pass bits should be exactly the same as calling apply on each trigger
+	//
+	std::vector< std::vector<bool> > results;
+	compiledMenu.applyBatch( eventPointers, results );
+	CPPUNIT_ASSERT_EQUAL( menu.numberOfTriggers(), results.size() );
+	for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+	{
+		const l1menu::ITrigger& trigger=menu.getTrigger( triggerNumber );
+		CPPUNIT_ASSERT_EQUAL( events.size(), results[triggerNumber].size() );
+
+		size_t numberPassed=0;
+		for( size_t eventNumber=0; eventNumber<events.size(); ++eventNumber )
+		{
+			const bool expected=trigger.apply( events[eventNumber] );
+			CPPUNIT_ASSERT_EQUAL_MESSAGE( trigger.name()+" gives a different result for event "+std::to_string(eventNumber), expected, static_cast<bool>(results[triggerNumber][eventNumber]) );
+			if( expected ) ++numberPassed;
+		}
+		// Make sure the events actually test something
+		CPPUNIT_ASSERT_MESSAGE( trigger.name()+" passes none or all of the events", numberPassed>0 && numberPassed<events.size() );
+	}
+
+	// A smaller batch reusing the same compiled menu should still agree
+	eventPointers.resize( 37 );
+	compiledMenu.applyBatch( eventPointers, results );
+	for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+	{
+		CPPUNIT_ASSERT_EQUAL( eventPointers.size(), results[triggerNumber].size() );
+		for( size_t eventNumber=0; eventNumber<eventPointers.size(); ++eventNumber )
+		{
+			CPPUNIT_ASSERT_EQUAL( menu.getTrigger(triggerNumber).apply( events[eventNumber] ), static_cast<bool>(results[triggerNumber][eventNumber]) );
+		}
+	}
+}
+
+const l1menu::ISample& TriggerMenuUnitTestSuite::testSample()
+{
+	if( pSample_==nullptr )
+	{
+		std::string sampleFilename=TestParameters<std::string>::instance().getParameter( "TEST_SAMPLE_FILENAME" );
+		CPPUNIT_ASSERT_NO_THROW( pSample_=l1menu::tools::loadSample( sampleFilename ) );
+		CPPUNIT_ASSERT( pSample_!=nullptr );
+	}
+	return *pSample_;
+}
+
+void TriggerMenuUnitTestSuite::checkRatesAreEqual( const l1menu::IMenuRate& expected, const l1menu::IMenuRate& actual )
+{
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( expected.totalFraction(), actual.totalFraction(), 0.00001 );
+	CPPUNIT_ASSERT_EQUAL( expected.triggerRates().size(), actual.triggerRates().size() );
+	for( size_t index=0; index<expected.triggerRates().size(); ++index )
+	{
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( expected.triggerRates()[index]->fraction(), actual.triggerRates()[index]->fraction(), 0.00001 );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( expected.triggerRates()[index]->pureFraction(), actual.triggerRates()[index]->pureFraction(), 0.00001 );
+	}
+}
+
+void TriggerMenuUnitTestSuite::testRateSession()
+{
+	const l1menu::ISample& sample=testSample();
+	l1menu::TriggerMenu menu=*pMenuFromXMLFormat_;
+	l1menu::RateSession rateSession( menu, sample );
+
+	// Change the main threshold of a couple of triggers, in the session and in a copy of the
+	// menu, and check the session gives the same rates as doing everything again.
+	for( size_t triggerNumber : { static_cast<size_t>(0), menu.numberOfTriggers()-1 } )
+	{
+		l1menu::ITrigger& trigger=menu.getTrigger( triggerNumber );
+		const std::string mainThreshold=l1menu::tools::getThresholdNames( trigger ).front();
+		trigger.parameter( mainThreshold )+=5;
+		CPPUNIT_ASSERT_NO_THROW( rateSession.setParameter( triggerNumber, mainThreshold, trigger.parameter(mainThreshold) ) );
+
+		std::shared_ptr<const l1menu::IMenuRate> pSessionRate=rateSession.rate();
+		std::shared_ptr<const l1menu::IMenuRate> pFullRate=sample.rate( menu );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( pFullRate->totalFractionError(), pSessionRate->totalFractionError(), 0.00001 );
+		checkRatesAreEqual( *pFullRate, *pSessionRate );
+	}
+
+	// The wrong trigger should be rejected
+	CPPUNIT_ASSERT_THROW( rateSession.setTrigger( 0, menu.getTrigger(1) ), std::runtime_error );
+}
+
+void TriggerMenuUnitTestSuite::testRateSessionPureRates()
+{
+	const l1menu::ISample& sample=testSample();
+	l1menu::TriggerMenu menu=*pMenuFromXMLFormat_;
+	l1menu::RateSession rateSession( menu, sample );
+	std::shared_ptr<const l1menu::IMenuRate> pOriginalRate=rateSession.rate();
+
+	// Drop the threshold of the first trigger so that it passes nearly everything, which takes the
+	// events that were pure for the other triggers and makes them shared. Then raise it so that it
+	// passes nothing, which makes events shared with it pure for the others. Then put it back.
+	l1menu::ITrigger& trigger=menu.getTrigger( 0 );
+	const std::string mainThreshold=l1menu::tools::getThresholdNames( trigger ).front();
+	const float originalThreshold=trigger.parameter( mainThreshold );
+	for( float threshold : { -1000.0f, 10000.0f, originalThreshold } )
+	{
+		trigger.parameter( mainThreshold )=threshold;
+		CPPUNIT_ASSERT_NO_THROW( rateSession.setParameter( 0, mainThreshold, threshold ) );
+		checkRatesAreEqual( *sample.rate( menu ), *rateSession.rate() );
+	}
+
+	// Back where it started the pure rates should be what they were before anything changed
+	checkRatesAreEqual( *pOriginalRate, *rateSession.rate() );
+}
+
+void TriggerMenuUnitTestSuite::testTotalRateCalculator()
+{
+	const l1menu::ISample& sample=testSample();
+	l1menu::TriggerMenu menu=*pMenuFromXMLFormat_;
+	l1menu::TotalRateCalculator totalRateCalculator( sample );
+
+	// The first call works out an order to try the triggers in and the later ones use it, so the
+	// total should be the same either way. Then change all the thresholds at once.
+	for( size_t callNumber=0; callNumber<3; ++callNumber )
+	{
+		if( callNumber==2 )
+		{
+			for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+			{
+				l1menu::ITrigger& trigger=menu.getTrigger( triggerNumber );
+				trigger.parameter( l1menu::tools::getThresholdNames( trigger ).front() )+=5;
+			}
+		}
+
+		std::shared_ptr<const l1menu::IMenuRate> pFullRate=sample.rate( menu );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( pFullRate->totalFraction(), totalRateCalculator.totalFraction( menu ), 0.00001 );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( pFullRate->totalRate(), totalRateCalculator.totalRate( menu ), pFullRate->totalRate()*0.00001 );
+	}
+}
+
+void TriggerMenuUnitTestSuite::testTotalRateCalculatorReorder()
+{
+	const l1menu::ISample& sample=testSample();
+	const l1menu::TriggerMenu& menu=*pMenuFromXMLFormat_;
+	l1menu::TotalRateCalculator totalRateCalculator( sample );
+	const float totalFraction=totalRateCalculator.totalFraction( menu );
+
+	// The same triggers in the reverse order. The number of triggers is the same so the calculator
+	// carries on with the order it learnt for the original menu, which is now wrong for every trigger.
+	// That should only make it slower.
+	l1menu::TriggerMenu reversedMenu;
+	for( size_t triggerNumber=menu.numberOfTriggers(); triggerNumber>0; --triggerNumber )
+	{
+		reversedMenu.addTrigger( menu.getTrigger(triggerNumber-1) );
+	}
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( totalFraction, totalRateCalculator.totalFraction( reversedMenu ), 0.00001 );
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( totalFraction, totalRateCalculator.totalFraction( reversedMenu ), 0.00001 );
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( totalFraction, totalRateCalculator.totalFraction( menu ), 0.00001 );
+}
+
+void TriggerMenuUnitTestSuite::testProgressiveRate()
+{
+	const l1menu::ISample& sample=testSample();
+	const l1menu::TriggerMenu& menu=*pMenuFromXMLFormat_;
+
+	// Without stopping early every block should be processed, giving the same as the normal rate
+	const size_t numberOfBlocks=(sample.numberOfEvents()+l1menu::MenuRateSums::eventsPerProgressiveBlock-1)/l1menu::MenuRateSums::eventsPerProgressiveBlock;
+	size_t numberOfCallbacks=0;
+	std::shared_ptr<const l1menu::IMenuRate> pProgressiveRate=sample.progressiveRate( menu, [&]( const l1menu::IMenuRate& ){ ++numberOfCallbacks; return true; } );
+	CPPUNIT_ASSERT_EQUAL( numberOfBlocks, numberOfCallbacks );
+	checkRatesAreEqual( *sample.rate( menu ), *pProgressiveRate );
+
+	// Stopping after the first block should only have processed one block
+	numberOfCallbacks=0;
+	const l1menu::MenuRateSums firstBlockSums=l1menu::MenuRateSums::progressive( menu, sample, [&]( const l1menu::MenuRateSums& ){ ++numberOfCallbacks; return false; } );
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(1), numberOfCallbacks );
+	CPPUNIT_ASSERT( firstBlockSums.numberOfEvents()<=l1menu::MenuRateSums::eventsPerProgressiveBlock );
+	CPPUNIT_ASSERT( firstBlockSums.numberOfEvents()>0 );
+}
+
+void TriggerMenuUnitTestSuite::testProgressiveEarlyStop()
+{
+	const l1menu::ISample& sample=testSample();
+	const l1menu::TriggerMenu& menu=*pMenuFromXMLFormat_;
+	const size_t numberOfBlocks=(sample.numberOfEvents()+l1menu::MenuRateSums::eventsPerProgressiveBlock-1)/l1menu::MenuRateSums::eventsPerProgressiveBlock;
+	CPPUNIT_ASSERT_MESSAGE( "The test sample needs more progressive blocks for this test", numberOfBlocks>=20 );
+
+	// Ask for three times the error of the whole sample. The error from the spread of the blocks goes down
+	// with the square root of the number of events, and the blocks aren't put back, so that needs about a
+	// tenth of the sample. It should take more than the minimum number of blocks, but stop well before the end.
+	const l1menu::MenuRateSums fullSums( menu, sample );
+	const double fullRelativeError=std::sqrt( fullSums.weightSquaredOfEventsPassingAnyTrigger() )/fullSums.weightOfEventsPassingAnyTrigger();
+	size_t numberOfCallbacks=0;
+	const l1menu::MenuRateSums sums=l1menu::MenuRateSums::progressive( menu, sample, [&]( const l1menu::MenuRateSums& ){ ++numberOfCallbacks; return true; }, 3*fullRelativeError );
+	CPPUNIT_ASSERT( numberOfCallbacks>=l1menu::MenuRateSums::minimumProgressiveBlocks );
+	CPPUNIT_ASSERT( numberOfCallbacks<numberOfBlocks );
+	CPPUNIT_ASSERT( sums.numberOfEvents()<sample.numberOfEvents() );
+
+	// The estimate should be within a few of the requested errors of the full answer
+	const double fraction=sums.weightOfEventsPassingAnyTrigger()/sums.sumOfWeights();
+	const double fullFraction=fullSums.weightOfEventsPassingAnyTrigger()/fullSums.sumOfWeights();
+	CPPUNIT_ASSERT_DOUBLES_EQUAL( fullFraction, fraction, 5*3*fullRelativeError*fullFraction );
+}
+
+void TriggerMenuUnitTestSuite::testRatesForManyMenus()
+{
+	const l1menu::ISample& sample=testSample();
+
+	// The original menu, one with the first trigger changed so that most triggers are shared, and one
+	// with only the last few triggers in a different order.
+	std::vector<l1menu::TriggerMenu> menus( 2, *pMenuFromXMLFormat_ );
+	l1menu::ITrigger& changedTrigger=menus[1].getTrigger(0);
+	changedTrigger.parameter( l1menu::tools::getThresholdNames( changedTrigger ).front() )+=5;
+	menus.push_back( l1menu::TriggerMenu() );
+	for( size_t triggerNumber=pMenuFromXMLFormat_->numberOfTriggers(); triggerNumber>0 && menus.back().numberOfTriggers()<3; --triggerNumber )
+	{
+		menus.back().addTrigger( pMenuFromXMLFormat_->getTrigger(triggerNumber-1) );
+	}
+
+	std::vector< std::shared_ptr<const l1menu::IMenuRate> > menuRates;
+	CPPUNIT_ASSERT_NO_THROW( menuRates=sample.rates( menus ) );
+	CPPUNIT_ASSERT_EQUAL( menus.size(), menuRates.size() );
+	for( size_t menuNumber=0; menuNumber<menus.size(); ++menuNumber )
+	{
+		checkRatesAreEqual( *sample.rate( menus[menuNumber] ), *menuRates[menuNumber] );
+	}
+
+	CPPUNIT_ASSERT( sample.rates( std::vector<l1menu::TriggerMenu>() ).empty() );
+}
@@ -11,6 +11,14 @@ class TriggerTableUnitTestSuite : public CPPUNIT_NS::TestFixture
 {
 	CPPUNIT_TEST_SUITE(TriggerTableUnitTestSuite);
 	CPPUNIT_TEST(testGettingAndSettingAllTriggerParameters);
+	CPPUNIT_TEST(testParameterHandles);
+	CPPUNIT_TEST(testLoadingTriggerDefinitions);
+	CPPUNIT_TEST(testDeclaredTriggerMatchesCompiledTrigger);
+	CPPUNIT_TEST(testSortedEtMatchesCounting);
+	CPPUNIT_TEST(testFamiliesMatchOriginalLoops);
+	CPPUNIT_TEST(testVertexMatchedPairsMatchNestedLoops);
+	CPPUNIT_TEST(testTowerOverlapMatchesNestedLoops);
+	CPPUNIT_TEST(testCloning);
 	//CPPUNIT_TEST(dumpTriggerTable); // Commented this out because it's pointless and messy
 	CPPUNIT_TEST_SUITE_END();
 
@@ -21,6 +29,27 @@ public:
 
 protected:
 	void testGettingAndSettingAllTriggerParameters();
+	/** @brief Checks that the parameter handles refer to the same parameters as the names. */
+	void testParameterHandles();
+	/** @brief Checks that triggers declared in XML are registered with the right parameters. */
+	void testLoadingTriggerDefinitions();
+	/** @brief Checks that L1_DeclaredIsoEG_Mu from the test definitions gives exactly the same results as
+	 * the compiled L1_isoEG_Mu, both on its own and fused in a CompiledMenu. */
+	void testDeclaredTriggerMatchesCompiledTrigger();
+	/** @brief Checks L1_DoubleEG, which uses L1TriggerDPGEvent::sortedEt, against the loop that counted
+	 * objects above each threshold, including objects with a NaN Et. */
+	void testSortedEtMatchesCounting();
+	/** @brief Checks some of the triggers made from the templates in TriggerFamilies.h against the loops over
+	 * the raw data they were first written as, including NaN Et, eta and track isolation values. */
+	void testFamiliesMatchOriginalLoops();
+	/** @brief Checks the track pair triggers that use the z sorted sweep against the nested loops they
+	 * used to have, including a zero zVtxCut, pairs exactly zVtxCut apart and NaN z values. */
+	void testVertexMatchedPairsMatchNestedLoops();
+	/** @brief Checks the cross triggers that use the tower index to remove overlaps against the nested loops
+	 * they used to have, including objects with eta and phi that aren't on the region grid. */
+	void testTowerOverlapMatchesNestedLoops();
+	/** @brief Checks that clone() and copyTrigger() give an independent trigger with the same parameters. */
+	void testCloning();
 	/** @brief Not really a test as such, just prints out all the triggers for the
 	 * user to see what triggers are registered. */
 	void dumpTriggerTable();
@@ -33,12 +62,94 @@ protected:
 #include <cppunit/config/SourcePrefix.h>
 #include "l1menu/TriggerTable.h"
 #include "l1menu/ITrigger.h"
+#include "l1menu/tools/fileIO.h"
+#include "l1menu/TriggerMenu.h"
+#include "l1menu/ReducedSample.h"
+#include "l1menu/FullSample.h"
+#include "l1menu/MenuRateSums.h"
+#include "l1menu/L1TriggerDPGEvent.h"
+#include "implementation/CompiledMenu.h"
+#include "TestParameters.h"
+#include "TestEvents.h"
 #include <stdexcept>
 #include <cmath>
+#include <limits>
 #include <iomanip>
+#include <typeinfo>
+#include <utility>
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TriggerTableUnitTestSuite);
 
+namespace // Use the unnamed namespace for things only used in this file
+{
+	/** @brief Registers the triggers in a definitions file for as long as the instance exists.
+	 *
+	 * The TriggerTable is global, so anything a test registers is removed again at the end of
+	 * the test and doesn't change what other tests see.
+	 */
+	class ScopedTriggerDefinitions
+	{
+	public:
+		explicit ScopedTriggerDefinitions( const std::string& filename ) : triggers_( l1menu::tools::loadTriggerDefinitions(filename) ) {}
+		~ScopedTriggerDefinitions()
+		{
+			for( const auto& triggerDetails : triggers_ ) l1menu::TriggerTable::instance().unregisterTrigger( triggerDetails.name, triggerDetails.version );
+		}
+		const std::vector<l1menu::TriggerTable::TriggerDetails>& triggers() const { return triggers_; }
+	private:
+		ScopedTriggerDefinitions( const ScopedTriggerDefinitions& ) = delete;
+		ScopedTriggerDefinitions& operator=( const ScopedTriggerDefinitions& ) = delete;
+		std::vector<l1menu::TriggerTable::TriggerDetails> triggers_;
+	};
+
+	/** @brief Sets every combination of the given parameter values on the trigger, and checks it against
+	 * "originalLoop" on all of the events.
+	 *
+	 * @param[in] trigger          The trigger to test.
+	 * @param[in] parameterValues  The values to try for each parameter, in the order of trigger.parameterNames().
+	 * @param[in] events           The events to test on.
+	 * @param[in] originalLoop     Callable with signature bool(const L1TriggerDPGEvent&,const std::vector<float>& parameters).
+	 * @return                     The number of events that passed and the number tested, summed over all the combinations.
+	 */
+	template<class T_Loop>
+	std::pair<size_t,size_t> checkAgainstLoop( l1menu::ITrigger& trigger, const std::vector< std::vector<float> >& parameterValues,
+			const std::vector<l1menu::L1TriggerDPGEvent>& events, T_Loop originalLoop )
+	{
+		CPPUNIT_ASSERT_EQUAL( trigger.parameterNames().size(), parameterValues.size() );
+		std::pair<size_t,size_t> numberPassedAndTested( 0, 0 );
+
+		// Count through the combinations like an odometer
+		std::vector<size_t> positions( parameterValues.size(), 0 );
+		std::vector<float> parameters( parameterValues.size() );
+		bool finished=false;
+		while( !finished )
+		{
+			for( size_t handle=0; handle<parameters.size(); ++handle )
+			{
+				parameters[handle]=parameterValues[handle][positions[handle]];
+				trigger.parameter(handle)=parameters[handle];
+			}
+
+			for( size_t eventNumber=0; eventNumber<events.size(); ++eventNumber )
+			{
+				const bool expected=originalLoop( events[eventNumber], parameters );
+				CPPUNIT_ASSERT_EQUAL_MESSAGE( "Different "+trigger.name()+" result for event "+std::to_string(eventNumber), expected, trigger.apply(events[eventNumber]) );
+				if( expected ) ++numberPassedAndTested.first;
+				++numberPassedAndTested.second;
+			}
+
+			finished=true;
+			for( size_t handle=0; handle<positions.size() && finished; ++handle )
+			{
+				if( ++positions[handle]<parameterValues[handle].size() ) finished=false;
+				else positions[handle]=0;
+			}
+		}
+
+		return numberPassedAndTested;
+	}
+}
+
 void TriggerTableUnitTestSuite::setUp()
 {
 	pVerboseOutput_=nullptr;
@@ -74,6 +185,555 @@ void TriggerTableUnitTestSuite::testGettingAndSettingAllTriggerParameters()
 	}
 }
 
+void TriggerTableUnitTestSuite::testParameterHandles()
+{
+	l1menu::TriggerTable& table=l1menu::TriggerTable::instance();
+
+	const auto& allTriggerDetails=table.listTriggers();
+
+	// Loop over all of the triggers
+	for( const auto& triggerDetails : allTriggerDetails )
+	{
+		std::unique_ptr<l1menu::ITrigger> pTrigger=table.getTrigger( triggerDetails.name, triggerDetails.version );
+		CPPUNIT_ASSERT( pTrigger!=nullptr );
+		const l1menu::ITrigger& constTrigger=*pTrigger;
+
+		const auto& parameterNames=pTrigger->parameterNames();
+		for( size_t index=0; index<parameterNames.size(); ++index )
+		{
+			l1menu::ITrigger::ParameterHandle handle=pTrigger->parameterIndex( parameterNames[index] );
+			CPPUNIT_ASSERT_EQUAL( index, handle );
+			// Both should give a reference to exactly the same float
+			CPPUNIT_ASSERT( &pTrigger->parameter(handle)==&pTrigger->parameter(parameterNames[index]) );
+			CPPUNIT_ASSERT( &constTrigger.parameter(handle)==&constTrigger.parameter(parameterNames[index]) );
+		}
+		CPPUNIT_ASSERT_THROW( pTrigger->parameter( parameterNames.size() ), std::logic_error );
+		CPPUNIT_ASSERT_THROW( pTrigger->parameterIndex( "notAParameter" ), std::logic_error );
+	}
+}
+
+void TriggerTableUnitTestSuite::testLoadingTriggerDefinitions()
+{
+	std::string definitionsFilename=TestParameters<std::string>::instance().getParameter( "TEST_TRIGGERDEFINITIONS_FILENAME" );
+	l1menu::TriggerTable& table=l1menu::TriggerTable::instance();
+	const size_t numberOfTriggersBefore=table.listTriggers().size();
+
+	{
+		std::unique_ptr<ScopedTriggerDefinitions> pDefinitions;
+		CPPUNIT_ASSERT_NO_THROW( pDefinitions.reset( new ScopedTriggerDefinitions( definitionsFilename ) ) );
+		CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(3), pDefinitions->triggers().size() );
+		CPPUNIT_ASSERT_EQUAL( numberOfTriggersBefore+3, table.listTriggers().size() );
+		// Loading the same triggers again should fail because they're already registered
+		CPPUNIT_ASSERT_THROW( l1menu::tools::loadTriggerDefinitions( definitionsFilename ), std::logic_error );
+
+		std::unique_ptr<l1menu::ITrigger> pTrigger=table.getTrigger( "L1_DeclaredDoubleJet", 0 );
+		CPPUNIT_ASSERT( pTrigger!=nullptr );
+		CPPUNIT_ASSERT( pTrigger->thresholdsAreCorrelated() );
+		const std::vector<std::string> expectedNames{ "threshold1", "threshold2", "regionCut" };
+		CPPUNIT_ASSERT( pTrigger->parameterNames()==expectedNames );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( 4.5, pTrigger->parameter("regionCut"), std::pow(10,-7) );
+		CPPUNIT_ASSERT_EQUAL( 100u, table.getSuggestedNumberOfBins( "L1_DeclaredDoubleJet", "threshold1" ) );
+
+		// Each instance has its own parameters, even though they share the definition
+		std::unique_ptr<l1menu::ITrigger> pOtherTrigger=table.getTrigger( "L1_DeclaredDoubleJet" );
+		pTrigger->parameter("threshold1")=50;
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( 20, pOtherTrigger->parameter("threshold1"), std::pow(10,-7) );
+
+		pTrigger=table.getTrigger( "L1_DeclaredIsoEG_Mu" );
+		CPPUNIT_ASSERT( pTrigger!=nullptr );
+		CPPUNIT_ASSERT( !pTrigger->thresholdsAreCorrelated() );
+		CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(5), pTrigger->parameterNames().size() );
+
+		// Triggers created while registered should still work after the definitions are removed
+		pOtherTrigger=table.getTrigger( "L1_DeclaredTripleMu" );
+		pDefinitions.reset();
+		CPPUNIT_ASSERT( pOtherTrigger!=nullptr );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( 5, pOtherTrigger->parameter("threshold1"), std::pow(10,-7) );
+	}
+
+	// Everything the file declared should be gone, so that it can be loaded again
+	CPPUNIT_ASSERT_EQUAL( numberOfTriggersBefore, table.listTriggers().size() );
+	CPPUNIT_ASSERT( table.getTrigger( "L1_DeclaredDoubleJet" )==nullptr );
+	CPPUNIT_ASSERT( !table.unregisterTrigger( "L1_DeclaredDoubleJet", 0 ) );
+	CPPUNIT_ASSERT_NO_THROW( ScopedTriggerDefinitions definitions( definitionsFilename ) );
+}
+
+void TriggerTableUnitTestSuite::testDeclaredTriggerMatchesCompiledTrigger()
+{
+	ScopedTriggerDefinitions definitions( TestParameters<std::string>::instance().getParameter( "TEST_TRIGGERDEFINITIONS_FILENAME" ) );
+
+	//
+	// Put the compiled trigger and the declared one in the same menu with the same parameters. The
+	// cross trigger legs are version 0 of the single object triggers, which is what the declaration
+	// copies.
+	//
+	l1menu::TriggerMenu menu;
+	const l1menu::ITrigger& compiledTrigger=menu.addTrigger( "L1_isoEG_Mu", 0 );
+	l1menu::ITrigger& declaredTrigger=menu.addTrigger( "L1_DeclaredIsoEG_Mu", 0 );
+	CPPUNIT_ASSERT( declaredTrigger.parameterNames()==compiledTrigger.parameterNames() );
+	for( const auto& parameterName : compiledTrigger.parameterNames() ) declaredTrigger.parameter(parameterName)=compiledTrigger.parameter(parameterName);
+
+	// Lower thresholds than the defaults so that plenty of the made up events pass
+	l1menu::TriggerMenu lowThresholdMenu( menu );
+	for( size_t triggerNumber=0; triggerNumber<lowThresholdMenu.numberOfTriggers(); ++triggerNumber )
+	{
+		lowThresholdMenu.getTrigger(triggerNumber).parameter("leg1threshold1")=8;
+		lowThresholdMenu.getTrigger(triggerNumber).parameter("leg2threshold1")=6;
+	}
+
+	//
+	// The test sample is normally a reduced sample, which can only evaluate the triggers it was made
+	// with. So check the pass bits with made up events, and also on the test sample if it's a full one.
+	//
+	l1menu::ReducedSample parentSample( lowThresholdMenu ); // Only needed because the events have to have a sample
+	const std::vector<l1menu::L1TriggerDPGEvent> events=createMuonAndEGammaEvents( parentSample, 2000, 9012 );
+	std::vector<const l1menu::L1TriggerDPGEvent*> eventPointers;
+	for( const auto& event : events ) eventPointers.push_back( &event );
+
+	l1menu::implementation::CompiledMenu compiledMenu( lowThresholdMenu );
+	std::vector< std::vector<bool> > results;
+	compiledMenu.applyBatch( eventPointers, results );
+	CPPUNIT_ASSERT_EQUAL( static_cast<size_t>(2), results.size() );
+
+	size_t numberPassed=0;
+	for( size_t eventNumber=0; eventNumber<events.size(); ++eventNumber )
+	{
+		const bool expected=lowThresholdMenu.getTrigger(0).apply( events[eventNumber] );
+		CPPUNIT_ASSERT_EQUAL_MESSAGE( "Different result for event "+std::to_string(eventNumber), expected, lowThresholdMenu.getTrigger(1).apply( events[eventNumber] ) );
+		CPPUNIT_ASSERT_EQUAL_MESSAGE( "Different compiled menu result for event "+std::to_string(eventNumber), expected, static_cast<bool>(results[0][eventNumber]) );
+		CPPUNIT_ASSERT_EQUAL_MESSAGE( "Different fused result for event "+std::to_string(eventNumber), expected, static_cast<bool>(results[1][eventNumber]) );
+		if( expected ) ++numberPassed;
+	}
+	// Make sure the events actually test something
+	CPPUNIT_ASSERT( numberPassed>0 && numberPassed<events.size() );
+
+	std::unique_ptr<l1menu::ISample> pSample;
+	CPPUNIT_ASSERT_NO_THROW( pSample=l1menu::tools::loadSample( TestParameters<std::string>::instance().getParameter( "TEST_SAMPLE_FILENAME" ) ) );
+	const l1menu::FullSample* pFullSample=dynamic_cast<const l1menu::FullSample*>( pSample.get() );
+	if( pFullSample!=nullptr )
+	{
+		for( size_t eventNumber=0; eventNumber<pFullSample->numberOfEvents(); ++eventNumber )
+		{
+			const l1menu::L1TriggerDPGEvent& event=static_cast<const l1menu::L1TriggerDPGEvent&>( pFullSample->getEvent(eventNumber) );
+			CPPUNIT_ASSERT_EQUAL( compiledTrigger.apply(event), declaredTrigger.apply(event) );
+		}
+
+		// MenuRateSums goes through the CompiledMenu, so this checks the fused path on the sample as well
+		const l1menu::MenuRateSums sums( menu, *pFullSample );
+		CPPUNIT_ASSERT_EQUAL( sums.weightOfEventsPassed(0), sums.weightOfEventsPassed(1) );
+		CPPUNIT_ASSERT_EQUAL( sums.weightOfEventsPassed(0), sums.weightOfEventsPassedBoth(0,1) );
+	}
+}
+
+void TriggerTableUnitTestSuite::testSortedEtMatchesCounting()
+{
+	l1menu::TriggerMenu menu;
+	l1menu::ITrigger& trigger=menu.addTrigger( "L1_DoubleEG", 0 );
+	l1menu::ReducedSample parentSample( menu ); // Only needed because the events have to have a sample
+	std::vector<l1menu::L1TriggerDPGEvent> events=createMuonAndEGammaEvents( parentSample, 2000, 3456 );
+	// Change some of the Et values to NaN. These should never be counted, wherever they would sort.
+	size_t objectNumber=0;
+	for( auto& event : events )
+	{
+		for( auto& et : event.rawEvent().Etel )
+		{
+			if( objectNumber%5==1 ) et=std::numeric_limits<float>::quiet_NaN();
+			++objectNumber;
+		}
+	}
+
+	// How DoubleEG was written before it used sortedEt
+	auto countingLoop=[]( const l1menu::L1TriggerDPGEvent& event, float leg1threshold1, float leg2threshold1, float regionCut )
+	{
+		int n1=0;
+		int n2=0;
+		for( const auto& eg : event.prefilteredObjects().egamma )
+		{
+			if( eg.symmetricRegion<regionCut ) continue;
+			float pt=eg.et;
+			if( pt>=leg1threshold1 ) n1++;
+			if( pt>=leg2threshold1 ) n2++;
+		}
+		return ( n1>=1 && n2>=2 );
+	};
+
+	size_t numberPassed=0;
+	size_t numberTested=0;
+	for( const float regionCut : { 0.0f, 4.5f, 9.0f } )
+	{
+		for( const float leg1threshold1 : { 0.0f, 5.0f, 12.0f, 20.0f } )
+		{
+			for( const float leg2threshold1 : { 0.0f, 3.0f, 8.0f, 20.0f } )
+			{
+				trigger.parameter("leg1threshold1")=leg1threshold1;
+				trigger.parameter("leg2threshold1")=leg2threshold1;
+				trigger.parameter("regionCut")=regionCut;
+				for( size_t eventNumber=0; eventNumber<events.size(); ++eventNumber )
+				{
+					const bool expected=( events[eventNumber].prefilteredObjects().zeroBias && countingLoop( events[eventNumber], leg1threshold1, leg2threshold1, regionCut ) );
+					CPPUNIT_ASSERT_EQUAL_MESSAGE( "Different result for event "+std::to_string(eventNumber), expected, trigger.apply( events[eventNumber] ) );
+					if( expected ) ++numberPassed;
+					++numberTested;
+				}
+			}
+		}
+	}
+	// Make sure the events actually test something
+	CPPUNIT_ASSERT( numberPassed>0 && numberPassed<numberTested );
+}
+
+void TriggerTableUnitTestSuite::testFamiliesMatchOriginalLoops()
+{
+	l1menu::TriggerMenu menu;
+	l1menu::ReducedSample parentSample( menu ); // Only needed because the events have to have a sample
+	std::vector<l1menu::L1TriggerDPGEvent> events=createMuonAndEGammaEvents( parentSample, 1000, 1357 );
+	// The original loops skipped objects if a cut value was out of range, so a NaN passed the cut
+	// but could never pass a threshold. Put some in to make sure that's still the case.
+	size_t objectNumber=0;
+	for( auto& event : events )
+	{
+		L1Analysis::L1AnalysisDataFormat& rawEvent=event.rawEvent();
+		for( size_t index=0; index<rawEvent.Etel.size(); ++index, ++objectNumber )
+		{
+			if( objectNumber%7==2 ) rawEvent.Etael[index]=std::numeric_limits<float>::quiet_NaN();
+			if( objectNumber%11==5 ) rawEvent.Etel[index]=std::numeric_limits<float>::quiet_NaN();
+		}
+		for( size_t index=0; index<rawEvent.Etamu.size(); ++index, ++objectNumber )
+		{
+			if( objectNumber%7==2 ) rawEvent.Etamu[index]=std::numeric_limits<float>::quiet_NaN();
+		}
+	}
+	const std::vector<l1menu::L1TriggerDPGEvent> trackEvents=createTrackEvents( parentSample, 1000, 2345 );
+
+	const std::vector<float> thresholds={ 0, 6, 15 };
+	const std::vector<float> regionCuts={ 0, 4.5, 8 };
+	std::pair<size_t,size_t> numberPassedAndTested( 0, 0 );
+	auto addCounts=[&numberPassedAndTested]( const std::pair<size_t,size_t>& counts )
+	{
+		numberPassedAndTested.first+=counts.first;
+		numberPassedAndTested.second+=counts.second;
+	};
+
+	//
+	// The loops below are as they were in the trigger classes before the families, apart from the
+	// member variables becoming the "parameters" vector.
+	//
+	addCounts( checkAgainstLoop( menu.addTrigger( "L1_SingleEGEta", 0 ), { thresholds, regionCuts }, events,
+		[]( const l1menu::L1TriggerDPGEvent& event, const std::vector<float>& parameters )
+		{
+			const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
+			if( !event.physicsBits()[0] ) return false;
+			bool ok=false;
+			for( int ue=0; ue<analysisDataFormat.Nele; ue++ )
+			{
+				if( analysisDataFormat.Bxel[ue]!=0 ) continue;
+				float eta=analysisDataFormat.Etael[ue];
+				if( eta<parameters[1] || eta>21.-parameters[1] ) continue;
+				float pt=analysisDataFormat.Etel[ue];
+				if( pt>=parameters[0] ) ok=true;
+			}
+			return ok;
+		} ) );
+
+	addCounts( checkAgainstLoop( menu.addTrigger( "L1_SingleIsoEGEta", 0 ), { thresholds, regionCuts }, events,
+		[]( const l1menu::L1TriggerDPGEvent& event, const std::vector<float>& parameters )
+		{
+			const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
+			if( !event.physicsBits()[0] ) return false;
+			bool ok=false;
+			for( int ue=0; ue<analysisDataFormat.Nele; ue++ )
+			{
+				if( analysisDataFormat.Bxel[ue]!=0 ) continue;
+				bool iso=analysisDataFormat.Isoel[ue];
+				if( !iso ) continue;
+				float eta=analysisDataFormat.Etael[ue];
+				if( eta<parameters[1] || eta>21.-parameters[1] ) continue;
+				float pt=analysisDataFormat.Etel[ue];
+				if( pt>=parameters[0] ) ok=true;
+			}
+			return ok;
+		} ) );
+
+	addCounts( checkAgainstLoop( menu.addTrigger( "L1_SingleMuEta", 0 ), { thresholds, { 0, 4, 6.5 }, { 1, 2.1 } }, events,
+		[]( const l1menu::L1TriggerDPGEvent& event, const std::vector<float>& parameters )
+		{
+			const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
+			if( !event.physicsBits()[0] ) return false;
+			bool muon=false;
+			for( int imu=0; imu<analysisDataFormat.Nmu; imu++ )
+			{
+				if( analysisDataFormat.Bxmu.at(imu)!=0 ) continue;
+				float pt=analysisDataFormat.Ptmu.at(imu);
+				int qual=analysisDataFormat.Qualmu.at(imu);
+				if( qual<parameters[1] ) continue;
+				float eta=analysisDataFormat.Etamu.at(imu);
+				if( std::fabs(eta)>parameters[2] ) continue;
+				if( pt>=parameters[0] ) muon=true;
+			}
+			return muon;
+		} ) );
+
+	addCounts( checkAgainstLoop( menu.addTrigger( "L1_DoubleEG", 0 ), { thresholds, thresholds, regionCuts }, events,
+		[]( const l1menu::L1TriggerDPGEvent& event, const std::vector<float>& parameters )
+		{
+			const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
+			if( !event.physicsBits()[0] ) return false;
+			int n1=0;
+			int n2=0;
+			for( int ue=0; ue<analysisDataFormat.Nele; ue++ )
+			{
+				if( analysisDataFormat.Bxel[ue]!=0 ) continue;
+				float eta=analysisDataFormat.Etael[ue];
+				if( eta<parameters[2] || eta>21.-parameters[2] ) continue;
+				float pt=analysisDataFormat.Etel[ue];
+				if( pt>=parameters[0] ) n1++;
+				if( pt>=parameters[1] ) n2++;
+			}
+			return ( n1>=1 && n2>=2 );
+		} ) );
+
+	addCounts( checkAgainstLoop( menu.addTrigger( "L1_SingleIsoTkEleEta", 1 ), { thresholds, regionCuts, { 0, 2, 999 } }, trackEvents,
+		[]( const l1menu::L1TriggerDPGEvent& event, const std::vector<float>& parameters )
+		{
+			const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
+			if( !event.physicsBits()[0] ) return false;
+			bool ok=false;
+			for( int ue=0; ue<analysisDataFormat.NTkele; ue++ )
+			{
+				if( analysisDataFormat.BxTkel[ue]!=0 ) continue;
+				float iso=analysisDataFormat.tIsoTkel[ue];
+				if( iso>parameters[2] ) continue;
+				float eta=analysisDataFormat.EtaTkel[ue];
+				if( eta<parameters[1] || eta>21.-parameters[1] ) continue;
+				float pt=analysisDataFormat.EtTkel[ue];
+				if( pt>=parameters[0] ) ok=true;
+			}
+			return ok;
+		} ) );
+
+	addCounts( checkAgainstLoop( menu.addTrigger( "L1_DoubleTkEle", 0 ), { thresholds, thresholds, regionCuts, { 9999 } }, trackEvents,
+		[]( const l1menu::L1TriggerDPGEvent& event, const std::vector<float>& parameters )
+		{
+			const L1Analysis::L1AnalysisDataFormat& analysisDataFormat=event.rawEvent();
+			if( !event.physicsBits()[0] ) return false;
+			int n1=0;
+			int n2=0;
+			for( int ue=0; ue<analysisDataFormat.NTkele; ue++ )
+			{
+				if( analysisDataFormat.BxTkel[ue]!=0 ) continue;
+				float eta=analysisDataFormat.EtaTkel[ue];
+				if( eta<parameters[2] || eta>21.-parameters[2] ) continue;
+				float pt=analysisDataFormat.EtTkel[ue];
+				if( pt>=parameters[0] ) n1++;
+				if( pt>=parameters[1] ) n2++;
+			}
+			return ( n1>=1 && n2>=2 );
+		} ) );
+
+	// Make sure the events actually test something
+	CPPUNIT_ASSERT( numberPassedAndTested.first>0 && numberPassedAndTested.first<numberPassedAndTested.second );
+}
+
+void TriggerTableUnitTestSuite::testVertexMatchedPairsMatchNestedLoops()
+{
+	l1menu::TriggerMenu menu;
+	l1menu::ITrigger& doubleTrigger=menu.addTrigger( "L1_DoubleTkEle", 2 );
+	l1menu::ITrigger& crossTrigger=menu.addTrigger( "L1_TkEle_TkJet", 1 );
+	l1menu::ReducedSample parentSample( menu ); // Only needed because the events have to have a sample
+	const std::vector<l1menu::L1TriggerDPGEvent> events=createTrackEvents( parentSample, 1000, 7890 );
+
+	// How DoubleTkEle_v2 was written before it used vertexMatchedPairExists
+	auto doubleLoop=[]( const l1menu::L1TriggerDPGEvent& event, float leg1threshold1, float leg2threshold1, float regionCut, float zVtxCut )
+	{
+		const auto& electrons=event.prefilteredObjects().trackElectrons;
+		bool ok=false;
+		for( size_t ue=0; ue<electrons.size(); ue++ )
+		{
+			if( electrons[ue].symmetricRegion<regionCut ) continue;
+			float pt=electrons[ue].et;
+			if( pt>=leg1threshold1 )
+			{
+				float eleZvtx=electrons[ue].zVtx;
+				for( size_t ue2=0; ue2<electrons.size(); ue2++ )
+				{
+					if( ue2!=ue && std::fabs(eleZvtx-electrons[ue2].zVtx)<zVtxCut )
+					{
+						if( electrons[ue2].symmetricRegion<regionCut ) continue;
+						float pt2=electrons[ue2].et;
+						if( pt2>=leg2threshold1 ) ok=true;
+					}
+				}
+			}
+		}
+		return ok;
+	};
+
+	// How TkEle_TkJet_v1 was written before it used vertexMatchedPairExists
+	auto crossLoop=[]( const l1menu::L1TriggerDPGEvent& event, float leg1threshold1, float leg2threshold1, float regionCut, float zVtxCut )
+	{
+		const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+		bool ok=false;
+		for( const auto& electron : objects.trackElectrons )
+		{
+			if( electron.symmetricRegion<regionCut ) continue;
+			float pt=electron.et;
+			if( pt>=leg1threshold1 )
+			{
+				float eleZvtx=electron.zVtx;
+				for( const auto& jet : objects.trackJets )
+				{
+					if( std::fabs(eleZvtx-jet.zVtx)<zVtxCut )
+					{
+						if( jet.symmetricRegion<regionCut ) continue;
+						float ptj=jet.et;
+						if( ptj>=leg2threshold1 && !(jet.eta==electron.eta && jet.phi==electron.phi) ) ok=true;
+					}
+				}
+			}
+		}
+		return ok;
+	};
+
+	size_t numberPassed=0;
+	size_t numberTested=0;
+	for( const float zVtxCut : { 0.0f, 0.5f, 1.0f, 2.0f, 9999.0f } )
+	{
+		for( const float regionCut : { 0.0f, 4.5f } )
+		{
+			for( const float leg1threshold1 : { 0.0f, 10.0f } )
+			{
+				for( const float leg2threshold1 : { 0.0f, 6.0f } )
+				{
+					doubleTrigger.parameter("leg1threshold1")=leg1threshold1;
+					doubleTrigger.parameter("leg2threshold1")=leg2threshold1;
+					doubleTrigger.parameter("regionCut")=regionCut;
+					doubleTrigger.parameter("zVtxCut")=zVtxCut;
+					crossTrigger.parameter("leg1threshold1")=leg1threshold1;
+					crossTrigger.parameter("leg2threshold1")=leg2threshold1;
+					crossTrigger.parameter("leg1regionCut")=regionCut;
+					crossTrigger.parameter("leg2regionCut")=regionCut;
+					crossTrigger.parameter("zVtxCut")=zVtxCut;
+					for( size_t eventNumber=0; eventNumber<events.size(); ++eventNumber )
+					{
+						const l1menu::L1TriggerDPGEvent& event=events[eventNumber];
+						const bool expectedDouble=doubleLoop( event, leg1threshold1, leg2threshold1, regionCut, zVtxCut );
+						const bool expectedCross=crossLoop( event, leg1threshold1, leg2threshold1, regionCut, zVtxCut );
+						CPPUNIT_ASSERT_EQUAL_MESSAGE( "Different DoubleTkEle result for event "+std::to_string(eventNumber), expectedDouble, doubleTrigger.apply(event) );
+						CPPUNIT_ASSERT_EQUAL_MESSAGE( "Different TkEle_TkJet result for event "+std::to_string(eventNumber), expectedCross, crossTrigger.apply(event) );
+						if( expectedDouble ) ++numberPassed;
+						if( expectedCross ) ++numberPassed;
+						numberTested+=2;
+					}
+				}
+			}
+		}
+	}
+	// Make sure the events actually test something
+	CPPUNIT_ASSERT( numberPassed>0 && numberPassed<numberTested );
+}
+
+void TriggerTableUnitTestSuite::testTowerOverlapMatchesNestedLoops()
+{
+	l1menu::TriggerMenu menu;
+	menu.addTrigger( "L1_EG_JetCentral", 1 );
+	menu.addTrigger( "L1_EG_Tau", 0 );
+	menu.addTrigger( "L1_TkEle_EG", 0 );
+	l1menu::ReducedSample parentSample( menu ); // Only needed because the events have to have a sample
+	const std::vector<l1menu::L1TriggerDPGEvent> events=createOverlappingEvents( parentSample, 1000, 2468 );
+
+	// The loop EG_JetCentral_v1, EG_Tau and TkEle_EG used to have, apart from the collections
+	typedef std::vector<l1menu::L1TriggerDPGEvent::L1Object> Collection;
+	auto nestedLoop=[]( const Collection& leg1Collection, const Collection& leg2Collection, float leg1threshold1, float leg1regionCut, float leg2threshold1, float leg2regionCut )
+	{
+		bool ok=false;
+		for( const auto& leg1 : leg1Collection )
+		{
+			if( leg1.symmetricRegion<leg1regionCut ) continue;
+			float pt=leg1.et;
+			if( pt>=leg1threshold1 )
+			{
+				for( const auto& leg2 : leg2Collection )
+				{
+					if( leg2.symmetricRegion<leg2regionCut ) continue;
+					float ptj=leg2.et;
+					if( ptj>=leg2threshold1 && !(leg2.eta==leg1.eta && leg2.phi==leg1.phi) ) ok=true;
+				}
+			}
+		}
+		return ok;
+	};
+
+	size_t numberPassed=0;
+	size_t numberTested=0;
+	for( const float regionCut : { -2.0f, 3.5f } )
+	{
+		for( const float leg1threshold1 : { 0.0f, 10.0f } )
+		{
+			for( const float leg2threshold1 : { 0.0f, 6.0f, 20.0f } )
+			{
+				for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+				{
+					l1menu::ITrigger& trigger=menu.getTrigger(triggerNumber);
+					trigger.parameter("leg1threshold1")=leg1threshold1;
+					trigger.parameter("leg1regionCut")=regionCut;
+					trigger.parameter("leg2threshold1")=leg2threshold1;
+					trigger.parameter("leg2regionCut")=regionCut;
+				}
+				for( size_t eventNumber=0; eventNumber<events.size(); ++eventNumber )
+				{
+					const l1menu::L1TriggerDPGEvent& event=events[eventNumber];
+					const l1menu::L1TriggerDPGEvent::PrefilteredObjects& objects=event.prefilteredObjects();
+					const bool expected[]={
+						nestedLoop( objects.egamma, objects.centralJets, leg1threshold1, regionCut, leg2threshold1, regionCut ),
+						nestedLoop( objects.egamma, objects.tauJets, leg1threshold1, regionCut, leg2threshold1, regionCut ),
+						nestedLoop( objects.trackElectrons, objects.egamma, leg1threshold1, regionCut, leg2threshold1, regionCut ) };
+					for( size_t triggerNumber=0; triggerNumber<menu.numberOfTriggers(); ++triggerNumber )
+					{
+						const l1menu::ITrigger& trigger=menu.getTrigger(triggerNumber);
+						CPPUNIT_ASSERT_EQUAL_MESSAGE( "Different "+trigger.name()+" result for event "+std::to_string(eventNumber), expected[triggerNumber], trigger.apply(event) );
+						if( expected[triggerNumber] ) ++numberPassed;
+						++numberTested;
+					}
+				}
+			}
+		}
+	}
+	// Make sure the events actually test something
+	CPPUNIT_ASSERT( numberPassed>0 && numberPassed<numberTested );
+}
+
+void TriggerTableUnitTestSuite::testCloning()
+{
+	l1menu::TriggerTable& table=l1menu::TriggerTable::instance();
+
+	for( const auto& triggerDetails : table.listTriggers() )
+	{
+		std::unique_ptr<l1menu::ITrigger> pTrigger=table.getTrigger( triggerDetails.name, triggerDetails.version );
+		CPPUNIT_ASSERT( pTrigger!=nullptr );
+
+		const auto& parameterNames=pTrigger->parameterNames();
+		for( size_t handle=0; handle<parameterNames.size(); ++handle ) pTrigger->parameter(handle)=std::rand();
+
+		std::unique_ptr<l1menu::ITrigger> pClone=pTrigger->clone();
+		std::unique_ptr<l1menu::ITrigger> pCopy=table.copyTrigger( *pTrigger );
+		for( const auto& pNewTrigger : { pClone.get(), pCopy.get() } )
+		{
+			CPPUNIT_ASSERT( pNewTrigger!=nullptr );
+			CPPUNIT_ASSERT_EQUAL( triggerDetails.name, pNewTrigger->name() );
+			CPPUNIT_ASSERT_EQUAL( triggerDetails.version, pNewTrigger->version() );
+			// Should be exactly the same type, not a base class that happens to have the same name
+			CPPUNIT_ASSERT( typeid(*pNewTrigger)==typeid(*pTrigger) );
+			CPPUNIT_ASSERT( pNewTrigger->parameterNames()==parameterNames );
+			for( size_t handle=0; handle<parameterNames.size(); ++handle )
+			{
+				CPPUNIT_ASSERT_EQUAL( pTrigger->parameter(handle), pNewTrigger->parameter(handle) );
+				// Make sure it's a copy and not sharing the parameters, e.g. the legs of a cross trigger
+				CPPUNIT_ASSERT( &pTrigger->parameter(handle)!=&pNewTrigger->parameter(handle) );
+			}
+		}
+	}
+}
+
 void TriggerTableUnitTestSuite::dumpTriggerTable()
 {
 	// No tests performed with this one, just prints out the available triggers
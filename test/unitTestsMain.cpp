@@ -131,6 +131,7 @@ bool handleCommandLine( int argc, char* argv[] )
 	requiredParametersAndDefaults.push_back( std::make_pair("TEST_MENU_FILENAME","src/L1Trigger/MenuGeneration/test/unitTestData/L1Menu_v22m20_std.txt") );
 	requiredParametersAndDefaults.push_back( std::make_pair("TEST_RATEPLOT_FILENAME","src/L1Trigger/MenuGeneration/test/unitTestData/output_rates_PU140_v23_trk.root") );
 	requiredParametersAndDefaults.push_back( std::make_pair("TEST_XMLMENU_FILENAME","src/L1Trigger/MenuGeneration/test/unitTestData/L1Menu_v22m20_std.xml") );
+	requiredParametersAndDefaults.push_back( std::make_pair("TEST_TRIGGERDEFINITIONS_FILENAME","src/L1Trigger/MenuGeneration/test/unitTestData/TriggerDefinitions.xml") );
 
 	try{ commandLineParser.parse( argc, argv ); }
 	catch( std::runtime_error& exception )